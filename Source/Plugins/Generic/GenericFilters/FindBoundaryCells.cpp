@@ -54,6 +54,7 @@
 
 #include "Generic/GenericConstants.h"
 #include "Generic/GenericVersion.h"
+#include "Generic/GenericFilters/util/FeatureVolumeReduction.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -155,89 +156,12 @@ void FindBoundaryCells::execute()
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
-  int64_t xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-  int64_t yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  int64_t zPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -1 * (xPoints * yPoints);
-  neighpoints[1] = -1 * (xPoints);
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xPoints;
-  neighpoints[5] = xPoints * yPoints;
-
-  int32_t feature = 0;
-  int32_t onsurf = 0;
-  int32_t good = 0;
-  int64_t neighbor = 0;
-
-  int ignoreFeatureZeroVal = 0;
-  if(!m_IgnoreFeatureZero)
-  {
-    ignoreFeatureZeroVal = -1;
-  }
-
-  int64_t zStride = 0, yStride = 0;
-  for(int64_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for(int64_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for(int64_t k = 0; k < xPoints; k++)
-      {
-        onsurf = 0;
-        feature = m_FeatureIds[zStride + yStride + k];
-        if(feature >= 0)
-        {
-          if(m_IncludeVolumeBoundary)
-          {
-            if (xPoints > 2 && (k == 0 || k == xPoints - 1)) { onsurf++; }
-            if (yPoints > 2 && (j == 0 || j == yPoints - 1)) { onsurf++; }
-            if (zPoints > 2 && (i == 0 || i == zPoints - 1)) { onsurf++; }
-
-            if(onsurf > 0 && feature == 0) { onsurf = 0; }
-          }
-
-          for(int64_t l = 0; l < 6; l++)
-          {
-            good = 1;
-            neighbor = zStride + yStride + k + neighpoints[l];
-            if(l == 0 && i == 0)
-            {
-              good = 0;
-            }
-            if(l == 5 && i == (zPoints - 1))
-            {
-              good = 0;
-            }
-            if(l == 1 && j == 0)
-            {
-              good = 0;
-            }
-            if(l == 4 && j == (yPoints - 1))
-            {
-              good = 0;
-            }
-            if(l == 2 && k == 0)
-            {
-              good = 0;
-            }
-            if(l == 3 && k == (xPoints - 1))
-            {
-              good = 0;
-            }
-            if(good == 1 && m_FeatureIds[neighbor] != feature && m_FeatureIds[neighbor] > ignoreFeatureZeroVal)
-            {
-              onsurf++;
-            }
-          }
-        }
-        m_BoundaryCells[zStride + yStride + k] = onsurf;
-      }
-    }
-  }
+  // The boundary counts are written by the same parallel sweep that computes the per Feature reductions
+  FeatureVolumeReduction::BoundaryCells boundaryCells;
+  boundaryCells.boundaryCells = m_BoundaryCells;
+  boundaryCells.ignoreFeatureZero = m_IgnoreFeatureZero;
+  boundaryCells.includeVolumeBoundary = m_IncludeVolumeBoundary;
+  FeatureVolumeReduction::Find(m_FeatureIdsPtr.lock(), m->getGeometryAs<ImageGeom>(), 0, 0, boundaryCells);
 
 }
 
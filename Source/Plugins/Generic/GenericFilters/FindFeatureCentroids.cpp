@@ -37,7 +37,7 @@
 
 #include "FindFeatureCentroids.h"
 
-#include <array>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -53,6 +53,7 @@
 
 #include "Generic/GenericConstants.h"
 #include "Generic/GenericVersion.h"
+#include "Generic/GenericFilters/util/FeatureVolumeReduction.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -148,48 +149,16 @@ void FindFeatureCentroids::find_centroids()
 
   size_t totalFeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
-  std::vector<size_t> dims(1, 4);
-  FloatArrayType::Pointer m_FeatureCentersPtr = FloatArrayType::CreateArray(totalFeatures, dims, "_INTERNAL_USE_ONLY_Centroids", true);
-  m_FeatureCentersPtr->initializeWithZeros();
-  float* featurecenters = m_FeatureCentersPtr->getPointer(0);
-
-  size_t xPoints = imageGeom->getXPoints();
-  size_t yPoints = imageGeom->getYPoints();
-  size_t zPoints = imageGeom->getZPoints();
-
-  // FloatVec3Type spacing = imageGeom->getSpacing();
-  // FloatVec3Type origin = imageGeom->getOrigin();
-
-  size_t zStride = 0;
-  size_t yStride = 0;
-  for(size_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for(size_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for(size_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        featurecenters[gnum * 4 + 0]++;
-        std::array<float, 3> coords = {{0.0f, 0.0f, 0.0f}};
-        imageGeom->getCoords(k, j, i, coords.data());
-        featurecenters[gnum * 4 + 1] = featurecenters[gnum * 4 + 1] + coords[0];
-        featurecenters[gnum * 4 + 2] = featurecenters[gnum * 4 + 2] + coords[1];
-        featurecenters[gnum * 4 + 3] = featurecenters[gnum * 4 + 3] + coords[2];
-      }
-    }
-  }
+  FeatureVolumeReduction::ConstPointer reduction = FeatureVolumeReduction::Find(m_FeatureIdsPtr.lock(), imageGeom, totalFeatures, FeatureVolumeReduction::Centroids);
+  const std::vector<uint64_t>& counts = reduction->getCounts();
+  const std::vector<float>& centroids = reduction->getCentroids();
   for(size_t i = 0; i < totalFeatures; i++)
   {
-    if(featurecenters[i * 4 + 0] > 0.0f)
+    if(counts[i] > 0)
     {
-      featurecenters[i * 4 + 1] = featurecenters[i * 4 + 1] / featurecenters[i * 4 + 0];
-      featurecenters[i * 4 + 2] = featurecenters[i * 4 + 2] / featurecenters[i * 4 + 0];
-      featurecenters[i * 4 + 3] = featurecenters[i * 4 + 3] / featurecenters[i * 4 + 0];
-      m_Centroids[3 * i] = featurecenters[i * 4 + 1];
-      m_Centroids[3 * i + 1] = featurecenters[i * 4 + 2];
-      m_Centroids[3 * i + 2] = featurecenters[i * 4 + 3];
+      m_Centroids[3 * i] = centroids[3 * i];
+      m_Centroids[3 * i + 1] = centroids[3 * i + 1];
+      m_Centroids[3 * i + 2] = centroids[3 * i + 2];
     }
   }
 }
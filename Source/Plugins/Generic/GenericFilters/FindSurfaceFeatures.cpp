@@ -51,6 +51,7 @@
 
 #include "Generic/GenericConstants.h"
 #include "Generic/GenericVersion.h"
+#include "Generic/GenericFilters/util/FeatureVolumeReduction.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -143,150 +144,17 @@ void FindSurfaceFeatures::dataCheck()
 void FindSurfaceFeatures::find_surfacefeatures()
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
+  ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
 
-  int64_t xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-  int64_t yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  int64_t zPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
+  size_t totalFeatures = m_SurfaceFeaturesPtr.lock()->getNumberOfTuples();
 
-  int64_t zStride = 0, yStride = 0;
-  for(int64_t i = 0; i < zPoints; i++)
+  FeatureVolumeReduction::ConstPointer reduction = FeatureVolumeReduction::Find(m_FeatureIdsPtr.lock(), imageGeom, totalFeatures, FeatureVolumeReduction::SurfaceFeatures);
+  const std::vector<uint8_t>& surfaceFeatures = reduction->getSurfaceFeatures();
+  for(size_t i = 0; i < totalFeatures; i++)
   {
-    zStride = i * xPoints * yPoints;
-    for(int64_t j = 0; j < yPoints; j++)
+    if(surfaceFeatures[i] != 0)
     {
-      yStride = j * xPoints;
-      for(int64_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        if(!m_SurfaceFeatures[gnum])
-        {
-          if(k <= 0)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(k >= xPoints - 1)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(j <= 0)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(j >= yPoints - 1)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(i <= 0)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(i >= zPoints - 1)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(!m_SurfaceFeatures[gnum])
-          {
-            if(m_FeatureIds[zStride + yStride + k - 1] == 0)
-            {
-              m_SurfaceFeatures[gnum] = true;
-            }
-            if(m_FeatureIds[zStride + yStride + k + 1] == 0)
-            {
-              m_SurfaceFeatures[gnum] = true;
-            }
-            if(m_FeatureIds[zStride + yStride + k - xPoints] == 0)
-            {
-              m_SurfaceFeatures[gnum] = true;
-            }
-            if(m_FeatureIds[zStride + yStride + k + xPoints] == 0)
-            {
-              m_SurfaceFeatures[gnum] = true;
-            }
-            if(m_FeatureIds[zStride + yStride + k - (xPoints * yPoints)] == 0)
-            {
-              m_SurfaceFeatures[gnum] = true;
-            }
-            if(m_FeatureIds[zStride + yStride + k + (xPoints * yPoints)] == 0)
-            {
-              m_SurfaceFeatures[gnum] = true;
-            }
-          }
-        }
-      }
-    }
-  }
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void FindSurfaceFeatures::find_surfacefeatures2D()
-{
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
-
-  int64_t xPoints = 0, yPoints = 0;
-
-  if(m->getGeometryAs<ImageGeom>()->getXPoints() == 1)
-  {
-    xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-    yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
-  }
-  if(m->getGeometryAs<ImageGeom>()->getYPoints() == 1)
-  {
-    xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-    yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
-  }
-  if(m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
-  {
-    xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-    yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  }
-
-  int64_t yStride;
-  for(int64_t j = 0; j < yPoints; j++)
-  {
-    yStride = j * xPoints;
-    for(int64_t k = 0; k < xPoints; k++)
-    {
-      int32_t gnum = m_FeatureIds[yStride + k];
-      if(!m_SurfaceFeatures[gnum])
-      {
-        if(k <= 0)
-        {
-          m_SurfaceFeatures[gnum] = true;
-        }
-        if(k >= xPoints - 1)
-        {
-          m_SurfaceFeatures[gnum] = true;
-        }
-        if(j <= 0)
-        {
-          m_SurfaceFeatures[gnum] = true;
-        }
-        if(j >= yPoints - 1)
-        {
-          m_SurfaceFeatures[gnum] = true;
-        }
-        if(!m_SurfaceFeatures[gnum])
-        {
-          if(m_FeatureIds[yStride + k - 1] == 0)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(m_FeatureIds[yStride + k + 1] == 0)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(m_FeatureIds[yStride + k - static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints())] == 0)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(m_FeatureIds[yStride + k + static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints())] == 0)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-        }
-      }
+      m_SurfaceFeatures[i] = true;
     }
   }
 }
@@ -304,16 +172,7 @@ void FindSurfaceFeatures::execute()
     return;
   }
 
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
-
-  if(m->getGeometryAs<ImageGeom>()->getXPoints() > 1 && m->getGeometryAs<ImageGeom>()->getYPoints() > 1 && m->getGeometryAs<ImageGeom>()->getZPoints() > 1)
-  {
-    find_surfacefeatures();
-  }
-  if(m->getGeometryAs<ImageGeom>()->getXPoints() == 1 || m->getGeometryAs<ImageGeom>()->getYPoints() == 1 || m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
-  {
-    find_surfacefeatures2D();
-  }
+  find_surfacefeatures();
 
 }
 
@@ -0,0 +1,457 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+/**
+ * @brief The FeatureVolumeReduction class computes per Feature quantities of an image FeatureIds array in a single
+ * sweep over the volume. The rows of the volume are split into slabs that are scanned in parallel, each slab
+ * accumulating into its own table, and the tables are merged in slab order so the results do not depend on the
+ * thread schedule. Filters request only the outputs they need, so each filter pays for a single sweep. The sweep
+ * can also write the per cell output of FindBoundaryCells.
+ */
+class FeatureVolumeReduction
+{
+public:
+  using ConstPointer = std::shared_ptr<const FeatureVolumeReduction>;
+
+  enum Output : uint32_t
+  {
+    Counts = 0x1,
+    Centroids = 0x2,
+    SurfaceFeatures = 0x4
+  };
+
+  /**
+   * @brief The BoundaryCells struct describes the optional per cell output of FindBoundaryCells
+   */
+  struct BoundaryCells
+  {
+    int8_t* boundaryCells = nullptr;
+    bool ignoreFeatureZero = true;
+    bool includeVolumeBoundary = false;
+  };
+
+  ~FeatureVolumeReduction() = default;
+
+  /**
+   * @brief Find Computes the requested per Feature outputs of the FeatureIds in one sweep.
+   * FeatureIds outside [0, numFeatures) do not contribute to any per Feature output.
+   * @param featureIds Cell FeatureIds
+   * @param image Geometry of the cells
+   * @param numFeatures Number of tuples of the Feature AttributeMatrix
+   * @param outputs Bitwise combination of Output values
+   * @return The reduction. Outputs that were not requested are empty, except for the counts that come with the centroids.
+   */
+  static ConstPointer Find(const Int32ArrayType::Pointer& featureIds, const ImageGeom::Pointer& image, size_t numFeatures, uint32_t outputs)
+  {
+    return Find(featureIds, image, numFeatures, outputs, BoundaryCells());
+  }
+
+  /**
+   * @brief Find Same as above; if boundaryCells.boundaryCells is set, the sweep also writes the boundary cell counts
+   */
+  static ConstPointer Find(const Int32ArrayType::Pointer& featureIds, const ImageGeom::Pointer& image, size_t numFeatures, uint32_t outputs, const BoundaryCells& boundaryCells)
+  {
+    if((outputs & Centroids) != 0)
+    {
+      outputs |= Counts;
+    }
+    std::shared_ptr<FeatureVolumeReduction> reduction(new FeatureVolumeReduction(featureIds->getNumberOfTuples(), image, numFeatures));
+    reduction->sweep(featureIds->getPointer(0), outputs, boundaryCells);
+    return reduction;
+  }
+
+  /**
+   * @brief getCounts Number of cells of each Feature
+   */
+  const std::vector<uint64_t>& getCounts() const
+  {
+    return m_Counts;
+  }
+
+  /**
+   * @brief getCentroids Centroid of each Feature as 3 floats; zero for Features without cells
+   */
+  const std::vector<float>& getCentroids() const
+  {
+    return m_Centroids;
+  }
+
+  /**
+   * @brief getSurfaceFeatures Non zero for each Feature that touches the outer surface of the volume or a cell of Feature 0
+   */
+  const std::vector<uint8_t>& getSurfaceFeatures() const
+  {
+    return m_SurfaceFeatures;
+  }
+
+private:
+  static const size_t k_MaxTableBytes = 256 * 1024 * 1024;
+
+  std::array<size_t, 3> m_Dims = {{0, 0, 0}};
+  std::array<float, 3> m_FirstCoords = {{0.0f, 0.0f, 0.0f}};
+  std::array<float, 3> m_Step = {{0.0f, 0.0f, 0.0f}};
+  size_t m_NumPoints = 0;
+  size_t m_NumFeatures = 0;
+  uint32_t m_Outputs = 0;
+
+  std::vector<uint64_t> m_Counts;
+  std::vector<float> m_Centroids;
+  std::vector<uint8_t> m_SurfaceFeatures;
+
+  /**
+   * @brief The SlabTable struct holds the partial per Feature results of one slab
+   */
+  struct SlabTable
+  {
+    size_t firstRow = 0;
+    size_t endRow = 0;
+    std::vector<uint64_t> counts;
+    std::vector<double> indexSums;
+    std::vector<uint8_t> surface;
+  };
+
+  FeatureVolumeReduction(size_t numPoints, const ImageGeom::Pointer& image, size_t numFeatures)
+  : m_NumPoints(numPoints)
+  , m_NumFeatures(numFeatures)
+  {
+    m_Dims = {{image->getXPoints(), image->getYPoints(), image->getZPoints()}};
+    // Centroids are accumulated in index space and mapped through the geometry's own cell coordinates at the end
+    std::array<float, 3> nextCoords = {{0.0f, 0.0f, 0.0f}};
+    image->getCoords(size_t(0), size_t(0), size_t(0), m_FirstCoords.data());
+    image->getCoords(size_t(1), size_t(1), size_t(1), nextCoords.data());
+    for(size_t d = 0; d < 3; d++)
+    {
+      m_Step[d] = nextCoords[d] - m_FirstCoords[d];
+    }
+  }
+
+  /**
+   * @brief makeSlabs Splits the rows of the volume into slabs, using fewer slabs when the per slab tables would get large
+   */
+  std::vector<SlabTable> makeSlabs(uint32_t outputs) const
+  {
+    size_t numRows = m_Dims[1] * m_Dims[2];
+    size_t numThreads = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    numThreads = std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+#endif
+    size_t maxSlabs = numThreads * 4;
+    size_t bytesPerFeature = ((outputs & Counts) != 0 ? sizeof(uint64_t) : 0) + ((outputs & Centroids) != 0 ? 3 * sizeof(double) : 0) + ((outputs & SurfaceFeatures) != 0 ? 1 : 0);
+    size_t tableBytes = bytesPerFeature * m_NumFeatures;
+    if(tableBytes > 0)
+    {
+      maxSlabs = std::max(std::min(maxSlabs, k_MaxTableBytes / tableBytes), static_cast<size_t>(1));
+    }
+    size_t numSlabs = std::max(std::min(maxSlabs, numRows), static_cast<size_t>(1));
+
+    std::vector<SlabTable> slabs(numSlabs);
+    for(size_t s = 0; s < numSlabs; s++)
+    {
+      slabs[s].firstRow = numRows * s / numSlabs;
+      slabs[s].endRow = numRows * (s + 1) / numSlabs;
+    }
+    return slabs;
+  }
+
+  /**
+   * @brief sweep Scans the volume once and merges the slab tables
+   */
+  void sweep(const int32_t* featureIds, uint32_t outputs, const BoundaryCells& boundaryCells)
+  {
+    m_Outputs = outputs;
+    std::vector<SlabTable> slabs = makeSlabs(outputs);
+    SweepImpl impl(*this, featureIds, outputs, boundaryCells, slabs);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, slabs.size(), 1), impl, tbb::simple_partitioner());
+#else
+    impl.convert(0, slabs.size());
+#endif
+    if(outputs == 0)
+    {
+      return;
+    }
+
+    if((outputs & Counts) != 0)
+    {
+      m_Counts.assign(m_NumFeatures, 0);
+    }
+    if((outputs & Centroids) != 0)
+    {
+      m_Centroids.assign(m_NumFeatures * 3, 0.0f);
+    }
+    if((outputs & SurfaceFeatures) != 0)
+    {
+      m_SurfaceFeatures.assign(m_NumFeatures, 0);
+    }
+    MergeImpl merge(*this, slabs);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_NumFeatures), merge, tbb::auto_partitioner());
+#else
+    merge.convert(0, m_NumFeatures);
+#endif
+  }
+
+  /**
+   * @brief The SweepImpl class scans whole slabs of rows for the requested outputs
+   */
+  class SweepImpl
+  {
+  public:
+    SweepImpl(const FeatureVolumeReduction& reduction, const int32_t* featureIds, uint32_t outputs, const BoundaryCells& boundaryCells, std::vector<SlabTable>& slabs)
+    : m_Reduction(reduction)
+    , m_FeatureIds(featureIds)
+    , m_Outputs(outputs)
+    , m_BoundaryCells(boundaryCells)
+    , m_Slabs(slabs)
+    {
+    }
+    virtual ~SweepImpl() = default;
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t s = start; s < end; s++)
+      {
+        sweepSlab(m_Slabs[s]);
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const FeatureVolumeReduction& m_Reduction;
+    const int32_t* m_FeatureIds;
+    uint32_t m_Outputs;
+    BoundaryCells m_BoundaryCells;
+    std::vector<SlabTable>& m_Slabs;
+
+    void sweepSlab(SlabTable& slab) const
+    {
+      const std::array<size_t, 3>& dims = m_Reduction.m_Dims;
+      size_t numFeatures = m_Reduction.m_NumFeatures;
+      int64_t strides[3] = {1, static_cast<int64_t>(dims[0]), static_cast<int64_t>(dims[0] * dims[1])};
+
+      bool doCounts = (m_Outputs & Counts) != 0;
+      bool doCentroids = (m_Outputs & Centroids) != 0;
+      bool doSurface = (m_Outputs & SurfaceFeatures) != 0;
+      bool doBoundaryCells = nullptr != m_BoundaryCells.boundaryCells;
+      int32_t ignoreFeatureZeroVal = m_BoundaryCells.ignoreFeatureZero ? 0 : -1;
+
+      if(doCounts)
+      {
+        slab.counts.assign(numFeatures, 0);
+      }
+      if(doCentroids)
+      {
+        slab.indexSums.assign(numFeatures * 3, 0.0);
+      }
+      if(doSurface)
+      {
+        slab.surface.assign(numFeatures, 0);
+      }
+
+      for(size_t row = slab.firstRow; row < slab.endRow; row++)
+      {
+        size_t idx[3] = {0, row % dims[1], row / dims[1]};
+        size_t rowStart = row * dims[0];
+        for(idx[0] = 0; idx[0] < dims[0]; idx[0]++)
+        {
+          size_t index = rowStart + idx[0];
+          int32_t feature = m_FeatureIds[index];
+
+          if(doBoundaryCells)
+          {
+            int8_t onsurf = 0;
+            if(feature >= 0)
+            {
+              if(m_BoundaryCells.includeVolumeBoundary)
+              {
+                for(size_t d = 0; d < 3; d++)
+                {
+                  if(dims[d] > 2 && (idx[d] == 0 || idx[d] == dims[d] - 1))
+                  {
+                    onsurf++;
+                  }
+                }
+                if(onsurf > 0 && feature == 0)
+                {
+                  onsurf = 0;
+                }
+              }
+              for(size_t d = 0; d < 3; d++)
+              {
+                if(idx[d] > 0)
+                {
+                  int32_t neighbor = m_FeatureIds[index - strides[d]];
+                  if(neighbor != feature && neighbor > ignoreFeatureZeroVal)
+                  {
+                    onsurf++;
+                  }
+                }
+                if(idx[d] < dims[d] - 1)
+                {
+                  int32_t neighbor = m_FeatureIds[index + strides[d]];
+                  if(neighbor != feature && neighbor > ignoreFeatureZeroVal)
+                  {
+                    onsurf++;
+                  }
+                }
+              }
+            }
+            m_BoundaryCells.boundaryCells[index] = onsurf;
+          }
+
+          if(feature < 0 || static_cast<size_t>(feature) >= numFeatures)
+          {
+            continue;
+          }
+          if(doCounts)
+          {
+            slab.counts[feature]++;
+          }
+          if(doCentroids)
+          {
+            slab.indexSums[feature * 3] += static_cast<double>(idx[0]);
+            slab.indexSums[feature * 3 + 1] += static_cast<double>(idx[1]);
+            slab.indexSums[feature * 3 + 2] += static_cast<double>(idx[2]);
+          }
+          if(doSurface && slab.surface[feature] == 0)
+          {
+            bool onSurface = false;
+            for(size_t d = 0; d < 3 && !onSurface; d++)
+            {
+              if(dims[d] == 1)
+              {
+                continue;
+              }
+              onSurface = idx[d] == 0 || idx[d] == dims[d] - 1 || m_FeatureIds[index - strides[d]] == 0 || m_FeatureIds[index + strides[d]] == 0;
+            }
+            slab.surface[feature] = onSurface ? 1 : 0;
+          }
+        }
+      }
+    }
+  };
+
+  /**
+   * @brief The MergeImpl class sums the slab tables of a range of Features in slab order
+   */
+  class MergeImpl
+  {
+  public:
+    MergeImpl(FeatureVolumeReduction& reduction, const std::vector<SlabTable>& slabs)
+    : m_Reduction(reduction)
+    , m_Slabs(slabs)
+    {
+    }
+    virtual ~MergeImpl() = default;
+
+    void convert(size_t start, size_t end) const
+    {
+      uint32_t outputs = m_Reduction.m_Outputs;
+      for(size_t feature = start; feature < end; feature++)
+      {
+        uint64_t count = 0;
+        double sums[3] = {0.0, 0.0, 0.0};
+        uint8_t surface = 0;
+        for(const SlabTable& slab : m_Slabs)
+        {
+          if((outputs & Counts) != 0)
+          {
+            count += slab.counts[feature];
+          }
+          if((outputs & Centroids) != 0)
+          {
+            sums[0] += slab.indexSums[feature * 3];
+            sums[1] += slab.indexSums[feature * 3 + 1];
+            sums[2] += slab.indexSums[feature * 3 + 2];
+          }
+          if((outputs & SurfaceFeatures) != 0)
+          {
+            surface |= slab.surface[feature];
+          }
+        }
+        if((outputs & Counts) != 0)
+        {
+          m_Reduction.m_Counts[feature] = count;
+        }
+        if((outputs & Centroids) != 0 && count > 0)
+        {
+          for(size_t d = 0; d < 3; d++)
+          {
+            m_Reduction.m_Centroids[feature * 3 + d] = m_Reduction.m_FirstCoords[d] + static_cast<float>(sums[d] / static_cast<double>(count)) * m_Reduction.m_Step[d];
+          }
+        }
+        if((outputs & SurfaceFeatures) != 0)
+        {
+          m_Reduction.m_SurfaceFeatures[feature] = surface;
+        }
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    FeatureVolumeReduction& m_Reduction;
+    const std::vector<SlabTable>& m_Slabs;
+  };
+};
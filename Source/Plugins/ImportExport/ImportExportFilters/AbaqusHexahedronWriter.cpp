@@ -56,6 +56,7 @@
 #include "SIMPLib/Utilities/TimeUtilities.h"
 
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedAsciiWriter.h"
 #include "ImportExport/ImportExportVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -282,13 +283,8 @@ int32_t AbaqusHexahedronWriter::writeNodes(const QList<QString>& fileNames, size
   QTextStream ss(&buf);
 
   size_t pDims[3] = {cDims[0] + 1, cDims[1] + 1, cDims[2] + 1};
-  size_t nodeIndex = 1;
+  size_t nodeIndex = 0;
   size_t totalPoints = pDims[0] * pDims[1] * pDims[2];
-  size_t increment = static_cast<size_t>(totalPoints * 0.01f);
-  if(increment == 0) // check to prevent divide by 0
-  {
-    increment = 1;
-  }
 
   int32_t err = 0;
   FILE* f = nullptr;
@@ -301,38 +297,63 @@ int32_t AbaqusHexahedronWriter::writeNodes(const QList<QString>& fileNames, size
   fprintf(f, "** Generated by : %s\n", ImportExport::Version::PackageComplete().toLatin1().data());
   fprintf(f, "** ----------------------------------------------------------------\n**\n*Node\n");
 
-  for(size_t z = 0; z < pDims[2]; z++)
-  {
-    for(size_t y = 0; y < pDims[1]; y++)
+  // Each node is formatted independently from its linear index so the chunks can be formatted in parallel
+  auto formatNodes = [pDims, origin, spacing](size_t start, size_t end, ImportExport::AsciiChunk& chunk) {
+    size_t x = start % pDims[0];
+    size_t y = (start / pDims[0]) % pDims[1];
+    size_t z = start / (pDims[0] * pDims[1]);
+    for(size_t i = start; i < end; i++)
     {
-      for(size_t x = 0; x < pDims[0]; x++)
+      float xCoord = origin[0] + (x * spacing[0]);
+      float yCoord = origin[1] + (y * spacing[1]);
+      float zCoord = origin[2] + (z * spacing[2]);
+      chunk.appendUInt(i + 1);
+      chunk.append(", ", 2);
+      chunk.appendFixed(xCoord);
+      chunk.append(", ", 2);
+      chunk.appendFixed(yCoord);
+      chunk.append(", ", 2);
+      chunk.appendFixed(zCoord);
+      chunk.append('\n');
+      if(++x == pDims[0])
       {
-        float xCoord = origin[0] + (x * spacing[0]);
-        float yCoord = origin[1] + (y * spacing[1]);
-        float zCoord = origin[2] + (z * spacing[2]);
-        fprintf(f, "%llu, %f, %f, %f\n", static_cast<unsigned long long int>(nodeIndex), xCoord, yCoord, zCoord);
-        if(nodeIndex % increment == 0)
+        x = 0;
+        if(++y == pDims[1])
         {
-          currentMillis = QDateTime::currentMSecsSinceEpoch();
-          if(currentMillis - millis > 1000)
-          {
-            buf.clear();
-            ss << "Writing Nodes (File 1/5) " << static_cast<int>((float)(nodeIndex) / (float)(totalPoints)*100) << "% Completed ";
-            timeDiff = ((float)nodeIndex / (float)(currentMillis - startMillis));
-            estimatedTime = (float)(totalPoints - nodeIndex) / timeDiff;
-            ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-            notifyStatusMessage(buf);
-            millis = QDateTime::currentMSecsSinceEpoch();
-            if(getCancel()) // Filter has been cancelled
-            {
-              fclose(f);
-              return 1;
-            }
-          }
+          y = 0;
+          ++z;
         }
-        ++nodeIndex;
       }
     }
+  };
+
+  auto progress = [&](size_t nodesWritten) {
+    nodeIndex = nodesWritten;
+    currentMillis = QDateTime::currentMSecsSinceEpoch();
+    if(currentMillis - millis > 1000)
+    {
+      buf.clear();
+      ss << "Writing Nodes (File 1/5) " << static_cast<int>((float)(nodeIndex) / (float)(totalPoints)*100) << "% Completed ";
+      timeDiff = ((float)nodeIndex / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(totalPoints - nodeIndex) / timeDiff;
+      ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
+      notifyStatusMessage(buf);
+      millis = QDateTime::currentMSecsSinceEpoch();
+    }
+    return !getCancel();
+  };
+
+  ImportExport::ChunkedAsciiWriter writer(f);
+  err = writer.write(totalPoints, formatNodes, progress);
+  if(err == ImportExport::ChunkedAsciiWriter::Canceled) // Filter has been cancelled
+  {
+    fclose(f);
+    return 1;
+  }
+  if(err < 0)
+  {
+    fclose(f);
+    return err;
   }
 
   // Write the last node, which is a dummy node used for stress - strain curves.
@@ -358,11 +379,7 @@ int32_t AbaqusHexahedronWriter::writeElems(const QList<QString>& fileNames, size
   QString buf;
   QTextStream ss(&buf);
   size_t totalPoints = cDims[0] * cDims[1] * cDims[2];
-  size_t increment = static_cast<size_t>(totalPoints * 0.01f);
-  if(increment == 0) // check to prevent divide by 0
-  {
-    increment = 1;
-  }
+  size_t index = 0;
 
   int32_t err = 0;
   FILE* f = nullptr;
@@ -372,43 +389,65 @@ int32_t AbaqusHexahedronWriter::writeElems(const QList<QString>& fileNames, size
     return -1;
   }
 
-  // Get a typedef to shorten up the printf codes
-  using _lli_t_ = long long int;
-
-  size_t index = 1;
   fprintf(f, "** Generated by : %s\n", ImportExport::Version::PackageComplete().toLatin1().data());
   fprintf(f, "** ----------------------------------------------------------------\n**\n*Element, type=C3D8\n");
-  for(size_t z = 0; z < cDims[2]; z++)
-  {
-    for(size_t y = 0; y < cDims[1]; y++)
+
+  auto formatElems = [this, cDims, pDims](size_t start, size_t end, ImportExport::AsciiChunk& chunk) {
+    // Abaqus expects the C3D8 nodes in this order
+    const int32_t order[8] = {5, 1, 0, 4, 7, 3, 2, 6};
+    int64_t nodeId[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    size_t x = start % cDims[0];
+    size_t y = (start / cDims[0]) % cDims[1];
+    size_t z = start / (cDims[0] * cDims[1]);
+    for(size_t i = start; i < end; i++)
     {
-      for(size_t x = 0; x < cDims[0]; x++)
+      getNodeIds(x, y, z, pDims, nodeId);
+      chunk.appendUInt(i + 1);
+      for(int32_t n = 0; n < 8; n++)
+      {
+        chunk.append(", ", 2);
+        chunk.appendInt(nodeId[order[n]]);
+      }
+      chunk.append('\n');
+      if(++x == cDims[0])
       {
-        std::vector<int64_t> nodeId = getNodeIds(x, y, z, pDims);
-        fprintf(f, "%llu, %lld, %lld, %lld, %lld, %lld, %lld, %lld, %lld\n", (_lli_t_)index, (_lli_t_)nodeId[5], (_lli_t_)nodeId[1], (_lli_t_)nodeId[0], (_lli_t_)nodeId[4], (_lli_t_)nodeId[7],
-                (_lli_t_)nodeId[3], (_lli_t_)nodeId[2], (_lli_t_)nodeId[6]);
-        if(index % increment == 0)
+        x = 0;
+        if(++y == cDims[1])
         {
-          currentMillis = QDateTime::currentMSecsSinceEpoch();
-          if(currentMillis - millis > 1000)
-          {
-            buf.clear();
-            ss << "Writing Elements (File 2/5) " << static_cast<int>((float)(index) / (float)(totalPoints)*100) << "% Completed ";
-            timeDiff = ((float)index / (float)(currentMillis - startMillis));
-            estimatedTime = (float)(totalPoints - index) / timeDiff;
-            ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-            notifyStatusMessage(buf);
-            millis = QDateTime::currentMSecsSinceEpoch();
-            if(getCancel()) // Filter has been cancelled
-            {
-              fclose(f);
-              return 1;
-            }
-          }
+          y = 0;
+          ++z;
         }
-        ++index;
       }
     }
+  };
+
+  auto progress = [&](size_t elemsWritten) {
+    index = elemsWritten;
+    currentMillis = QDateTime::currentMSecsSinceEpoch();
+    if(currentMillis - millis > 1000)
+    {
+      buf.clear();
+      ss << "Writing Elements (File 2/5) " << static_cast<int>((float)(index) / (float)(totalPoints)*100) << "% Completed ";
+      timeDiff = ((float)index / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(totalPoints - index) / timeDiff;
+      ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
+      notifyStatusMessage(buf);
+      millis = QDateTime::currentMSecsSinceEpoch();
+    }
+    return !getCancel();
+  };
+
+  ImportExport::ChunkedAsciiWriter writer(f);
+  err = writer.write(totalPoints, formatElems, progress);
+  if(err == ImportExport::ChunkedAsciiWriter::Canceled) // Filter has been cancelled
+  {
+    fclose(f);
+    return 1;
+  }
+  if(err < 0)
+  {
+    fclose(f);
+    return err;
   }
 
   fprintf(f, "**\n** ----------------------------------------------------------------\n**\n");
@@ -594,10 +633,8 @@ int32_t AbaqusHexahedronWriter::writeSects(const QString& file, size_t totalPoin
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-std::vector<int64_t> AbaqusHexahedronWriter::getNodeIds(size_t x, size_t y, size_t z, size_t* pDims)
+void AbaqusHexahedronWriter::getNodeIds(size_t x, size_t y, size_t z, const size_t* pDims, int64_t* nodeId) const
 {
-  std::vector<int64_t> nodeId(8, 0);
-
   nodeId[0] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * y) + x);
   nodeId[1] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * y) + (x + 1));
   nodeId[2] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * (y + 1)) + x);
@@ -621,7 +658,6 @@ std::vector<int64_t> AbaqusHexahedronWriter::getNodeIds(size_t x, size_t y, size
     printf("         | /        |/     \n");
     printf("        %lld--------%lld     \n", static_cast<long long int>(nodeId[2]), static_cast<long long int>(nodeId[3]));
 #endif
-  return nodeId;
 }
 
 // -----------------------------------------------------------------------------
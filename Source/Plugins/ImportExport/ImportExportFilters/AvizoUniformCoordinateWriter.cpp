@@ -43,6 +43,7 @@
 #include <QtCore/QFileInfo>
 
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedAsciiWriter.h"
 #include "ImportExport/ImportExportVersion.h"
 
 #include <QtCore/QTextStream>
@@ -256,21 +257,21 @@ int AvizoUniformCoordinateWriter::writeData(FILE* f)
   }
   else
   {
-    // The "20 Items" is purely arbitrary and is put in to try and save some space in the ASCII file
-    int count = 0;
-    for(size_t i = 0; i < totalPoints; ++i)
-    {
-      fprintf(f, "%d", m_FeatureIds[i]);
-      if(count < 20)
-      {
-        fprintf(f, " ");
-        count++;
-      }
-      else
+    // The "20 Items" is purely arbitrary and is put in to try and save some space in the ASCII file.
+    // Every 21st value ends a line, which only depends on the index of the value so the values
+    // can be formatted in parallel chunks.
+    int32_t* featureIds = m_FeatureIds;
+    auto formatFeatureIds = [featureIds](size_t start, size_t end, ImportExport::AsciiChunk& chunk) {
+      for(size_t i = start; i < end; ++i)
       {
-        fprintf(f, "\n");
-        count = 0;
+        chunk.appendInt(featureIds[i]);
+        chunk.append(i % 21 == 20 ? '\n' : ' ');
       }
+    };
+    ImportExport::ChunkedAsciiWriter writer(f);
+    if(writer.write(totalPoints, formatFeatureIds) < 0)
+    {
+      return -1;
     }
   }
   fprintf(f, "\n");
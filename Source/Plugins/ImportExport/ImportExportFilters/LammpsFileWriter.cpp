@@ -50,6 +50,7 @@
 #include "SIMPLib/Utilities/SIMPLibEndian.h"
 
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedAsciiWriter.h"
 #include "ImportExport/ImportExportVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -217,10 +218,35 @@ void LammpsFileWriter::execute()
   fprintf(lammpsFile, "\n");
 
   // Write the Atom positions (Vertices)
-  for(int64_t i = 0; i < numAtoms; i++)
+  float* coords = vertices->getVertexPointer(0);
+  auto formatAtoms = [coords, atomType, dummy](size_t start, size_t end, ImportExport::AsciiChunk& chunk) {
+    for(size_t i = start; i < end; i++)
+    {
+      // Same text as "%lld %d %f %f %f %d %d %d\n"
+      chunk.appendInt(static_cast<int64_t>(i));
+      chunk.append(' ');
+      chunk.appendInt(atomType);
+      chunk.append(' ');
+      chunk.appendFixed(coords[i * 3]);
+      chunk.append(' ');
+      chunk.appendFixed(coords[i * 3 + 1]);
+      chunk.append(' ');
+      chunk.appendFixed(coords[i * 3 + 2]);
+      for(int32_t d = 0; d < 3; d++)
+      {
+        chunk.append(' ');
+        chunk.appendInt(dummy);
+      }
+      chunk.append('\n');
+    }
+  };
+  ImportExport::ChunkedAsciiWriter writer(lammpsFile);
+  if(writer.write(static_cast<size_t>(numAtoms), formatAtoms) < 0)
   {
-    vertices->getCoords(i, pos);
-    fprintf(lammpsFile, "%lld %d %f %f %f %d %d %d\n", (long long int)(i), atomType, pos[0], pos[1], pos[2], dummy, dummy, dummy); // Write the positions to the output file
+    fclose(lammpsFile);
+    QString ss = QObject::tr(": Error writing LAMMPS output file '%1'").arg(getLammpsFile());
+    setErrorCondition(-11001, ss);
+    return;
   }
 
   fprintf(lammpsFile, "\n");
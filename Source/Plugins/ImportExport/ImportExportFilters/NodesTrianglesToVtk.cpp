@@ -51,6 +51,7 @@
 #include "SIMPLib/Utilities/SIMPLibEndian.h"
 
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/BinaryBlockWriter.h"
 #include "ImportExport/ImportExportVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -234,9 +235,10 @@ void NodesTrianglesToVtk::execute()
   int nodeKind = 0;
   float pos[3] = {0.0f, 0.0f, 0.0f};
 
-  size_t totalWritten = 0;
   size_t nread = 0;
-  // Write the POINTS data (Vertex)
+  // Write the POINTS data (Vertex). Binary values are staged and swapped in blocks
+  // and only reach the file when the writer's buffer fills up or is flushed.
+  ImportExport::BinaryBlockWriter binaryWriter(vtkFile, ImportExport::BinaryBlockWriter::ByteOrder::BigEndian, m_WriteBinaryFile ? ImportExport::BinaryBlockWriter::k_DefaultBufferSize : 0);
   for(int i = 0; i < nNodes; i++)
   {
     nread = fscanf(nodesFile, "%d %d %f %f %f", &nodeId, &nodeKind, pos, pos + 1, pos + 2); // Read one set of positions from the nodes file
@@ -246,13 +248,7 @@ void NodesTrianglesToVtk::execute()
     }
     if(m_WriteBinaryFile)
     {
-      SIMPLib::Endian::FromSystemToBig::convert(pos[0]);
-      SIMPLib::Endian::FromSystemToBig::convert(pos[1]);
-      SIMPLib::Endian::FromSystemToBig::convert(pos[2]);
-      totalWritten = fwrite(pos, sizeof(float), 3, vtkFile);
-      if(totalWritten != sizeof(float) * 3)
-      {
-      }
+      binaryWriter.write(pos, 3);
     }
     else
     {
@@ -260,6 +256,7 @@ void NodesTrianglesToVtk::execute()
     }
   }
   fclose(nodesFile);
+  binaryWriter.flush();
 
   // Write the triangle indices into the vtk File
   // column 1 = triangle id, starts from zero
@@ -281,19 +278,11 @@ void NodesTrianglesToVtk::execute()
     if(m_WriteBinaryFile)
     {
       tData[0] = 3; // Push on the total number of entries for this entry
-      SIMPLib::Endian::FromSystemToBig::convert(tData[0]);
-      SIMPLib::Endian::FromSystemToBig::convert(tData[1]);
-      SIMPLib::Endian::FromSystemToBig::convert(tData[2]);
-      SIMPLib::Endian::FromSystemToBig::convert(tData[3]);
-      fwrite(tData, sizeof(int), 4, vtkFile);
+      binaryWriter.write(tData, 4);
       if(!m_WriteConformalMesh)
       {
-        tData[0] = tData[1];
-        tData[1] = tData[3];
-        tData[3] = tData[0];
-        tData[0] = 3;
-        SIMPLib::Endian::FromSystemToBig::convert(tData[0]);
-        fwrite(tData, sizeof(int), 4, vtkFile);
+        int32_t backFace[4] = {3, tData[3], tData[2], tData[1]};
+        binaryWriter.write(backFace, 4);
       }
     }
     else
@@ -306,6 +295,12 @@ void NodesTrianglesToVtk::execute()
     }
   }
   fclose(triFile);
+  if(!binaryWriter.flush())
+  {
+    setErrorCondition(-1, tr("Could not write binary polygon data to file '%1'").arg(getOutputVtkFile()));
+    fclose(vtkFile);
+    return;
+  }
 
   int err = 0;
   // Write the CELL_DATA section
@@ -372,7 +367,6 @@ int NodesTrianglesToVtk::writeBinaryPointData(const QString& NodesFile, FILE* vt
   int nodeId = 0;
   int nodeKind = 0;
   float pos[3] = {0.0f, 0.0f, 0.0f};
-  int swapped;
   int nread = 0;
   FILE* nodesFile = fopen(NodesFile.toLatin1().data(), "rb");
   fprintf(vtkFile, "\n");
@@ -380,7 +374,8 @@ int NodesTrianglesToVtk::writeBinaryPointData(const QString& NodesFile, FILE* vt
   fprintf(vtkFile, "SCALARS Node_Type int 1\n");
   fprintf(vtkFile, "LOOKUP_TABLE default\n");
   fscanf(nodesFile, "%d", &nodeId); // Read the number of nodes
-  std::vector<int> data(nNodes, 0);
+  ImportExport::BinaryBlockWriter writer(vtkFile);
+  int numRead = 0;
   for(int i = 0; i < nNodes; i++)
   {
     nread = fscanf(nodesFile, "%d %d %f %f %f", &nodeId, &nodeKind, pos, pos + 1, pos + 2); // Read one set of positions from the nodes file
@@ -388,14 +383,16 @@ int NodesTrianglesToVtk::writeBinaryPointData(const QString& NodesFile, FILE* vt
     {
       break;
     }
-    swapped = nodeKind;
-    SIMPLib::Endian::FromSystemToBig::convert(swapped);
-
-    data[i] = swapped;
+    writer.writeValue<int32_t>(nodeKind);
+    numRead++;
+  }
+  // Pad a short nodes file with zeros so the section still has nNodes values
+  for(int i = numRead; i < nNodes; i++)
+  {
+    writer.writeValue<int32_t>(0);
   }
-  int totalWritten = fwrite(&(data.front()), sizeof(int), nNodes, vtkFile);
   fclose(nodesFile);
-  if(totalWritten != nNodes)
+  if(!writer.flush())
   {
     return -1;
   }
@@ -459,36 +456,35 @@ int NodesTrianglesToVtk::writeBinaryCellData(const QString& TrianglesFile, FILE*
     triangleCount = nTriangles * 2;
     offset = 2;
   }
-  std::vector<int> tri_ids(triangleCount);
+  std::vector<int32_t> tri_ids(triangleCount);
   // Write the FeatureId Data to the file
   fprintf(vtkFile, "\n");
   fprintf(vtkFile, "CELL_DATA %d\n", triangleCount);
   fprintf(vtkFile, "SCALARS FeatureID int 1\n");
   fprintf(vtkFile, "LOOKUP_TABLE default\n");
 
-  std::vector<int> cell_data(triangleCount);
+  // The feature ids are written while the file is parsed; the triangle ids are kept
+  // for the second section and swapped in the writer's buffer when they are written.
+  ImportExport::BinaryBlockWriter writer(vtkFile);
   for(int i = 0; i < nTriangles; i++)
   {
     nread = fscanf(triFile, "%d %d %d %d %d %d %d %d %d", tData, tData + 1, tData + 2, tData + 3, tData + 4, tData + 5, tData + 6, tData + 7, tData + 8);
     if(nread != 9)
     {
+      fclose(triFile);
       return -1;
     }
-    SIMPLib::Endian::FromSystemToBig::convert(tData[0]);
     tri_ids[i * offset] = tData[0];
-    SIMPLib::Endian::FromSystemToBig::convert(tData[7]);
-    cell_data[i * offset] = tData[7];
+    writer.writeValue<int32_t>(tData[7]);
     if(!conformalMesh)
     {
-      SIMPLib::Endian::FromSystemToBig::convert(tData[8]);
-      cell_data[i * offset + 1] = tData[8];
+      writer.writeValue<int32_t>(tData[8]);
       tri_ids[i * offset + 1] = tData[0];
     }
   }
-
-  int totalWritten = fwrite(&(cell_data.front()), sizeof(int), triangleCount, vtkFile);
-  if(totalWritten != triangleCount)
+  if(!writer.flush())
   {
+    fclose(triFile);
     return -1;
   }
 
@@ -497,9 +493,10 @@ int NodesTrianglesToVtk::writeBinaryCellData(const QString& TrianglesFile, FILE*
   fprintf(vtkFile, "SCALARS TriangleID int 1\n");
   fprintf(vtkFile, "LOOKUP_TABLE default\n");
 
-  totalWritten = fwrite(&(tri_ids.front()), sizeof(int), triangleCount, vtkFile);
-  if(totalWritten != triangleCount)
+  writer.write(tri_ids.data(), tri_ids.size());
+  if(!writer.flush())
   {
+    fclose(triFile);
     return -1;
   }
 
@@ -37,14 +37,9 @@
 
 #include "ReadStlFile.h"
 
-#include <QtCore/QFileInfo>
+#include <vector>
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
-#endif
+#include <QtCore/QFileInfo>
 
 #include <QtCore/QTextStream>
 
@@ -54,6 +49,7 @@
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -61,6 +57,7 @@
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/VertexWelder.h"
 #include "ImportExport/ImportExportVersion.h"
 
 #define STL_HEADER_LENGTH 80
@@ -74,55 +71,6 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
-/**
- * @brief The FindUniqueIdsImpl class implements a threaded algorithm that determines the set of
- * unique vertices in the triangle geometry
- */
-class FindUniqueIdsImpl
-{
-public:
-  FindUniqueIdsImpl(SharedVertexList::Pointer vertex, QVector<std::vector<size_t>> nodesInBin, int64_t* uniqueIds)
-  : m_Vertex(vertex)
-  , m_NodesInBin(nodesInBin)
-  , m_UniqueIds(uniqueIds)
-  {
-  }
-
-  void convert(size_t start, size_t end) const
-  {
-    float* verts = m_Vertex->getPointer(0);
-    for(size_t i = start; i < end; i++)
-    {
-      for(int32_t j = 0; j < m_NodesInBin[i].size(); j++)
-      {
-        size_t node1 = m_NodesInBin[i][j];
-        if(m_UniqueIds[node1] == node1)
-        {
-          for(int32_t k = j + 1; k < m_NodesInBin[i].size(); k++)
-          {
-            size_t node2 = m_NodesInBin[i][k];
-            if(verts[node1 * 3] == verts[node2 * 3] && verts[node1 * 3 + 1] == verts[node2 * 3 + 1] && verts[node1 * 3 + 2] == verts[node2 * 3 + 2])
-            {
-              m_UniqueIds[node2] = node1;
-            }
-          }
-        }
-      }
-    }
-  }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
-  {
-    convert(r.begin(), r.end());
-  }
-#endif
-private:
-  SharedVertexList::Pointer m_Vertex;
-  QVector<std::vector<size_t>> m_NodesInBin;
-  int64_t* m_UniqueIds;
-};
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -131,12 +79,7 @@ ReadStlFile::ReadStlFile()
 , m_FaceAttributeMatrixName(SIMPL::Defaults::FaceAttributeMatrixName)
 , m_StlFilePath("")
 , m_FaceNormalsArrayName(SIMPL::FaceData::SurfaceMeshFaceNormals)
-, m_minXcoord(std::numeric_limits<float>::max())
-, m_maxXcoord(-std::numeric_limits<float>::max())
-, m_minYcoord(std::numeric_limits<float>::max())
-, m_maxYcoord(-std::numeric_limits<float>::max())
-, m_minZcoord(std::numeric_limits<float>::max())
-, m_maxZcoord(-std::numeric_limits<float>::max())
+, m_WeldTolerance(0.0f)
 {
 }
 
@@ -153,6 +96,7 @@ void ReadStlFile::setupFilterParameters()
   FilterParameterVectorType parameters;
 
   parameters.push_back(SIMPL_NEW_INPUT_FILE_FP("STL File", StlFilePath, FilterParameter::Parameter, ReadStlFile, "*.stl", "STL File"));
+  parameters.push_back(SIMPL_NEW_FLOAT_FP("Vertex Weld Tolerance", WeldTolerance, FilterParameter::Parameter, ReadStlFile));
   parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", SurfaceMeshDataContainerName, FilterParameter::CreatedArray, ReadStlFile));
   parameters.push_back(SeparatorFilterParameter::New("Face Data", FilterParameter::CreatedArray));
   parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Face Attribute Matrix", FaceAttributeMatrixName, SurfaceMeshDataContainerName, FilterParameter::CreatedArray, ReadStlFile));
@@ -170,6 +114,7 @@ void ReadStlFile::readFilterParameters(AbstractFilterParametersReader* reader, i
   setFaceAttributeMatrixName(reader->readString("FaceAttributeMatrixName", getFaceAttributeMatrixName()));
   setSurfaceMeshDataContainerName(reader->readDataArrayPath("SurfaceMeshDataContainerName", getSurfaceMeshDataContainerName()));
   setFaceNormalsArrayName(reader->readString("FaceNormalsArrayName", getFaceNormalsArrayName()));
+  setWeldTolerance(reader->readValue("WeldTolerance", getWeldTolerance()));
   reader->closeFilterGroup();
 }
 
@@ -192,12 +137,6 @@ void ReadStlFile::updateFaceInstancePointers()
 // -----------------------------------------------------------------------------
 void ReadStlFile::initialize()
 {
-  m_minXcoord = std::numeric_limits<float>::max();
-  m_maxXcoord = -std::numeric_limits<float>::max();
-  m_minYcoord = std::numeric_limits<float>::max();
-  m_maxYcoord = -std::numeric_limits<float>::max();
-  m_minZcoord = std::numeric_limits<float>::max();
-  m_maxZcoord = -std::numeric_limits<float>::max();
 }
 
 // -----------------------------------------------------------------------------
@@ -224,6 +163,12 @@ void ReadStlFile::dataCheck()
     setErrorCondition(-388, ss);
   }
 
+  if(getWeldTolerance() < 0.0f)
+  {
+    QString ss = QObject::tr("The vertex weld tolerance must be zero or greater");
+    setErrorCondition(-389, ss);
+  }
+
   // Create a SufaceMesh Data Container with Faces, Vertices, Feature Labels and optionally Phase labels
   DataContainer::Pointer sm = getDataContainerArray()->createNonPrereqDataContainer(this, getSurfaceMeshDataContainerName(), DataContainerID);
   if(getErrorCode() < 0)
@@ -332,78 +277,6 @@ void ReadStlFile::readFile()
       std::vector<unsigned char> buffer(attr);                       // Allocate a buffer for the STL attribute data to be placed into
       fread(reinterpret_cast<void*>(&(buffer.front())), attr, 1, f); // Read the bytes into the buffer so that we can skip it.
     }
-    if(v[3] < m_minXcoord)
-    {
-      m_minXcoord = v[3];
-    }
-    if(v[3] > m_maxXcoord)
-    {
-      m_maxXcoord = v[3];
-    }
-    if(v[4] < m_minYcoord)
-    {
-      m_minYcoord = v[4];
-    }
-    if(v[4] > m_maxYcoord)
-    {
-      m_maxYcoord = v[4];
-    }
-    if(v[5] < m_minZcoord)
-    {
-      m_minZcoord = v[5];
-    }
-    if(v[5] > m_maxZcoord)
-    {
-      m_maxZcoord = v[5];
-    }
-    if(v[6] < m_minXcoord)
-    {
-      m_minXcoord = v[6];
-    }
-    if(v[6] > m_maxXcoord)
-    {
-      m_maxXcoord = v[6];
-    }
-    if(v[7] < m_minYcoord)
-    {
-      m_minYcoord = v[7];
-    }
-    if(v[7] > m_maxYcoord)
-    {
-      m_maxYcoord = v[7];
-    }
-    if(v[8] < m_minZcoord)
-    {
-      m_minZcoord = v[8];
-    }
-    if(v[8] > m_maxZcoord)
-    {
-      m_maxZcoord = v[8];
-    }
-    if(v[9] < m_minXcoord)
-    {
-      m_minXcoord = v[9];
-    }
-    if(v[9] > m_maxXcoord)
-    {
-      m_maxXcoord = v[9];
-    }
-    if(v[10] < m_minYcoord)
-    {
-      m_minYcoord = v[10];
-    }
-    if(v[10] > m_maxYcoord)
-    {
-      m_maxYcoord = v[10];
-    }
-    if(v[11] < m_minZcoord)
-    {
-      m_minZcoord = v[11];
-    }
-    if(v[11] > m_maxZcoord)
-    {
-      m_maxZcoord = v[11];
-    }
     m_FaceNormals[3 * t + 0] = static_cast<double>(v[0]);
     m_FaceNormals[3 * t + 1] = static_cast<double>(v[1]);
     m_FaceNormals[3 * t + 2] = static_cast<double>(v[2]);
@@ -439,97 +312,39 @@ void ReadStlFile::eliminate_duplicate_nodes()
   {
     nNodes = static_cast<size_t>(nNodes_);
   }
-  float stepX = (m_maxXcoord - m_minXcoord) / 100.0f;
-  float stepY = (m_maxYcoord - m_minYcoord) / 100.0f;
-  float stepZ = (m_maxZcoord - m_minZcoord) / 100.0f;
-
-  QVector<std::vector<size_t>> nodesInBin(100 * 100 * 100);
 
-  // determine (xyz) bin each node falls in - used to speed up node comparison
-  int32_t bin = 0, xBin = 0, yBin = 0, zBin = 0;
-  for(size_t i = 0; i < nNodes; i++)
-  {
-    xBin = static_cast<int32_t>((vertex[i * 3] - m_minXcoord) / stepX);
-    yBin = static_cast<int32_t>((vertex[i * 3 + 1] - m_minYcoord) / stepY);
-    zBin = static_cast<int32_t>((vertex[i * 3 + 2] - m_minZcoord) / stepZ);
-    if(xBin == 100)
-    {
-      xBin = 99;
-    }
-    if(yBin == 100)
-    {
-      yBin = 99;
-    }
-    if(zBin == 100)
-    {
-      zBin = 99;
-    }
-    bin = (zBin * 10000) + (yBin * 100) + xBin;
-    nodesInBin[bin].push_back(i);
-  }
-
-  // Create array to hold unique node numbers
-  Int64ArrayType::Pointer uniqueIdsPtr = Int64ArrayType::CreateArray(nNodes, "uniqueIds", true);
-  int64_t* uniqueIds = uniqueIdsPtr->getPointer(0);
-  for(MeshIndexType i = 0; i < nNodes_; i++)
-  {
-    uniqueIds[i] = static_cast<int64_t>(i);
-  }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
-#endif
-
-// Parallel algorithm to find duplicate nodes
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  if(doParallel)
-  {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, 100 * 100 * 100), FindUniqueIdsImpl(triangleGeom->getVertices(), nodesInBin, uniqueIds), tbb::auto_partitioner());
-  }
-  else
-#endif
-  {
-    FindUniqueIdsImpl serial(triangleGeom->getVertices(), nodesInBin, uniqueIds);
-    serial.convert(0, 100 * 100 * 100);
-  }
+  // Weld the three vertices of every facet into a shared vertex list. The remap table
+  // is applied in place so no second copy of the vertices or triangles is needed.
+  ImportExport::VertexWelder welder(getWeldTolerance());
+  size_t uniqueCount = welder.weld(vertex, nNodes);
+  welder.remapTriangles(triangles, static_cast<size_t>(nTriangles));
+  welder.compactVertices(vertex);
+  triangleGeom->resizeVertexList(uniqueCount);
 
-  // renumber the unique nodes
-  int64_t uniqueCount = 0;
-  for(size_t i = 0; i < nNodes; i++)
+  if(getWeldTolerance() <= 0.0f)
   {
-    if(uniqueIds[i] == static_cast<int64_t>(i))
-    {
-      uniqueIds[i] = uniqueCount;
-      uniqueCount++;
-    }
-    else
-    {
-      uniqueIds[i] = uniqueIds[uniqueIds[i]];
-    }
+    return;
   }
 
-  // Move nodes to unique Id and then resize nodes array
-  for(size_t i = 0; i < nNodes; i++)
+  // Welding with a tolerance can collapse short edges. Drop the triangles that lost an edge
+  // and move their face normals along with the remaining triangles.
+  std::vector<size_t> keptTriangles;
+  size_t keptCount = ImportExport::VertexWelder::removeDegenerateTriangles(triangles, static_cast<size_t>(nTriangles), keptTriangles);
+  if(keptCount == static_cast<size_t>(nTriangles))
   {
-    vertex[uniqueIds[i] * 3] = vertex[i * 3];
-    vertex[uniqueIds[i] * 3 + 1] = vertex[i * 3 + 1];
-    vertex[uniqueIds[i] * 3 + 2] = vertex[i * 3 + 2];
+    return;
   }
-  triangleGeom->resizeVertexList(uniqueCount);
-
-  // Update the triangle nodes to reflect the unique ids
-  int64_t node1 = 0, node2 = 0, node3 = 0;
-  for(size_t i = 0; i < static_cast<size_t>(nTriangles); i++)
+  for(size_t t = 0; t < keptCount; t++)
   {
-    node1 = triangles[i * 3];
-    node2 = triangles[i * 3 + 1];
-    node3 = triangles[i * 3 + 2];
-
-    triangles[i * 3] = uniqueIds[node1];
-    triangles[i * 3 + 1] = uniqueIds[node2];
-    triangles[i * 3 + 2] = uniqueIds[node3];
+    size_t source = keptTriangles[t];
+    m_FaceNormals[3 * t + 0] = m_FaceNormals[3 * source + 0];
+    m_FaceNormals[3 * t + 1] = m_FaceNormals[3 * source + 1];
+    m_FaceNormals[3 * t + 2] = m_FaceNormals[3 * source + 2];
   }
+  triangleGeom->resizeTriList(keptCount);
+  std::vector<size_t> tDims(1, keptCount);
+  sm->getAttributeMatrix(getFaceAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFaceInstancePointers();
 }
 
 // -----------------------------------------------------------------------------
@@ -679,3 +494,15 @@ QString ReadStlFile::getFaceNormalsArrayName() const
 {
   return m_FaceNormalsArrayName;
 }
+
+// -----------------------------------------------------------------------------
+void ReadStlFile::setWeldTolerance(float value)
+{
+  m_WeldTolerance = value;
+}
+
+// -----------------------------------------------------------------------------
+float ReadStlFile::getWeldTolerance() const
+{
+  return m_WeldTolerance;
+}
@@ -58,6 +58,7 @@ class ImportExport_EXPORT ReadStlFile : public AbstractFilter
   PYB11_PROPERTY(QString FaceAttributeMatrixName READ getFaceAttributeMatrixName WRITE setFaceAttributeMatrixName)
   PYB11_PROPERTY(QString StlFilePath READ getStlFilePath WRITE setStlFilePath)
   PYB11_PROPERTY(QString FaceNormalsArrayName READ getFaceNormalsArrayName WRITE setFaceNormalsArrayName)
+  PYB11_PROPERTY(float WeldTolerance READ getWeldTolerance WRITE setWeldTolerance)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -135,6 +136,17 @@ public:
   QString getFaceNormalsArrayName() const;
   Q_PROPERTY(QString FaceNormalsArrayName READ getFaceNormalsArrayName WRITE setFaceNormalsArrayName)
 
+  /**
+   * @brief Setter property for WeldTolerance
+   */
+  void setWeldTolerance(float value);
+  /**
+   * @brief Getter property for WeldTolerance
+   * @return Value of WeldTolerance
+   */
+  float getWeldTolerance() const;
+  Q_PROPERTY(float WeldTolerance READ getWeldTolerance WRITE setWeldTolerance)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -217,13 +229,7 @@ private:
   QString m_FaceAttributeMatrixName = {};
   QString m_StlFilePath = {};
   QString m_FaceNormalsArrayName = {};
-
-  float m_minXcoord;
-  float m_maxXcoord;
-  float m_minYcoord;
-  float m_maxYcoord;
-  float m_minZcoord;
-  float m_maxZcoord;
+  float m_WeldTolerance = {};
 
   /**
    * @brief updateFaceInstancePointers Updates raw Face pointers
@@ -33,7 +33,9 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "SurfaceMeshToNonconformalVtk.h"
 
@@ -58,6 +60,7 @@
 #include "SIMPLib/Utilities/SIMPLibEndian.h"
 
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/BinaryBlockWriter.h"
 #include "ImportExport/ImportExportVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -265,32 +268,29 @@ void SurfaceMeshToNonconformalVtk::execute()
 
   fprintf(vtkFile, "POINTS %d float\n", numberWrittenNodes);
 
-  float pos[3] = {0.0f, 0.0f, 0.0f};
-
-  size_t totalWritten = 0;
-
   // Write the POINTS data (Vertex)
-  for(int i = 0; i < numNodes; i++)
+  int8_t* nodeType = m_SurfaceMeshNodeType;
+  if(m_WriteBinaryFile)
   {
-    if(m_SurfaceMeshNodeType[i] > 0)
-    {
-      pos[0] = static_cast<float>(nodes[i * 3]);
-      pos[1] = static_cast<float>(nodes[i * 3 + 1]);
-      pos[2] = static_cast<float>(nodes[i * 3 + 2]);
-
-      if(m_WriteBinaryFile)
+    ImportExport::BinaryBlockWriter writer(vtkFile);
+    writer.writeGenerated<float>(numNodes, 3, [nodes, nodeType](size_t i, float* pos) -> size_t {
+      if(nodeType[i] <= 0)
       {
-        SIMPLib::Endian::FromSystemToBig::convert(pos[0]);
-        SIMPLib::Endian::FromSystemToBig::convert(pos[1]);
-        SIMPLib::Endian::FromSystemToBig::convert(pos[2]);
-        totalWritten = fwrite(pos, sizeof(float), 3, vtkFile);
-        if(totalWritten != 3)
-        {
-        }
+        return 0;
       }
-      else
+      pos[0] = nodes[i * 3];
+      pos[1] = nodes[i * 3 + 1];
+      pos[2] = nodes[i * 3 + 2];
+      return 3;
+    });
+  }
+  else
+  {
+    for(int i = 0; i < numNodes; i++)
+    {
+      if(m_SurfaceMeshNodeType[i] > 0)
       {
-        fprintf(vtkFile, "%f %f %f\n", pos[0], pos[1], pos[2]); // Write the positions to the output file
+        fprintf(vtkFile, "%f %f %f\n", nodes[i * 3], nodes[i * 3 + 1], nodes[i * 3 + 2]); // Write the positions to the output file
       }
     }
   }
@@ -298,103 +298,46 @@ void SurfaceMeshToNonconformalVtk::execute()
   // Write the triangle indices into the vtk File
   notifyStatusMessage("Writing Faces ....");
 
-  int tData[4];
-
-  // Store all the unique Spins
-  QMap<int32_t, int32_t> featureTriangleCount;
-  for(int i = 0; i < numTriangles; i++)
-  {
-    if(featureTriangleCount.find(m_SurfaceMeshFaceLabels[i * 2]) == featureTriangleCount.end())
-    {
-      featureTriangleCount[m_SurfaceMeshFaceLabels[i * 2]] = 1;
-    }
-    else
-    {
-      featureTriangleCount[m_SurfaceMeshFaceLabels[i * 2]]++;
-    }
-    if(featureTriangleCount.find(m_SurfaceMeshFaceLabels[i * 2 + 1]) == featureTriangleCount.end())
-    {
-      featureTriangleCount[m_SurfaceMeshFaceLabels[i * 2 + 1]] = 1;
-    }
-    else
-    {
-      featureTriangleCount[m_SurfaceMeshFaceLabels[i * 2 + 1]]++;
-    }
-  }
+  // Group the faces by feature once so every section can be written in a single pass
+  // instead of scanning all of the triangles once per feature
+  std::vector<int64_t> faceOrder = sortFacesByFeature(numTriangles);
 
   // Write the POLYGONS
-  fprintf(vtkFile, "\nPOLYGONS %lld %lld\n", (long long int)(numTriangles * 2), (long long int)(numTriangles * 2 * 4));
+  fprintf(vtkFile, "\nPOLYGONS %lld %lld\n", (long long int)(faceOrder.size()), (long long int)(faceOrder.size() * 4));
 
-  size_t totalCells = 0;
-  // Loop over all the features
-  for(QMap<int32_t, int32_t>::iterator featureIter = featureTriangleCount.begin(); featureIter != featureTriangleCount.end(); ++featureIter)
+  // Each entry is the index of a face label; odd entries use the back side of the triangle so the winding is flipped
+  if(m_WriteBinaryFile)
   {
-    totalCells += featureIter.value();
+    ImportExport::BinaryBlockWriter writer(vtkFile);
+    writer.writeGenerated<int32_t>(faceOrder.size(), 4, [&faceOrder, triangles](size_t i, int32_t* tData) -> size_t {
+      int64_t j = faceOrder[i] / 2;
+      bool flip = (faceOrder[i] % 2) == 1;
+      tData[0] = 3; // Push on the total number of entries for this entry
+      tData[1] = static_cast<int32_t>(triangles[j * 3 + (flip ? 2 : 0)]);
+      tData[2] = static_cast<int32_t>(triangles[j * 3 + 1]);
+      tData[3] = static_cast<int32_t>(triangles[j * 3 + (flip ? 0 : 2)]);
+      return 4;
+    });
+    if(!writer.flush())
+    {
+      QString ss = QObject::tr("Error writing the polygons to file '%1'").arg(getOutputVtkFile());
+      setErrorCondition(-18543, ss);
+      return;
+    }
   }
-  Q_ASSERT(totalCells == (size_t)(numTriangles * 2));
-
-  // Loop over all the features
-  for(QMap<int32_t, int32_t>::iterator featureIter = featureTriangleCount.begin(); featureIter != featureTriangleCount.end(); ++featureIter)
+  else
   {
-    int32_t gid = featureIter.key();             // The current Feature Id
-    int32_t numTriToWrite = featureIter.value(); // The number of triangles for this feature
-    uint8_t doWrite = 0;
-
-    // Loop over all the triangles looking for the current feature id
-    // this is probably sub-optimal as if we have 1000 features we are going to loop 1000 times but this will use the
-    // least amount of memory. We could run a filter to group the triangles by feature but then we would need an
-    // additional amount of memory equal to 3X the memory used for the triangle list because every triangle will be listed
-    // twice. We could get some slightly better performance if we buffered 4K worth of data then wrote out that data
-    // in one chunk versus what we are doing here.
-    for(int j = 0; j < numTriangles; j++)
+    for(const int64_t& face : faceOrder)
     {
-      doWrite = 0;
-
-      if(m_SurfaceMeshFaceLabels[j * 2] == gid)
-      {
-        doWrite = 1;
-      }
-      else if(m_SurfaceMeshFaceLabels[j * 2 + 1] == gid)
-      {
-        doWrite = 2;
-      } // We need to flip the winding of the triangle
-      if(doWrite == 0)
+      int64_t j = face / 2;
+      if(face % 2 == 0)
       {
-        continue;
-      } // Labels in the triangle did match the current feature id.
-
-      if(doWrite == 1)
-      {
-        tData[0] = 3; // Push on the total number of entries for this entry
-        tData[1] = triangles[j * 3];
-        tData[2] = triangles[j * 3 + 1];
-        tData[3] = triangles[j * 3 + 2];
+        fprintf(vtkFile, "3 %d %d %d\n", (int)triangles[j * 3], (int)triangles[j * 3 + 1], (int)triangles[j * 3 + 2]);
       }
       else
       {
-        tData[0] = 3; // Push on the total number of entries for this entry
-        tData[1] = triangles[j * 3 + 2];
-        tData[2] = triangles[j * 3 + 1];
-        tData[3] = triangles[j * 3];
-      }
-      if(m_WriteBinaryFile)
-      {
-
-        SIMPLib::Endian::FromSystemToBig::convert(tData[0]);
-        SIMPLib::Endian::FromSystemToBig::convert(tData[1]); // Index of Vertex 0
-        SIMPLib::Endian::FromSystemToBig::convert(tData[2]); // Index of Vertex 1
-        SIMPLib::Endian::FromSystemToBig::convert(tData[3]); // Index of Vertex 2
-        fwrite(tData, sizeof(int), 4, vtkFile);
+        fprintf(vtkFile, "3 %d %d %d\n", (int)triangles[j * 3 + 2], (int)triangles[j * 3 + 1], (int)triangles[j * 3]);
       }
-      else
-      {
-        fprintf(vtkFile, "3 %d %d %d\n", tData[1], tData[2], tData[3]);
-      }
-      numTriToWrite--;
-    }
-    if(numTriToWrite != 0)
-    {
-      qDebug() << "Not enough triangles written: " << gid << "::" << numTriToWrite << " Total Triangles to Write " << featureIter.value();
     }
   }
 
@@ -402,7 +345,7 @@ void SurfaceMeshToNonconformalVtk::execute()
   int err = writePointData(vtkFile);
 
   // Write the CELL_DATA section
-  err = writeCellData(vtkFile, featureTriangleCount);
+  err = writeCellData(vtkFile, faceOrder);
 
   fprintf(vtkFile, "\n");
 
@@ -410,6 +353,34 @@ void SurfaceMeshToNonconformalVtk::execute()
   clearWarningCode();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<int64_t> SurfaceMeshToNonconformalVtk::sortFacesByFeature(int64_t numTriangles)
+{
+  // A triangle is written once for each distinct feature on either side of it. The
+  // entries are ordered by feature id and, within a feature, by triangle index which
+  // is the same order the per feature scan produced.
+  std::vector<std::pair<int32_t, int64_t>> faces;
+  faces.reserve(numTriangles * 2);
+  for(int64_t j = 0; j < numTriangles; j++)
+  {
+    faces.emplace_back(m_SurfaceMeshFaceLabels[j * 2], j * 2);
+    if(m_SurfaceMeshFaceLabels[j * 2 + 1] != m_SurfaceMeshFaceLabels[j * 2])
+    {
+      faces.emplace_back(m_SurfaceMeshFaceLabels[j * 2 + 1], j * 2 + 1);
+    }
+  }
+  std::stable_sort(faces.begin(), faces.end(), [](const std::pair<int32_t, int64_t>& a, const std::pair<int32_t, int64_t>& b) { return a.first < b.first; });
+
+  std::vector<int64_t> faceOrder(faces.size());
+  for(size_t i = 0; i < faces.size(); i++)
+  {
+    faceOrder[i] = faces[i].second;
+  }
+  return faceOrder;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -424,18 +395,15 @@ void writePointScalarData(DataContainer::Pointer dc, const QString& vertexAttrib
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "SCALARS %s %s\n", dataName.toLatin1().data(), dataType.toLatin1().data());
     fprintf(vtkFile, "LOOKUP_TABLE default\n");
+    if(writeBinaryData)
+    {
+      ImportExport::BinaryBlockWriter writer(vtkFile);
+      writer.write(m, nT);
+      return;
+    }
     for(int i = 0; i < nT; ++i)
     {
-      T swapped = 0x00;
-      if(writeBinaryData)
-      {
-        swapped = static_cast<T>(m[i]);
-        SIMPLib::Endian::FromSystemToBig::convert(swapped);
-        fwrite(&swapped, sizeof(T), 1, vtkFile);
-      }
-      else
       {
-
         ss = QString::number(m[i]) + " ";
         fprintf(vtkFile, "%s ", ss.toLatin1().data());
         // if (i%50 == 0)
@@ -462,26 +430,15 @@ void writePointVectorData(DataContainer::Pointer dc, const QString& vertexAttrib
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "%s %s %s\n", vtkAttributeType.toLatin1().data(), dataName.toLatin1().data(), dataType.toLatin1().data());
+    if(writeBinaryData)
+    {
+      ImportExport::BinaryBlockWriter writer(vtkFile);
+      writer.write(m, static_cast<size_t>(nT) * 3);
+      return;
+    }
     for(int i = 0; i < nT; ++i)
     {
-      T s0 = 0x00;
-      T s1 = 0x00;
-      T s2 = 0x00;
-      if(writeBinaryData)
       {
-        s0 = static_cast<T>(m[i * 3 + 0]);
-        s1 = static_cast<T>(m[i * 3 + 1]);
-        s2 = static_cast<T>(m[i * 3 + 2]);
-        SIMPLib::Endian::FromSystemToBig::convert(s0);
-        SIMPLib::Endian::FromSystemToBig::convert(s1);
-        SIMPLib::Endian::FromSystemToBig::convert(s2);
-        fwrite(&s0, sizeof(T), 1, vtkFile);
-        fwrite(&s1, sizeof(T), 1, vtkFile);
-        fwrite(&s1, sizeof(T), 1, vtkFile);
-      }
-      else
-      {
-
         ss << m[i * 3 + 0] << " " << m[i * 3 + 1] << " " << m[i * 3 + 2] << " ";
         fprintf(vtkFile, "%s ", buf.toLatin1().data());
         buf.clear();
@@ -532,17 +489,21 @@ int SurfaceMeshToNonconformalVtk::writePointData(FILE* vtkFile)
   fprintf(vtkFile, "SCALARS Node_Type char 1\n");
   fprintf(vtkFile, "LOOKUP_TABLE default\n");
 
-  for(int i = 0; i < numNodes; ++i)
+  if(m_WriteBinaryFile)
   {
-    if(m_SurfaceMeshNodeType[i] > 0)
+    // 1 byte Char values so there is nothing to swap
+    int8_t* nodeType = m_SurfaceMeshNodeType;
+    ImportExport::BinaryBlockWriter writer(vtkFile);
+    writer.writeGenerated<int8_t>(numNodes, 1, [nodeType](size_t i, int8_t* out) -> size_t {
+      *out = nodeType[i];
+      return nodeType[i] > 0 ? 1 : 0;
+    });
+  }
+  else
+  {
+    for(int i = 0; i < numNodes; ++i)
     {
-      if(m_WriteBinaryFile)
-      {
-        // swapped = m_SurfaceMeshNodeType[i];
-        // SIMPLib::Endian::FromSystemToBig::convert(swapped);
-        fwrite(m_SurfaceMeshNodeType + i, sizeof(char), 1, vtkFile);
-      }
-      else
+      if(m_SurfaceMeshNodeType[i] > 0)
       {
         fprintf(vtkFile, "%d ", m_SurfaceMeshNodeType[i]);
       }
@@ -575,64 +536,37 @@ int SurfaceMeshToNonconformalVtk::writePointData(FILE* vtkFile)
 
 template <typename T>
 void writeCellScalarData(DataContainer::Pointer dc, const QString& faceAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, FILE* vtkFile,
-                         QMap<int32_t, int32_t>& featureIds, int32_t* m_SurfaceMeshFaceLabels)
+                         const std::vector<int64_t>& faceOrder)
 {
-  TriangleGeom::Pointer triangleGeom = dc->getGeometryAs<TriangleGeom>();
-
-  int64_t numTriangles = triangleGeom->getNumberOfTris();
   IDataArray::Pointer data = dc->getAttributeMatrix(faceAttributeMatrixName)->getAttributeArray(dataName);
 
   QString ss;
   if(nullptr != data.get())
   {
-    int32_t totalCellsWritten = 0;
-
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "SCALARS %s %s 1\n", dataName.toLatin1().data(), dataType.toLatin1().data());
     fprintf(vtkFile, "LOOKUP_TABLE default\n");
-    // Loop over all the features
-    for(QMap<int32_t, int32_t>::iterator featureIter = featureIds.begin(); featureIter != featureIds.end(); ++featureIter)
+    // The value is negated when the current feature is on the back side of the triangle
+    if(writeBinaryData)
     {
-      int32_t gid = featureIter.key();   // The current Feature Id
-      size_t size = featureIter.value(); // The number of triangles for this feature id
-      std::vector<T> buffer(size, 0);
-      totalCellsWritten += size;
-      size_t index = 0;
-
-      for(int j = 0; j < numTriangles; j++)
-      {
-        if(m_SurfaceMeshFaceLabels[j * 2] != gid && m_SurfaceMeshFaceLabels[j * 2 + 1] != gid)
-        {
-          continue;
-        }
-        // Get the data
-        T s0 = static_cast<T>(m[j]);
-        if(m_SurfaceMeshFaceLabels[j * 2 + 1] == gid)
-        {
-          s0 = s0 * -1;
-        }
-
-        // Write the values to the buffer after an Endian swap.
-        if(writeBinaryData)
-        {
-          SIMPLib::Endian::FromSystemToBig::convert(s0);
-          buffer[index] = s0;
-          ++index;
-        }
-        else
-        {
-
-          ss = QString::number(s0);
-          fprintf(vtkFile, "%s\n", ss.toLatin1().data());
-        }
-      }
-
-      // Write the Buffer
-      if(writeBinaryData)
+      ImportExport::BinaryBlockWriter writer(vtkFile);
+      writer.writeGenerated<T>(faceOrder.size(), 1, [&faceOrder, m](size_t i, T* out) -> size_t {
+        T s0 = static_cast<T>(m[faceOrder[i] / 2]);
+        *out = (faceOrder[i] % 2 == 1) ? static_cast<T>(s0 * -1) : s0;
+        return 1;
+      });
+      return;
+    }
+    for(const int64_t& face : faceOrder)
+    {
+      T s0 = static_cast<T>(m[face / 2]);
+      if(face % 2 == 1)
       {
-        fwrite(&(buffer.front()), sizeof(T), size, vtkFile);
+        s0 = s0 * -1;
       }
+      ss = QString::number(s0);
+      fprintf(vtkFile, "%s\n", ss.toLatin1().data());
     }
   }
 }
@@ -642,76 +576,45 @@ void writeCellScalarData(DataContainer::Pointer dc, const QString& faceAttribute
 // -----------------------------------------------------------------------------
 template <typename T>
 void writeCellNormalData(DataContainer::Pointer dc, const QString& faceAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, FILE* vtkFile,
-                         QMap<int32_t, int32_t>& featureIds, int32_t* m_SurfaceMeshFaceLabels)
+                         const std::vector<int64_t>& faceOrder)
 {
-  TriangleGeom::Pointer triangleGeom = dc->getGeometryAs<TriangleGeom>();
-
-  int64_t numTriangles = triangleGeom->getNumberOfTris();
   IDataArray::Pointer data = dc->getAttributeMatrix(faceAttributeMatrixName)->getAttributeArray(dataName);
   QString buf;
   QTextStream ss(&buf);
   if(nullptr != data.get())
   {
-    int32_t totalCellsWritten = 0;
-
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "NORMALS %s %s\n", dataName.toLatin1().data(), dataType.toLatin1().data());
-    // Loop over all the features
-    for(QMap<int32_t, int32_t>::iterator featureIter = featureIds.begin(); featureIter != featureIds.end(); ++featureIter)
+    // Flip the normal if needed because the current feature id is assigned to the triangle.labels[1]
+    if(writeBinaryData)
     {
-      int32_t gid = featureIter.key();   // The current Feature Id
-      size_t size = featureIter.value(); // The number of triangles for this feature id
-      std::vector<T> buffer(size * 3, 0);
-      totalCellsWritten += size * 3;
-      size_t index = 0;
-
-      for(int j = 0; j < numTriangles; j++)
-      {
-        if(m_SurfaceMeshFaceLabels[j * 2] != gid && m_SurfaceMeshFaceLabels[j * 2 + 1] != gid)
-        {
-          continue;
-        }
-        // Get the data
-        T s0 = static_cast<T>(m[j * 3 + 0]);
-        T s1 = static_cast<T>(m[j * 3 + 1]);
-        T s2 = static_cast<T>(m[j * 3 + 2]);
-        // Flip the normal if needed because the current feature id is assigned to the triangle.labels[1]
-        if(m_SurfaceMeshFaceLabels[j * 2 + 1] == gid)
-        {
-          s0 *= -1.0;
-          s1 *= -1.0;
-          s2 *= -1.0;
-        }
-        // Write the values to the buffer after an Endian swap.
-        if(writeBinaryData)
-        {
-          SIMPLib::Endian::FromSystemToBig::convert(s0);
-          buffer[index] = s0;
-          ++index;
-
-          SIMPLib::Endian::FromSystemToBig::convert(s1);
-          buffer[index] = s1;
-          ++index;
-
-          SIMPLib::Endian::FromSystemToBig::convert(s2);
-          buffer[index] = s2;
-          ++index;
-        }
-        else
-        {
-
-          ss << s0 << " " << s1 << " " << s2;
-          fprintf(vtkFile, "%s\n", buf.toLatin1().data());
-          buf.clear();
-        }
-      }
-
-      // Write the Buffer
-      if(writeBinaryData)
+      ImportExport::BinaryBlockWriter writer(vtkFile);
+      writer.writeGenerated<T>(faceOrder.size(), 3, [&faceOrder, m](size_t i, T* out) -> size_t {
+        int64_t j = faceOrder[i] / 2;
+        T sign = (faceOrder[i] % 2 == 1) ? -1.0 : 1.0;
+        out[0] = static_cast<T>(m[j * 3 + 0]) * sign;
+        out[1] = static_cast<T>(m[j * 3 + 1]) * sign;
+        out[2] = static_cast<T>(m[j * 3 + 2]) * sign;
+        return 3;
+      });
+      return;
+    }
+    for(const int64_t& face : faceOrder)
+    {
+      int64_t j = face / 2;
+      T s0 = static_cast<T>(m[j * 3 + 0]);
+      T s1 = static_cast<T>(m[j * 3 + 1]);
+      T s2 = static_cast<T>(m[j * 3 + 2]);
+      if(face % 2 == 1)
       {
-        fwrite(&(buffer.front()), sizeof(T), size * 3, vtkFile);
+        s0 *= -1.0;
+        s1 *= -1.0;
+        s2 *= -1.0;
       }
+      ss << s0 << " " << s1 << " " << s2;
+      fprintf(vtkFile, "%s\n", buf.toLatin1().data());
+      buf.clear();
     }
   }
 }
@@ -721,7 +624,7 @@ void writeCellNormalData(DataContainer::Pointer dc, const QString& faceAttribute
 // -----------------------------------------------------------------------------
 template <typename T>
 void writeCellVectorData(DataContainer::Pointer dc, const QString& faceAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, const QString& vtkAttributeType,
-                         FILE* vtkFile, QMap<int32_t, int32_t>& featureIds)
+                         FILE* vtkFile)
 {
   TriangleGeom::Pointer triangleGeom = dc->getGeometryAs<TriangleGeom>();
 
@@ -734,26 +637,15 @@ void writeCellVectorData(DataContainer::Pointer dc, const QString& faceAttribute
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "%s %s %s\n", vtkAttributeType.toLatin1().data(), dataName.toLatin1().data(), dataType.toLatin1().data());
+    if(writeBinaryData)
+    {
+      ImportExport::BinaryBlockWriter writer(vtkFile);
+      writer.write(m, static_cast<size_t>(numTriangles) * 3);
+      return;
+    }
     for(int i = 0; i < numTriangles; ++i)
     {
-      T s0 = 0x00;
-      T s1 = 0x00;
-      T s2 = 0x00;
-      if(writeBinaryData)
       {
-        s0 = static_cast<T>(m[i * 3 + 0]);
-        s1 = static_cast<T>(m[i * 3 + 1]);
-        s2 = static_cast<T>(m[i * 3 + 2]);
-        SIMPLib::Endian::FromSystemToBig::convert(s0);
-        SIMPLib::Endian::FromSystemToBig::convert(s1);
-        SIMPLib::Endian::FromSystemToBig::convert(s2);
-        fwrite(&s0, sizeof(T), 1, vtkFile);
-        fwrite(&s1, sizeof(T), 1, vtkFile);
-        fwrite(&s2, sizeof(T), 1, vtkFile);
-      }
-      else
-      {
-
         ss << m[i * 3 + 0] << " " << m[i * 3 + 1] << " " << m[i * 3 + 2] << " ";
 
         fprintf(vtkFile, "%s ", ss.toLatin1().data());
@@ -769,7 +661,7 @@ void writeCellVectorData(DataContainer::Pointer dc, const QString& faceAttribute
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int SurfaceMeshToNonconformalVtk::writeCellData(FILE* vtkFile, QMap<int32_t, int32_t>& featureIds)
+int SurfaceMeshToNonconformalVtk::writeCellData(FILE* vtkFile, const std::vector<int64_t>& faceOrder)
 {
   int err = 0;
   if(nullptr == vtkFile)
@@ -779,60 +671,28 @@ int SurfaceMeshToNonconformalVtk::writeCellData(FILE* vtkFile, QMap<int32_t, int
 
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(m_SurfaceMeshFaceLabelsArrayPath.getDataContainerName());
 
-  // Write the triangle region ids
-  TriangleGeom::Pointer triangleGeom = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName())->getGeometryAs<TriangleGeom>();
-  int64_t numTriangles = triangleGeom->getNumberOfTris();
-
-  int swapped;
-
   // This is like a "section header"
   fprintf(vtkFile, "\n");
-  fprintf(vtkFile, "CELL_DATA %lld\n", (long long int)(numTriangles * 2));
-
-  int32_t totalCellsWritten = 0;
+  fprintf(vtkFile, "CELL_DATA %lld\n", (long long int)(faceOrder.size()));
 
   // Write the FeatureId Data to the file
   fprintf(vtkFile, "SCALARS FeatureID int 1\n");
   fprintf(vtkFile, "LOOKUP_TABLE default\n");
 
-  // Loop over all the features
-  for(QMap<int32_t, int32_t>::iterator featureIter = featureIds.begin(); featureIter != featureIds.end(); ++featureIter)
+  int32_t* faceLabels = m_SurfaceMeshFaceLabels;
+  if(m_WriteBinaryFile)
   {
-    int32_t gid = featureIter.key();   // The current Feature Id
-    size_t size = featureIter.value(); // The number of triangles for this feature id
-    std::vector<int32_t> buffer(size, 0);
-    totalCellsWritten += size;
-
-    // Endian Swap our current feature Id since we are going to write it a bunch of times.
-    swapped = gid;
-    SIMPLib::Endian::FromSystemToBig::convert(swapped);
-    size_t index = 0;
-
-    // Loop over all the triangles looking for the current feature id
-    // this is probably sub-optimal as if we have 1000 features we are going to loop 1000 times but this will use the
-    // least amount of memory. We could run a filter to group the triangles by feature but then we would need an
-    // additional amount of memory equal to 3X the memory used for the triangle list because every triangle will be listed
-    // twice. We could get some slightly better performance if we buffered 4K worth of data then wrote out that data
-    // in one chunk versus what we are doing here.
-    for(int j = 0; j < numTriangles; j++)
-    {
-      if(m_SurfaceMeshFaceLabels[j * 2] == gid || m_SurfaceMeshFaceLabels[j * 2 + 1] == gid)
-      {
-        if(m_WriteBinaryFile)
-        {
-          buffer[index] = swapped;
-          ++index;
-        }
-        else
-        {
-          fprintf(vtkFile, "%d\n", gid);
-        }
-      }
-    }
-    // Write the Buffer
-    if(m_WriteBinaryFile)
+    ImportExport::BinaryBlockWriter writer(vtkFile);
+    writer.writeGenerated<int32_t>(faceOrder.size(), 1, [&faceOrder, faceLabels](size_t i, int32_t* out) -> size_t {
+      *out = faceLabels[faceOrder[i]];
+      return 1;
+    });
+  }
+  else
+  {
+    for(const int64_t& face : faceOrder)
     {
-      fwrite(&(buffer.front()), sizeof(int32_t), size, vtkFile);
+      fprintf(vtkFile, "%d\n", faceLabels[face]);
     }
   }
 #if 0
@@ -862,21 +722,21 @@ int SurfaceMeshToNonconformalVtk::writeCellData(FILE* vtkFile, QMap<int32_t, int
   QString attrMatName = m_SurfaceMeshFaceLabelsArrayPath.getAttributeMatrixName();
 
   notifyStatusMessage("Writing Face Normals...");
-  writeCellNormalData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshFaceNormals, "double", m_WriteBinaryFile, vtkFile, featureIds, m_SurfaceMeshFaceLabels);
+  writeCellNormalData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshFaceNormals, "double", m_WriteBinaryFile, vtkFile, faceOrder);
 
   notifyStatusMessage("Writing Principal Curvature 1");
-  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature1, "double", m_WriteBinaryFile, vtkFile, featureIds, m_SurfaceMeshFaceLabels);
+  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature1, "double", m_WriteBinaryFile, vtkFile, faceOrder);
   notifyStatusMessage("Writing Principal Curvature 2");
-  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature2, "double", m_WriteBinaryFile, vtkFile, featureIds, m_SurfaceMeshFaceLabels);
+  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature2, "double", m_WriteBinaryFile, vtkFile, faceOrder);
 
   notifyStatusMessage("Writing Feature Face Id");
-  writeCellScalarData<int32_t>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshFeatureFaceId, "int", m_WriteBinaryFile, vtkFile, featureIds, m_SurfaceMeshFaceLabels);
+  writeCellScalarData<int32_t>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshFeatureFaceId, "int", m_WriteBinaryFile, vtkFile, faceOrder);
 
   notifyStatusMessage("Writing Gaussian Curvature");
-  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshGaussianCurvatures, "double", m_WriteBinaryFile, vtkFile, featureIds, m_SurfaceMeshFaceLabels);
+  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshGaussianCurvatures, "double", m_WriteBinaryFile, vtkFile, faceOrder);
 
   notifyStatusMessage("Writing Mean Curvature");
-  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshMeanCurvatures, "double", m_WriteBinaryFile, vtkFile, featureIds, m_SurfaceMeshFaceLabels);
+  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshMeanCurvatures, "double", m_WriteBinaryFile, vtkFile, faceOrder);
 #if 0
   writeCellVectorData<double>(sm, attrMatName, SIMPL::CellData::SurfaceMeshPrincipalDirection1,
                               "double", m_WriteBinaryFile, "VECTORS", vtkFile, nT);
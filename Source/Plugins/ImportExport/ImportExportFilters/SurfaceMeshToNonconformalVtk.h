@@ -36,6 +36,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <QtCore/QString>
 
@@ -217,7 +218,13 @@ protected:
    */
   void initialize();
 
-  int writeCellData(FILE* vtkFile, QMap<int32_t, int32_t>& featureIds);
+  /**
+   * @brief Returns the face label index (triangle * 2 + side) of every face to write,
+   * grouped by feature id in ascending order.
+   */
+  std::vector<int64_t> sortFacesByFeature(int64_t numTriangles);
+
+  int writeCellData(FILE* vtkFile, const std::vector<int64_t>& faceOrder);
 
   int writePointData(FILE* vtkFile);
 
@@ -57,6 +57,9 @@
 #include "SIMPLib/Utilities/SIMPLibEndian.h"
 
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/BinaryBlockWriter.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedAsciiWriter.h"
+#include "ImportExport/ImportExportFilters/util/VtkXmlAppendedWriter.h"
 #include "ImportExport/ImportExportVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -280,6 +283,17 @@ void SurfaceMeshToVtk::execute()
   }
   ScopedFileMonitor vtkFileMonitor(vtkFile);
 
+  // A .vtp extension selects the VTK XML PolyData format with raw appended arrays
+  if(fi.suffix().compare("vtp", Qt::CaseInsensitive) == 0)
+  {
+    if(writeXmlPolyData(vtkFile) < 0)
+    {
+      QString ss = QObject::tr("Error writing vtp file '%1'").arg(getOutputVtkFile());
+      setErrorCondition(-18545, ss);
+    }
+    return;
+  }
+
   fprintf(vtkFile, "# vtk DataFile Version 2.0\n");
   fprintf(vtkFile, "Data set from DREAM.3D Surface Meshing Module\n");
   if(m_WriteBinaryFile)
@@ -304,37 +318,51 @@ void SurfaceMeshToVtk::execute()
 
   fprintf(vtkFile, "POINTS %d float\n", numberWrittenumNodes);
 
-  float pos[3] = {0.0f, 0.0f, 0.0f};
-
-  size_t totalWritten = 0;
-
   // Write the POINTS data (Vertex)
-  for(int i = 0; i < numNodes; i++)
+  int8_t* nodeType = m_SurfaceMeshNodeType;
+  if(m_WriteBinaryFile)
   {
-    if(m_SurfaceMeshNodeType[i] > 0)
+    ImportExport::BinaryBlockWriter writer(vtkFile);
+    writer.writeGenerated<float>(numNodes, 3, [nodes, nodeType](size_t i, float* pos) -> size_t {
+      if(nodeType[i] <= 0)
+      {
+        return 0;
+      }
+      pos[0] = nodes[i * 3];
+      pos[1] = nodes[i * 3 + 1];
+      pos[2] = nodes[i * 3 + 2];
+      return 3;
+    });
+    if(!writer.flush())
     {
-      pos[0] = static_cast<float>(nodes[i * 3]);
-      pos[1] = static_cast<float>(nodes[i * 3 + 1]);
-      pos[2] = static_cast<float>(nodes[i * 3 + 2]);
-
-      if(m_WriteBinaryFile)
+      setErrorCondition(-18543, QObject::tr("Error writing the points to file '%1'").arg(getOutputVtkFile()));
+      return;
+    }
+  }
+  else
+  {
+    auto formatPoints = [nodes, nodeType](size_t start, size_t end, ImportExport::AsciiChunk& chunk) {
+      for(size_t i = start; i < end; i++)
       {
-        SIMPLib::Endian::FromSystemToBig::convert(pos[0]);
-        SIMPLib::Endian::FromSystemToBig::convert(pos[1]);
-        SIMPLib::Endian::FromSystemToBig::convert(pos[2]);
-        totalWritten = fwrite(pos, sizeof(float), 3, vtkFile);
-        if(totalWritten != sizeof(float) * 3)
+        if(nodeType[i] > 0)
         {
+          chunk.appendFixed(nodes[i * 3]);
+          chunk.append(' ');
+          chunk.appendFixed(nodes[i * 3 + 1]);
+          chunk.append(' ');
+          chunk.appendFixed(nodes[i * 3 + 2]);
+          chunk.append('\n');
         }
       }
-      else
-      {
-        fprintf(vtkFile, "%f %f %f\n", pos[0], pos[1], pos[2]); // Write the positions to the output file
-      }
+    };
+    ImportExport::ChunkedAsciiWriter writer(vtkFile);
+    if(writer.write(numNodes, formatPoints) < 0)
+    {
+      setErrorCondition(-18543, QObject::tr("Error writing the points to file '%1'").arg(getOutputVtkFile()));
+      return;
     }
   }
 
-  int tData[4];
   int triangleCount = numTriangles;
   //  int tn1, tn2, tn3;
   if(!m_WriteConformalMesh)
@@ -343,45 +371,81 @@ void SurfaceMeshToVtk::execute()
   }
   // Write the POLYGONS
   fprintf(vtkFile, "\nPOLYGONS %d %d\n", triangleCount, (triangleCount * 4));
-  for(int j = 0; j < numTriangles; j++)
+  bool writeConformalMesh = m_WriteConformalMesh;
+  if(m_WriteBinaryFile)
   {
-    //  Triangle& t = triangles[j];
-    tData[1] = triangles[j * 3];
-    tData[2] = triangles[j * 3 + 1];
-    tData[3] = triangles[j * 3 + 2];
-
-    if(m_WriteBinaryFile)
-    {
+    ImportExport::BinaryBlockWriter writer(vtkFile);
+    writer.writeGenerated<int32_t>(numTriangles, 8, [triangles, writeConformalMesh](size_t j, int32_t* tData) -> size_t {
       tData[0] = 3; // Push on the total number of entries for this entry
-      SIMPLib::Endian::FromSystemToBig::convert(tData[0]);
-      SIMPLib::Endian::FromSystemToBig::convert(tData[1]); // Index of Vertex 0
-      SIMPLib::Endian::FromSystemToBig::convert(tData[2]); // Index of Vertex 1
-      SIMPLib::Endian::FromSystemToBig::convert(tData[3]); // Index of Vertex 2
-      fwrite(tData, sizeof(int), 4, vtkFile);
-      if(!m_WriteConformalMesh)
+      tData[1] = static_cast<int32_t>(triangles[j * 3]);     // Index of Vertex 0
+      tData[2] = static_cast<int32_t>(triangles[j * 3 + 1]); // Index of Vertex 1
+      tData[3] = static_cast<int32_t>(triangles[j * 3 + 2]); // Index of Vertex 2
+      if(writeConformalMesh)
       {
-        tData[0] = tData[1];
-        tData[1] = tData[3];
-        tData[3] = tData[0];
-        tData[0] = 3;
-        SIMPLib::Endian::FromSystemToBig::convert(tData[0]);
-        fwrite(tData, sizeof(int), 4, vtkFile);
+        return 4;
       }
-    }
-    else
+      // The back face has the opposite winding
+      tData[4] = 3;
+      tData[5] = tData[3];
+      tData[6] = tData[2];
+      tData[7] = tData[1];
+      return 8;
+    });
+    if(!writer.flush())
     {
-      fprintf(vtkFile, "3 %d %d %d\n", tData[1], tData[2], tData[3]);
-      if(!m_WriteConformalMesh)
+      setErrorCondition(-18544, QObject::tr("Error writing the polygons to file '%1'").arg(getOutputVtkFile()));
+      return;
+    }
+  }
+  else
+  {
+    auto formatPolygons = [triangles, writeConformalMesh](size_t start, size_t end, ImportExport::AsciiChunk& chunk) {
+      for(size_t j = start; j < end; j++)
       {
-        fprintf(vtkFile, "3 %d %d %d\n", tData[3], tData[2], tData[1]);
+        int v0 = triangles[j * 3];
+        int v1 = triangles[j * 3 + 1];
+        int v2 = triangles[j * 3 + 2];
+        chunk.append("3 ", 2);
+        chunk.appendInt(v0);
+        chunk.append(' ');
+        chunk.appendInt(v1);
+        chunk.append(' ');
+        chunk.appendInt(v2);
+        chunk.append('\n');
+        if(!writeConformalMesh)
+        {
+          chunk.append("3 ", 2);
+          chunk.appendInt(v2);
+          chunk.append(' ');
+          chunk.appendInt(v1);
+          chunk.append(' ');
+          chunk.appendInt(v0);
+          chunk.append('\n');
+        }
       }
+    };
+    ImportExport::ChunkedAsciiWriter writer(vtkFile);
+    if(writer.write(numTriangles, formatPolygons) < 0)
+    {
+      setErrorCondition(-18544, QObject::tr("Error writing the polygons to file '%1'").arg(getOutputVtkFile()));
+      return;
     }
   }
 
   // Write the POINT_DATA section
   int err = writePointData(vtkFile);
+  if(err < 0)
+  {
+    setErrorCondition(-18546, QObject::tr("Error writing the point data to file '%1'").arg(getOutputVtkFile()));
+    return;
+  }
   // Write the CELL_DATA section
   err = writeCellData(vtkFile);
+  if(err < 0)
+  {
+    setErrorCondition(-18547, QObject::tr("Error writing the cell data to file '%1'").arg(getOutputVtkFile()));
+    return;
+  }
 
   fprintf(vtkFile, "\n");
 
@@ -393,83 +457,88 @@ void SurfaceMeshToVtk::execute()
 //
 // -----------------------------------------------------------------------------
 template <typename T>
-void writePointScalarData(DataContainer::Pointer dc, const QString& vertexAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, bool writeConformalMesh,
-                          FILE* vtkFile, int nT)
+int writePointScalarData(DataContainer::Pointer dc, const QString& vertexAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, bool writeConformalMesh,
+                         FILE* vtkFile, int nT)
 {
   IDataArray::Pointer data = dc->getAttributeMatrix(vertexAttributeMatrixName)->getAttributeArray(dataName);
-  QString ss;
   if(nullptr != data.get())
   {
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "SCALARS %s %s\n", dataName.toLatin1().data(), dataType.toLatin1().data());
     fprintf(vtkFile, "LOOKUP_TABLE default\n");
-    for(int i = 0; i < nT; ++i)
+    if(writeBinaryData)
     {
-      T swapped = 0x00;
-      if(writeBinaryData)
+      ImportExport::BinaryBlockWriter writer(vtkFile);
+      writer.write(m, nT);
+      if(!writer.flush())
       {
-        swapped = static_cast<T>(m[i]);
-        SIMPLib::Endian::FromSystemToBig::convert(swapped);
-        fwrite(&swapped, sizeof(T), 1, vtkFile);
+        return -1;
       }
-      else
-      {
-
-        ss = QString::number(m[i]) + " ";
-        fprintf(vtkFile, "%s ", ss.toLatin1().data());
-        // if (i%50 == 0)
+    }
+    else
+    {
+      // QString::number() is reentrant so each chunk can format its values on its own thread
+      auto formatValues = [m](size_t start, size_t end, ImportExport::AsciiChunk& chunk) {
+        for(size_t i = start; i < end; ++i)
         {
-          fprintf(vtkFile, "\n");
+          chunk.append(QString::number(m[i]).toLatin1().constData());
+          chunk.append("  \n", 3);
         }
+      };
+      ImportExport::ChunkedAsciiWriter writer(vtkFile);
+      if(writer.write(nT, formatValues) < 0)
+      {
+        return -1;
       }
     }
   }
+  return 0;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 template <typename T>
-void writePointVectorData(DataContainer::Pointer dc, const QString& vertexAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, bool writeConformalMesh,
-                          const QString& vtkAttributeType, FILE* vtkFile, int nT)
+int writePointVectorData(DataContainer::Pointer dc, const QString& vertexAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, bool writeConformalMesh,
+                         const QString& vtkAttributeType, FILE* vtkFile, int nT)
 {
   IDataArray::Pointer data = dc->getAttributeMatrix(vertexAttributeMatrixName)->getAttributeArray(dataName);
-  QString ss;
   if(nullptr != data.get())
   {
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "%s %s %s\n", vtkAttributeType.toLatin1().data(), dataName.toLatin1().data(), dataType.toLatin1().data());
-    for(int i = 0; i < nT; ++i)
+    if(writeBinaryData)
     {
-      T s0 = 0x00;
-      T s1 = 0x00;
-      T s2 = 0x00;
-      if(writeBinaryData)
+      ImportExport::BinaryBlockWriter writer(vtkFile);
+      writer.write(m, static_cast<size_t>(nT) * 3);
+      if(!writer.flush())
       {
-        s0 = static_cast<T>(m[i * 3 + 0]);
-        s1 = static_cast<T>(m[i * 3 + 1]);
-        s2 = static_cast<T>(m[i * 3 + 2]);
-        SIMPLib::Endian::FromSystemToBig::convert(s0);
-        SIMPLib::Endian::FromSystemToBig::convert(s1);
-        SIMPLib::Endian::FromSystemToBig::convert(s2);
-        fwrite(&s0, sizeof(T), 1, vtkFile);
-        fwrite(&s1, sizeof(T), 1, vtkFile);
-        fwrite(&s1, sizeof(T), 1, vtkFile);
+        return -1;
       }
-      else
-      {
-
-        ss = QString::number(m[i * 3 + 0]) + " " + QString::number(m[i * 3 + 1]) + " " + QString::number(m[i * 3 + 2]) + " ";
-        fprintf(vtkFile, "%s ", ss.toLatin1().data());
-        // if (i%50 == 0)
+    }
+    else
+    {
+      auto formatVectors = [m](size_t start, size_t end, ImportExport::AsciiChunk& chunk) {
+        for(size_t i = start; i < end; ++i)
         {
-          fprintf(vtkFile, "\n");
+          for(size_t c = 0; c < 3; c++)
+          {
+            chunk.append(QString::number(m[i * 3 + c]).toLatin1().constData());
+            chunk.append(' ');
+          }
+          chunk.append(" \n", 2);
         }
+      };
+      ImportExport::ChunkedAsciiWriter writer(vtkFile);
+      if(writer.write(nT, formatVectors) < 0)
+      {
+        return -1;
       }
     }
   }
+  return 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -504,20 +573,36 @@ int SurfaceMeshToVtk::writePointData(FILE* vtkFile)
   fprintf(vtkFile, "SCALARS Node_Type char 1\n");
   fprintf(vtkFile, "LOOKUP_TABLE default\n");
 
-  for(int i = 0; i < numNodes; ++i)
+  int8_t* nodeType = m_SurfaceMeshNodeType;
+  if(m_WriteBinaryFile)
   {
-    if(m_SurfaceMeshNodeType[i] > 0)
+    // 1 byte Char values so there is nothing to swap
+    ImportExport::BinaryBlockWriter writer(vtkFile);
+    writer.writeGenerated<int8_t>(numNodes, 1, [nodeType](size_t i, int8_t* out) -> size_t {
+      *out = nodeType[i];
+      return nodeType[i] > 0 ? 1 : 0;
+    });
+    if(!writer.flush())
     {
-      if(m_WriteBinaryFile)
-      {
-        // Normally, we would byte swap to big endian but since we are only writing
-        // 1 byte Char values, nothing to swap.
-        fwrite(m_SurfaceMeshNodeType + i, sizeof(char), 1, vtkFile);
-      }
-      else
+      return -1;
+    }
+  }
+  else
+  {
+    auto formatNodeTypes = [nodeType](size_t start, size_t end, ImportExport::AsciiChunk& chunk) {
+      for(size_t i = start; i < end; ++i)
       {
-        fprintf(vtkFile, "%d ", m_SurfaceMeshNodeType[i]);
+        if(nodeType[i] > 0)
+        {
+          chunk.appendInt(nodeType[i]);
+          chunk.append(' ');
+        }
       }
+    };
+    ImportExport::ChunkedAsciiWriter writer(vtkFile);
+    if(writer.write(numNodes, formatNodeTypes) < 0)
+    {
+      return -1;
     }
   }
 
@@ -525,19 +610,39 @@ int SurfaceMeshToVtk::writePointData(FILE* vtkFile)
 
 #if 1
   // This is from the Goldfeather Paper
-  writePointVectorData<double>(sm, attrMatName, "Principal_Direction_1", "double", m_WriteBinaryFile, m_WriteConformalMesh, "VECTORS", vtkFile, numNodes);
+  err = writePointVectorData<double>(sm, attrMatName, "Principal_Direction_1", "double", m_WriteBinaryFile, m_WriteConformalMesh, "VECTORS", vtkFile, numNodes);
+  if(err < 0)
+  {
+    return err;
+  }
   // This is from the Goldfeather Paper
-  writePointVectorData<double>(sm, attrMatName, "Principal_Direction_2", "double", m_WriteBinaryFile, m_WriteConformalMesh, "VECTORS", vtkFile, numNodes);
+  err = writePointVectorData<double>(sm, attrMatName, "Principal_Direction_2", "double", m_WriteBinaryFile, m_WriteConformalMesh, "VECTORS", vtkFile, numNodes);
+  if(err < 0)
+  {
+    return err;
+  }
 
   // This is from the Goldfeather Paper
-  writePointScalarData<double>(sm, attrMatName, "Principal_Curvature_1", "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, numNodes);
+  err = writePointScalarData<double>(sm, attrMatName, "Principal_Curvature_1", "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, numNodes);
+  if(err < 0)
+  {
+    return err;
+  }
 
   // This is from the Goldfeather Paper
-  writePointScalarData<double>(sm, attrMatName, "Principal_Curvature_2", "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, numNodes);
+  err = writePointScalarData<double>(sm, attrMatName, "Principal_Curvature_2", "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, numNodes);
+  if(err < 0)
+  {
+    return err;
+  }
 #endif
 
   // This is from the Goldfeather Paper
-  writePointVectorData<double>(sm, attrMatName, SIMPL::VertexData::SurfaceMeshNodeNormals, "double", m_WriteBinaryFile, m_WriteConformalMesh, "VECTORS", vtkFile, numNodes);
+  err = writePointVectorData<double>(sm, attrMatName, SIMPL::VertexData::SurfaceMeshNodeNormals, "double", m_WriteBinaryFile, m_WriteConformalMesh, "VECTORS", vtkFile, numNodes);
+  if(err < 0)
+  {
+    return err;
+  }
 
   return err;
 }
@@ -546,168 +651,201 @@ int SurfaceMeshToVtk::writePointData(FILE* vtkFile)
 //
 // -----------------------------------------------------------------------------
 template <typename T>
-void writeCellScalarData(DataContainer::Pointer dc, const QString& faceAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, bool writeConformalMesh,
-                         FILE* vtkFile, int nT)
+int writeCellScalarData(DataContainer::Pointer dc, const QString& faceAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, bool writeConformalMesh,
+                        FILE* vtkFile, int nT)
 {
   // Write the Feature Face ID Data to the file
   IDataArray::Pointer data = dc->getAttributeMatrix(faceAttributeMatrixName)->getAttributeArray(dataName);
-  QString buf;
-  QTextStream ss(&buf);
   if(nullptr != data.get())
   {
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "SCALARS %s %s 1\n", dataName.toLatin1().data(), dataType.toLatin1().data());
     fprintf(vtkFile, "LOOKUP_TABLE default\n");
-    for(int i = 0; i < nT; ++i)
+    if(writeBinaryData)
     {
-      T swapped = 0x00;
-      if(writeBinaryData)
+      ImportExport::BinaryBlockWriter writer(vtkFile);
+      if(writeConformalMesh)
       {
-        swapped = static_cast<T>(m[i]);
-        SIMPLib::Endian::FromSystemToBig::convert(swapped);
-        fwrite(&swapped, sizeof(T), 1, vtkFile);
-        if(!writeConformalMesh)
-        {
-          fwrite(&swapped, sizeof(T), 1, vtkFile);
-        }
+        writer.write(m, nT);
       }
       else
       {
-
-        ss << m[i] << " ";
-        if(!writeConformalMesh)
+        writer.writeGenerated<T>(nT, 2, [m](size_t i, T* out) -> size_t {
+          out[0] = m[i];
+          out[1] = m[i];
+          return 2;
+        });
+      }
+      if(!writer.flush())
+      {
+        return -1;
+      }
+    }
+    else
+    {
+      // Each chunk gets its own QTextStream so the numbers are formatted exactly as before
+      auto formatValues = [m, writeConformalMesh](size_t start, size_t end, ImportExport::AsciiChunk& chunk) {
+        QString buf;
+        QTextStream ss(&buf);
+        for(size_t i = start; i < end; ++i)
         {
           ss << m[i] << " ";
+          if(!writeConformalMesh)
+          {
+            ss << m[i] << " ";
+          }
+          chunk.append(buf.toLatin1().constData());
+          buf.clear();
+          if(i % 50 == 0)
+          {
+            chunk.append('\n');
+          }
         }
-        fprintf(vtkFile, "%s", buf.toLatin1().data());
-        buf.clear();
-        if(i % 50 == 0)
-        {
-          fprintf(vtkFile, "\n");
-        }
+      };
+      ImportExport::ChunkedAsciiWriter writer(vtkFile);
+      if(writer.write(nT, formatValues) < 0)
+      {
+        return -1;
       }
     }
   }
+  return 0;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 template <typename T>
-void writeCellVectorData(DataContainer::Pointer dc, const QString& faceAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, bool writeConformalMesh,
-                         const QString& vtkAttributeType, FILE* vtkFile, int nT)
+int writeCellVectorData(DataContainer::Pointer dc, const QString& faceAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, bool writeConformalMesh,
+                        const QString& vtkAttributeType, FILE* vtkFile, int nT)
 {
   IDataArray::Pointer data = dc->getAttributeMatrix(faceAttributeMatrixName)->getAttributeArray(dataName);
-  QString buf;
-  QTextStream ss(&buf);
   if(nullptr != data.get())
   {
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "%s %s %s\n", vtkAttributeType.toLatin1().data(), dataName.toLatin1().data(), dataType.toLatin1().data());
-    for(int i = 0; i < nT; ++i)
+    if(writeBinaryData)
     {
-      T s0 = 0x00;
-      T s1 = 0x00;
-      T s2 = 0x00;
-      if(writeBinaryData)
+      ImportExport::BinaryBlockWriter writer(vtkFile);
+      if(writeConformalMesh)
       {
-        s0 = static_cast<T>(m[i * 3 + 0]);
-        s1 = static_cast<T>(m[i * 3 + 1]);
-        s2 = static_cast<T>(m[i * 3 + 2]);
-        SIMPLib::Endian::FromSystemToBig::convert(s0);
-        SIMPLib::Endian::FromSystemToBig::convert(s1);
-        SIMPLib::Endian::FromSystemToBig::convert(s2);
-        fwrite(&s0, sizeof(T), 1, vtkFile);
-        fwrite(&s1, sizeof(T), 1, vtkFile);
-        fwrite(&s2, sizeof(T), 1, vtkFile);
-        if(!writeConformalMesh)
-        {
-          fwrite(&s0, sizeof(T), 1, vtkFile);
-          fwrite(&s1, sizeof(T), 1, vtkFile);
-          fwrite(&s2, sizeof(T), 1, vtkFile);
-        }
+        writer.write(m, static_cast<size_t>(nT) * 3);
       }
       else
       {
-        ss << m[i * 3 + 0] << " " << m[i * 3 + 1] << " " << m[i * 3 + 2] << " ";
-        if(!writeConformalMesh)
+        writer.writeGenerated<T>(nT, 6, [m](size_t i, T* out) -> size_t {
+          for(size_t c = 0; c < 3; c++)
+          {
+            out[c] = m[i * 3 + c];
+            out[c + 3] = m[i * 3 + c];
+          }
+          return 6;
+        });
+      }
+      if(!writer.flush())
+      {
+        return -1;
+      }
+    }
+    else
+    {
+      auto formatVectors = [m, writeConformalMesh](size_t start, size_t end, ImportExport::AsciiChunk& chunk) {
+        QString buf;
+        QTextStream ss(&buf);
+        for(size_t i = start; i < end; ++i)
         {
           ss << m[i * 3 + 0] << " " << m[i * 3 + 1] << " " << m[i * 3 + 2] << " ";
+          if(!writeConformalMesh)
+          {
+            ss << m[i * 3 + 0] << " " << m[i * 3 + 1] << " " << m[i * 3 + 2] << " ";
+          }
+          chunk.append(buf.toLatin1().constData());
+          chunk.append(' ');
+          buf.clear();
+          if(i % 25 == 0)
+          {
+            chunk.append('\n');
+          }
         }
-        fprintf(vtkFile, "%s ", buf.toLatin1().data());
-        buf.clear();
-        if(i % 25 == 0)
-        {
-          fprintf(vtkFile, "\n");
-        }
+      };
+      ImportExport::ChunkedAsciiWriter writer(vtkFile);
+      if(writer.write(nT, formatVectors) < 0)
+      {
+        return -1;
       }
     }
   }
+  return 0;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 template <typename T>
-void writeCellNormalData(DataContainer::Pointer dc, const QString& faceAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, bool writeConformalMesh,
-                         FILE* vtkFile, int nT)
+int writeCellNormalData(DataContainer::Pointer dc, const QString& faceAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, bool writeConformalMesh,
+                        FILE* vtkFile, int nT)
 {
   IDataArray::Pointer data = dc->getAttributeMatrix(faceAttributeMatrixName)->getAttributeArray(dataName);
-  QString buf;
-  QTextStream ss(&buf);
   if(nullptr != data.get())
   {
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "NORMALS %s %s\n", dataName.toLatin1().data(), dataType.toLatin1().data());
-    for(int i = 0; i < nT; ++i)
+    if(writeBinaryData)
     {
-      T s0 = 0x00;
-      T s1 = 0x00;
-      T s2 = 0x00;
-      if(writeBinaryData)
+      ImportExport::BinaryBlockWriter writer(vtkFile);
+      if(writeConformalMesh)
       {
-        s0 = static_cast<T>(m[i * 3 + 0]);
-        s1 = static_cast<T>(m[i * 3 + 1]);
-        s2 = static_cast<T>(m[i * 3 + 2]);
-        SIMPLib::Endian::FromSystemToBig::convert(s0);
-        SIMPLib::Endian::FromSystemToBig::convert(s1);
-        SIMPLib::Endian::FromSystemToBig::convert(s2);
-        fwrite(&s0, sizeof(T), 1, vtkFile);
-        fwrite(&s1, sizeof(T), 1, vtkFile);
-        fwrite(&s2, sizeof(T), 1, vtkFile);
-        if(!writeConformalMesh)
-        {
-          s0 = static_cast<T>(m[i * 3 + 0]) * -1.0;
-          s1 = static_cast<T>(m[i * 3 + 1]) * -1.0;
-          s2 = static_cast<T>(m[i * 3 + 2]) * -1.0;
-          SIMPLib::Endian::FromSystemToBig::convert(s0);
-          SIMPLib::Endian::FromSystemToBig::convert(s1);
-          SIMPLib::Endian::FromSystemToBig::convert(s2);
-          fwrite(&s0, sizeof(T), 1, vtkFile);
-          fwrite(&s1, sizeof(T), 1, vtkFile);
-          fwrite(&s2, sizeof(T), 1, vtkFile);
-        }
+        writer.write(m, static_cast<size_t>(nT) * 3);
       }
       else
       {
-
-        ss << m[i * 3 + 0] << " " << m[i * 3 + 1] << " " << m[i * 3 + 2] << " ";
-        if(!writeConformalMesh)
-        {
-          ss << -1.0 * m[i * 3 + 0] << " " << -1.0 * m[i * 3 + 1] << " " << -1.0 * m[i * 3 + 2] << " ";
-        }
-        fprintf(vtkFile, "%s ", buf.toLatin1().data());
-        buf.clear();
-        if(i % 50 == 0)
+        // The back face gets the flipped normal
+        writer.writeGenerated<T>(nT, 6, [m](size_t i, T* out) -> size_t {
+          for(size_t c = 0; c < 3; c++)
+          {
+            out[c] = m[i * 3 + c];
+            out[c + 3] = static_cast<T>(m[i * 3 + c] * -1.0);
+          }
+          return 6;
+        });
+      }
+      if(!writer.flush())
+      {
+        return -1;
+      }
+    }
+    else
+    {
+      auto formatNormals = [m, writeConformalMesh](size_t start, size_t end, ImportExport::AsciiChunk& chunk) {
+        QString buf;
+        QTextStream ss(&buf);
+        for(size_t i = start; i < end; ++i)
         {
-          fprintf(vtkFile, "\n");
+          ss << m[i * 3 + 0] << " " << m[i * 3 + 1] << " " << m[i * 3 + 2] << " ";
+          if(!writeConformalMesh)
+          {
+            ss << -1.0 * m[i * 3 + 0] << " " << -1.0 * m[i * 3 + 1] << " " << -1.0 * m[i * 3 + 2] << " ";
+          }
+          chunk.append(buf.toLatin1().constData());
+          chunk.append(' ');
+          buf.clear();
+          if(i % 50 == 0)
+          {
+            chunk.append('\n');
+          }
         }
+      };
+      ImportExport::ChunkedAsciiWriter writer(vtkFile);
+      if(writer.write(nT, formatNormals) < 0)
+      {
+        return -1;
       }
     }
   }
+  return 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -729,7 +867,6 @@ int SurfaceMeshToVtk::writeCellData(FILE* vtkFile)
   int64_t nT = triangleGeom->getNumberOfTris();
 
   int numTriangles = nT;
-  int swapped;
   if(!m_WriteConformalMesh)
   {
     numTriangles = nT * 2;
@@ -742,29 +879,46 @@ int SurfaceMeshToVtk::writeCellData(FILE* vtkFile)
   // Write the FeatureId Data to the file
   fprintf(vtkFile, "SCALARS FeatureID int 1\n");
   fprintf(vtkFile, "LOOKUP_TABLE default\n");
-  for(int i = 0; i < nT; ++i)
+  int32_t* faceLabels = m_SurfaceMeshFaceLabels;
+  bool writeConformalMesh = m_WriteConformalMesh;
+  if(m_WriteBinaryFile)
   {
-    // FaceArray::Face_t& t = triangles[i]; // Get the current Node
-
-    if(m_WriteBinaryFile)
+    ImportExport::BinaryBlockWriter writer(vtkFile);
+    if(writeConformalMesh)
     {
-      swapped = m_SurfaceMeshFaceLabels[i * 2];
-      SIMPLib::Endian::FromSystemToBig::convert(swapped);
-      fwrite(&swapped, sizeof(int), 1, vtkFile);
-      if(!m_WriteConformalMesh)
-      {
-        swapped = m_SurfaceMeshFaceLabels[i * 2 + 1];
-        SIMPLib::Endian::FromSystemToBig::convert(swapped);
-        fwrite(&swapped, sizeof(int), 1, vtkFile);
-      }
+      writer.writeGenerated<int32_t>(nT, 1, [faceLabels](size_t i, int32_t* out) -> size_t {
+        *out = faceLabels[i * 2];
+        return 1;
+      });
     }
     else
     {
-      fprintf(vtkFile, "%d\n", m_SurfaceMeshFaceLabels[i * 2]);
-      if(!m_WriteConformalMesh)
+      // Both labels of every face in order is exactly the face labels array
+      writer.write(faceLabels, static_cast<size_t>(nT) * 2);
+    }
+    if(!writer.flush())
+    {
+      return -1;
+    }
+  }
+  else
+  {
+    auto formatFaceLabels = [faceLabels, writeConformalMesh](size_t start, size_t end, ImportExport::AsciiChunk& chunk) {
+      for(size_t i = start; i < end; ++i)
       {
-        fprintf(vtkFile, "%d\n", m_SurfaceMeshFaceLabels[i * 2 + 1]);
+        chunk.appendInt(faceLabels[i * 2]);
+        chunk.append('\n');
+        if(!writeConformalMesh)
+        {
+          chunk.appendInt(faceLabels[i * 2 + 1]);
+          chunk.append('\n');
+        }
       }
+    };
+    ImportExport::ChunkedAsciiWriter writer(vtkFile);
+    if(writer.write(nT, formatFaceLabels) < 0)
+    {
+      return -1;
     }
   }
 
@@ -800,27 +954,178 @@ int SurfaceMeshToVtk::writeCellData(FILE* vtkFile)
 
   QString attrMatName = m_SurfaceMeshFaceLabelsArrayPath.getAttributeMatrixName();
 
-  writeCellScalarData<int32_t>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshFeatureFaceId, "int", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, nT);
+  err = writeCellScalarData<int32_t>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshFeatureFaceId, "int", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, nT);
+  if(err < 0)
+  {
+    return err;
+  }
 
-  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature1, "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, nT);
+  err = writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature1, "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, nT);
+  if(err < 0)
+  {
+    return err;
+  }
 
-  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature2, "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, nT);
+  err = writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature2, "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, nT);
+  if(err < 0)
+  {
+    return err;
+  }
 
-  writeCellVectorData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalDirection1, "double", m_WriteBinaryFile, m_WriteConformalMesh, "VECTORS", vtkFile, nT);
+  err = writeCellVectorData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalDirection1, "double", m_WriteBinaryFile, m_WriteConformalMesh, "VECTORS", vtkFile, nT);
+  if(err < 0)
+  {
+    return err;
+  }
 
-  writeCellVectorData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalDirection2, "double", m_WriteBinaryFile, m_WriteConformalMesh, "VECTORS", vtkFile, nT);
+  err = writeCellVectorData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalDirection2, "double", m_WriteBinaryFile, m_WriteConformalMesh, "VECTORS", vtkFile, nT);
+  if(err < 0)
+  {
+    return err;
+  }
 
-  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshGaussianCurvatures, "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, nT);
+  err = writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshGaussianCurvatures, "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, nT);
+  if(err < 0)
+  {
+    return err;
+  }
 
-  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshMeanCurvatures, "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, nT);
+  err = writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshMeanCurvatures, "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, nT);
+  if(err < 0)
+  {
+    return err;
+  }
 
-  writeCellNormalData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshFaceNormals, "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, nT);
+  err = writeCellNormalData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshFaceNormals, "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, nT);
+  if(err < 0)
+  {
+    return err;
+  }
 
-  writeCellNormalData<double>(sm, attrMatName, "Goldfeather_Triangle_Normals", "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, nT);
+  err = writeCellNormalData<double>(sm, attrMatName, "Goldfeather_Triangle_Normals", "double", m_WriteBinaryFile, m_WriteConformalMesh, vtkFile, nT);
+  if(err < 0)
+  {
+    return err;
+  }
 
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+void addXmlAttributeArray(ImportExport::VtkXmlAppendedWriter& xmlWriter, ImportExport::VtkXmlAppendedWriter::Section section, DataContainer::Pointer dc, const QString& attributeMatrixName,
+                          const QString& dataName, int32_t numComps, size_t numTuples, bool duplicate, bool negateDuplicate)
+{
+  IDataArray::Pointer data = dc->getAttributeMatrix(attributeMatrixName)->getAttributeArray(dataName);
+  if(nullptr == data.get())
+  {
+    return;
+  }
+  const T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
+  size_t numValues = numTuples * numComps * (duplicate ? 2 : 1);
+  xmlWriter.addArray<T>(section, dataName.toStdString(), numComps, numValues, [data, m, numComps, numTuples, duplicate, negateDuplicate](ImportExport::BinaryBlockWriter& writer) {
+    if(!duplicate)
+    {
+      writer.write(m, numTuples * numComps);
+      return;
+    }
+    writer.writeGenerated<T>(numTuples, 2 * numComps, [m, numComps, negateDuplicate](size_t i, T* out) -> size_t {
+      for(int32_t c = 0; c < numComps; c++)
+      {
+        out[c] = m[i * numComps + c];
+        out[c + numComps] = negateDuplicate ? static_cast<T>(m[i * numComps + c] * -1.0) : m[i * numComps + c];
+      }
+      return 2 * numComps;
+    });
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SurfaceMeshToVtk::writeXmlPolyData(FILE* vtkFile)
+{
+  using Section = ImportExport::VtkXmlAppendedWriter::Section;
+
+  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(m_SurfaceMeshFaceLabelsArrayPath.getDataContainerName());
+  TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
+  float* nodes = triangleGeom->getVertexPointer(0);
+  MeshIndexType* triangles = triangleGeom->getTriPointer(0);
+  size_t numNodes = triangleGeom->getNumberOfVertices();
+  size_t numTriangles = triangleGeom->getNumberOfTris();
+  bool writeConformalMesh = m_WriteConformalMesh;
+  size_t numPolys = writeConformalMesh ? numTriangles : numTriangles * 2;
+  int8_t* nodeType = m_SurfaceMeshNodeType;
+  int32_t* faceLabels = m_SurfaceMeshFaceLabels;
+
+  // Every vertex is written, unlike the legacy format, so the connectivity can use the
+  // vertex indices as they are
+  ImportExport::VtkXmlAppendedWriter xmlWriter;
+  xmlWriter.addArray<float>(Section::Points, "Points", 3, numNodes * 3, [nodes, numNodes](ImportExport::BinaryBlockWriter& writer) { writer.write(nodes, numNodes * 3); });
+  xmlWriter.addArray<int64_t>(Section::Polys, "connectivity", 1, numPolys * 3, [triangles, numTriangles, writeConformalMesh](ImportExport::BinaryBlockWriter& writer) {
+    writer.writeGenerated<int64_t>(numTriangles, 6, [triangles, writeConformalMesh](size_t j, int64_t* out) -> size_t {
+      out[0] = static_cast<int64_t>(triangles[j * 3]);
+      out[1] = static_cast<int64_t>(triangles[j * 3 + 1]);
+      out[2] = static_cast<int64_t>(triangles[j * 3 + 2]);
+      if(writeConformalMesh)
+      {
+        return 3;
+      }
+      out[3] = out[2];
+      out[4] = out[1];
+      out[5] = out[0];
+      return 6;
+    });
+  });
+  xmlWriter.addArray<int64_t>(Section::Polys, "offsets", 1, numPolys, [numPolys](ImportExport::BinaryBlockWriter& writer) {
+    writer.writeGenerated<int64_t>(numPolys, 1, [](size_t i, int64_t* out) -> size_t {
+      *out = static_cast<int64_t>(i + 1) * 3;
+      return 1;
+    });
+  });
+  xmlWriter.addArray<int8_t>(Section::PointData, "Node_Type", 1, numNodes, [nodeType, numNodes](ImportExport::BinaryBlockWriter& writer) { writer.write(nodeType, numNodes); });
+  xmlWriter.addArray<int32_t>(Section::CellData, "FeatureID", 1, numPolys, [faceLabels, numTriangles, writeConformalMesh](ImportExport::BinaryBlockWriter& writer) {
+    if(writeConformalMesh)
+    {
+      writer.writeGenerated<int32_t>(numTriangles, 1, [faceLabels](size_t i, int32_t* out) -> size_t {
+        *out = faceLabels[i * 2];
+        return 1;
+      });
+    }
+    else
+    {
+      writer.write(faceLabels, numTriangles * 2);
+    }
+  });
+
+  QString vertexAttrMatName = m_SurfaceMeshNodeTypeArrayPath.getAttributeMatrixName();
+  addXmlAttributeArray<double>(xmlWriter, Section::PointData, sm, vertexAttrMatName, "Principal_Direction_1", 3, numNodes, false, false);
+  addXmlAttributeArray<double>(xmlWriter, Section::PointData, sm, vertexAttrMatName, "Principal_Direction_2", 3, numNodes, false, false);
+  addXmlAttributeArray<double>(xmlWriter, Section::PointData, sm, vertexAttrMatName, "Principal_Curvature_1", 1, numNodes, false, false);
+  addXmlAttributeArray<double>(xmlWriter, Section::PointData, sm, vertexAttrMatName, "Principal_Curvature_2", 1, numNodes, false, false);
+  addXmlAttributeArray<double>(xmlWriter, Section::PointData, sm, vertexAttrMatName, SIMPL::VertexData::SurfaceMeshNodeNormals, 3, numNodes, false, false);
+
+  QString faceAttrMatName = m_SurfaceMeshFaceLabelsArrayPath.getAttributeMatrixName();
+  bool duplicate = !writeConformalMesh;
+  addXmlAttributeArray<int32_t>(xmlWriter, Section::CellData, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshFeatureFaceId, 1, numTriangles, duplicate, false);
+  addXmlAttributeArray<double>(xmlWriter, Section::CellData, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature1, 1, numTriangles, duplicate, false);
+  addXmlAttributeArray<double>(xmlWriter, Section::CellData, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature2, 1, numTriangles, duplicate, false);
+  addXmlAttributeArray<double>(xmlWriter, Section::CellData, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshPrincipalDirection1, 3, numTriangles, duplicate, false);
+  addXmlAttributeArray<double>(xmlWriter, Section::CellData, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshPrincipalDirection2, 3, numTriangles, duplicate, false);
+  addXmlAttributeArray<double>(xmlWriter, Section::CellData, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshGaussianCurvatures, 1, numTriangles, duplicate, false);
+  addXmlAttributeArray<double>(xmlWriter, Section::CellData, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshMeanCurvatures, 1, numTriangles, duplicate, false);
+  addXmlAttributeArray<double>(xmlWriter, Section::CellData, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshFaceNormals, 3, numTriangles, duplicate, true);
+  addXmlAttributeArray<double>(xmlWriter, Section::CellData, sm, faceAttrMatName, "Goldfeather_Triangle_Normals", 3, numTriangles, duplicate, true);
+
+  if(!xmlWriter.writePolyData(vtkFile, numNodes, numPolys))
+  {
+    return -1;
+  }
+  return 0;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
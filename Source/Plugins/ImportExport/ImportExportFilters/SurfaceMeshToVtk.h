@@ -268,6 +268,14 @@ protected:
    */
   int writePointData(FILE* vtkFile);
 
+  /**
+   * @brief writeXmlPolyData Writes the mesh and its arrays as a VTK XML PolyData
+   * file with raw appended data
+   * @param vtkFile
+   * @return
+   */
+  int writeXmlPolyData(FILE* vtkFile);
+
 private:
   std::weak_ptr<DataArray<int32_t>> m_SurfaceMeshFaceLabelsPtr;
   int32_t* m_SurfaceMeshFaceLabels = nullptr;
@@ -36,8 +36,6 @@
 
 #include "VtkRectilinearGridWriter.h"
 
-#include <sstream>
-
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
@@ -61,6 +59,9 @@
 #include "SIMPLib/VTKUtils/VTKUtil.hpp"
 
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/BinaryBlockWriter.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedAsciiWriter.h"
+#include "ImportExport/ImportExportFilters/util/VtkXmlAppendedWriter.h"
 #include "ImportExport/ImportExportVersion.h"
 
 #define LD_CAST(arg) static_cast<long int>(arg)
@@ -113,21 +114,16 @@ template <typename T> int WriteCoords(FILE* f, const char* axis, const char* typ
 #endif
   if(binary)
   {
-    T* data = new T[npoints];
-    T d;
-    for(int idx = 0; idx < npoints; ++idx)
-    {
-      d = idx * step + min;
-      SIMPLib::Endian::FromSystemToBig::convert(d);
-      data[idx] = d;
-    }
-    size_t totalWritten = fwrite(static_cast<void*>(data), sizeof(T), static_cast<size_t>(npoints), f);
+    ImportExport::BinaryBlockWriter writer(f);
+    writer.writeGenerated<T>(static_cast<size_t>(npoints), 1, [min, step](size_t idx, T* out) -> size_t {
+      *out = idx * step + min;
+      return 1;
+    });
+    bool good = writer.flush();
     fprintf(f, "\n"); // Write a newline character at the end of the coordinates
-    delete[] data;
-    if(totalWritten != static_cast<size_t>(npoints))
+    if(!good)
     {
       qDebug() << "Error Writing Binary VTK Data into file ";
-      fclose(f);
       return -1;
     }
   }
@@ -170,53 +166,66 @@ template <typename T> void WriteDataArray(AbstractFilter* filter, FILE* f, IData
     dName = dName.replace(" ", "_");
 
     QString vtkTypeString = VTKUtil::TypeForPrimitive<T>(val[0]);
-    bool useIntCast = false;
-    if(vtkTypeString.compare("unsigned_char") == 0 || vtkTypeString.compare("char") == 0)
-    {
-      useIntCast = true;
-    }
 
     fprintf(f, "SCALARS %s %s %d\n", dName.toLatin1().data(), vtkTypeString.toLatin1().data(), numComps);
     fprintf(f, "LOOKUP_TABLE default\n");
     if(writeBinary)
     {
-      if(BIGENDIAN == 0)
-      {
-        array->byteSwapElements();
-      }
-      size_t totalWritten = fwrite(val, array->getTypeSize(), totalElements, f);
-      if(totalWritten != totalElements)
+      // The values are swapped in the writer's staging buffer so the array itself is never touched
+      ImportExport::BinaryBlockWriter writer(f);
+      writer.write(val, totalElements);
+      if(!writer.flush())
       {
+        QString ss = QObject::tr("Error writing binary data for array '%1'").arg(iDataPtr->getName());
+        filter->setErrorCondition(-2031003, ss);
+        return;
       }
       fprintf(f, "\n");
-      if(BIGENDIAN == 0)
-      {
-        array->byteSwapElements();
-      }
     }
     else
     {
-      std::stringstream ss;
-      for(size_t i = 0; i < totalElements; i++)
-      {
-        if(i % 20 == 0 && i > 0)
+      // appendValue() always writes char types as numbers which is what the VTK reader expects
+      auto formatValues = [val](size_t start, size_t end, ImportExport::AsciiChunk& chunk) {
+        for(size_t i = start; i < end; i++)
         {
-          ss << "\n";
-        }
-        if(useIntCast)
-        {
-          ss << " " << static_cast<int>(val[i]);
-        }
-        else
-        {
-          ss << " " << val[i];
+          if(i % 20 == 0 && i > 0)
+          {
+            chunk.append('\n');
+          }
+          chunk.append(' ');
+          chunk.appendValue(val[i]);
         }
+      };
+      ImportExport::ChunkedAsciiWriter writer(f);
+      if(writer.write(totalElements, formatValues) < 0)
+      {
+        QString ss = QObject::tr("Error writing ASCII data for array '%1'").arg(iDataPtr->getName());
+        filter->setErrorCondition(-2031005, ss);
+        return;
       }
-      ss << "\n";
-      fprintf(f, "%s", ss.str().c_str());
+      fprintf(f, "\n");
     }
   }
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T> void AddXmlDataArray(AbstractFilter* filter, ImportExport::VtkXmlAppendedWriter* xmlWriter, IDataArray::Pointer iDataPtr)
+{
+  typename DataArray<T>::Pointer array = std::dynamic_pointer_cast<DataArray<T>>(iDataPtr);
+  if(nullptr == array.get())
+  {
+    return;
+  }
+  QString dName = array->getName();
+  dName = dName.replace(" ", "_");
+  xmlWriter->addArray<T>(ImportExport::VtkXmlAppendedWriter::Section::CellData, dName.toStdString(), array->getNumberOfComponents(), array->getSize(), [filter, array](ImportExport::BinaryBlockWriter& writer) {
+    QString ss = QObject::tr("Writing Cell Data %1").arg(array->getName());
+    filter->notifyStatusMessage(ss);
+    writer.write(array->getPointer(0), array->getSize());
+  });
+}
 } // namespace Detail
 
 // -----------------------------------------------------------------------------
@@ -240,7 +249,7 @@ void VtkRectilinearGridWriter::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
 
-  parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Output File", OutputFile, FilterParameter::Parameter, VtkRectilinearGridWriter, "*.vtk", "VTK Rectilinear Grid"));
+  parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Output File", OutputFile, FilterParameter::Parameter, VtkRectilinearGridWriter, "*.vtk *.vti", "VTK Rectilinear Grid"));
   parameters.push_back(SIMPL_NEW_BOOL_FP("Write Binary File", WriteBinaryFile, FilterParameter::Parameter, VtkRectilinearGridWriter));
 
   {
@@ -366,6 +375,13 @@ void VtkRectilinearGridWriter::execute()
     return;
   }
 
+  // A .vti extension selects the VTK XML ImageData format with raw appended arrays
+  if(fi.suffix().compare("vti", Qt::CaseInsensitive) == 0)
+  {
+    writeXmlImageData(f, image);
+    return;
+  }
+
   // write the header
   Detail::WriteVTKHeader<ImageGeom>(f, m, getWriteBinaryFile());
 
@@ -401,6 +417,10 @@ void VtkRectilinearGridWriter::execute()
     IDataArray::Pointer iDataPtr = getDataContainerArray()->getPrereqIDataArrayFromPath(this, arrayPath);
 
     EXECUTE_FUNCTION_TEMPLATE(this, Detail::WriteDataArray, iDataPtr, this, f, iDataPtr, m_WriteBinaryFile);
+    if(getErrorCode() < 0)
+    {
+      break;
+    }
 
 #if 0
     QString className = iDataPtr->getNameOfClass();
@@ -433,6 +453,35 @@ void VtkRectilinearGridWriter::execute()
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkRectilinearGridWriter::writeXmlImageData(FILE* f, const ImageGeom::Pointer& image)
+{
+  SizeVec3Type dims = image->getDimensions();
+  FloatVec3Type res = image->getSpacing();
+  FloatVec3Type origin = image->getOrigin();
+
+  // Match the point coordinates of the legacy writer which puts the cell centers at origin + i * res
+  size_t cellDims[3] = {dims[0], dims[1], dims[2]};
+  float pointOrigin[3] = {origin[0] - res[0] * 0.5f, origin[1] - res[1] * 0.5f, origin[2] - res[2] * 0.5f};
+  float spacing[3] = {res[0], res[1], res[2]};
+
+  ImportExport::VtkXmlAppendedWriter xmlWriter;
+  QVector<DataArrayPath> dataPaths = getSelectedDataArrayPaths();
+  foreach(const DataArrayPath arrayPath, dataPaths)
+  {
+    IDataArray::Pointer iDataPtr = getDataContainerArray()->getPrereqIDataArrayFromPath(this, arrayPath);
+    EXECUTE_FUNCTION_TEMPLATE(this, Detail::AddXmlDataArray, iDataPtr, this, &xmlWriter, iDataPtr);
+  }
+
+  if(!xmlWriter.writeImageData(f, cellDims, pointOrigin, spacing))
+  {
+    QString ss = QObject::tr("Error writing vti file '%1'").arg(m_OutputFile);
+    setErrorCondition(-2031004, ss);
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -43,6 +43,7 @@
 #include "SIMPLib/DataContainers/DataArrayPath.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/VTKUtils/VTKWriterMacros.h"
 
@@ -276,6 +277,11 @@ protected:
    */
   void initialize();
 
+  /**
+   * @brief Writes the selected arrays as a VTK XML ImageData file with raw appended data
+   */
+  void writeXmlImageData(FILE* f, const ImageGeom::Pointer& image);
+
 private:
   QString m_OutputFile = {};
   bool m_WriteBinaryFile = {};
@@ -0,0 +1,175 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ImportExport/ImportExportFilters/util/BinaryBlockWriter.h"
+
+#if defined(_MSC_VER)
+#include <cstdlib>
+#endif
+
+#include "SIMPLib/SIMPLib.h"
+
+namespace
+{
+#if defined(_MSC_VER)
+inline uint16_t ByteSwap16(uint16_t v)
+{
+  return _byteswap_ushort(v);
+}
+inline uint32_t ByteSwap32(uint32_t v)
+{
+  return _byteswap_ulong(v);
+}
+inline uint64_t ByteSwap64(uint64_t v)
+{
+  return _byteswap_uint64(v);
+}
+#else
+inline uint16_t ByteSwap16(uint16_t v)
+{
+  return __builtin_bswap16(v);
+}
+inline uint32_t ByteSwap32(uint32_t v)
+{
+  return __builtin_bswap32(v);
+}
+inline uint64_t ByteSwap64(uint64_t v)
+{
+  return __builtin_bswap64(v);
+}
+#endif
+
+// The memcpy() calls keep the loads and stores free of alignment and aliasing
+// problems; the compiler turns each loop into vector shuffles.
+template <typename U, U (*Swap)(U)>
+void SwapBlock(uint8_t* data, size_t count)
+{
+  for(size_t i = 0; i < count; i++)
+  {
+    U v;
+    std::memcpy(&v, data + i * sizeof(U), sizeof(U));
+    v = Swap(v);
+    std::memcpy(data + i * sizeof(U), &v, sizeof(U));
+  }
+}
+} // namespace
+
+using namespace ImportExport;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BinaryBlockWriter::BinaryBlockWriter(FILE* f, ByteOrder byteOrder, size_t bufferSize)
+: m_File(f)
+, m_SwapBytes(byteOrder != SystemByteOrder())
+, m_Buffer(bufferSize < 8 ? 8 : bufferSize)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BinaryBlockWriter::~BinaryBlockWriter()
+{
+  flush();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BinaryBlockWriter::ByteOrder BinaryBlockWriter::SystemByteOrder()
+{
+#ifdef CMP_WORDS_BIGENDIAN
+  return ByteOrder::BigEndian;
+#else
+  return ByteOrder::LittleEndian;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BinaryBlockWriter::SwapBytes(uint8_t* data, size_t count, size_t typeSize)
+{
+  switch(typeSize)
+  {
+  case 2:
+    SwapBlock<uint16_t, ByteSwap16>(data, count);
+    break;
+  case 4:
+    SwapBlock<uint32_t, ByteSwap32>(data, count);
+    break;
+  case 8:
+    SwapBlock<uint64_t, ByteSwap64>(data, count);
+    break;
+  default:
+    break;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BinaryBlockWriter::flush()
+{
+  if(m_Size == 0)
+  {
+    return m_Good;
+  }
+  size_t written = fwrite(m_Buffer.data(), 1, m_Size, m_File);
+  m_BytesWritten += written;
+  if(written != m_Size)
+  {
+    m_Good = false;
+  }
+  m_Size = 0;
+  return m_Good;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BinaryBlockWriter::good() const
+{
+  return m_Good;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t BinaryBlockWriter::getBytesWritten() const
+{
+  return m_BytesWritten;
+}
@@ -0,0 +1,191 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace ImportExport
+{
+
+/**
+ * @brief The BinaryBlockWriter class stages binary values in a large reusable buffer and
+ * writes them to a FILE* with a single fwrite() per buffer. Byte swapping, when the requested
+ * byte order differs from the host, is done on whole blocks in the staging buffer so the
+ * swap loop is vectorized by the compiler and the source arrays are never modified.
+ *
+ * Callers that interleave fprintf() headers with binary data must call flush() before
+ * writing any text to the same FILE*.
+ */
+class BinaryBlockWriter
+{
+public:
+  enum class ByteOrder : int32_t
+  {
+    BigEndian = 0,
+    LittleEndian = 1
+  };
+
+  static const size_t k_DefaultBufferSize = 4 * 1024 * 1024;
+
+  /**
+   * @brief BinaryBlockWriter
+   * @param f Open file to write into. The writer does not take ownership of the file.
+   * @param byteOrder Byte order of the values in the file. Legacy VTK files are always big endian.
+   * @param bufferSize Size of the staging buffer in bytes
+   */
+  explicit BinaryBlockWriter(FILE* f, ByteOrder byteOrder = ByteOrder::BigEndian, size_t bufferSize = k_DefaultBufferSize);
+
+  /**
+   * @brief Flushes any staged data
+   */
+  ~BinaryBlockWriter();
+
+  /**
+   * @brief Returns the byte order of the host
+   */
+  static ByteOrder SystemByteOrder();
+
+  /**
+   * @brief Reverses the bytes of each of the count values of size typeSize stored at data
+   */
+  static void SwapBytes(uint8_t* data, size_t count, size_t typeSize);
+
+  /**
+   * @brief Stages count contiguous values
+   */
+  template <typename T>
+  void write(const T* values, size_t count)
+  {
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(values);
+    while(count > 0)
+    {
+      size_t room = (m_Buffer.size() - m_Size) / sizeof(T);
+      if(room == 0)
+      {
+        flush();
+        room = m_Buffer.size() / sizeof(T);
+      }
+      size_t n = count < room ? count : room;
+      uint8_t* dst = m_Buffer.data() + m_Size;
+      std::memcpy(dst, src, n * sizeof(T));
+      if(m_SwapBytes && sizeof(T) > 1)
+      {
+        SwapBytes(dst, n, sizeof(T));
+      }
+      m_Size += n * sizeof(T);
+      src += n * sizeof(T);
+      count -= n;
+    }
+  }
+
+  /**
+   * @brief Stages a single value
+   */
+  template <typename T>
+  void writeValue(T value)
+  {
+    if(m_Size + sizeof(T) > m_Buffer.size())
+    {
+      flush();
+    }
+    uint8_t* dst = m_Buffer.data() + m_Size;
+    std::memcpy(dst, &value, sizeof(T));
+    if(m_SwapBytes && sizeof(T) > 1)
+    {
+      SwapBytes(dst, 1, sizeof(T));
+    }
+    m_Size += sizeof(T);
+  }
+
+  /**
+   * @brief Stages the values produced by a generator. The generator is called as
+   * generator(i, T* out) for i in [0, count), writes at most valuesPerItem (<= 1024) values
+   * into out and returns how many it wrote, so items can be skipped by returning 0. Items are
+   * produced into a small local block that is then staged and swapped with write().
+   */
+  template <typename T, typename Generator>
+  void writeGenerated(size_t count, size_t valuesPerItem, Generator generator)
+  {
+    static const size_t k_BlockValues = 1024;
+    T block[k_BlockValues];
+    const size_t itemsPerBlock = valuesPerItem < k_BlockValues ? k_BlockValues / valuesPerItem : 1;
+    for(size_t i = 0; i < count; i += itemsPerBlock)
+    {
+      size_t end = (count - i) < itemsPerBlock ? count : i + itemsPerBlock;
+      T* out = block;
+      for(size_t item = i; item < end; item++)
+      {
+        out += generator(item, out);
+      }
+      write(block, static_cast<size_t>(out - block));
+    }
+  }
+
+  /**
+   * @brief Writes all staged data to the file
+   * @return false if the file could not take all of the data
+   */
+  bool flush();
+
+  /**
+   * @brief Returns false once any write to the file has failed
+   */
+  bool good() const;
+
+  /**
+   * @brief Returns the number of bytes handed to the file so far
+   */
+  uint64_t getBytesWritten() const;
+
+private:
+  FILE* m_File = nullptr;
+  bool m_SwapBytes = false;
+  bool m_Good = true;
+  std::vector<uint8_t> m_Buffer;
+  size_t m_Size = 0;
+  uint64_t m_BytesWritten = 0;
+
+public:
+  BinaryBlockWriter(const BinaryBlockWriter&) = delete;            // Copy Constructor Not Implemented
+  BinaryBlockWriter(BinaryBlockWriter&&) = delete;                 // Move Constructor Not Implemented
+  BinaryBlockWriter& operator=(const BinaryBlockWriter&) = delete; // Copy Assignment Not Implemented
+  BinaryBlockWriter& operator=(BinaryBlockWriter&&) = delete;      // Move Assignment Not Implemented
+};
+
+} // namespace ImportExport
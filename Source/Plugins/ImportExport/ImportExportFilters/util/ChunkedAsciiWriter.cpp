@@ -0,0 +1,214 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ImportExport/ImportExportFilters/util/ChunkedAsciiWriter.h"
+
+#include <cstdarg>
+#include <cstring>
+#include <thread>
+
+using namespace ImportExport;
+
+namespace
+{
+// Large enough for any "%f" formatted float and for most "%g" / "%f" formatted doubles
+const size_t k_StackBufferSize = 64;
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AsciiChunk::append(const char* str)
+{
+  m_Buffer.append(str, std::strlen(str));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AsciiChunk::appendUInt(uint64_t value)
+{
+  char digits[24];
+  char* end = digits + sizeof(digits);
+  char* pos = end;
+  do
+  {
+    *--pos = static_cast<char>('0' + (value % 10));
+    value /= 10;
+  } while(value != 0);
+  m_Buffer.append(pos, static_cast<size_t>(end - pos));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AsciiChunk::appendInt(int64_t value)
+{
+  if(value < 0)
+  {
+    m_Buffer.push_back('-');
+    // Negate in unsigned arithmetic so that INT64_MIN does not overflow
+    appendUInt(0 - static_cast<uint64_t>(value));
+    return;
+  }
+  appendUInt(static_cast<uint64_t>(value));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AsciiChunk::appendFixed(double value)
+{
+  appendFormat("%f", value);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AsciiChunk::appendGeneral(double value)
+{
+  appendFormat("%g", value);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AsciiChunk::appendFormat(const char* format, ...)
+{
+  char stackBuffer[k_StackBufferSize];
+  va_list args;
+  va_start(args, format);
+  int count = vsnprintf(stackBuffer, k_StackBufferSize, format, args);
+  va_end(args);
+  if(count < 0)
+  {
+    return;
+  }
+  if(static_cast<size_t>(count) < k_StackBufferSize)
+  {
+    m_Buffer.append(stackBuffer, static_cast<size_t>(count));
+    return;
+  }
+
+  // Very large values in "%f" notation do not fit into the stack buffer. Format them directly
+  // into the end of the chunk instead.
+  size_t offset = m_Buffer.size();
+  m_Buffer.resize(offset + static_cast<size_t>(count) + 1);
+  va_start(args, format);
+  vsnprintf(&m_Buffer[offset], static_cast<size_t>(count) + 1, format, args);
+  va_end(args);
+  m_Buffer.resize(offset + static_cast<size_t>(count));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ChunkedAsciiWriter::ChunkedAsciiWriter(FILE* f, size_t chunkSize)
+: m_File(f)
+, m_ChunkSize(chunkSize > 0 ? chunkSize : k_DefaultChunkSize)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ChunkedAsciiWriter::~ChunkedAsciiWriter() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ChunkedAsciiWriter::setChunksPerWindow(size_t value)
+{
+  m_ChunksPerWindow = value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ChunkedAsciiWriter::setParallel(bool value)
+{
+  m_Parallel = value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t ChunkedAsciiWriter::getBytesWritten() const
+{
+  return m_BytesWritten;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ChunkedAsciiWriter::getWindowSize() const
+{
+  if(m_ChunksPerWindow > 0)
+  {
+    return m_ChunksPerWindow;
+  }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(m_Parallel)
+  {
+    // A few chunks per thread keeps every thread busy even if some chunks format faster
+    // than others while still bounding the amount of text held in memory.
+    size_t numThreads = std::thread::hardware_concurrency();
+    return std::max<size_t>(numThreads, 1) * 4;
+  }
+#endif
+  return 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ChunkedAsciiWriter::writeChunks(size_t count)
+{
+  for(size_t c = 0; c < count; c++)
+  {
+    const AsciiChunk& chunk = m_Chunks[c];
+    if(chunk.size() == 0)
+    {
+      continue;
+    }
+    size_t totalWritten = fwrite(chunk.data(), sizeof(char), chunk.size(), m_File);
+    if(totalWritten != chunk.size())
+    {
+      return false;
+    }
+    m_BytesWritten += totalWritten;
+  }
+  return true;
+}
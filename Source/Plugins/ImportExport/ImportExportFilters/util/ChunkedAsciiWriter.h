@@ -0,0 +1,365 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+namespace ImportExport
+{
+
+/**
+ * @brief The AsciiChunk class is the text buffer that a single worker formats a contiguous
+ * range of items into. The append functions produce exactly the same characters that the
+ * equivalent printf conversion would, so a file assembled from AsciiChunks is byte identical
+ * to one written with one fprintf() per item.
+ */
+class AsciiChunk
+{
+public:
+  AsciiChunk() = default;
+  ~AsciiChunk() = default;
+
+  /**
+   * @brief Empties the buffer but keeps the allocated capacity
+   */
+  void clear()
+  {
+    m_Buffer.clear();
+  }
+
+  /**
+   * @brief Returns the formatted text
+   */
+  const char* data() const
+  {
+    return m_Buffer.data();
+  }
+
+  /**
+   * @brief Returns the number of formatted characters
+   */
+  size_t size() const
+  {
+    return m_Buffer.size();
+  }
+
+  /**
+   * @brief Appends a single character
+   */
+  void append(char c)
+  {
+    m_Buffer.push_back(c);
+  }
+
+  /**
+   * @brief Appends a null terminated string
+   */
+  void append(const char* str);
+
+  /**
+   * @brief Appends len characters from str
+   */
+  void append(const char* str, size_t len)
+  {
+    m_Buffer.append(str, len);
+  }
+
+  /**
+   * @brief Appends an unsigned integer. Equivalent to the "%u", "%lu" and "%llu" conversions.
+   */
+  void appendUInt(uint64_t value);
+
+  /**
+   * @brief Appends a signed integer. Equivalent to the "%d", "%ld" and "%lld" conversions.
+   */
+  void appendInt(int64_t value);
+
+  /**
+   * @brief Appends a value using the "%f" conversion (6 digits after the decimal point)
+   */
+  void appendFixed(double value);
+
+  /**
+   * @brief Appends a value using the "%g" conversion with a precision of 6. This is also what
+   * std::ostream produces for a float or double with the default stream flags.
+   */
+  void appendGeneral(double value);
+
+  /**
+   * @brief Appends arbitrary printf style formatted text. Use this for conversions that do
+   * not have a dedicated append function.
+   */
+  void appendFormat(const char* format, ...)
+#if defined(__GNUC__) || defined(__clang__)
+      __attribute__((format(printf, 2, 3)))
+#endif
+      ;
+
+  /**
+   * @brief Appends a value the way std::ostream formats it with the default stream flags, except
+   * that 1 byte integers are written as numbers instead of characters.
+   */
+  template <typename T>
+  void appendValue(T value)
+  {
+    appendValue(value, std::is_floating_point<T>(), std::is_signed<T>());
+  }
+
+private:
+  template <typename T, typename Signed>
+  void appendValue(T value, std::true_type, Signed)
+  {
+    appendGeneral(static_cast<double>(value));
+  }
+
+  template <typename T>
+  void appendValue(T value, std::false_type, std::true_type)
+  {
+    appendInt(static_cast<int64_t>(value));
+  }
+
+  template <typename T>
+  void appendValue(T value, std::false_type, std::false_type)
+  {
+    appendUInt(static_cast<uint64_t>(value));
+  }
+
+  std::string m_Buffer;
+};
+
+/**
+ * @brief The ChunkedAsciiWriter class writes large ASCII data sections to an already opened
+ * FILE*. The items to write are split into fixed size chunks. A window of chunks is formatted
+ * in parallel (each chunk into its own AsciiChunk buffer) and the window is then written to
+ * the file in order with one fwrite() per chunk. The buffers are reused from one window to the
+ * next so the memory used is bounded by the window size and not by the size of the data.
+ *
+ * The formatter is any callable with the signature
+ * @code
+ *   void operator()(size_t start, size_t end, AsciiChunk& chunk) const;
+ * @endcode
+ * that appends the text for items [start, end) to chunk. Because chunks are formatted out of
+ * order the text of an item may only depend on its index, never on what was written before it.
+ *
+ * The optional progress callback has the signature
+ * @code
+ *   bool operator()(size_t itemsWritten);
+ * @endcode
+ * and is called from the calling thread after each window has been written. Returning false
+ * stops the writer.
+ */
+class ChunkedAsciiWriter
+{
+public:
+  /**
+   * @brief Status codes returned from write()
+   */
+  enum Status : int32_t
+  {
+    Success = 0,
+    Canceled = 1,
+    WriteError = -1
+  };
+
+  /**
+   * @brief ChunkedAsciiWriter
+   * @param f The file to append to
+   * @param chunkSize The number of items each chunk holds
+   */
+  explicit ChunkedAsciiWriter(FILE* f, size_t chunkSize = k_DefaultChunkSize);
+  ~ChunkedAsciiWriter();
+
+  static const size_t k_DefaultChunkSize = 32768;
+
+  /**
+   * @brief Sets the number of chunks that are formatted before they are written. A value of 0
+   * selects a window based on the number of available threads.
+   */
+  void setChunksPerWindow(size_t value);
+
+  /**
+   * @brief Allows the writer to format chunks on multiple threads. The default is true.
+   */
+  void setParallel(bool value);
+
+  /**
+   * @brief Returns the total number of bytes written so far
+   */
+  uint64_t getBytesWritten() const;
+
+  /**
+   * @brief Formats and writes numItems items
+   * @param numItems Number of items to write
+   * @param formatter Callable that formats a range of items into an AsciiChunk
+   * @return Status code
+   */
+  template <typename Formatter>
+  int32_t write(size_t numItems, const Formatter& formatter)
+  {
+    return write(numItems, formatter, [](size_t) { return true; });
+  }
+
+  /**
+   * @brief Formats and writes numItems items, reporting progress after each window
+   * @param numItems Number of items to write
+   * @param formatter Callable that formats a range of items into an AsciiChunk
+   * @param progress Callable that receives the number of items written so far
+   * @return Status code
+   */
+  template <typename Formatter, typename Progress>
+  int32_t write(size_t numItems, const Formatter& formatter, Progress progress)
+  {
+    if(nullptr == m_File)
+    {
+      return WriteError;
+    }
+    size_t numChunks = (numItems + m_ChunkSize - 1) / m_ChunkSize;
+    size_t window = getWindowSize();
+    if(m_Chunks.size() < window)
+    {
+      m_Chunks.resize(window);
+    }
+
+    for(size_t firstChunk = 0; firstChunk < numChunks; firstChunk += window)
+    {
+      size_t lastChunk = std::min(firstChunk + window, numChunks);
+      FormatChunksImpl<Formatter> impl(formatter, m_Chunks.data(), firstChunk, m_ChunkSize, numItems);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      if(m_Parallel && lastChunk - firstChunk > 1)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(firstChunk, lastChunk, 1), impl, tbb::simple_partitioner());
+      }
+      else
+#endif
+      {
+        impl.format(firstChunk, lastChunk);
+      }
+
+      if(!writeChunks(lastChunk - firstChunk))
+      {
+        return WriteError;
+      }
+      size_t itemsWritten = std::min(lastChunk * m_ChunkSize, numItems);
+      if(!progress(itemsWritten))
+      {
+        return Canceled;
+      }
+    }
+    return Success;
+  }
+
+protected:
+  /**
+   * @brief Writes the first count chunk buffers to the file in order
+   * @return false if the file could not be written
+   */
+  bool writeChunks(size_t count);
+
+  /**
+   * @brief Returns the number of chunks formatted before each write
+   */
+  size_t getWindowSize() const;
+
+private:
+  /**
+   * @brief The FormatChunksImpl class formats a range of chunks, each into the chunk buffer
+   * that matches its position inside the current window.
+   */
+  template <typename Formatter>
+  class FormatChunksImpl
+  {
+  public:
+    FormatChunksImpl(const Formatter& formatter, AsciiChunk* chunks, size_t firstChunk, size_t chunkSize, size_t numItems)
+    : m_Formatter(formatter)
+    , m_Chunks(chunks)
+    , m_FirstChunk(firstChunk)
+    , m_ChunkSize(chunkSize)
+    , m_NumItems(numItems)
+    {
+    }
+
+    void format(size_t start, size_t end) const
+    {
+      for(size_t c = start; c < end; c++)
+      {
+        AsciiChunk& chunk = m_Chunks[c - m_FirstChunk];
+        chunk.clear();
+        size_t first = c * m_ChunkSize;
+        size_t last = std::min(first + m_ChunkSize, m_NumItems);
+        m_Formatter(first, last, chunk);
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      format(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const Formatter& m_Formatter;
+    AsciiChunk* m_Chunks;
+    size_t m_FirstChunk;
+    size_t m_ChunkSize;
+    size_t m_NumItems;
+  };
+
+  FILE* m_File = nullptr;
+  size_t m_ChunkSize = k_DefaultChunkSize;
+  size_t m_ChunksPerWindow = 0;
+  bool m_Parallel = true;
+  uint64_t m_BytesWritten = 0;
+  std::vector<AsciiChunk> m_Chunks;
+
+public:
+  ChunkedAsciiWriter(const ChunkedAsciiWriter&) = delete;            // Copy Constructor Not Implemented
+  ChunkedAsciiWriter(ChunkedAsciiWriter&&) = delete;                 // Move Constructor Not Implemented
+  ChunkedAsciiWriter& operator=(const ChunkedAsciiWriter&) = delete; // Copy Assignment Not Implemented
+  ChunkedAsciiWriter& operator=(ChunkedAsciiWriter&&) = delete;      // Move Assignment Not Implemented
+};
+
+} // namespace ImportExport
@@ -0,0 +1,514 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ImportExport/ImportExportFilters/util/VertexWelder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/partitioner.h>
+#endif
+
+using namespace ImportExport;
+
+namespace
+{
+/**
+ * @brief Sort key of a vertex. For exact welding the cell is the bit pattern of the
+ * coordinates, otherwise it is the tolerance sized cell the vertex falls in. The vertex
+ * index breaks ties so the lowest vertex comes first in every run of equal cells.
+ */
+struct WeldKey
+{
+  int64_t x;
+  int64_t y;
+  int64_t z;
+  MeshIndexType index;
+
+  bool operator<(const WeldKey& other) const
+  {
+    if(x != other.x)
+    {
+      return x < other.x;
+    }
+    if(y != other.y)
+    {
+      return y < other.y;
+    }
+    if(z != other.z)
+    {
+      return z < other.z;
+    }
+    return index < other.index;
+  }
+
+  bool sameCell(const WeldKey& other) const
+  {
+    return x == other.x && y == other.y && z == other.z;
+  }
+};
+
+/**
+ * @brief Cells are clamped to this range so the floor of a large coordinate divided by a small
+ * tolerance stays representable and the cells around any cell can be formed without overflowing.
+ * Vertices clamped into the same cell are still compared by their real distance.
+ */
+const double k_MaxCell = 4.0E18;
+
+/**
+ * @brief The BuildWeldKeysImpl class computes the sort key of each vertex
+ */
+class BuildWeldKeysImpl
+{
+public:
+  BuildWeldKeysImpl(const float* vertices, WeldKey* keys, float tolerance)
+  : m_Vertices(vertices)
+  , m_Keys(keys)
+  , m_Tolerance(tolerance)
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      int64_t cell[3] = {0, 0, 0};
+      for(size_t c = 0; c < 3; c++)
+      {
+        float v = m_Vertices[i * 3 + c];
+        if(m_Tolerance > 0.0f)
+        {
+          // NaN coordinates end up in the lowest cell
+          double cellValue = std::floor(static_cast<double>(v) / m_Tolerance);
+          cellValue = (cellValue < k_MaxCell) ? cellValue : k_MaxCell;
+          cellValue = (cellValue > -k_MaxCell) ? cellValue : -k_MaxCell;
+          cell[c] = static_cast<int64_t>(cellValue);
+        }
+        else
+        {
+          // Adding zero turns -0.0 into +0.0 so both compare equal like they do with operator==
+          v = v + 0.0f;
+          uint32_t bits = 0;
+          std::memcpy(&bits, &v, sizeof(bits));
+          cell[c] = static_cast<int64_t>(bits);
+        }
+      }
+      m_Keys[i] = {cell[0], cell[1], cell[2], static_cast<MeshIndexType>(i)};
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const float* m_Vertices;
+  WeldKey* m_Keys;
+  float m_Tolerance;
+};
+
+/**
+ * @brief The FindNeighborCellsImpl class lists, for each occupied cell of the sorted keys, the
+ * occupied cells among it and its 26 surrounding cells. The cells are processed in fixed size
+ * blocks that each collect their own lists so the result does not depend on how the work was
+ * scheduled.
+ */
+class FindNeighborCellsImpl
+{
+public:
+  FindNeighborCellsImpl(const std::vector<WeldKey>& keys, const std::vector<size_t>& cellStarts, const std::vector<size_t>& cellOfVertex, size_t blockSize,
+                        std::vector<std::vector<size_t>>& blockNeighbors, std::vector<size_t>& neighborCounts)
+  : m_Keys(keys)
+  , m_CellStarts(cellStarts)
+  , m_CellOfVertex(cellOfVertex)
+  , m_BlockSize(blockSize)
+  , m_BlockNeighbors(blockNeighbors)
+  , m_NeighborCounts(neighborCounts)
+  {
+  }
+
+  void convert(size_t startBlock, size_t endBlock) const
+  {
+    size_t numCells = m_CellStarts.size() - 1;
+    for(size_t block = startBlock; block < endBlock; block++)
+    {
+      std::vector<size_t>& neighbors = m_BlockNeighbors[block];
+      size_t end = std::min(numCells, (block + 1) * m_BlockSize);
+      for(size_t cell = block * m_BlockSize; cell < end; cell++)
+      {
+        size_t count = neighbors.size();
+        findNeighbors(m_Keys[m_CellStarts[cell]], neighbors);
+        m_NeighborCounts[cell] = neighbors.size() - count;
+      }
+    }
+  }
+
+  void findNeighbors(const WeldKey& key, std::vector<size_t>& neighbors) const
+  {
+    for(int64_t dz = -1; dz <= 1; dz++)
+    {
+      for(int64_t dy = -1; dy <= 1; dy++)
+      {
+        for(int64_t dx = -1; dx <= 1; dx++)
+        {
+          WeldKey first = {key.x + dx, key.y + dy, key.z + dz, 0};
+          auto iter = std::lower_bound(m_Keys.begin(), m_Keys.end(), first);
+          if(iter != m_Keys.end() && iter->sameCell(first))
+          {
+            neighbors.push_back(m_CellOfVertex[iter->index]);
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<WeldKey>& m_Keys;
+  const std::vector<size_t>& m_CellStarts;
+  const std::vector<size_t>& m_CellOfVertex;
+  size_t m_BlockSize;
+  std::vector<std::vector<size_t>>& m_BlockNeighbors;
+  std::vector<size_t>& m_NeighborCounts;
+};
+
+/**
+ * @brief The RemapTrianglesImpl class replaces the vertex indices of the triangles
+ */
+class RemapTrianglesImpl
+{
+public:
+  RemapTrianglesImpl(MeshIndexType* triangles, const MeshIndexType* remap)
+  : m_Triangles(triangles)
+  , m_Remap(remap)
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start * 3; i < end * 3; i++)
+    {
+      m_Triangles[i] = m_Remap[m_Triangles[i]];
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  MeshIndexType* m_Triangles;
+  const MeshIndexType* m_Remap;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+void SortValues(std::vector<T>& values)
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_sort(values.begin(), values.end());
+#else
+  std::sort(values.begin(), values.end());
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<WeldKey> BuildKeys(const float* vertices, size_t numVertices, float tolerance)
+{
+  std::vector<WeldKey> keys(numVertices);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numVertices), BuildWeldKeysImpl(vertices, keys.data(), tolerance), tbb::auto_partitioner());
+#else
+  BuildWeldKeysImpl serial(vertices, keys.data(), tolerance);
+  serial.convert(0, numVertices);
+#endif
+  SortValues(keys);
+  return keys;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VertexWelder::VertexWelder(float tolerance)
+: m_Tolerance(tolerance > 0.0f ? tolerance : 0.0f)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VertexWelder::~VertexWelder() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VertexWelder::findExactDuplicates(const float* vertices, size_t numVertices, std::vector<MeshIndexType>& parents) const
+{
+  std::vector<WeldKey> keys = BuildKeys(vertices, numVertices, 0.0f);
+  MeshIndexType representative = 0;
+  for(size_t p = 0; p < numVertices; p++)
+  {
+    if(p == 0 || !keys[p].sameCell(keys[p - 1]))
+    {
+      representative = keys[p].index;
+    }
+    parents[keys[p].index] = representative;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VertexWelder::findNearDuplicates(const float* vertices, size_t numVertices, std::vector<MeshIndexType>& parents) const
+{
+  std::vector<WeldKey> keys = BuildKeys(vertices, numVertices, m_Tolerance);
+
+  // Each run of equal cells in the sorted keys is one occupied cell
+  std::vector<size_t> cellStarts;
+  std::vector<size_t> cellOfVertex(numVertices);
+  for(size_t p = 0; p < numVertices; p++)
+  {
+    if(p == 0 || !keys[p].sameCell(keys[p - 1]))
+    {
+      cellStarts.push_back(p);
+    }
+    cellOfVertex[keys[p].index] = cellStarts.size() - 1;
+  }
+  cellStarts.push_back(numVertices);
+  size_t numCells = cellStarts.size() - 1;
+
+  static const size_t k_BlockSize = 16384;
+  size_t numBlocks = (numCells + k_BlockSize - 1) / k_BlockSize;
+  std::vector<std::vector<size_t>> blockNeighbors(numBlocks);
+  std::vector<size_t> neighborStarts(numCells + 1, 0);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), FindNeighborCellsImpl(keys, cellStarts, cellOfVertex, k_BlockSize, blockNeighbors, neighborStarts), tbb::auto_partitioner());
+#else
+  FindNeighborCellsImpl serial(keys, cellStarts, cellOfVertex, k_BlockSize, blockNeighbors, neighborStarts);
+  serial.convert(0, numBlocks);
+#endif
+  std::vector<WeldKey>().swap(keys);
+
+  // The blocks are in cell order, so concatenating them lists the neighbors of every cell in turn
+  std::vector<size_t> neighbors;
+  {
+    size_t total = 0;
+    for(size_t cell = 0; cell < numCells; cell++)
+    {
+      size_t count = neighborStarts[cell];
+      neighborStarts[cell] = total;
+      total += count;
+    }
+    neighborStarts[numCells] = total;
+    neighbors.reserve(total);
+    for(std::vector<size_t>& block : blockNeighbors)
+    {
+      neighbors.insert(neighbors.end(), block.begin(), block.end());
+      std::vector<size_t>().swap(block);
+    }
+  }
+
+  // Each vertex joins the lowest earlier group root within the tolerance or starts a group of its own.
+  // Every vertex is within the tolerance of the vertex whose position the group keeps, so a run of
+  // vertices that are each close to the next does not chain into one group. No two roots are within
+  // the tolerance of each other, so a cell holds only a handful of them and a vertex only looks at the
+  // roots of its neighboring cells, however many vertices coincide.
+  const double toleranceSquared = static_cast<double>(m_Tolerance) * m_Tolerance;
+  std::vector<MeshIndexType> firstRoot(numCells, numVertices);
+  std::vector<MeshIndexType> nextRoot(numVertices, numVertices);
+  for(size_t i = 0; i < numVertices; i++)
+  {
+    const float* v0 = vertices + i * 3;
+    MeshIndexType parent = i;
+    size_t cell = cellOfVertex[i];
+    for(size_t n = neighborStarts[cell]; n < neighborStarts[cell + 1]; n++)
+    {
+      for(MeshIndexType root = firstRoot[neighbors[n]]; root != numVertices; root = nextRoot[root])
+      {
+        if(root > parent)
+        {
+          continue;
+        }
+        const float* v1 = vertices + root * 3;
+        double ddx = static_cast<double>(v0[0]) - v1[0];
+        double ddy = static_cast<double>(v0[1]) - v1[1];
+        double ddz = static_cast<double>(v0[2]) - v1[2];
+        if(ddx * ddx + ddy * ddy + ddz * ddz < toleranceSquared)
+        {
+          parent = root;
+        }
+      }
+    }
+    parents[i] = parent;
+    if(parent == i)
+    {
+      nextRoot[i] = firstRoot[cell];
+      firstRoot[cell] = i;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t VertexWelder::weld(const float* vertices, size_t numVertices)
+{
+  std::vector<MeshIndexType> parents(numVertices);
+  if(m_Tolerance > 0.0f)
+  {
+    findNearDuplicates(vertices, numVertices, parents);
+  }
+  else
+  {
+    findExactDuplicates(vertices, numVertices, parents);
+  }
+
+  // Every parent is a lower vertex, so its welded id is already known
+  m_Remap.swap(parents);
+  m_NumUnique = 0;
+  for(size_t i = 0; i < numVertices; i++)
+  {
+    if(m_Remap[i] == i)
+    {
+      m_Remap[i] = m_NumUnique++;
+    }
+    else
+    {
+      m_Remap[i] = m_Remap[m_Remap[i]];
+    }
+  }
+  return m_NumUnique;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<MeshIndexType>& VertexWelder::getRemap() const
+{
+  return m_Remap;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t VertexWelder::getNumberOfUniqueVertices() const
+{
+  return m_NumUnique;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VertexWelder::compactVertices(float* vertices) const
+{
+  // The first vertex of each group is the one that gets the next welded id. Its slot
+  // is never behind a vertex that has not been moved yet so the copy can be done in place.
+  MeshIndexType next = 0;
+  for(size_t i = 0; i < m_Remap.size(); i++)
+  {
+    if(m_Remap[i] != next)
+    {
+      continue;
+    }
+    if(next != i)
+    {
+      vertices[next * 3] = vertices[i * 3];
+      vertices[next * 3 + 1] = vertices[i * 3 + 1];
+      vertices[next * 3 + 2] = vertices[i * 3 + 2];
+    }
+    next++;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t VertexWelder::removeDegenerateTriangles(MeshIndexType* triangles, size_t numTriangles, std::vector<size_t>& keptTriangles)
+{
+  keptTriangles.clear();
+  size_t numKept = 0;
+  for(size_t t = 0; t < numTriangles; t++)
+  {
+    MeshIndexType v0 = triangles[t * 3];
+    MeshIndexType v1 = triangles[t * 3 + 1];
+    MeshIndexType v2 = triangles[t * 3 + 2];
+    if(v0 == v1 || v1 == v2 || v0 == v2)
+    {
+      continue;
+    }
+    triangles[numKept * 3] = v0;
+    triangles[numKept * 3 + 1] = v1;
+    triangles[numKept * 3 + 2] = v2;
+    keptTriangles.push_back(t);
+    numKept++;
+  }
+  return numKept;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VertexWelder::remapTriangles(MeshIndexType* triangles, size_t numTriangles) const
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles), RemapTrianglesImpl(triangles, m_Remap.data()), tbb::auto_partitioner());
+#else
+  RemapTrianglesImpl serial(triangles, m_Remap.data());
+  serial.convert(0, numTriangles);
+#endif
+}
@@ -0,0 +1,131 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "SIMPLib/Geometry/IGeometry.h"
+
+namespace ImportExport
+{
+
+/**
+ * @brief The VertexWelder class merges coincident vertices of a triangle soup. The vertices
+ * are keyed by their coordinates (or by the tolerance sized cell they fall in), the keys are
+ * sorted in parallel, and coincident vertices are found by scanning runs of equal keys. The
+ * worst case is O(n log n) no matter how the vertices are distributed in space.
+ *
+ * The result is a remap table holding the welded id of every input vertex. Welded ids are
+ * handed out in order of first occurrence and every group keeps the position of its lowest
+ * input vertex, so the table can be applied in place to a SharedVertexList and to the
+ * triangle list of a TriangleGeom.
+ */
+class VertexWelder
+{
+public:
+  /**
+   * @brief VertexWelder
+   * @param tolerance Vertices closer than this distance to the first vertex of a group are merged
+   * into that group. A tolerance of zero only merges vertices with exactly the same coordinates.
+   */
+  explicit VertexWelder(float tolerance = 0.0f);
+  ~VertexWelder();
+
+  /**
+   * @brief Computes the remap table for the vertex list
+   * @param vertices xyz coordinates of each vertex
+   * @param numVertices Number of vertices
+   * @return The number of welded vertices
+   */
+  size_t weld(const float* vertices, size_t numVertices);
+
+  /**
+   * @brief Returns the welded id of every input vertex
+   */
+  const std::vector<MeshIndexType>& getRemap() const;
+
+  /**
+   * @brief Returns the number of welded vertices
+   */
+  size_t getNumberOfUniqueVertices() const;
+
+  /**
+   * @brief Moves each welded vertex into its slot at the front of the vertex list. The
+   * caller resizes the list to getNumberOfUniqueVertices() afterwards.
+   */
+  void compactVertices(float* vertices) const;
+
+  /**
+   * @brief Replaces every vertex index of the triangles with its welded id
+   */
+  void remapTriangles(MeshIndexType* triangles, size_t numTriangles) const;
+
+  /**
+   * @brief Removes the triangles that share a vertex with themselves after remapping, which happens
+   * when welding with a tolerance collapses an edge. The remaining triangles are moved to the front.
+   * @param keptTriangles Filled with the original index of each remaining triangle, so face data can
+   * be moved the same way
+   * @return The number of remaining triangles
+   */
+  static size_t removeDegenerateTriangles(MeshIndexType* triangles, size_t numTriangles, std::vector<size_t>& keptTriangles);
+
+protected:
+  /**
+   * @brief Sets the parent of each vertex to the lowest vertex it shares exact coordinates with
+   */
+  void findExactDuplicates(const float* vertices, size_t numVertices, std::vector<MeshIndexType>& parents) const;
+
+  /**
+   * @brief Sets the parent of each vertex to the first vertex of its group. Vertices are visited in
+   * order and each one joins the lowest earlier group whose first vertex is within the tolerance,
+   * so groups never chain beyond the tolerance.
+   */
+  void findNearDuplicates(const float* vertices, size_t numVertices, std::vector<MeshIndexType>& parents) const;
+
+private:
+  float m_Tolerance = 0.0f;
+  std::vector<MeshIndexType> m_Remap;
+  size_t m_NumUnique = 0;
+
+public:
+  VertexWelder(const VertexWelder&) = delete;            // Copy Constructor Not Implemented
+  VertexWelder(VertexWelder&&) = delete;                 // Move Constructor Not Implemented
+  VertexWelder& operator=(const VertexWelder&) = delete; // Copy Assignment Not Implemented
+  VertexWelder& operator=(VertexWelder&&) = delete;      // Move Assignment Not Implemented
+};
+
+} // namespace ImportExport
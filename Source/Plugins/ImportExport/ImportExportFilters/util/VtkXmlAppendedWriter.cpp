@@ -0,0 +1,172 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ImportExport/ImportExportFilters/util/VtkXmlAppendedWriter.h"
+
+using namespace ImportExport;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VtkXmlAppendedWriter::VtkXmlAppendedWriter() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VtkXmlAppendedWriter::~VtkXmlAppendedWriter() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlAppendedWriter::addArray(Section section, const std::string& name, const std::string& vtkType, int32_t numComps, uint64_t numBytes, const ArrayWriter& writer)
+{
+  ArrayInfo info;
+  info.section = section;
+  info.name = name;
+  info.vtkType = vtkType;
+  info.numComps = numComps;
+  info.numBytes = numBytes;
+  info.offset = m_AppendedSize;
+  info.writer = writer;
+  m_Arrays.push_back(info);
+  m_AppendedSize += sizeof(uint64_t) + numBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlAppendedWriter::writeFileHeader(FILE* f, const char* type) const
+{
+  const char* byteOrder = BinaryBlockWriter::SystemByteOrder() == BinaryBlockWriter::ByteOrder::BigEndian ? "BigEndian" : "LittleEndian";
+  fprintf(f, "<?xml version=\"1.0\"?>\n");
+  fprintf(f, "<VTKFile type=\"%s\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\">\n", type, byteOrder);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlAppendedWriter::writeArrayTags(FILE* f, Section section, const char* indent) const
+{
+  for(const ArrayInfo& info : m_Arrays)
+  {
+    if(info.section != section)
+    {
+      continue;
+    }
+    fprintf(f, "%s<DataArray type=\"%s\"", indent, info.vtkType.c_str());
+    if(section != Section::Points)
+    {
+      fprintf(f, " Name=\"%s\"", info.name.c_str());
+    }
+    fprintf(f, " NumberOfComponents=\"%d\" format=\"appended\" offset=\"%llu\"/>\n", info.numComps, static_cast<unsigned long long>(info.offset));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VtkXmlAppendedWriter::writeAppendedData(FILE* f) const
+{
+  fprintf(f, "  <AppendedData encoding=\"raw\">\n");
+  fprintf(f, "   _");
+  BinaryBlockWriter writer(f, BinaryBlockWriter::SystemByteOrder());
+  for(const ArrayInfo& info : m_Arrays)
+  {
+    uint64_t start = writer.getBytesWritten();
+    writer.writeValue<uint64_t>(info.numBytes);
+    info.writer(writer);
+    writer.flush();
+    if(writer.getBytesWritten() - start != sizeof(uint64_t) + info.numBytes)
+    {
+      return false;
+    }
+  }
+  if(!writer.flush())
+  {
+    return false;
+  }
+  fprintf(f, "\n  </AppendedData>\n");
+  fprintf(f, "</VTKFile>\n");
+  return ferror(f) == 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VtkXmlAppendedWriter::writePolyData(FILE* f, size_t numPoints, size_t numPolys)
+{
+  writeFileHeader(f, "PolyData");
+  fprintf(f, "  <PolyData>\n");
+  fprintf(f, "    <Piece NumberOfPoints=\"%llu\" NumberOfVerts=\"0\" NumberOfLines=\"0\" NumberOfStrips=\"0\" NumberOfPolys=\"%llu\">\n", static_cast<unsigned long long>(numPoints),
+          static_cast<unsigned long long>(numPolys));
+  fprintf(f, "      <PointData>\n");
+  writeArrayTags(f, Section::PointData, "        ");
+  fprintf(f, "      </PointData>\n");
+  fprintf(f, "      <CellData>\n");
+  writeArrayTags(f, Section::CellData, "        ");
+  fprintf(f, "      </CellData>\n");
+  fprintf(f, "      <Points>\n");
+  writeArrayTags(f, Section::Points, "        ");
+  fprintf(f, "      </Points>\n");
+  fprintf(f, "      <Polys>\n");
+  writeArrayTags(f, Section::Polys, "        ");
+  fprintf(f, "      </Polys>\n");
+  fprintf(f, "    </Piece>\n");
+  fprintf(f, "  </PolyData>\n");
+  return writeAppendedData(f);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VtkXmlAppendedWriter::writeImageData(FILE* f, const size_t dims[3], const float origin[3], const float spacing[3])
+{
+  unsigned long long x = dims[0];
+  unsigned long long y = dims[1];
+  unsigned long long z = dims[2];
+  writeFileHeader(f, "ImageData");
+  fprintf(f, "  <ImageData WholeExtent=\"0 %llu 0 %llu 0 %llu\" Origin=\"%.9g %.9g %.9g\" Spacing=\"%.9g %.9g %.9g\">\n", x, y, z, origin[0], origin[1], origin[2], spacing[0], spacing[1],
+          spacing[2]);
+  fprintf(f, "    <Piece Extent=\"0 %llu 0 %llu 0 %llu\">\n", x, y, z);
+  fprintf(f, "      <PointData>\n");
+  writeArrayTags(f, Section::PointData, "        ");
+  fprintf(f, "      </PointData>\n");
+  fprintf(f, "      <CellData>\n");
+  writeArrayTags(f, Section::CellData, "        ");
+  fprintf(f, "      </CellData>\n");
+  fprintf(f, "    </Piece>\n");
+  fprintf(f, "  </ImageData>\n");
+  return writeAppendedData(f);
+}
@@ -0,0 +1,158 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ImportExport/ImportExportFilters/util/BinaryBlockWriter.h"
+
+namespace ImportExport
+{
+
+/**
+ * @brief The VtkXmlAppendedWriter class writes VTK XML PolyData (.vtp) and ImageData (.vti)
+ * files whose arrays are stored in a single raw AppendedData block. The arrays are written
+ * in the byte order of the host, which the XML header advertises, so no byte swapping is
+ * needed at all. Each array is preceded by a UInt64 byte count as required by
+ * header_type="UInt64".
+ *
+ * Arrays are registered with addArray() along with a callback that streams exactly the
+ * announced number of bytes into a BinaryBlockWriter; the offsets in the XML header are
+ * computed from the announced sizes before any data is written.
+ */
+class VtkXmlAppendedWriter
+{
+public:
+  enum class Section : int32_t
+  {
+    PointData = 0,
+    CellData = 1,
+    Points = 2,
+    Polys = 3
+  };
+
+  using ArrayWriter = std::function<void(BinaryBlockWriter&)>;
+
+  VtkXmlAppendedWriter();
+  ~VtkXmlAppendedWriter();
+
+  /**
+   * @brief Returns the VTK XML type name (Int8, UInt32, Float64, ...) for T
+   */
+  template <typename T>
+  static std::string TypeName()
+  {
+    std::string name = std::is_floating_point<T>::value ? "Float" : (std::is_signed<T>::value ? "Int" : "UInt");
+    return name + std::to_string(sizeof(T) * 8);
+  }
+
+  /**
+   * @brief Registers an array of numValues values of type T
+   */
+  template <typename T>
+  void addArray(Section section, const std::string& name, int32_t numComps, size_t numValues, const ArrayWriter& writer)
+  {
+    addArray(section, name, TypeName<T>(), numComps, static_cast<uint64_t>(numValues) * sizeof(T), writer);
+  }
+
+  /**
+   * @brief Registers an array
+   * @param section Element of the Piece the array belongs to
+   * @param name Name of the array. Ignored for the Points array.
+   * @param vtkType VTK XML type name of the values
+   * @param numComps Number of components per tuple
+   * @param numBytes Exact number of bytes the writer callback will produce
+   * @param writer Callback that streams the values
+   */
+  void addArray(Section section, const std::string& name, const std::string& vtkType, int32_t numComps, uint64_t numBytes, const ArrayWriter& writer);
+
+  /**
+   * @brief Writes a PolyData file. The Polys section must contain the "connectivity" and
+   * "offsets" arrays.
+   * @return false if the file could not be written
+   */
+  bool writePolyData(FILE* f, size_t numPoints, size_t numPolys);
+
+  /**
+   * @brief Writes an ImageData file with dims cells in each direction.
+   * @return false if the file could not be written
+   */
+  bool writeImageData(FILE* f, const size_t dims[3], const float origin[3], const float spacing[3]);
+
+protected:
+  /**
+   * @brief Writes the DataArray tags of every array in a section
+   */
+  void writeArrayTags(FILE* f, Section section, const char* indent) const;
+
+  /**
+   * @brief Writes the AppendedData element with every registered array
+   */
+  bool writeAppendedData(FILE* f) const;
+
+  /**
+   * @brief Writes the opening VTKFile element
+   */
+  void writeFileHeader(FILE* f, const char* type) const;
+
+private:
+  struct ArrayInfo
+  {
+    Section section;
+    std::string name;
+    std::string vtkType;
+    int32_t numComps;
+    uint64_t numBytes;
+    uint64_t offset;
+    ArrayWriter writer;
+  };
+
+  std::vector<ArrayInfo> m_Arrays;
+  uint64_t m_AppendedSize = 0;
+
+public:
+  VtkXmlAppendedWriter(const VtkXmlAppendedWriter&) = delete;            // Copy Constructor Not Implemented
+  VtkXmlAppendedWriter(VtkXmlAppendedWriter&&) = delete;                 // Move Constructor Not Implemented
+  VtkXmlAppendedWriter& operator=(const VtkXmlAppendedWriter&) = delete; // Copy Assignment Not Implemented
+  VtkXmlAppendedWriter& operator=(VtkXmlAppendedWriter&&) = delete;      // Move Assignment Not Implemented
+};
+
+} // namespace ImportExport
@@ -0,0 +1,311 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "ImportExportTestFileLocations.h"
+
+// Directly include the .cpp file instead of the header because of the way the unit
+// tests are compiled.
+#include "ImportExport/ImportExportFilters/util/VertexWelder.cpp"
+
+class VertexWelderTest
+{
+public:
+  VertexWelderTest() = default;
+  virtual ~VertexWelderTest() = default;
+
+  /**
+   * @brief Returns the name of the class for VertexWelderTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("VertexWelderTest");
+  }
+
+  // -----------------------------------------------------------------------------
+  // Brute force weld: every vertex is compared against all earlier vertices and joins the lowest
+  // group root it is close enough to. A tolerance of zero compares the coordinates exactly, which
+  // is what ReadStlFile did before the sort based welder.
+  // -----------------------------------------------------------------------------
+  std::vector<MeshIndexType> ReferenceWeld(const std::vector<float>& vertices, float tolerance)
+  {
+    size_t numVertices = vertices.size() / 3;
+    std::vector<MeshIndexType> parents(numVertices);
+    double toleranceSquared = static_cast<double>(tolerance) * tolerance;
+    for(size_t i = 0; i < numVertices; i++)
+    {
+      parents[i] = i;
+      for(size_t j = 0; j < i; j++)
+      {
+        if(parents[j] != j)
+        {
+          continue;
+        }
+        bool same = false;
+        if(tolerance > 0.0f)
+        {
+          double dx = static_cast<double>(vertices[i * 3]) - vertices[j * 3];
+          double dy = static_cast<double>(vertices[i * 3 + 1]) - vertices[j * 3 + 1];
+          double dz = static_cast<double>(vertices[i * 3 + 2]) - vertices[j * 3 + 2];
+          same = dx * dx + dy * dy + dz * dz < toleranceSquared;
+        }
+        else
+        {
+          same = vertices[i * 3] == vertices[j * 3] && vertices[i * 3 + 1] == vertices[j * 3 + 1] && vertices[i * 3 + 2] == vertices[j * 3 + 2];
+        }
+        if(same)
+        {
+          parents[i] = j;
+          break;
+        }
+      }
+    }
+
+    MeshIndexType numUnique = 0;
+    for(size_t i = 0; i < numVertices; i++)
+    {
+      parents[i] = (parents[i] == i) ? numUnique++ : parents[parents[i]];
+    }
+    return parents;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareWithReference(const std::vector<float>& vertices, float tolerance)
+  {
+    std::vector<MeshIndexType> reference = ReferenceWeld(vertices, tolerance);
+    size_t numVertices = vertices.size() / 3;
+
+    ImportExport::VertexWelder welder(tolerance);
+    size_t numUnique = welder.weld(vertices.data(), numVertices);
+    const std::vector<MeshIndexType>& remap = welder.getRemap();
+    DREAM3D_REQUIRE_EQUAL(remap.size(), numVertices)
+    for(size_t i = 0; i < numVertices; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(remap[i], reference[i])
+    }
+
+    // Every welded vertex keeps the position of the first vertex of its group
+    std::vector<float> compacted = vertices;
+    welder.compactVertices(compacted.data());
+    std::vector<bool> seen(numUnique, false);
+    for(size_t i = 0; i < numVertices; i++)
+    {
+      MeshIndexType id = remap[i];
+      DREAM3D_REQUIRE(id < numUnique)
+      if(!seen[id])
+      {
+        seen[id] = true;
+        DREAM3D_REQUIRE_EQUAL(compacted[id * 3], vertices[i * 3])
+        DREAM3D_REQUIRE_EQUAL(compacted[id * 3 + 1], vertices[i * 3 + 1])
+        DREAM3D_REQUIRE_EQUAL(compacted[id * 3 + 2], vertices[i * 3 + 2])
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestExactDuplicates()
+  {
+    // A triangle soup of a 10 x 10 grid of quads, each quad split into two facets
+    std::vector<float> vertices;
+    const size_t k_Size = 10;
+    for(size_t y = 0; y < k_Size; y++)
+    {
+      for(size_t x = 0; x < k_Size; x++)
+      {
+        float x0 = static_cast<float>(x) * 0.1f;
+        float y0 = static_cast<float>(y) * 0.1f;
+        float x1 = static_cast<float>(x + 1) * 0.1f;
+        float y1 = static_cast<float>(y + 1) * 0.1f;
+        float quad[18] = {x0, y0, 0.0f, x1, y0, 0.0f, x1, y1, 0.0f, x0, y0, 0.0f, x1, y1, 0.0f, x0, y1, 0.0f};
+        vertices.insert(vertices.end(), quad, quad + 18);
+      }
+    }
+    // -0.0 and +0.0 are the same coordinate
+    float negativeZero[3] = {-0.0f, 0.0f, 0.0f};
+    vertices.insert(vertices.end(), negativeZero, negativeZero + 3);
+
+    CompareWithReference(vertices, 0.0f);
+
+    ImportExport::VertexWelder welder(0.0f);
+    DREAM3D_REQUIRE_EQUAL(welder.weld(vertices.data(), vertices.size() / 3), (k_Size + 1) * (k_Size + 1))
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestNearDuplicates()
+  {
+    // Clusters of jittered copies around well separated centers, listed in random order
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<float> jitter(-0.01f, 0.01f);
+    std::uniform_int_distribution<int32_t> cell(0, 40);
+    std::vector<float> vertices;
+    for(size_t i = 0; i < 3000; i++)
+    {
+      float center[3] = {static_cast<float>(cell(generator)), static_cast<float>(cell(generator)), static_cast<float>(cell(generator))};
+      for(size_t c = 0; c < 3; c++)
+      {
+        vertices.push_back(center[c] + jitter(generator));
+      }
+    }
+    CompareWithReference(vertices, 0.05f);
+    CompareWithReference(vertices, 0.0f);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestChain()
+  {
+    // Each vertex is within the tolerance of the next, but the ends of the row are far apart.
+    // The row must not collapse into a single vertex.
+    std::vector<float> vertices;
+    for(size_t i = 0; i < 5; i++)
+    {
+      float vertex[3] = {static_cast<float>(i) * 0.6f, 0.0f, 0.0f};
+      vertices.insert(vertices.end(), vertex, vertex + 3);
+    }
+    CompareWithReference(vertices, 1.0f);
+
+    ImportExport::VertexWelder welder(1.0f);
+    DREAM3D_REQUIRE_EQUAL(welder.weld(vertices.data(), 5), 3)
+    const std::vector<MeshIndexType>& remap = welder.getRemap();
+    MeshIndexType expected[5] = {0, 0, 1, 1, 2};
+    for(size_t i = 0; i < 5; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(remap[i], expected[i])
+    }
+
+    // Two vertices exactly one tolerance apart are not closer than the tolerance
+    float pair[6] = {0.0f, 0.0f, 0.0f, 0.5f, 0.0f, 0.0f};
+    ImportExport::VertexWelder pairWelder(0.5f);
+    DREAM3D_REQUIRE_EQUAL(pairWelder.weld(pair, 2), 2)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestDenseCluster()
+  {
+    // Many copies of a few points inside one tolerance cell, as a fan of facets around a vertex produces
+    std::mt19937 generator(4242);
+    std::uniform_real_distribution<float> jitter(-1.0E-5f, 1.0E-5f);
+    std::uniform_int_distribution<int32_t> corner(0, 3);
+    std::vector<float> vertices;
+    for(size_t i = 0; i < 40000; i++)
+    {
+      int32_t c = corner(generator);
+      float vertex[3] = {0.2f + 0.05f * static_cast<float>(c & 1) + jitter(generator), 0.2f + 0.05f * static_cast<float>(c >> 1) + jitter(generator), 0.2f};
+      vertices.insert(vertices.end(), vertex, vertex + 3);
+    }
+    CompareWithReference(vertices, 0.1f);
+    CompareWithReference(vertices, 0.01f);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestLargeCoordinates()
+  {
+    // Coordinates divided by the tolerance fall far outside the 64 bit integer range
+    std::vector<float> vertices = {3.0E38f, 0.0f, 0.0f, 3.0E38f, 0.0f, 0.0f, -3.0E38f, 1.0f, 0.0f, -3.0E38f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+    CompareWithReference(vertices, 1.0E-30f);
+
+    ImportExport::VertexWelder welder(1.0E-30f);
+    DREAM3D_REQUIRE_EQUAL(welder.weld(vertices.data(), 6), 3)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestDegenerateTriangles()
+  {
+    // A sliver whose short edge is shorter than the tolerance next to a regular triangle
+    std::vector<float> vertices = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.001f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+    std::vector<MeshIndexType> triangles = {0, 1, 2, 3, 4, 5};
+
+    ImportExport::VertexWelder welder(0.01f);
+    DREAM3D_REQUIRE_EQUAL(welder.weld(vertices.data(), 6), 3)
+    welder.remapTriangles(triangles.data(), 2);
+
+    std::vector<size_t> keptTriangles;
+    size_t numKept = ImportExport::VertexWelder::removeDegenerateTriangles(triangles.data(), 2, keptTriangles);
+    DREAM3D_REQUIRE_EQUAL(numKept, 1)
+    DREAM3D_REQUIRE_EQUAL(keptTriangles.size(), 1)
+    DREAM3D_REQUIRE_EQUAL(keptTriangles[0], 1)
+    DREAM3D_REQUIRE_EQUAL(triangles[0], 0)
+    DREAM3D_REQUIRE_EQUAL(triangles[1], 1)
+    DREAM3D_REQUIRE_EQUAL(triangles[2], 2)
+    return EXIT_SUCCESS;
+  }
+
+  /**
+   * @brief This is the main function
+   */
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start " << getNameOfClass().toStdString() << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestExactDuplicates())
+    DREAM3D_REGISTER_TEST(TestNearDuplicates())
+    DREAM3D_REGISTER_TEST(TestChain())
+    DREAM3D_REGISTER_TEST(TestDenseCluster())
+    DREAM3D_REGISTER_TEST(TestLargeCoordinates())
+    DREAM3D_REGISTER_TEST(TestDegenerateTriangles())
+  }
+
+private:
+  VertexWelderTest(const VertexWelderTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const VertexWelderTest&) = delete;   // Move assignment Not Implemented
+};
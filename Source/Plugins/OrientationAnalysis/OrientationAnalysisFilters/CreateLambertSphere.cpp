@@ -58,6 +58,12 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 enum createdPathID : RenameDataPath::DataID_t
 {
   AttributeMatrixID21 = 21,
@@ -76,6 +82,190 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+/**
+ * @brief The LambertSphereVerticesImpl class generates rows of the Lambert square grid and maps each vertex onto
+ * the sphere in the same pass. The last vertex of each row that failed to map is recorded so the error can be
+ * reported from the calling thread.
+ */
+class LambertSphereVerticesImpl
+{
+public:
+  LambertSphereVerticesImpl(float* vertices, int64_t numColumns, float res, float L, LambertUtilities::Hemisphere hemisphere, int64_t* lastFailure)
+  : m_Vertices(vertices)
+  , m_NumColumns(numColumns)
+  , m_Res(res)
+  , m_L(L)
+  , m_Hemisphere(hemisphere)
+  , m_LastFailure(lastFailure)
+  {
+  }
+  virtual ~LambertSphereVerticesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t y = start; y < end; y++)
+    {
+      m_LastFailure[y] = -1;
+      for(int64_t x = 0; x < m_NumColumns; x++)
+      {
+        int64_t vIndex = static_cast<int64_t>(y) * m_NumColumns + x;
+        float* vert = m_Vertices + vIndex * 3;
+        vert[0] = x * m_Res - m_L;
+        vert[1] = y * m_Res - m_L;
+        vert[2] = 0.0;
+        int32_t error = LambertUtilities::LambertSquareVertToSphereVert(vert, m_Hemisphere);
+        if(error < 0)
+        {
+          m_LastFailure[y] = vIndex;
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  float* m_Vertices;
+  int64_t m_NumColumns;
+  float m_Res;
+  float m_L;
+  LambertUtilities::Hemisphere m_Hemisphere;
+  int64_t* m_LastFailure;
+};
+
+/**
+ * @brief The LambertSphereFacesImpl class writes the connectivity and the pixel values of rows of image pixels. Each
+ * pixel is one quad and two triangles over the shared vertex list; either output may be skipped by passing nullptr.
+ */
+class LambertSphereFacesImpl
+{
+public:
+  LambertSphereFacesImpl(size_t width, const uint8_t* pixels, MeshIndexType* triangles, uint8_t* triangleData, MeshIndexType* quads, uint8_t* quadData)
+  : m_Width(width)
+  , m_Pixels(pixels)
+  , m_Triangles(triangles)
+  , m_TriangleData(triangleData)
+  , m_Quads(quads)
+  , m_QuadData(quadData)
+  {
+  }
+  virtual ~LambertSphereFacesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t y = start; y < end; y++)
+    {
+      for(size_t x = 0; x < m_Width; x++)
+      {
+        size_t iIndex = m_Width * y + x;
+        size_t vIndex = ((m_Width + 1) * y) + x;
+        if(nullptr != m_Triangles)
+        {
+          MeshIndexType* tri = m_Triangles + iIndex * 6;
+          tri[0] = static_cast<int64_t>(vIndex);
+          tri[1] = static_cast<int64_t>(vIndex + 1);
+          tri[2] = static_cast<int64_t>(vIndex + m_Width + 1 + 1);
+          tri[3] = static_cast<int64_t>(vIndex);
+          tri[4] = static_cast<int64_t>(vIndex + m_Width + 1 + 1);
+          tri[5] = static_cast<int64_t>(vIndex + m_Width + 1);
+          m_TriangleData[iIndex * 2] = m_Pixels[iIndex];
+          m_TriangleData[iIndex * 2 + 1] = m_Pixels[iIndex];
+        }
+        if(nullptr != m_Quads)
+        {
+          MeshIndexType* quad = m_Quads + iIndex * 4;
+          quad[0] = static_cast<int64_t>(vIndex);
+          quad[1] = static_cast<int64_t>(vIndex + 1);
+          quad[2] = static_cast<int64_t>(vIndex + m_Width + 1 + 1);
+          quad[3] = static_cast<int64_t>(vIndex + m_Width + 1);
+          m_QuadData[iIndex] = m_Pixels[iIndex];
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  size_t m_Width;
+  const uint8_t* m_Pixels;
+  MeshIndexType* m_Triangles;
+  uint8_t* m_TriangleData;
+  MeshIndexType* m_Quads;
+  uint8_t* m_QuadData;
+};
+
+/**
+ * @brief The LambertSphereEdgesImpl class writes the edges of rows of image pixels. Every row except the last adds
+ * 2 * width + 1 edges, so the first edge of a row is known without walking the rows before it.
+ */
+class LambertSphereEdgesImpl
+{
+public:
+  LambertSphereEdgesImpl(size_t width, size_t height, MeshIndexType* edges)
+  : m_Width(width)
+  , m_Height(height)
+  , m_Edges(edges)
+  {
+  }
+  virtual ~LambertSphereEdgesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t y = start; y < end; y++)
+    {
+      size_t eIndex = y * (2 * m_Width + 1);
+      for(size_t x = 0; x < m_Width; x++)
+      {
+        size_t vIndex = ((m_Width + 1) * y) + x;
+
+        MeshIndexType* edge = m_Edges + 2 * eIndex++;
+        edge[0] = static_cast<int64_t>(vIndex + m_Width + 1);
+        edge[1] = static_cast<int64_t>(vIndex);
+        edge = m_Edges + 2 * eIndex++;
+        edge[0] = static_cast<int64_t>(vIndex);
+        edge[1] = static_cast<int64_t>(vIndex + 1);
+
+        if(x == m_Width - 1)
+        {
+          edge = m_Edges + 2 * eIndex++;
+          edge[0] = static_cast<int64_t>(vIndex + 1);
+          edge[1] = static_cast<int64_t>(vIndex + m_Width + 1 + 1);
+        }
+
+        if(y == m_Height - 1)
+        {
+          edge = m_Edges + 2 * eIndex++;
+          edge[0] = static_cast<int64_t>(vIndex + m_Width + 1 + 1);
+          edge[1] = static_cast<int64_t>(vIndex + m_Width + 1);
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  size_t m_Width;
+  size_t m_Height;
+  MeshIndexType* m_Edges;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -403,34 +593,49 @@ void CreateLambertSphere::createVertices()
 
   // The number of vertices in X & Y is one more than the dims
   int64_t points[3] = {static_cast<int64_t>(imageDims[0] + 1), static_cast<int64_t>(imageDims[1] + 1), 1};
-  
-  
-//  DataContainer::Pointer vertexDC = getDataContainerArray()->getDataContainer(getVertexDataContainerName());
-//  m_VertexData = m_VertexDataPtr.lock()->getPointer(0);
 
-  //int64_t iIndex = 0;
-  size_t vIndex = 0;
-  // Generate all the vertex values
-  for(int64_t y = 0; y < points[1]; y++)
+  LambertUtilities::Hemisphere hemisphere = LambertUtilities::Hemisphere::North;
+  if(getHemisphere() == 0)
   {
-    float* vert = nullptr;
-    for(int64_t x = 0; x < points[0]; x++)
+    hemisphere = LambertUtilities::Hemisphere::North;
+  }
+  else if(getHemisphere() == 1)
+  {
+    hemisphere = LambertUtilities::Hemisphere::South;
+  }
+
+  // Generate all the vertex values and transform the flat grid to a sphere using equations from D. Rosca's paper
+  size_t numRows = static_cast<size_t>(points[1]);
+  std::vector<int64_t> lastFailure(numRows, -1);
+  LambertSphereVerticesImpl vertsImpl(m_Vertices->getPointer(0), points[0], res, L, hemisphere, lastFailure.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numRows), vertsImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    vertsImpl.compute(0, numRows);
+  }
+
+  // Report the last vertex that could not be mapped
+  for(size_t y = numRows; y > 0; y--)
+  {
+    int64_t v = lastFailure[y - 1];
+    if(v < 0)
     {
-      vert = m_Vertices->getTuplePointer(vIndex);
-      vert[0] = x * res - L;
-      vert[1] = y * res - L;
-      vert[2] = 0.0;
-      
-//      if (x < points[0]-1 && y < points[1] - 1) 
-//      {
-//        iIndex = (imageDims[0] * y) + x;
-//        m_VertexData[iIndex] = masterPattern->getValue(iIndex);
-//      }
-      vIndex++;
+      continue;
     }
+    float* vert = m_Vertices->getTuplePointer(static_cast<size_t>(v));
+    QString msg;
+    QTextStream ss(&msg);
+    ss << "Error calculating sphere vertex from Lambert Square. Vertex ID=" << v;
+    ss << " with value (" << vert[0] << ", " << vert[1] << ", " << vert[2] << ")";
+    setErrorCondition(-99000, msg);
+    break;
   }
-
-  transformFromLambertSquareToSphere(m_Vertices.get());
 }
 
 // -----------------------------------------------------------------------------
@@ -465,41 +670,17 @@ void CreateLambertSphere::createEdgeGeometry()
   EdgeGeom::Pointer edgeGeom = edgeDC->getGeometryAs<EdgeGeom>();
   SharedEdgeList::Pointer edges = edgeGeom->getEdges();
 
-  size_t vIndex;
-  size_t eIndex = 0;
-  for(size_t y = 0; y < imageDims[1]; y++)
+  LambertSphereEdgesImpl edgesImpl(imageDims[0], imageDims[1], edges->getPointer(0));
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
   {
-    for(size_t x = 0; x < imageDims[0]; x++)
-    {
-      vIndex = ((imageDims[0] + 1) * y) + x;
-
-      MeshIndexType* edge = edges->getTuplePointer(eIndex++);
-      edge[0] = static_cast<int64_t>(vIndex + imageDims[0] + 1);
-      edge[1] = static_cast<int64_t>(vIndex);
-      edge = edges->getTuplePointer(eIndex++);
-      edge[0] = static_cast<int64_t>(vIndex);
-      edge[1] = static_cast<int64_t>(vIndex + 1);
-
-      if(x == imageDims[0] - 1)
-      {
-        edge = edges->getTuplePointer(eIndex++);
-        edge[0] = static_cast<int64_t>(vIndex + 1);
-        edge[1] = static_cast<int64_t>(vIndex + imageDims[0] + 1 + 1);
-      }
-
-      if(y == imageDims[1] - 1)
-      {
-        edge = edges->getTuplePointer(eIndex++);
-        edge[0] = static_cast<int64_t>(vIndex + imageDims[0] + 1 + 1);
-        edge[1] = static_cast<int64_t>(vIndex + imageDims[0] + 1);
-      }
-
-      //      int64_t* quad = quads->getTuplePointer(qIndex);
-      //      quad[0] = static_cast<int64_t>(vIndex);
-      //      quad[1] = static_cast<int64_t>(vIndex + 1);
-      //      quad[2] = static_cast<int64_t>(vIndex + imageDims[0] + 1 + 1);
-      //      quad[3] = static_cast<int64_t>(vIndex + imageDims[0] + 1);
-    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, imageDims[1]), edgesImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    edgesImpl.compute(0, imageDims[1]);
   }
 }
 
@@ -527,30 +708,17 @@ void CreateLambertSphere::createTriangleGeometry()
 
 
   m_TriangleFaceData = m_TriangleFaceDataPtr.lock()->getPointer(0);
-  size_t iIndex = 0;
-  size_t vIndex = 0;
-  size_t tIndex = 0;
-  for(size_t y = 0; y < imageDims[1]; y++)
+  LambertSphereFacesImpl facesImpl(imageDims[0], masterPattern->getPointer(0), triangles->getPointer(0), m_TriangleFaceData, nullptr, nullptr);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
   {
-    for(size_t x = 0; x < imageDims[0]; x++)
-    {
-      vIndex = ((imageDims[0] + 1) * y) + x;
-
-      MeshIndexType* tri = triangles->getTuplePointer(tIndex);
-      tri[0] = static_cast<int64_t>(vIndex);
-      tri[1] = static_cast<int64_t>(vIndex + 1);
-      tri[2] = static_cast<int64_t>(vIndex + imageDims[0] + 1 + 1);
-      m_TriangleFaceData[tIndex] = masterPattern->getValue(iIndex);
-      tIndex++;
-      
-      tri = triangles->getTuplePointer(tIndex);
-      tri[0] = static_cast<int64_t>(vIndex);
-      tri[1] = static_cast<int64_t>(vIndex + imageDims[0] + 1 + 1);
-      tri[2] = static_cast<int64_t>(vIndex + imageDims[0] + 1);
-      m_TriangleFaceData[tIndex] = masterPattern->getValue(iIndex);
-      tIndex++;
-      iIndex++;
-    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, imageDims[1]), facesImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    facesImpl.compute(0, imageDims[1]);
   }
 }
 
@@ -587,8 +755,6 @@ void CreateLambertSphere::createQuadGeometry()
   FloatVec3Type origin = {-(imageDims[0] * res) / 2.0f, -(imageDims[1] * res) / 2.0f, 0.0f};
   imageGeom->setOrigin(origin);
 
-  size_t vIndex = 0;
-
   size_t totalQuads = (imageDims[0] * imageDims[1]);
   std::vector<size_t> tDims(1, totalQuads);
   quadDC->getAttributeMatrix(getFaceAttributeMatrixName())->resizeAttributeArrays(tDims);
@@ -598,24 +764,17 @@ void CreateLambertSphere::createQuadGeometry()
   m_QuadFaceData = m_QuadFaceDataPtr.lock()->getPointer(0);
 
   SharedQuadList::Pointer quads = quadGeom->getQuads();
-  size_t qIndex = 0;
-  for(size_t y = 0; y < imageDims[1]; y++)
+  LambertSphereFacesImpl facesImpl(imageDims[0], masterPattern->getPointer(0), nullptr, nullptr, quads->getPointer(0), m_QuadFaceData);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
   {
-    for(size_t x = 0; x < imageDims[0]; x++)
-    {
-      vIndex = ((imageDims[0] + 1) * y) + x;
-
-      MeshIndexType* quad = quads->getTuplePointer(qIndex);
-      quad[0] = static_cast<int64_t>(vIndex);
-      quad[1] = static_cast<int64_t>(vIndex + 1);
-      quad[2] = static_cast<int64_t>(vIndex + imageDims[0] + 1 + 1);
-      quad[3] = static_cast<int64_t>(vIndex + imageDims[0] + 1);
-
-      // Fill in the value for the Quad Cell value.
-      m_QuadFaceData[qIndex] = masterPattern->getValue(qIndex);
-
-      qIndex++;
-    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, imageDims[1]), facesImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    facesImpl.compute(0, imageDims[1]);
   }
 }
 
@@ -628,37 +787,6 @@ float CreateLambertSphere::cp(float p)
   return cc;
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void CreateLambertSphere::transformFromLambertSquareToSphere(SharedVertexList* verts)
-{
-  size_t numVerts = verts->getNumberOfTuples();
-
-  LambertUtilities::Hemisphere hemisphere = LambertUtilities::Hemisphere::North;
-  if(getHemisphere() == 0)
-  {
-    hemisphere = LambertUtilities::Hemisphere::North;
-  }
-  else if(getHemisphere() == 1)
-  {
-    hemisphere = LambertUtilities::Hemisphere::South;
-  }
-  for(size_t v = 0; v < numVerts; v++)
-  {
-    float* vert = verts->getTuplePointer(v);
-    int32_t error = LambertUtilities::LambertSquareVertToSphereVert(vert, hemisphere);
-    if(error < 0)
-    {
-      QString msg;
-      QTextStream ss(&msg);
-      ss << "Error calculating sphere vertex from Lambert Square. Vertex ID=" << v;
-      ss << " with value (" << vert[0] << ", " << vert[1] << ", " << vert[2] << ")";
-      setErrorCondition(-99000, msg);
-    }
-  }
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -391,13 +391,6 @@ private:
   QString m_TriangleDataName;
   QString m_QuadDataName;
 
-  /**
-   * @brief Transforms the initial flat grid to a sphere using equations from
-   * D. Rosca's paper.
-   * @param verts The vertices to transform.
-   */
-  void transformFromLambertSquareToSphere(SharedVertexList* verts);
-
   /**
    * @brief Internal helper function
    * @param p The float to adjust.
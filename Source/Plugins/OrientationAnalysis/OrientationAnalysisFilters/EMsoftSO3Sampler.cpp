@@ -32,6 +32,7 @@
 
 #include "EMsoftSO3Sampler.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include <QtCore/QTextStream>
@@ -58,6 +59,12 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 enum createdPathID : RenameDataPath::DataID_t
 {
   AttributeMatrixID21 = 21,
@@ -68,6 +75,151 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+/**
+ * @brief The SampleFZGridImpl class samples one x plane of the cubochoric grid per block index and keeps the
+ * Euler angles of the points that fall inside the fundamental zone, in grid order.
+ */
+class SampleFZGridImpl
+{
+public:
+  SampleFZGridImpl(EMsoftSO3Sampler* filter, std::vector<std::vector<float>>& planeEulers, int Np, double delta, double gridShift, double edge, int32_t FZtype, int32_t FZorder)
+  : m_Filter(filter)
+  , m_PlaneEulers(planeEulers)
+  , m_Np(Np)
+  , m_Delta(delta)
+  , m_GridShift(gridShift)
+  , m_Edge(edge)
+  , m_FZtype(FZtype)
+  , m_FZorder(FZorder)
+  {
+  }
+  virtual ~SampleFZGridImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t plane = start; plane < end; plane++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      int i = -m_Np + 1 + static_cast<int>(plane);
+      double x = (static_cast<double>(i) + m_GridShift) * m_Delta;
+      if(fabs(x) > m_Edge)
+      {
+        continue;
+      }
+      std::vector<float>& eulers = m_PlaneEulers[plane];
+      for(int j = -m_Np + 1; j < m_Np + 1; j++)
+      {
+        double y = (static_cast<double>(j) + m_GridShift) * m_Delta;
+        if(fabs(y) > m_Edge)
+        {
+          continue;
+        }
+        for(int k = -m_Np + 1; k < m_Np + 1; k++)
+        {
+          double z = (static_cast<double>(k) + m_GridShift) * m_Delta;
+          if(fabs(z) > m_Edge)
+          {
+            continue;
+          }
+          // convert to Rodrigues representation and keep the point if it is inside the FZ
+          OrientationD cu(x, y, z);
+          OrientationD rod = OrientationTransformation::cu2ro<OrientationD, OrientationD>(cu);
+          if(m_Filter->IsinsideFZ(rod.data(), m_FZtype, m_FZorder))
+          {
+            OrientationD eu = OrientationTransformation::ro2eu<OrientationD, OrientationD>(rod);
+            eulers.push_back(static_cast<float>(eu[0]));
+            eulers.push_back(static_cast<float>(eu[1]));
+            eulers.push_back(static_cast<float>(eu[2]));
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  EMsoftSO3Sampler* m_Filter;
+  std::vector<std::vector<float>>& m_PlaneEulers;
+  int m_Np;
+  double m_Delta;
+  double m_GridShift;
+  double m_Edge;
+  int32_t m_FZtype;
+  int32_t m_FZorder;
+};
+
+/**
+ * @brief The SampleMisorientationCubeImpl class samples x planes of the full misorientation cube. Every grid point
+ * is kept, so each point writes its Euler angles straight to its grid order position in the output array.
+ */
+class SampleMisorientationCubeImpl
+{
+public:
+  SampleMisorientationCubeImpl(EMsoftSO3Sampler* filter, float* eulerAngles, int Np, double delta, const OrientationD& sigma)
+  : m_Filter(filter)
+  , m_EulerAngles(eulerAngles)
+  , m_Np(Np)
+  , m_Delta(delta)
+  , m_Sigma(sigma)
+  {
+  }
+  virtual ~SampleMisorientationCubeImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    size_t side = static_cast<size_t>(2 * m_Np + 1);
+    for(size_t plane = start; plane < end; plane++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      double x = static_cast<double>(static_cast<int>(plane) - m_Np) * m_Delta;
+      size_t index = plane * side * side;
+      for(int j = -m_Np; j <= m_Np; j++)
+      {
+        double y = static_cast<double>(j) * m_Delta;
+        for(int k = -m_Np; k <= m_Np; k++)
+        {
+          double z = static_cast<double>(k) * m_Delta;
+          // convert to Rodrigues representation and apply Rodrigues composition formula
+          OrientationD cu(-x, -y, -z);
+          OrientationD rod = OrientationTransformation::cu2ro<OrientationD, OrientationD>(cu);
+          m_Filter->RodriguesComposition(m_Sigma, rod);
+          OrientationD eu = OrientationTransformation::ro2eu<OrientationD, OrientationD>(rod);
+          m_EulerAngles[index * 3 + 0] = static_cast<float>(eu[0]);
+          m_EulerAngles[index * 3 + 1] = static_cast<float>(eu[1]);
+          m_EulerAngles[index * 3 + 2] = static_cast<float>(eu[2]);
+          index++;
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  EMsoftSO3Sampler* m_Filter;
+  float* m_EulerAngles;
+  int m_Np;
+  double m_Delta;
+  OrientationD m_Sigma;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -279,13 +431,25 @@ void EMsoftSO3Sampler::execute()
     return;
   }
 
+  // resize the EulerAngles array to the number of sampled orientations; don't forget to redefine the hard pointer
+  auto resizeEulerAngles = [this](size_t numTuples) {
+    AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(DataArrayPath(getDataContainerName().getDataContainerName(), getEMsoftAttributeMatrixName(), ""));
+    std::vector<size_t> tDims(1, numTuples);
+    am->resizeAttributeArrays(tDims);
+    m_EulerAngles = m_EulerAnglesPtr.lock()->getPointer(0);
+  };
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+#endif
+
   OrientationListArrayType FZlist;
 
   if(getsampleModeSelector() == 0)
   {
-    // here we perform the actual calculation; once we have the FZlist,
-    // we can allocate the data array and copy all entries
-    double x, y, z, delta;
+    // here we perform the actual calculation; every x plane of the grid collects the
+    // Euler angles of its points inside the FZ and the planes are then copied in order
+    double delta;
     int32_t FZtype, FZorder;
 
     // step size for sampling of grid; maximum total number of samples = pow(2*getNumsp()+1,3)
@@ -307,65 +471,47 @@ void EMsoftSO3Sampler::execute()
     // with a rotation angle of 180 degrees.  This only affects the cyclic groups.
     int Np = getNumsp();
     int Totp = (2 * Np + 1) * (2 * Np + 1) * (2 * Np + 1);
-    int Dn = Totp / 10;
-    int Dc = Dn;
-    int Di = 0;
-    int Dg = 0;
 
     // eliminate points for which any of the coordinates lies outside the cube with semi-edge length "edge"
     double edge = 0.5 * LPs::ap;
 
-    for(int i = -Np + 1; i < Np + 1; i++)
-    {
-      x = (static_cast<double>(i) + gridShift) * delta;
+    QString ss = QString("Euler Angles | Testing %1 grid points").arg(QString::number(Totp));
+    notifyStatusMessage(ss);
 
-      if(fabs(x) <= edge)
-      {
-
-        for(int j = -Np + 1; j < Np + 1; j++)
-        {
-          y = (static_cast<double>(j) + gridShift) * delta;
-
-          if(fabs(y) <= edge)
-          {
-
-            for(int k = -Np + 1; k < Np + 1; k++)
-            {
-              z = (static_cast<double>(k) + gridShift) * delta;
-
-              if(fabs(z) <= edge)
-              {
-
-                // convert to Rodrigues representation
-                OrientationD cu(x, y, z);
-                OrientationD rod = OrientationTransformation::cu2ro<OrientationD, OrientationD>(cu);
-
-                // If insideFZ=true, then add this point to FZlist
-                bool b = IsinsideFZ(rod.data(), FZtype, FZorder);
-                if(b)
-                {
-                  FZlist.push_back(rod);
-                  Dg += 1;
-                }
-                Di += 1;
-              }
-            }
-          }
-        }
-      }
+    size_t numPlanes = static_cast<size_t>(2 * Np);
+    std::vector<std::vector<float>> planeEulers(numPlanes);
+    SampleFZGridImpl sampleImpl(this, planeEulers, Np, delta, gridShift, edge, FZtype, FZorder);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numPlanes, 1), sampleImpl, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      sampleImpl.compute(0, numPlanes);
+    }
+    if(getCancel())
+    {
+      return;
+    }
 
-      // report on status of computation
-      if(Di > Dc)
-      {
-        QString ss = QString("Euler Angles | Tested: %1 of %2 | Inside RFZ: %3 ").arg(QString::number(Di), QString::number(Totp), QString::number(Dg));
-        notifyStatusMessage(ss);
-        Dc += Dn;
-      }
-      if(getCancel())
-      {
-        break;
-      }
+    // a prefix sum over the plane counts gives the offset of every plane in the output array
+    std::vector<size_t> planeOffsets(numPlanes + 1, 0);
+    for(size_t plane = 0; plane < numPlanes; plane++)
+    {
+      planeOffsets[plane + 1] = planeOffsets[plane] + planeEulers[plane].size();
     }
+    resizeEulerAngles(planeOffsets[numPlanes] / 3);
+    for(size_t plane = 0; plane < numPlanes; plane++)
+    {
+      std::copy(planeEulers[plane].begin(), planeEulers[plane].end(), m_EulerAngles + planeOffsets[plane]);
+      std::vector<float>().swap(planeEulers[plane]);
+    }
+
+    ss = QString("Euler Angles | Tested: %1 | Inside RFZ: %2 ").arg(QString::number(Totp), QString::number(planeOffsets[numPlanes] / 3));
+    notifyStatusMessage(ss);
+    return;
   }
 
   // here are the misorientation sampling cases:
@@ -494,48 +640,31 @@ void EMsoftSO3Sampler::execute()
     }
     else
     {
-      // set counter parameters for the loop over the sub-cube surface
+      // every point of the cube is kept, so each x plane writes straight into its slice of the output array
       int Np = getNumsp();
-      int Totp = (2 * Np + 1) * (2 * Np + 1) * (2 * Np + 1); // see misorientation sampling paper for this expression
-      int Dn = Totp / 20;
-      int Dc = Dn;
-      int Dg = 0;
+      size_t Totp = static_cast<size_t>(2 * Np + 1) * static_cast<size_t>(2 * Np + 1) * static_cast<size_t>(2 * Np + 1); // see misorientation sampling paper for this expression
+      resizeEulerAngles(Totp);
 
-      for(int i = -Np; i <= Np; i++)
+      QString ss = QString("Euler Angles | Generating: %1").arg(QString::number(Totp));
+      notifyStatusMessage(ss);
+
+      size_t numPlanes = static_cast<size_t>(2 * Np + 1);
+      SampleMisorientationCubeImpl sampleImpl(this, m_EulerAngles, Np, delta, sigma);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      if(doParallel)
       {
-        x = static_cast<double>(i) * delta;
-        for(int j = -Np; j <= Np; j++)
-        {
-          y = static_cast<double>(j) * delta;
-          for(int k = -Np; k <= Np; k++)
-          {
-            z = static_cast<double>(k) * delta;
-            // convert to Rodrigues representation and apply Rodrigues composition formula
-            {
-              OrientationD cu(-x, -y, -z);
-              OrientationD rod = OrientationTransformation::cu2ro<OrientationD, OrientationD>(cu);
-              RodriguesComposition(sigma, rod);
-              FZlist.push_back(rod);
-              Dg += 1;
-            }
-          }
-        }
-        // report on status of computation
-        if(Dg > Dc)
-        {
-          QString ss = QString("Euler Angles | Generated: %1 / %2").arg(QString::number(Dg), QString::number(Totp));
-          notifyStatusMessage(ss);
-          Dc += Dn;
-        }
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numPlanes, 1), sampleImpl, tbb::simple_partitioner());
+      }
+      else
+#endif
+      {
+        sampleImpl.compute(0, numPlanes);
       }
+      return;
     }
   }
 
-  // resize the EulerAngles array to the number of items in FZlist; don't forget to redefine the hard pointer
-  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(DataArrayPath(getDataContainerName().getDataContainerName(), getEMsoftAttributeMatrixName(), ""));
-  std::vector<size_t> tDims(1, FZlist.size());
-  am->resizeAttributeArrays(tDims);
-  m_EulerAngles = m_EulerAnglesPtr.lock()->getPointer(0);
+  resizeEulerAngles(FZlist.size());
 
   // copy the Rodrigues vectors as Euler angles into the m_EulerAngles array; convert doubles to floats along the way
   int j = -1;
@@ -554,7 +683,7 @@ void EMsoftSO3Sampler::execute()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void EMsoftSO3Sampler::RodriguesComposition(OrientationD sigma, OrientationD& rod)
+void EMsoftSO3Sampler::RodriguesComposition(const OrientationD& sigma, OrientationD& rod)
 {
   OrientationD rho(3), rhomis(3);
   rho[0] = -rod[0] * rod[3];
@@ -712,16 +841,13 @@ bool EMsoftSO3Sampler::insideDihedralFZ(double* rod, int order)
 bool EMsoftSO3Sampler::insideCubicFZ(double* rod, int ot)
 {
   bool res = false, c1 = false, c2 = false;
-  std::vector<double> r(3);
-  r[0] = std::fabs(rod[0] * rod[3]);
-  r[1] = std::fabs(rod[1] * rod[3]);
-  r[2] = std::fabs(rod[2] * rod[3]);
+  double r[3] = {std::fabs(rod[0] * rod[3]), std::fabs(rod[1] * rod[3]), std::fabs(rod[2] * rod[3])};
   const double r1 = 1.0;
 
   // primary cube planes (only needed for octahedral case)
   if(ot == OrientationAnalysisConstants::OctahedralType)
   {
-    double maxValue = *(std::max_element(r.begin(), r.end()));
+    double maxValue = *(std::max_element(r, r + 3));
     c1 = (maxValue <= LPs::BP[3]);
   }
   else
@@ -282,7 +282,7 @@ public:
    * @param sigma
    * @param rod
    */
-  void RodriguesComposition(OrientationD sigma, OrientationD& rod);
+  void RodriguesComposition(const OrientationD& sigma, OrientationD& rod);
 
   /**
    * @brief OrientationListArrayType
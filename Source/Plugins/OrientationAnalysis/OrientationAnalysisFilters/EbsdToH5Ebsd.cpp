@@ -33,6 +33,7 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
 #include <memory>
 
 #include "EbsdToH5Ebsd.h"
@@ -47,6 +48,7 @@
 #include "SIMPLib/Common/Constants.h"
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/Utilities/FilePathGenerator.h"
 
 #include "EbsdLib/IO/HKL/H5CtfImporter.h"
@@ -56,6 +58,207 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <atomic>
+
+#include <tbb/pipeline.h>
+
+namespace
+{
+/**
+ * @brief The H5AngSliceWriter class gives access to the slice writer of H5AngImporter so that a .ang file
+ * parsed on another thread can be written without reading it again.
+ */
+class H5AngSliceWriter : public H5AngImporter
+{
+public:
+  H5AngSliceWriter() = default;
+  ~H5AngSliceWriter() override = default;
+
+  using H5AngImporter::writeSliceData;
+};
+
+/**
+ * @brief The H5CtfSliceWriter class gives access to the slice writer of H5CtfImporter so that a .ctf file
+ * parsed on another thread can be written without reading it again.
+ */
+class H5CtfSliceWriter : public H5CtfImporter
+{
+public:
+  H5CtfSliceWriter() = default;
+  ~H5CtfSliceWriter() override = default;
+
+  using H5CtfImporter::writeSliceData;
+};
+
+// -----------------------------------------------------------------------------
+// The importer rejects hexagonal grid .ang files, so a parsed slice is checked the same way
+// -----------------------------------------------------------------------------
+int32_t checkParsedSlice(AngReader& reader, QString& message)
+{
+  if(reader.getGrid().compare(EbsdLib::Ang::HexGrid) == 0)
+  {
+    message = QObject::tr("DREAM.3D does not directly read HEX grid .ang files. Please use the 'Convert Hexagonal Grid Data to Square Grid Data (TSL - .ang)' filter first to batch convert the Hex grid files.");
+    return -400;
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t checkParsedSlice(CtfReader& reader, QString& message)
+{
+  Q_UNUSED(reader)
+  Q_UNUSED(message)
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t numberOfSlices(AngReader& reader)
+{
+  Q_UNUSED(reader)
+  return 1;
+}
+
+// -----------------------------------------------------------------------------
+// 3D .ctf files hold several slices
+// -----------------------------------------------------------------------------
+int32_t numberOfSlices(CtfReader& reader)
+{
+  return reader.getZCells() > 1 ? reader.getZCells() : 1;
+}
+
+/**
+ * @brief The ParsedSlice struct is a single slice file travelling through the conversion pipeline
+ */
+template <typename ReaderType> struct ParsedSlice
+{
+  QString filePath;
+  int64_t z = 0;
+  std::unique_ptr<ReaderType> reader;
+  int32_t err = 0;
+  QString message;
+};
+
+/**
+ * @brief convertSlicesInParallel Parses the slice files on the TBB thread pool while a single serial stage writes the
+ * parsed slices into the H5Ebsd file in slice order. The number of slices between the two stages, and therefore the
+ * number of parsed scans held in memory, is limited to maxSlicesInFlight.
+ * @param filter Filter used for status messages, cancellation and errors
+ * @param fileId Open H5Ebsd file
+ * @param fileList Slice files in slice order
+ * @param zStart Slice index of the first file
+ * @param maxSlicesInFlight Maximum number of slices being parsed or waiting to be written
+ * @param sliceWriter Importer used to write the parsed slices
+ * @param sliceWritten Called in slice order with (xDim, yDim, xRes, yRes, numSlicesImported, z) for each written file
+ * @return False if a slice could not be converted; the error has been set on the filter
+ */
+template <typename ReaderType, typename SliceWriterType, typename SliceWrittenCallback>
+bool convertSlicesInParallel(EbsdToH5Ebsd* filter, hid_t fileId, const QVector<QString>& fileList, int64_t zStart, size_t maxSlicesInFlight, SliceWriterType& sliceWriter,
+                             SliceWrittenCallback sliceWritten)
+{
+  using SliceType = ParsedSlice<ReaderType>;
+
+  std::atomic<bool> failed(false);
+  int32_t nextFile = 0;
+
+  auto readSliceNames = [&](tbb::flow_control& fc) -> SliceType* {
+    if(failed || nextFile >= fileList.size() || filter->getCancel())
+    {
+      fc.stop();
+      return nullptr;
+    }
+    SliceType* slice = new SliceType;
+    slice->filePath = fileList[nextFile];
+    slice->z = zStart + nextFile;
+    nextFile++;
+    return slice;
+  };
+
+  auto parseSlice = [&](SliceType* slice) -> SliceType* {
+    if(failed)
+    {
+      return slice;
+    }
+    slice->reader = std::make_unique<ReaderType>();
+    slice->reader->setFileName(slice->filePath);
+    slice->err = slice->reader->readFile();
+    if(slice->err < 0)
+    {
+      slice->message = QObject::tr("Could not read the EBSD file '%1': %2").arg(slice->filePath).arg(slice->reader->getErrorMessage());
+    }
+    else
+    {
+      slice->err = checkParsedSlice(*(slice->reader), slice->message);
+    }
+    return slice;
+  };
+
+  auto writeSlice = [&](SliceType* slice) {
+    std::unique_ptr<SliceType> sliceOwner(slice);
+    if(failed || filter->getCancel())
+    {
+      return;
+    }
+
+    QString msg = "Converting File: " + slice->filePath;
+    filter->notifyStatusMessage(msg);
+    if(slice->err < 0)
+    {
+      failed = true;
+      filter->setErrorCondition(slice->err, slice->message);
+      return;
+    }
+
+    ReaderType& reader = *(slice->reader);
+    int32_t err = 0;
+    if(numberOfSlices(reader) == 1)
+    {
+      err = sliceWriter.writeSliceData(fileId, reader, slice->z, 0);
+      if(err >= 0)
+      {
+        sliceWritten(static_cast<int64_t>(reader.getXDimension()), static_cast<int64_t>(reader.getYDimension()), reader.getXStep(), reader.getYStep(), 1, slice->z);
+      }
+    }
+    else
+    {
+      // Multi-slice files are rare enough that they simply go back through the importer
+      slice->reader.reset();
+      err = sliceWriter.importFile(fileId, slice->z, slice->filePath);
+      if(err >= 0)
+      {
+        int64_t xDim = 0, yDim = 0;
+        float xRes = 0.0f, yRes = 0.0f;
+        sliceWriter.getDims(xDim, yDim);
+        sliceWriter.getSpacing(xRes, yRes);
+        sliceWritten(xDim, yDim, xRes, yRes, sliceWriter.numberOfSlicesImported(), slice->z);
+      }
+    }
+
+    if(err < 0)
+    {
+      failed = true;
+      QString message = sliceWriter.getPipelineMessage();
+      if(message.isEmpty())
+      {
+        message = QObject::tr("Could not write the data of '%1' to the HDF5 file").arg(slice->filePath);
+      }
+      filter->setErrorCondition(err, message);
+    }
+  };
+
+  tbb::parallel_pipeline(maxSlicesInFlight, tbb::make_filter<void, SliceType*>(tbb::filter::serial_in_order, readSliceNames) &
+                                                tbb::make_filter<SliceType*, SliceType*>(tbb::filter::parallel, parseSlice) &
+                                                tbb::make_filter<SliceType*, void>(tbb::filter::serial_in_order, writeSlice));
+
+  return !failed;
+}
+} // namespace
+#endif
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -70,6 +273,7 @@ EbsdToH5Ebsd::EbsdToH5Ebsd()
 , m_FileSuffix("")
 , m_FileExtension("ang")
 , m_PaddingDigits(4)
+, m_MaxSlicesInFlight(8)
 {
   m_SampleTransformation.angle = 0.0f;
   m_SampleTransformation.h = 0.0f;
@@ -96,6 +300,7 @@ void EbsdToH5Ebsd::setupFilterParameters()
   FilterParameterVectorType parameters;
 
   parameters.push_back(EbsdToH5EbsdFilterParameter::New("Import Orientation Data", "OrientationData", getOutputFile(), FilterParameter::Parameter, this));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Maximum Slices Held in Memory", MaxSlicesInFlight, FilterParameter::Parameter, EbsdToH5Ebsd));
 
   setFilterParameters(parameters);
 }
@@ -118,6 +323,7 @@ void EbsdToH5Ebsd::readFilterParameters(AbstractFilterParametersReader* reader,
   setPaddingDigits(reader->readValue("PaddingDigits", getPaddingDigits()));
   setSampleTransformation(reader->readAxisAngle("SampleTransformation", getSampleTransformation(), -1));
   setEulerTransformation(reader->readAxisAngle("EulerTransformation", getEulerTransformation(), -1));
+  setMaxSlicesInFlight(reader->readValue("MaxSlicesInFlight", getMaxSlicesInFlight()));
   reader->closeFilterGroup();
 }
 
@@ -155,6 +361,12 @@ void EbsdToH5Ebsd::dataCheck()
     setErrorCondition(-388, ss);
   }
 
+  if(m_MaxSlicesInFlight < 1)
+  {
+    ss = QObject::tr("The maximum number of slices held in memory must be at least 1");
+    setErrorCondition(-14, ss);
+  }
+
   bool hasMissingFiles = false;
   const bool stackLowToHigh = true;
   int increment = 1;
@@ -395,6 +607,40 @@ void EbsdToH5Ebsd::execute()
   int64_t biggestxDim = 0;
   int64_t biggestyDim = 0;
   int32_t totalSlicesImported = 0;
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  // Parsing the ASCII scans is what takes the time, so the slices are parsed concurrently and written in order.
+  bool doParallel = true;
+  if(doParallel && fileList.size() > 1 && m_MaxSlicesInFlight > 1)
+  {
+    auto sliceWritten = [&](int64_t sliceXDim, int64_t sliceYDim, float sliceXRes, float sliceYRes, int32_t numSlicesImported, int64_t sliceZ) {
+      totalSlicesImported = totalSlicesImported + numSlicesImported;
+      xRes = sliceXRes;
+      yRes = sliceYRes;
+      biggestxDim = std::max(biggestxDim, sliceXDim);
+      biggestyDim = std::max(biggestyDim, sliceYDim);
+      indices.push_back(static_cast<int32_t>(sliceZ));
+    };
+
+    bool converted = false;
+    size_t maxSlicesInFlight = static_cast<size_t>(m_MaxSlicesInFlight);
+    if(ext.compare(EbsdLib::Ang::FileExt) == 0)
+    {
+      H5AngSliceWriter sliceWriter;
+      converted = convertSlicesInParallel<AngReader>(this, fileId, fileList, m_ZStartIndex, maxSlicesInFlight, sliceWriter, sliceWritten);
+    }
+    else
+    {
+      H5CtfSliceWriter sliceWriter;
+      converted = convertSlicesInParallel<CtfReader>(this, fileId, fileList, m_ZStartIndex, maxSlicesInFlight, sliceWriter, sliceWritten);
+    }
+    if(!converted || getCancel())
+    {
+      return;
+    }
+  }
+  else
+#endif
   for(QVector<QString>::iterator filepath = fileList.begin(); filepath != fileList.end(); ++filepath)
   {
     QString ebsdFName = *filepath;
@@ -514,6 +760,7 @@ AbstractFilter::Pointer EbsdToH5Ebsd::newFilterInstance(bool copyFilterParameter
     filter->setPaddingDigits(getPaddingDigits());
     filter->setSampleTransformation(getSampleTransformation());
     filter->setEulerTransformation(getEulerTransformation());
+    filter->setMaxSlicesInFlight(getMaxSlicesInFlight());
   }
   return filter;
 }
@@ -576,6 +823,18 @@ QString EbsdToH5Ebsd::getHumanLabel() const
   return "Import Orientation File(s) to H5EBSD";
 }
 
+// -----------------------------------------------------------------------------
+void EbsdToH5Ebsd::setMaxSlicesInFlight(int value)
+{
+  m_MaxSlicesInFlight = value;
+}
+
+// -----------------------------------------------------------------------------
+int EbsdToH5Ebsd::getMaxSlicesInFlight() const
+{
+  return m_MaxSlicesInFlight;
+}
+
 // -----------------------------------------------------------------------------
 EbsdToH5Ebsd::Pointer EbsdToH5Ebsd::NullPointer()
 {
@@ -68,6 +68,7 @@ class OrientationAnalysis_EXPORT EbsdToH5Ebsd : public AbstractFilter
   PYB11_PROPERTY(float ZResolution READ getZResolution WRITE setZResolution)
   PYB11_PROPERTY(AxisAngleInput_t SampleTransformation READ getSampleTransformation WRITE setSampleTransformation)
   PYB11_PROPERTY(AxisAngleInput_t EulerTransformation READ getEulerTransformation WRITE setEulerTransformation)
+  PYB11_PROPERTY(int MaxSlicesInFlight READ getMaxSlicesInFlight WRITE setMaxSlicesInFlight)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -221,6 +222,16 @@ public:
    */
   AxisAngleInput_t getEulerTransformation() const;
 
+  /**
+   * @brief Setter property for MaxSlicesInFlight
+   */
+  void setMaxSlicesInFlight(int value);
+  /**
+   * @brief Getter property for MaxSlicesInFlight
+   * @return Value of MaxSlicesInFlight
+   */
+  int getMaxSlicesInFlight() const;
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -314,5 +325,6 @@ private:
   int m_PaddingDigits = {};
   AxisAngleInput_t m_SampleTransformation = {};
   AxisAngleInput_t m_EulerTransformation = {};
+  int m_MaxSlicesInFlight = {};
 };
 
@@ -44,7 +44,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindGBCDMetricBased.h"
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include <QtCore/QDir>
 #include <QtCore/QTextStream>
@@ -68,9 +70,9 @@
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/SphericalNormalIndex.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include "tbb/concurrent_vector.h"
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 #include <tbb/partitioner.h>
@@ -87,6 +89,11 @@ const double FindGBCDMetricBased::k_BallVolumesM3M[FindGBCDMetricBased::k_Number
 
 namespace GBCDMetricBased
 {
+/**
+ * @brief Triangles are selected in blocks of this size; each block collects its own selections so the
+ * combined list keeps the mesh order no matter how the blocks are scheduled.
+ */
+const size_t k_TrisBlockSize = 4096;
 
 /**
  * @brief The TriAreaAndNormals class defines a container that stores the area of a given triangle
@@ -130,11 +137,8 @@ class TrisSelector
   MeshIndexType* m_Triangles;
   int8_t* m_NodeTypes;
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals>* selectedTris;
-#else
-  QVector<TriAreaAndNormals>* selectedTris;
-#endif
+  std::vector<std::vector<TriAreaAndNormals>>* blockTris;
+  size_t numTris;
   QVector<int8_t>* triIncluded;
   float m_misorResol;
   int32_t m_PhaseOfInterest;
@@ -151,19 +155,14 @@ class TrisSelector
   double* m_FaceAreas;
 
 public:
-  TrisSelector(bool __m_ExcludeTripleLines, MeshIndexType* __m_Triangles, int8_t* __m_NodeTypes,
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals>* __selectedTris,
-#else
-               QVector<TriAreaAndNormals>* __selectedTris,
-#endif
+  TrisSelector(bool __m_ExcludeTripleLines, MeshIndexType* __m_Triangles, int8_t* __m_NodeTypes, std::vector<std::vector<TriAreaAndNormals>>* __blockTris, size_t __numTris,
                QVector<int8_t>* __triIncluded, float __m_misorResol, int32_t __m_PhaseOfInterest, float (&__gFixedT)[3][3], uint32_t* __m_CrystalStructures, float* __m_Eulers, int32_t* __m_Phases,
                int32_t* __m_FaceLabels, double* __m_FaceNormals, double* __m_FaceAreas)
   : m_ExcludeTripleLines(__m_ExcludeTripleLines)
   , m_Triangles(__m_Triangles)
   , m_NodeTypes(__m_NodeTypes)
-  , selectedTris(__selectedTris)
+  , blockTris(__blockTris)
+  , numTris(__numTris)
   , triIncluded(__triIncluded)
   , m_misorResol(__m_misorResol)
   , m_PhaseOfInterest(__m_PhaseOfInterest)
@@ -181,7 +180,7 @@ public:
 
   virtual ~TrisSelector() = default;
 
-  void select(size_t start, size_t end) const
+  void select(size_t start, size_t end, std::vector<TriAreaAndNormals>& selectedTris) const
   {
     float g1ea[3] = {0.0f, 0.0f, 0.0f};
     float g2ea[3] = {0.0f, 0.0f, 0.0f};
@@ -292,11 +291,11 @@ public:
 
               if(transpose == 0)
               {
-                (*selectedTris).push_back(TriAreaAndNormals(m_FaceAreas[triIdx], normal_grain1[0], normal_grain1[1], normal_grain1[2], -normal_grain2[0], -normal_grain2[1], -normal_grain2[2]));
+                selectedTris.push_back(TriAreaAndNormals(m_FaceAreas[triIdx], normal_grain1[0], normal_grain1[1], normal_grain1[2], -normal_grain2[0], -normal_grain2[1], -normal_grain2[2]));
               }
               else
               {
-                (*selectedTris).push_back(TriAreaAndNormals(m_FaceAreas[triIdx], -normal_grain2[0], -normal_grain2[1], -normal_grain2[2], normal_grain1[0], normal_grain1[1], normal_grain1[2]));
+                selectedTris.push_back(TriAreaAndNormals(m_FaceAreas[triIdx], -normal_grain2[0], -normal_grain2[1], -normal_grain2[2], normal_grain1[0], normal_grain1[1], normal_grain1[2]));
               }
             }
           }
@@ -305,30 +304,39 @@ public:
     }
   }
 
+  void selectBlocks(size_t startBlock, size_t endBlock) const
+  {
+    for(size_t block = startBlock; block < endBlock; block++)
+    {
+      size_t start = block * k_TrisBlockSize;
+      size_t end = std::min(start + k_TrisBlockSize, numTris);
+      select(start, end, (*blockTris)[block]);
+    }
+  }
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   void operator()(const tbb::blocked_range<size_t>& r) const
   {
-    select(r.begin(), r.end());
+    selectBlocks(r.begin(), r.end());
   }
 #endif
 };
 
 /**
  * @brief The ProbeDistrib class implements a threaded algorithm that determines the distribution values
- * for the GBCD
+ * for the GBCD. Only the triangle representations whose first normal lies within sqrt(2) * plane resolution
+ * of the sampling point (or its inverse) can pass the distance test, so those are looked up in a
+ * SphericalNormalIndex instead of testing every representation.
  */
 class ProbeDistrib
 {
   QVector<double>* distribValues = nullptr;
   QVector<double>* errorValues = nullptr;
-  QVector<float> samplPtsX;
-  QVector<float> samplPtsY;
-  QVector<float> samplPtsZ;
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
-#else
-  QVector<TriAreaAndNormals> selectedTris;
-#endif
+  const QVector<float>* samplPtsX = nullptr;
+  const QVector<float>* samplPtsY = nullptr;
+  const QVector<float>* samplPtsZ = nullptr;
+  const std::vector<TriAreaAndNormals>* selectedTris = nullptr;
+  const SphericalNormalIndex* normalIndex = nullptr;
   float planeResolSq;
   double totalFaceArea;
   int numDistinctGBs;
@@ -336,19 +344,16 @@ class ProbeDistrib
   float (&gFixedT)[3][3];
 
 public:
-  ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, QVector<float> __samplPtsX, QVector<float> __samplPtsY, QVector<float> __samplPtsZ,
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
-#else
-               QVector<TriAreaAndNormals> __selectedTris,
-#endif
-               float __planeResolSq, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, float (&__gFixedT)[3][3])
+  ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, const QVector<float>* __samplPtsX, const QVector<float>* __samplPtsY, const QVector<float>* __samplPtsZ,
+               const std::vector<TriAreaAndNormals>* __selectedTris, const SphericalNormalIndex* __normalIndex, float __planeResolSq, double __totalFaceArea, int __numDistinctGBs,
+               double __ballVolume, float (&__gFixedT)[3][3])
   : distribValues(__distribValues)
   , errorValues(__errorValues)
   , samplPtsX(__samplPtsX)
   , samplPtsY(__samplPtsY)
   , samplPtsZ(__samplPtsZ)
   , selectedTris(__selectedTris)
+  , normalIndex(__normalIndex)
   , planeResolSq(__planeResolSq)
   , totalFaceArea(__totalFaceArea)
   , numDistinctGBs(__numDistinctGBs)
@@ -361,36 +366,52 @@ public:
 
   void probe(size_t start, size_t end) const
   {
+    std::vector<size_t> candidates;
+    std::vector<size_t> hits;
+
     for(size_t ptIdx = start; ptIdx < end; ptIdx++)
     {
-      float fixedNormal1[3] = {samplPtsX.at(ptIdx), samplPtsY.at(ptIdx), samplPtsZ.at(ptIdx)};
+      float fixedNormal1[3] = {samplPtsX->at(ptIdx), samplPtsY->at(ptIdx), samplPtsZ->at(ptIdx)};
       float fixedNormal2[3] = {0.0f, 0.0f, 0.0f};
       MatrixMath::Multiply3x3with3x1(gFixedT, fixedNormal1, fixedNormal2);
 
-      for(int triRepresIdx = 0; triRepresIdx < static_cast<int>(selectedTris.size()); triRepresIdx++)
+      hits.clear();
+      for(int inversion = 0; inversion <= 1; inversion++)
       {
-        for(int inversion = 0; inversion <= 1; inversion++)
+        float sign = 1.0f;
+        if(inversion == 1)
         {
-          float sign = 1.0f;
-          if(inversion == 1)
-          {
-            sign = -1.0f;
-          }
+          sign = -1.0f;
+        }
 
-          float theta1 = acosf(sign * (selectedTris[triRepresIdx].normal_grain1_x * fixedNormal1[0] + selectedTris[triRepresIdx].normal_grain1_y * fixedNormal1[1] +
-                                       selectedTris[triRepresIdx].normal_grain1_z * fixedNormal1[2]));
+        float direction[3] = {sign * fixedNormal1[0], sign * fixedNormal1[1], sign * fixedNormal1[2]};
+        candidates.clear();
+        normalIndex->findCandidates(direction, candidates);
 
-          float theta2 = acosf(-sign * (selectedTris[triRepresIdx].normal_grain2_x * fixedNormal2[0] + selectedTris[triRepresIdx].normal_grain2_y * fixedNormal2[1] +
-                                        selectedTris[triRepresIdx].normal_grain2_z * fixedNormal2[2]));
+        for(const auto& triRepresIdx : candidates)
+        {
+          const TriAreaAndNormals& tri = (*selectedTris)[triRepresIdx];
+
+          float theta1 = acosf(sign * (tri.normal_grain1_x * fixedNormal1[0] + tri.normal_grain1_y * fixedNormal1[1] + tri.normal_grain1_z * fixedNormal1[2]));
+
+          float theta2 = acosf(-sign * (tri.normal_grain2_x * fixedNormal2[0] + tri.normal_grain2_y * fixedNormal2[1] + tri.normal_grain2_z * fixedNormal2[2]));
 
           float distSq = 0.5f * (theta1 * theta1 + theta2 * theta2);
 
           if(distSq < planeResolSq)
           {
-            (*distribValues)[ptIdx] += selectedTris[triRepresIdx].area;
+            hits.push_back(2 * triRepresIdx + inversion);
           }
         }
       }
+
+      // Sum in representation order so the result does not depend on the index layout
+      std::sort(hits.begin(), hits.end());
+      for(const auto& hit : hits)
+      {
+        (*distribValues)[ptIdx] += (*selectedTris)[hit / 2].area;
+      }
+
       (*errorValues)[ptIdx] = sqrt((*distribValues)[ptIdx] / totalFaceArea / double(numDistinctGBs)) / ballVolume;
 
       (*distribValues)[ptIdx] /= totalFaceArea;
@@ -885,49 +906,62 @@ void FindGBCDMetricBased::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
-  tbb::concurrent_vector<GBCDMetricBased::TriAreaAndNormals> selectedTris(0);
-#else
-  QVector<GBCDMetricBased::TriAreaAndNormals> selectedTris(0);
 #endif
 
   QVector<int8_t> triIncluded(numMeshTris, 0);
 
-  size_t trisChunkSize = 50000;
-  if(numMeshTris < trisChunkSize)
+  ss = QObject::tr("|| Step 1/2: Selecting Triangles with the Specified Misorientation");
+  notifyStatusMessage(ss);
+
+  size_t numTrisBlocks = (numMeshTris + GBCDMetricBased::k_TrisBlockSize - 1) / GBCDMetricBased::k_TrisBlockSize;
+  std::vector<std::vector<GBCDMetricBased::TriAreaAndNormals>> blockTris(numTrisBlocks);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    trisChunkSize = numMeshTris;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTrisBlocks),
+                      GBCDMetricBased::TrisSelector(m_ExcludeTripleLines, m_Triangles, m_NodeTypes, &blockTris, numMeshTris, &triIncluded, m_misorResol, m_PhaseOfInterest, gFixedT, m_CrystalStructures,
+                                                    m_Eulers, m_Phases, m_FaceLabels, m_FaceNormals, m_FaceAreas),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    GBCDMetricBased::TrisSelector serial(m_ExcludeTripleLines, m_Triangles, m_NodeTypes, &blockTris, numMeshTris, &triIncluded, m_misorResol, m_PhaseOfInterest, gFixedT, m_CrystalStructures, m_Eulers,
+                                         m_Phases, m_FaceLabels, m_FaceNormals, m_FaceAreas);
+    serial.selectBlocks(0, numTrisBlocks);
   }
 
-  for(size_t i = 0; i < numMeshTris; i = i + trisChunkSize)
+  if(getCancel())
   {
-    if(getCancel())
-    {
-      return;
-    }
-    ss = QObject::tr("|| Step 1/2: Selecting Triangles with the Specified Misorientation (%1% completed)").arg(int(100.0 * float(i) / float(numMeshTris)));
-    notifyStatusMessage(ss);
-    if(i + trisChunkSize >= numMeshTris)
-    {
-      trisChunkSize = numMeshTris - i;
-    }
+    return;
+  }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    if(doParallel)
+  std::vector<GBCDMetricBased::TriAreaAndNormals> selectedTris;
+  {
+    size_t numSelected = 0;
+    for(const auto& block : blockTris)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(i, i + trisChunkSize),
-                        GBCDMetricBased::TrisSelector(m_ExcludeTripleLines, m_Triangles, m_NodeTypes, &selectedTris, &triIncluded, m_misorResol, m_PhaseOfInterest, gFixedT, m_CrystalStructures,
-                                                      m_Eulers, m_Phases, m_FaceLabels, m_FaceNormals, m_FaceAreas),
-                        tbb::auto_partitioner());
+      numSelected += block.size();
     }
-    else
-#endif
+    selectedTris.reserve(numSelected);
+    for(auto& block : blockTris)
     {
-      GBCDMetricBased::TrisSelector serial(m_ExcludeTripleLines, m_Triangles, m_NodeTypes, &selectedTris, &triIncluded, m_misorResol, m_PhaseOfInterest, gFixedT, m_CrystalStructures, m_Eulers,
-                                           m_Phases, m_FaceLabels, m_FaceNormals, m_FaceAreas);
-      serial.select(i, i + trisChunkSize);
+      selectedTris.insert(selectedTris.end(), block.begin(), block.end());
+      std::vector<GBCDMetricBased::TriAreaAndNormals>().swap(block);
     }
   }
 
+  // Index the first normal of every representation; the distance test needs it within sqrt(2) * plane resolution of the sampling point
+  std::vector<float> selectedNormals(3 * selectedTris.size());
+  for(size_t triRepresIdx = 0; triRepresIdx < selectedTris.size(); triRepresIdx++)
+  {
+    selectedNormals[3 * triRepresIdx] = selectedTris[triRepresIdx].normal_grain1_x;
+    selectedNormals[3 * triRepresIdx + 1] = selectedTris[triRepresIdx].normal_grain1_y;
+    selectedNormals[3 * triRepresIdx + 2] = selectedTris[triRepresIdx].normal_grain1_z;
+  }
+  SphericalNormalIndex normalIndex(selectedNormals.data(), selectedTris.size(), sqrtf(2.0f) * m_planeResol);
+
   // ------------------------  find the number of distinct boundaries ------------------------------
   int32_t numDistinctGBs = 0;
   int32_t numFaceFeatures = m_SurfaceMeshFeatureFaceLabelsPtr.lock()->getNumberOfTuples();
@@ -963,7 +997,8 @@ void FindGBCDMetricBased::execute()
   QVector<double> distribValues(samplPtsX.size(), 0.0);
   QVector<double> errorValues(samplPtsX.size(), 0.0);
 
-  int32_t pointsChunkSize = 100;
+  // Report progress (and check for cancel) in 1% steps
+  int32_t pointsChunkSize = std::max(100, samplPtsX.size() / 100);
   if(samplPtsX.size() < pointsChunkSize)
   {
     pointsChunkSize = samplPtsX.size();
@@ -986,13 +1021,15 @@ void FindGBCDMetricBased::execute()
     if(doParallel)
     {
       tbb::parallel_for(tbb::blocked_range<size_t>(i, i + pointsChunkSize),
-                        GBCDMetricBased::ProbeDistrib(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, selectedTris, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT),
+                        GBCDMetricBased::ProbeDistrib(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, &selectedTris, &normalIndex, m_PlaneResolSq, totalFaceArea, numDistinctGBs,
+                                                      ballVolume, gFixedT),
                         tbb::auto_partitioner());
     }
     else
 #endif
     {
-      GBCDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, selectedTris, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT);
+      GBCDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, &selectedTris, &normalIndex, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume,
+                                           gFixedT);
       serial.probe(i, i + pointsChunkSize);
     }
   }
@@ -45,7 +45,9 @@
 
 #include "FindGBPDMetricBased.h"
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include <QtCore/QDir>
 #include <QtCore/QTextStream>
@@ -69,9 +71,9 @@
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/SphericalNormalIndex.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include "tbb/concurrent_vector.h"
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 #include <tbb/partitioner.h>
@@ -83,6 +85,11 @@ using LaueOpsContainer = std::vector<LaueOpsShPtrType>;
 
 namespace GBPDMetricBased
 {
+/**
+ * @brief Triangles are selected in blocks of this size; each block collects its own selections so the
+ * combined list keeps the mesh order no matter how the blocks are scheduled.
+ */
+const size_t k_TrisBlockSize = 4096;
 
 /**
  * @brief The TriAreaAndNormals class defines a container that stores the area of a given triangle
@@ -131,11 +138,8 @@ class TrisSelector
   bool m_ExcludeTripleLines;
   MeshIndexType* m_Triangles = nullptr;
   int8_t* m_NodeTypes = nullptr;
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals>* selectedTris;
-#else
-  QVector<TriAreaAndNormals>* selectedTris;
-#endif
+  std::vector<std::vector<TriAreaAndNormals>>* blockTris = nullptr;
+  size_t numTris;
   int32_t m_PhaseOfInterest;
   LaueOpsContainer m_OrientationOps;
   uint32_t cryst;
@@ -147,18 +151,13 @@ class TrisSelector
   double* m_FaceAreas = nullptr;
 
 public:
-  TrisSelector(bool __m_ExcludeTripleLines, MeshIndexType* __m_Triangles, int8_t* __m_NodeTypes,
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals>* __selectedTris,
-#else
-               QVector<TriAreaAndNormals>* __selectedTris,
-#endif
+  TrisSelector(bool __m_ExcludeTripleLines, MeshIndexType* __m_Triangles, int8_t* __m_NodeTypes, std::vector<std::vector<TriAreaAndNormals>>* __blockTris, size_t __numTris,
                int32_t __m_PhaseOfInterest, uint32_t* __m_CrystalStructures, float* __m_Eulers, int32_t* __m_Phases, int32_t* __m_FaceLabels, double* __m_FaceNormals, double* __m_FaceAreas)
   : m_ExcludeTripleLines(__m_ExcludeTripleLines)
   , m_Triangles(__m_Triangles)
   , m_NodeTypes(__m_NodeTypes)
-  , selectedTris(__selectedTris)
+  , blockTris(__blockTris)
+  , numTris(__numTris)
   , m_PhaseOfInterest(__m_PhaseOfInterest)
   , m_Eulers(__m_Eulers)
   , m_Phases(__m_Phases)
@@ -173,7 +172,7 @@ public:
 
   virtual ~TrisSelector() = default;
 
-  void select(size_t start, size_t end) const
+  void select(size_t start, size_t end, std::vector<TriAreaAndNormals>& selectedTris) const
   {
     float g1ea[3] = {0.0f, 0.0f, 0.0f};
     float g2ea[3] = {0.0f, 0.0f, 0.0f};
@@ -231,21 +230,33 @@ public:
       MatrixMath::Multiply3x3with3x1(g1, normal_lab, normal_grain1);
       MatrixMath::Multiply3x3with3x1(g2, normal_lab, normal_grain2);
 
-      (*selectedTris).push_back(TriAreaAndNormals(m_FaceAreas[triIdx], normal_grain1[0], normal_grain1[1], normal_grain1[2], -normal_grain2[0], -normal_grain2[1], -normal_grain2[2]));
+      selectedTris.push_back(TriAreaAndNormals(m_FaceAreas[triIdx], normal_grain1[0], normal_grain1[1], normal_grain1[2], -normal_grain2[0], -normal_grain2[1], -normal_grain2[2]));
+    }
+  }
+
+  void selectBlocks(size_t startBlock, size_t endBlock) const
+  {
+    for(size_t block = startBlock; block < endBlock; block++)
+    {
+      size_t start = block * k_TrisBlockSize;
+      size_t end = std::min(start + k_TrisBlockSize, numTris);
+      select(start, end, (*blockTris)[block]);
     }
   }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   void operator()(const tbb::blocked_range<size_t>& r) const
   {
-    select(r.begin(), r.end());
+    selectBlocks(r.begin(), r.end());
   }
 #endif
 };
 
 /**
  * @brief The ProbeDistrib class implements a threaded algorithm that determines the distribution values
- * for the GBPD
+ * for the GBPD. A symmetrized normal sym * n lies within the limit distance of the probe direction p exactly
+ * when n lies within it of transpose(sym) * p, so for each symmetry operator the triangle normals near that
+ * rotated direction (and its inverse) are looked up in a SphericalNormalIndex instead of testing every normal.
  */
 class ProbeDistrib
 {
@@ -254,11 +265,8 @@ class ProbeDistrib
   QVector<float>* samplPtsX;
   QVector<float>* samplPtsY;
   QVector<float>* samplPtsZ;
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
-#else
-  QVector<TriAreaAndNormals> selectedTris;
-#endif
+  const std::vector<TriAreaAndNormals>* selectedTris;
+  const SphericalNormalIndex* normalIndex;
   float limitDist;
   double totalFaceArea;
   int numDistinctGBs;
@@ -268,18 +276,15 @@ class ProbeDistrib
 
 public:
   ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, QVector<float>* __samplPtsX, QVector<float>* __samplPtsY, QVector<float>* __samplPtsZ,
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
-#else
-               QVector<TriAreaAndNormals> __selectedTris,
-#endif
-               float __limitDist, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, int32_t __cryst)
+               const std::vector<TriAreaAndNormals>* __selectedTris, const SphericalNormalIndex* __normalIndex, float __limitDist, double __totalFaceArea, int __numDistinctGBs,
+               double __ballVolume, int32_t __cryst)
   : distribValues(__distribValues)
   , errorValues(__errorValues)
   , samplPtsX(__samplPtsX)
   , samplPtsY(__samplPtsY)
   , samplPtsZ(__samplPtsZ)
   , selectedTris(__selectedTris)
+  , normalIndex(__normalIndex)
   , limitDist(__limitDist)
   , totalFaceArea(__totalFaceArea)
   , numDistinctGBs(__numDistinctGBs)
@@ -294,62 +299,76 @@ public:
 
   void probe(size_t start, size_t end) const
   {
+    std::vector<size_t> candidates;
+    // Each hit is keyed ((triRepresIdx * nsym + symOp) * 2 + inversion) * 2 + whichNormal
+    std::vector<uint64_t> hits;
+
     for(size_t ptIdx = start; ptIdx < end; ptIdx++)
     {
       double __c = 0.0;
 
       float probeNormal[3] = {(*samplPtsX).at(ptIdx), (*samplPtsY).at(ptIdx), (*samplPtsZ).at(ptIdx)};
 
-      for(int triRepresIdx = 0; triRepresIdx < static_cast<int>(selectedTris.size()); triRepresIdx++)
-      {
-        float normal1[3] = {selectedTris[triRepresIdx].normal_grain1_x, selectedTris[triRepresIdx].normal_grain1_y, selectedTris[triRepresIdx].normal_grain1_z};
-
-        float normal2[3] = {selectedTris[triRepresIdx].normal_grain2_x, selectedTris[triRepresIdx].normal_grain2_y, selectedTris[triRepresIdx].normal_grain2_z};
+      float sym[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+      float symT[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
 
-        float sym[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+      hits.clear();
+      for(int j = 0; j < nsym; j++)
+      {
+        m_OrientationOps[cryst]->getMatSymOp(j, sym);
+        MatrixMath::Transpose3x3(sym, symT);
+        float symProbe[3] = {0.0f, 0.0f, 0.0f};
+        MatrixMath::Multiply3x3with3x1(symT, probeNormal, symProbe);
 
-        for(int j = 0; j < nsym; j++)
+        for(int inversion = 0; inversion <= 1; inversion++)
         {
-          m_OrientationOps[cryst]->getMatSymOp(j, sym);
-
-          float sym_normal1[3] = {0.0f, 0.0f, 0.0f};
-          float sym_normal2[3] = {0.0f, 0.0f, 0.0f};
+          float sign = 1.0f;
+          if(inversion == 1)
+          {
+            sign = -1.0f;
+          }
 
-          MatrixMath::Multiply3x3with3x1(sym, normal1, sym_normal1);
-          MatrixMath::Multiply3x3with3x1(sym, normal2, sym_normal2);
+          float direction[3] = {sign * symProbe[0], sign * symProbe[1], sign * symProbe[2]};
+          candidates.clear();
+          normalIndex->findCandidates(direction, candidates);
 
-          for(int inversion = 0; inversion <= 1; inversion++)
+          for(const auto& candidate : candidates)
           {
-            float sign = 1.0f;
-            if(inversion == 1)
+            size_t triRepresIdx = candidate / 2;
+            const TriAreaAndNormals& tri = (*selectedTris)[triRepresIdx];
+            float normal[3] = {tri.normal_grain1_x, tri.normal_grain1_y, tri.normal_grain1_z};
+            if(candidate % 2 == 1)
             {
-              sign = -1.0f;
+              normal[0] = tri.normal_grain2_x;
+              normal[1] = tri.normal_grain2_y;
+              normal[2] = tri.normal_grain2_z;
             }
 
-            float gamma1 = acosf(sign * (probeNormal[0] * sym_normal1[0] + probeNormal[1] * sym_normal1[1] + probeNormal[2] * sym_normal1[2]));
+            float sym_normal[3] = {0.0f, 0.0f, 0.0f};
+            MatrixMath::Multiply3x3with3x1(sym, normal, sym_normal);
 
-            float gamma2 = acosf(sign * (probeNormal[0] * sym_normal2[0] + probeNormal[1] * sym_normal2[1] + probeNormal[2] * sym_normal2[2]));
+            float gamma = acosf(sign * (probeNormal[0] * sym_normal[0] + probeNormal[1] * sym_normal[1] + probeNormal[2] * sym_normal[2]));
 
-            if(gamma1 < limitDist)
+            if(gamma < limitDist)
             {
-              // Kahan summation algorithm
-              double __y = selectedTris[triRepresIdx].area - __c;
-              double __t = (*distribValues)[ptIdx] + __y;
-              __c = (__t - (*distribValues)[ptIdx]);
-              __c -= __y;
-              (*distribValues)[ptIdx] = __t;
-            }
-            if(gamma2 < limitDist)
-            {
-              double __y = selectedTris[triRepresIdx].area - __c;
-              double __t = (*distribValues)[ptIdx] + __y;
-              __c = (__t - (*distribValues)[ptIdx]);
-              __c -= __y;
-              (*distribValues)[ptIdx] = __t;
+              hits.push_back(((static_cast<uint64_t>(triRepresIdx) * nsym + j) * 2 + inversion) * 2 + candidate % 2);
             }
           }
         }
       }
+
+      // Sum in the order the full triangle loop would visit the hits so the result does not depend on the index layout
+      std::sort(hits.begin(), hits.end());
+      for(const auto& hit : hits)
+      {
+        // Kahan summation algorithm
+        double __y = (*selectedTris)[hit / 4 / nsym].area - __c;
+        double __t = (*distribValues)[ptIdx] + __y;
+        __c = (__t - (*distribValues)[ptIdx]);
+        __c -= __y;
+        (*distribValues)[ptIdx] = __t;
+      }
+
       (*errorValues)[ptIdx] = sqrt((*distribValues)[ptIdx] / totalFaceArea / double(numDistinctGBs)) / ballVolume;
       (*distribValues)[ptIdx] /= totalFaceArea;
       (*distribValues)[ptIdx] /= ballVolume;
@@ -969,47 +988,64 @@ void FindGBPDMetricBased::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
-  tbb::concurrent_vector<GBPDMetricBased::TriAreaAndNormals> selectedTris(0);
-#else
-  QVector<GBPDMetricBased::TriAreaAndNormals> selectedTris(0);
 #endif
 
-  size_t trisChunkSize = 50000;
-  if(numMeshTris < trisChunkSize)
+  ss = QObject::tr("--> Selecting triangles corresponding to Phase Of Interest");
+  notifyStatusMessage(ss);
+
+  size_t numTrisBlocks = (numMeshTris + GBPDMetricBased::k_TrisBlockSize - 1) / GBPDMetricBased::k_TrisBlockSize;
+  std::vector<std::vector<GBPDMetricBased::TriAreaAndNormals>> blockTris(numTrisBlocks);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    trisChunkSize = numMeshTris;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTrisBlocks),
+                      GBPDMetricBased::TrisSelector(m_ExcludeTripleLines, m_Triangles, m_NodeTypes, &blockTris, numMeshTris, m_PhaseOfInterest, m_CrystalStructures, m_Eulers, m_Phases, m_FaceLabels,
+                                                    m_FaceNormals, m_FaceAreas),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    GBPDMetricBased::TrisSelector serial(m_ExcludeTripleLines, m_Triangles, m_NodeTypes, &blockTris, numMeshTris, m_PhaseOfInterest, m_CrystalStructures, m_Eulers, m_Phases, m_FaceLabels,
+                                         m_FaceNormals, m_FaceAreas);
+    serial.selectBlocks(0, numTrisBlocks);
   }
 
-  for(size_t i = 0; i < numMeshTris; i = i + trisChunkSize)
+  if(getCancel())
   {
-    if(getCancel())
-    {
-      return;
-    }
-    ss = QObject::tr("--> Selecting triangles corresponding to Phase Of Interest");
-    notifyStatusMessage(ss);
-    if(i + trisChunkSize >= numMeshTris)
-    {
-      trisChunkSize = numMeshTris - i;
-    }
+    return;
+  }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    if(doParallel)
+  std::vector<GBPDMetricBased::TriAreaAndNormals> selectedTris;
+  {
+    size_t numSelected = 0;
+    for(const auto& block : blockTris)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(i, i + trisChunkSize),
-                        GBPDMetricBased::TrisSelector(m_ExcludeTripleLines, m_Triangles, m_NodeTypes, &selectedTris, m_PhaseOfInterest, m_CrystalStructures, m_Eulers, m_Phases, m_FaceLabels,
-                                                      m_FaceNormals, m_FaceAreas),
-                        tbb::auto_partitioner());
+      numSelected += block.size();
     }
-    else
-#endif
+    selectedTris.reserve(numSelected);
+    for(auto& block : blockTris)
     {
-      GBPDMetricBased::TrisSelector serial(m_ExcludeTripleLines, m_Triangles, m_NodeTypes, &selectedTris, m_PhaseOfInterest, m_CrystalStructures, m_Eulers, m_Phases, m_FaceLabels, m_FaceNormals,
-                                           m_FaceAreas);
-      serial.select(i, i + trisChunkSize);
+      selectedTris.insert(selectedTris.end(), block.begin(), block.end());
+      std::vector<GBPDMetricBased::TriAreaAndNormals>().swap(block);
     }
   }
 
+  // Index both crystal frame normals of every selected triangle, entry 2 * i for grain 1 and 2 * i + 1 for grain 2
+  std::vector<float> selectedNormals(6 * selectedTris.size());
+  for(size_t triRepresIdx = 0; triRepresIdx < selectedTris.size(); triRepresIdx++)
+  {
+    float* normals = selectedNormals.data() + 6 * triRepresIdx;
+    normals[0] = selectedTris[triRepresIdx].normal_grain1_x;
+    normals[1] = selectedTris[triRepresIdx].normal_grain1_y;
+    normals[2] = selectedTris[triRepresIdx].normal_grain1_z;
+    normals[3] = selectedTris[triRepresIdx].normal_grain2_x;
+    normals[4] = selectedTris[triRepresIdx].normal_grain2_y;
+    normals[5] = selectedTris[triRepresIdx].normal_grain2_z;
+  }
+  SphericalNormalIndex normalIndex(selectedNormals.data(), 2 * selectedTris.size(), m_LimitDist);
+
   // ------------------------  find the number of distinct boundaries ------------------------------
   int32_t numDistinctGBs = 0;
   int32_t numFaceFeatures = m_SurfaceMeshFeatureFaceLabelsPtr.lock()->getNumberOfTuples();
@@ -1037,15 +1073,16 @@ void FindGBPDMetricBased::execute()
 
   // ----------------- determining distribution values at the sampling points (and their errors) ---
   double totalFaceArea = 0.0;
-  for(int i = 0; i < static_cast<int>(selectedTris.size()); i++)
+  for(const auto& tri : selectedTris)
   {
-    totalFaceArea += selectedTris.at(i).area;
+    totalFaceArea += tri.area;
   }
 
   QVector<double> distribValues(samplPtsX.size(), 0.0);
   QVector<double> errorValues(samplPtsX.size(), 0.0);
 
-  int32_t pointsChunkSize = 20;
+  // Report progress (and check for cancel) in 1% steps
+  int32_t pointsChunkSize = std::max(20, samplPtsX.size() / 100);
   if(samplPtsX.size() < pointsChunkSize)
   {
     pointsChunkSize = samplPtsX.size();
@@ -1068,13 +1105,15 @@ void FindGBPDMetricBased::execute()
     if(doParallel)
     {
       tbb::parallel_for(tbb::blocked_range<size_t>(i, i + pointsChunkSize),
-                        GBPDMetricBased::ProbeDistrib(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst),
+                        GBPDMetricBased::ProbeDistrib(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, &selectedTris, &normalIndex, m_LimitDist, totalFaceArea, numDistinctGBs,
+                                                      ballVolume, cryst),
                         tbb::auto_partitioner());
     }
     else
 #endif
     {
-      GBPDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst);
+      GBPDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, &selectedTris, &normalIndex, m_LimitDist, totalFaceArea, numDistinctGBs,
+                                           ballVolume, cryst);
       serial.probe(i, i + pointsChunkSize);
     }
   }
@@ -239,41 +239,59 @@ void FindMisorientations::execute()
 
   size_t tempMisoList = 0;
 
-  uint32_t xtalType1 = 0, xtalType2 = 0;
-  int32_t nname = 0;
+  auto misorientation = [this](int32_t feature1, int32_t feature2) -> float {
+    uint32_t xtalType1 = m_CrystalStructures[m_FeaturePhases[feature1]];
+    uint32_t xtalType2 = m_CrystalStructures[m_FeaturePhases[feature2]];
+    if(xtalType1 != xtalType2 || static_cast<int64_t>(xtalType1) >= static_cast<int64_t>(m_OrientationOps.size()))
+    {
+      return NAN;
+    }
+    QuatF q1(m_AvgQuats + feature1 * 4);
+    QuatF q2(m_AvgQuats + feature2 * 4);
+    OrientationD axisAngle = m_OrientationOps[xtalType1]->calculateMisorientation(q1, q2);
+    return static_cast<float>(axisAngle[3] * SIMPLib::Constants::k_180OverPi);
+  };
 
   misorientationlists.resize(totalFeatures);
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    QuatF q1(m_AvgQuats + i * 4);
-    xtalType1 = m_CrystalStructures[m_FeaturePhases[i]];
     NeighborList<int32_t>::VectorType& featureNeighborList = neighborlist[i];
 
     misorientationlists[i].assign(featureNeighborList.size(), -1.0);
+    tempMisoList = featureNeighborList.size();
 
     for(size_t j = 0; j < featureNeighborList.size(); j++)
     {
-      nname = featureNeighborList[j];
-      QuatF q2(m_AvgQuats + nname * 4);
-      xtalType2 = m_CrystalStructures[m_FeaturePhases[nname]];
-      tempMisoList = featureNeighborList.size();
-      if(xtalType1 == xtalType2 && static_cast<int64_t>(xtalType1) < static_cast<int64_t>(m_OrientationOps.size()))
+      int32_t nname = featureNeighborList[j];
+      // Every boundary appears in the lists of both of its Features; reuse the value found from the other side
+      bool found = false;
+      if(nname > 0 && static_cast<size_t>(nname) < i)
       {
-        OrientationD axisAngle = m_OrientationOps[xtalType1]->calculateMisorientation(q1, q2);
-
-        misorientationlists[i][j] = axisAngle[3] * SIMPLib::Constants::k_180OverPi;
-        if(m_FindAvgMisors)
+        NeighborList<int32_t>::VectorType& otherNeighborList = neighborlist[nname];
+        for(size_t k = 0; k < otherNeighborList.size(); k++)
         {
-          m_AvgMisorientations[i] += misorientationlists[i][j];
+          if(otherNeighborList[k] == static_cast<int32_t>(i))
+          {
+            misorientationlists[i][j] = misorientationlists[nname][k];
+            found = true;
+            break;
+          }
         }
       }
-      else
+      if(!found)
       {
-        if(m_FindAvgMisors)
+        misorientationlists[i][j] = misorientation(static_cast<int32_t>(i), nname);
+      }
+      if(m_FindAvgMisors)
+      {
+        if(std::isnan(misorientationlists[i][j]))
         {
           tempMisoList--;
         }
-        misorientationlists[i][j] = NAN;
+        else
+        {
+          m_AvgMisorientations[i] += misorientationlists[i][j];
+        }
       }
     }
     if(m_FindAvgMisors)
@@ -286,7 +304,6 @@ void FindMisorientations::execute()
       {
         m_AvgMisorientations[i] = NAN;
       }
-      tempMisoList = 0;
     }
   }
 
@@ -31,6 +31,8 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ImportEbsdMontage.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 #include <QtCore/QTextStream>
@@ -43,6 +45,7 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataArrays/StringDataArray.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/Montages/GridMontage.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -63,9 +66,19 @@
 #include "OrientationAnalysis/OrientationAnalysisFilters/ReadCtfData.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 enum createdPathID : RenameDataPath::DataID_t
 {
-  DataArrayID31 = 31
+  AttributeMatrixID21 = 21,
+
+  DataArrayID31 = 31,
+
+  DataContainerID = 1
 };
 
 // -----------------------------------------------------------------------------
@@ -119,6 +132,7 @@ void ImportEbsdMontage::setupFilterParameters()
     parameters.push_back(SIMPL_NEW_INT_VEC2_FP("Pixel Overlap Value (X, Y)", ScanOverlapPixel, FilterParameter::Parameter, ImportEbsdMontage, 1));
     parameters.push_back(SIMPL_NEW_FLOAT_VEC2_FP("Percent Overlap Value (X, Y)", ScanOverlapPercent, FilterParameter::Parameter, ImportEbsdMontage, 2));
   }
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Stitch Tiles into a Single Image Geometry", StitchTiles, FilterParameter::Parameter, ImportEbsdMontage));
 
   {
     QStringList linkedProps("CellIPFColorsArrayName");
@@ -128,27 +142,49 @@ void ImportEbsdMontage::setupFilterParameters()
   setFilterParameters(parameters);
 }
 
+namespace
+{
+/**
+ * @brief The MontageTile struct holds the reader sub-filter of a single tile together with the private
+ * DataContainerArray it reads into, so that tiles can be read concurrently without touching the filter's
+ * DataContainerArray.
+ */
+struct MontageTile
+{
+  QString fileName;
+  QString dcName;
+  AbstractFilter::Pointer reader;
+  DataContainerArray::Pointer dca;
+  SizeVec3Type dims = {0, 0, 0};
+  std::array<size_t, 2> pixelOffset = {{0, 0}};
+  std::array<size_t, 2> pixelExtent = {{0, 0}};
+};
+
+/**
+ * @brief The StitchedMontage struct describes the single Image Geometry that the tiles are copied into
+ */
+struct StitchedMontage
+{
+  size_t width = 0;
+  QString cellAttributeMatrixName;
+  AttributeMatrix::Pointer cellAttrMat;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 template <class EbsdReaderClass>
-void readEbsdFile(ImportEbsdMontage* filter, const QString& fileName, std::map<QString, AbstractFilter::Pointer>& prevFilterCache, std::map<QString, AbstractFilter::Pointer>& newFilterCache)
+AbstractFilter::Pointer createEbsdReader(ImportEbsdMontage* filter, const QString& fileName, const std::map<QString, AbstractFilter::Pointer>& prevFilterCache,
+                                         std::map<QString, AbstractFilter::Pointer>& newFilterCache)
 {
   QFileInfo fi(fileName);
   QString fname = fi.completeBaseName();
-  if(filter->getDataContainerArray()->doesDataContainerExist(fname))
-  {
-    QString msg = QString("Error: DataContainer '%1' already exists in the DataContainerArray.").arg(fname);
-    filter->setErrorCondition(-74000, msg);
-    return;
-  }
-
-  DataContainerArray::Pointer dca = DataContainerArray::New();
 
   typename EbsdReaderClass::Pointer reader = EbsdReaderClass::NullPointer();
-  if(prevFilterCache.find(fileName) != prevFilterCache.end())
+  auto cachedReader = prevFilterCache.find(fileName);
+  if(cachedReader != prevFilterCache.end())
   {
-    reader = std::dynamic_pointer_cast<EbsdReaderClass>(prevFilterCache[fileName]);
+    reader = std::dynamic_pointer_cast<EbsdReaderClass>(cachedReader->second);
   }
   else
   {
@@ -157,26 +193,314 @@ void readEbsdFile(ImportEbsdMontage* filter, const QString& fileName, std::map<Q
     reader->setDataContainerName(DataArrayPath(fname));
   }
   newFilterCache[fileName] = reader;
-  reader->setDataContainerArray(dca);
   reader->setCellEnsembleAttributeMatrixName(filter->getCellEnsembleAttributeMatrixName());
   reader->setCellAttributeMatrixName(filter->getCellAttributeMatrixName());
-  if(filter->getInPreflight())
+  return reader;
+}
+
+// -----------------------------------------------------------------------------
+// Copies the part of a tile that is not covered by a later tile into the stitched Cell Attribute Matrix.
+// Every tile owns a disjoint region, so tiles can be copied concurrently.
+// -----------------------------------------------------------------------------
+void copyTileIntoMontage(const MontageTile& tile, const StitchedMontage& montage)
+{
+  DataContainer::Pointer dc = tile.dca->getDataContainer(tile.dcName);
+  AttributeMatrix::Pointer tileAttrMat = dc->getAttributeMatrix(montage.cellAttributeMatrixName);
+  size_t tileWidth = dc->getGeometryAs<ImageGeom>()->getXPoints();
+
+  for(const QString& name : montage.cellAttrMat->getAttributeArrayNames())
   {
-    reader->preflight();
+    IDataArray::Pointer destArray = montage.cellAttrMat->getAttributeArray(name);
+    IDataArray::Pointer srcArray = tileAttrMat->getAttributeArray(name);
+    if(nullptr == srcArray.get())
+    {
+      continue;
+    }
+    for(size_t y = 0; y < tile.pixelExtent[1]; y++)
+    {
+      size_t destTupleOffset = (tile.pixelOffset[1] + y) * montage.width + tile.pixelOffset[0];
+      destArray->copyFromArray(destTupleOffset, srcArray, y * tileWidth, tile.pixelExtent[0]);
+    }
+  }
+}
+
+/**
+ * @brief The ReadMontageTilesImpl class runs the reader sub-filters of a range of tiles. When a stitched montage
+ * is given each tile is copied into it as soon as it has been read and the tile's own data is released.
+ */
+class ReadMontageTilesImpl
+{
+public:
+  ReadMontageTilesImpl(std::vector<MontageTile>& tiles, bool preflight, const StitchedMontage* montage)
+  : m_Tiles(tiles)
+  , m_Preflight(preflight)
+  , m_Montage(montage)
+  {
+  }
+  virtual ~ReadMontageTilesImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      MontageTile& tile = m_Tiles[i];
+      if(m_Preflight)
+      {
+        tile.reader->preflight();
+      }
+      else
+      {
+        tile.reader->execute();
+      }
+
+      if(nullptr == m_Montage || m_Preflight || tile.reader->getErrorCode() < 0)
+      {
+        continue;
+      }
+      copyTileIntoMontage(tile, *m_Montage);
+      // The first tile still supplies the Ensemble Attribute Matrix of the montage
+      if(i != 0)
+      {
+        tile.reader->setDataContainerArray(DataContainerArray::New());
+        tile.dca.reset();
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  std::vector<MontageTile>& m_Tiles;
+  bool m_Preflight;
+  const StitchedMontage* m_Montage;
+};
+
+// -----------------------------------------------------------------------------
+// Each tile is a whole scan file, so the tiles are handed out one at a time to the worker threads.
+// -----------------------------------------------------------------------------
+void readMontageTiles(std::vector<MontageTile>& tiles, bool preflight, const StitchedMontage* montage)
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, tiles.size(), 1), ReadMontageTilesImpl(tiles, preflight, montage), tbb::simple_partitioner());
   }
   else
+#endif
+  {
+    ReadMontageTilesImpl serial(tiles, preflight, montage);
+    serial.convert(0, tiles.size());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool checkTileReaders(ImportEbsdMontage* filter, const std::vector<MontageTile>& tiles)
+{
+  for(const MontageTile& tile : tiles)
+  {
+    if(tile.reader->getErrorCode() < 0)
+    {
+      QString msg = QString("Sub filter (%1) caused an error while reading '%2'.").arg(tile.reader->getHumanLabel()).arg(tile.fileName);
+      filter->setErrorCondition(tile.reader->getErrorCode(), msg);
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// Places the tiles on a single Image Geometry named after the montage and, when the data is read, reads them
+// straight into it
+// -----------------------------------------------------------------------------
+bool stitchTiles(ImportEbsdMontage* filter, std::vector<MontageTile>& tiles, size_t numRows, size_t numCols, const IntVec2Type& scanOverlapPixel, bool readData)
+{
+  // Place the tiles on a common pixel grid using the same stepping as the tile origins of an unstitched montage
+  FloatVec3Type spacing = tiles[0].dca->getDataContainer(tiles[0].dcName)->getGeometryAs<ImageGeom>()->getSpacing();
+  FloatVec3Type origin = tiles[0].dca->getDataContainer(tiles[0].dcName)->getGeometryAs<ImageGeom>()->getOrigin();
+  size_t width = 0;
+  size_t height = 0;
+  size_t rowOffset = 0;
+  for(size_t row = 0; row < numRows; row++)
+  {
+    size_t colOffset = 0;
+    size_t rowStep = 0;
+    for(size_t col = 0; col < numCols; col++)
+    {
+      MontageTile& tile = tiles[row * numCols + col];
+      FloatVec3Type tileSpacing = tile.dca->getDataContainer(tile.dcName)->getGeometryAs<ImageGeom>()->getSpacing();
+      if(std::fabs(tileSpacing[0] - spacing[0]) > 1.0E-6f || std::fabs(tileSpacing[1] - spacing[1]) > 1.0E-6f)
+      {
+        QString ss = QObject::tr("Tiles can only be stitched when every tile has the same spacing. '%1' differs from the first tile.").arg(tile.fileName);
+        filter->setErrorCondition(-74002, ss);
+        return false;
+      }
+      if(static_cast<int64_t>(tile.dims[0]) <= scanOverlapPixel[0] || static_cast<int64_t>(tile.dims[1]) <= scanOverlapPixel[1])
+      {
+        QString ss = QObject::tr("The scan overlap is larger than the tile '%1'").arg(tile.fileName);
+        filter->setErrorCondition(-74003, ss);
+        return false;
+      }
+
+      tile.pixelOffset = {{colOffset, rowOffset}};
+      width = std::max(width, colOffset + tile.dims[0]);
+      height = std::max(height, rowOffset + tile.dims[1]);
+      colOffset += tile.dims[0] - static_cast<size_t>(scanOverlapPixel[0]);
+      rowStep = tile.dims[1] - static_cast<size_t>(scanOverlapPixel[1]);
+    }
+    rowOffset += rowStep;
+  }
+
+  // Later tiles win in the overlaps, so each tile only copies up to where the next tile starts. This keeps the
+  // regions disjoint so that they can be filled concurrently.
+  for(size_t row = 0; row < numRows; row++)
   {
-    reader->execute();
+    for(size_t col = 0; col < numCols; col++)
+    {
+      MontageTile& tile = tiles[row * numCols + col];
+      tile.pixelExtent[0] = tile.dims[0];
+      tile.pixelExtent[1] = tile.dims[1];
+      if(col + 1 < numCols)
+      {
+        tile.pixelExtent[0] = std::min(tile.pixelExtent[0], tiles[row * numCols + col + 1].pixelOffset[0] - tile.pixelOffset[0]);
+      }
+      if(row + 1 < numRows)
+      {
+        tile.pixelExtent[1] = std::min(tile.pixelExtent[1], tiles[(row + 1) * numCols + col].pixelOffset[1] - tile.pixelOffset[1]);
+      }
+    }
   }
-  if(reader->getErrorCode() < 0)
+
+  // Create the stitched Data Container with every cell array of the tiles allocated at its final size
+  DataContainer::Pointer m = filter->getDataContainerArray()->createNonPrereqDataContainer(filter, DataArrayPath(filter->getMontageName(), "", ""), DataContainerID);
+  if(filter->getErrorCode() < 0)
+  {
+    return false;
+  }
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+  image->setDimensions(SizeVec3Type(width, height, 1));
+  image->setSpacing(spacing);
+  image->setOrigin(FloatVec3Type(0.0f, 0.0f, origin[2]));
+  m->setGeometry(image);
+
+  std::vector<size_t> tDims = {width, height, 1};
+  AttributeMatrix::Pointer cellAttrMat = m->createNonPrereqAttributeMatrix(filter, filter->getCellAttributeMatrixName(), tDims, AttributeMatrix::Type::Cell, AttributeMatrixID21);
+  if(filter->getErrorCode() < 0)
+  {
+    return false;
+  }
+  AttributeMatrix::Pointer tileAttrMat = tiles[0].dca->getDataContainer(tiles[0].dcName)->getAttributeMatrix(filter->getCellAttributeMatrixName());
+  for(const QString& name : tileAttrMat->getAttributeArrayNames())
+  {
+    IDataArray::Pointer p = tileAttrMat->getAttributeArray(name);
+    IDataArray::Pointer data = p->createNewArray(width * height, p->getComponentDimensions(), p->getName(), readData);
+    if(readData)
+    {
+      data->initializeWithZeros();
+    }
+    cellAttrMat->insertOrAssign(data);
+  }
+
+  if(readData)
   {
-    QString msg = QString("Sub filter (%1) caused an error.").arg(reader->getHumanLabel());
-    filter->setErrorCondition(reader->getErrorCode(), msg);
+    // Read every tile straight into its place in the stitched arrays. Each tile needs a fresh DataContainerArray
+    // because the header pass already created its Data Container.
+    for(MontageTile& tile : tiles)
+    {
+      tile.dca = DataContainerArray::New();
+      tile.reader->setDataContainerArray(tile.dca);
+    }
+    StitchedMontage montage;
+    montage.width = width;
+    montage.cellAttributeMatrixName = filter->getCellAttributeMatrixName();
+    montage.cellAttrMat = cellAttrMat;
+    filter->notifyStatusMessage(QString("Reading and Stitching EBSD Files: %1 Tiles").arg(tiles.size()));
+    readMontageTiles(tiles, false, &montage);
+    if(!checkTileReaders(filter, tiles) || filter->getCancel())
+    {
+      return false;
+    }
+  }
+
+  // The phase information of the first tile describes the whole montage
+  AttributeMatrix::Pointer ensembleAttrMat = tiles[0].dca->getDataContainer(tiles[0].dcName)->getAttributeMatrix(filter->getCellEnsembleAttributeMatrixName());
+  m->addOrReplaceAttributeMatrix(ensembleAttrMat);
+  tiles[0].reader->setDataContainerArray(DataContainerArray::New());
+  tiles[0].dca.reset();
+  return true;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImportEbsdMontage::generateIPFColors(const QString& dcName, const QString& statusMessage, bool readData)
+{
+  if(getCellIPFColorsArrayName().isEmpty())
+  {
+    QString ss = QObject::tr("Generate IPF Colors is ENABLED. Please set name for the generated IPColors DataArray");
+    setErrorCondition(-23500, ss);
     return;
   }
 
-  DataContainer::Pointer dc = dca->getDataContainer(fname);
-  filter->getDataContainerArray()->addOrReplaceDataContainer(dc);
+  QString phasesName;
+  QString eulersName;
+  QString xtalName;
+  if(m_InputFileListInfo.FileExtension == EbsdLib::Ang::FileExt)
+  {
+    phasesName = EbsdLib::AngFile::Phases;
+    eulersName = EbsdLib::AngFile::EulerAngles;
+    xtalName = EbsdLib::AngFile::CrystalStructures;
+  }
+  if(m_InputFileListInfo.FileExtension == EbsdLib::Ctf::FileExt)
+  {
+    phasesName = EbsdLib::CtfFile::Phases;
+    eulersName = EbsdLib::CtfFile::EulerAngles;
+    xtalName = EbsdLib::CtfFile::CrystalStructures;
+  }
+
+  DataArrayPath dap(dcName, getCellAttributeMatrixName(), getCellIPFColorsArrayName());
+
+  GenerateIPFColors::Pointer generateIPFColors = GenerateIPFColors::New();
+  generateIPFColors->setDataContainerArray(getDataContainerArray());
+  generateIPFColors->setReferenceDir(m_ReferenceDir);
+  dap.setDataArrayName(phasesName);
+  generateIPFColors->setCellPhasesArrayPath(dap);
+  dap.setDataArrayName(eulersName);
+  generateIPFColors->setCellEulerAnglesArrayPath(dap);
+
+  dap.setAttributeMatrixName(getCellEnsembleAttributeMatrixName());
+  dap.setDataArrayName(xtalName);
+  generateIPFColors->setCrystalStructuresArrayPath(dap);
+  generateIPFColors->setUseGoodVoxels(false);
+
+  generateIPFColors->setCellIPFColorsArrayName(getCellIPFColorsArrayName());
+  if(!readData)
+  {
+    generateIPFColors->preflight();
+    if(generateIPFColors->getErrorCode() < 0)
+    {
+      QString ss = QObject::tr("Preflight of GenerateIPFColors failed with error code ").arg(generateIPFColors->getErrorCode());
+      setErrorCondition(generateIPFColors->getErrorCode(), ss);
+    }
+  }
+  else
+  {
+    notifyStatusMessage(statusMessage);
+    generateIPFColors->execute();
+    if(generateIPFColors->getErrorCode() < 0)
+    {
+      QString ss = QObject::tr("GenerateIPFColors failed with error code ").arg(generateIPFColors->getErrorCode());
+      setErrorCondition(generateIPFColors->getErrorCode(), ss);
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -187,6 +511,14 @@ void ImportEbsdMontage::dataCheck()
   clearErrorCode();
   clearWarningCode();
 
+  readMontage(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImportEbsdMontage::readMontage(bool readData)
+{
   DataArrayPath tempPath;
   QString ss;
 
@@ -229,63 +561,100 @@ void ImportEbsdMontage::dataCheck()
     return;
   }
 
-  int32_t numRows = static_cast<int32_t>(tileLayout2d.size());
-  int32_t numCols = static_cast<int32_t>(tileLayout2d[0].size());
-  int32_t totalTiles = numRows * numCols;
+  size_t numRows = tileLayout2d.size();
+  size_t numCols = tileLayout2d[0].size();
+  int32_t totalTiles = static_cast<int32_t>(numRows * numCols);
   int32_t tilesRead = 0;
 
   std::array<double, 2> globalTileOrigin = {{0.0, 0.0}};
 
-  std::map<QString, AbstractFilter::Pointer> oldCache = m_FilterCache;
-
   std::map<QString, AbstractFilter::Pointer> newFilterCache;
 
   size_t rows = static_cast<size_t>(m_InputFileListInfo.RowEnd - m_InputFileListInfo.RowStart);
   size_t cols = static_cast<size_t>(m_InputFileListInfo.ColEnd - m_InputFileListInfo.ColStart);
   GridMontage::Pointer gridMontage = GridMontage::New(getMontageName(), rows, cols);
 
-  // Read all the files, caching the pertainent information....
+  // Set up a reader and a private DataContainerArray for every tile before any file is read
+  std::vector<MontageTile> tiles;
+  tiles.reserve(numRows * numCols);
   for(const FilePathGenerator::TileRCIndexRow2D& tileRow2D : tileLayout2d)
   {
-    globalTileOrigin[0] = 0.0; // Reset the X Coord back to Zero for each row.
+    if(tileRow2D.size() != numCols)
+    {
+      ss = QObject::tr("Every row of the montage must have the same number of tiles");
+      setErrorCondition(-74001, ss);
+      return;
+    }
     for(const FilePathGenerator::TileRCIndex2D& tile2D : tileRow2D)
     {
-      tilesRead++;
+      MontageTile tile;
+      tile.fileName = tile2D.FileName;
       QFileInfo fi(tile2D.FileName);
-      QString fname = fi.completeBaseName();
+      tile.dcName = fi.completeBaseName();
       if(!fi.exists())
       {
         QString msg = QString("Input EBSD file '%1' does not exist").arg(tile2D.FileName);
         setErrorCondition(-56500, msg);
         continue;
       }
-      if(getInPreflight())
-      {
-        QString msg = QString("Caching EBSD Header: [%1/%2] %3").arg(tilesRead).arg(totalTiles).arg(tile2D.FileName);
-        notifyStatusMessage(msg);
-      }
-      else
+      if(!m_StitchTiles && getDataContainerArray()->doesDataContainerExist(tile.dcName))
       {
-        QString msg = QString("Read EBSD File: [%1/%2] %3").arg(tilesRead).arg(totalTiles).arg(tile2D.FileName);
-        notifyStatusMessage(msg);
+        QString msg = QString("Error: DataContainer '%1' already exists in the DataContainerArray.").arg(tile.dcName);
+        setErrorCondition(-74000, msg);
+        continue;
       }
-      GridTileIndex gridIndex = gridMontage->getTileIndex(tile2D.data[0], tile2D.data[1]);
 
       if(m_InputFileListInfo.FileExtension == EbsdLib::Ang::FileExt)
       {
-        readEbsdFile<ReadAngData>(this, tile2D.FileName, m_FilterCache, newFilterCache);
+        tile.reader = createEbsdReader<ReadAngData>(this, tile2D.FileName, m_FilterCache, newFilterCache);
       }
       if(m_InputFileListInfo.FileExtension == EbsdLib::Ctf::FileExt)
       {
-        readEbsdFile<ReadCtfData>(this, tile2D.FileName, m_FilterCache, newFilterCache);
+        tile.reader = createEbsdReader<ReadCtfData>(this, tile2D.FileName, m_FilterCache, newFilterCache);
       }
+      if(nullptr == tile.reader.get())
+      {
+        QString msg = QString("The file extension '%1' was not recognized. Only .ang and .ctf files are supported").arg(m_InputFileListInfo.FileExtension);
+        setErrorCondition(-74004, msg);
+        return;
+      }
+      tile.dca = DataContainerArray::New();
+      tile.reader->setDataContainerArray(tile.dca);
+      tiles.push_back(tile);
     }
   }
   // If anything went wrong bail out now.....
-  if(getErrorCode() < 0)
+  if(getErrorCode() < 0 || tiles.size() != numRows * numCols)
+  {
+    return;
+  }
+
+  // A stitched montage is sized from the tile headers, so the headers are read first. Without stitching the
+  // tiles are read completely right away.
+  bool readHeadersOnly = !readData || m_StitchTiles;
+  if(readHeadersOnly)
+  {
+    notifyStatusMessage(QString("Caching EBSD Headers: %1 Tiles").arg(totalTiles));
+  }
+  else
+  {
+    notifyStatusMessage(QString("Reading EBSD Files: %1 Tiles").arg(totalTiles));
+  }
+  readMontageTiles(tiles, readHeadersOnly, nullptr);
+  if(!checkTileReaders(this, tiles) || getCancel())
   {
     return;
   }
+  m_FilterCache = newFilterCache; // Swap our maps. This dumps any previous instantiations of the reader filter that are not used any more.
+  for(MontageTile& tile : tiles)
+  {
+    tile.dims = tile.dca->getDataContainer(tile.dcName)->getGeometryAs<ImageGeom>()->getDimensions();
+  }
+
+  auto tileGeometry = [&](size_t row, size_t col) -> ImageGeom::Pointer {
+    const MontageTile& tile = tiles[row * numCols + col];
+    return tile.dca->getDataContainer(tile.dcName)->getGeometryAs<ImageGeom>();
+  };
 
   tilesRead = 0;
 
@@ -304,71 +673,46 @@ void ImportEbsdMontage::dataCheck()
       m_ScanOverlapPercent[1] = m_ScanOverlapPercent[1] / 100.0f;
     }
     scanOverlapPixel = {0, 0};
-    QFileInfo fi;
-    if(cols < 3) // 1 or 2 colums
-    {
-      fi = QFileInfo(tileLayout2d[0][0].FileName);
-    }
-    else
-    {
-      fi = QFileInfo(tileLayout2d[0][1].FileName);
-    }
-
-    QString fname = fi.completeBaseName();
-    DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(fname);
-    ImageGeom::Pointer imageGeom = dc->getGeometryAs<ImageGeom>();
+    ImageGeom::Pointer imageGeom = (cols < 3) ? tileGeometry(0, 0) : tileGeometry(0, 1); // 1 or 2 colums
 
     SizeVec3Type dims = imageGeom->getDimensions();
-    FloatVec3Type spacing = imageGeom->getSpacing();
-    FloatVec3Type origin = imageGeom->getOrigin();
-
     scanOverlapPixel[0] = static_cast<int32_t>(static_cast<float>(dims[0]) * m_ScanOverlapPercent[0]);
 
     if(rows > 3) // 3 or more rows
     {
-      fi = QFileInfo(tileLayout2d[1][0].FileName);
+      imageGeom = tileGeometry(1, 0);
     }
 
-    fname = fi.completeBaseName();
-    dc = getDataContainerArray()->getDataContainer(fname);
-    imageGeom = dc->getGeometryAs<ImageGeom>();
-
     dims = imageGeom->getDimensions();
-    spacing = imageGeom->getSpacing();
-    origin = imageGeom->getOrigin();
-
     scanOverlapPixel[1] = static_cast<int32_t>(static_cast<float>(dims[1]) * m_ScanOverlapPercent[1]);
   }
+  if(m_DefineScanOverlap == OverlapType::None)
+  {
+    scanOverlapPixel = {0, 0};
+  }
+
+  if(m_StitchTiles)
+  {
+    if(stitchTiles(this, tiles, numRows, numCols, scanOverlapPixel, readData) && getGenerateIPFColorMap())
+    {
+      generateIPFColors(getMontageName(), QString("Generating IPF Colors: %1").arg(getMontageName()), readData);
+    }
+    return;
+  }
 
   // Now roll back over all the input files and calculate the proper origins of each tile.
+  size_t tileIndex = 0;
   for(const FilePathGenerator::TileRCIndexRow2D& tileRow2D : tileLayout2d)
   {
     globalTileOrigin[0] = 0.0; // Reset the X Coord back to Zero for each row.
     double tileHeight = 0.0;
     for(const FilePathGenerator::TileRCIndex2D& tile2D : tileRow2D)
     {
-      QFileInfo fi(tile2D.FileName);
-      QString fname = fi.completeBaseName();
-
+      const MontageTile& tile = tiles[tileIndex++];
       GridTileIndex gridIndex = gridMontage->getTileIndex(tile2D.data[0], tile2D.data[1]);
-      QString phasesName;
-      QString eulersName;
-      QString xtalName;
 
-      if(m_InputFileListInfo.FileExtension == EbsdLib::Ang::FileExt)
-      {
-        phasesName = EbsdLib::AngFile::Phases;
-        eulersName = EbsdLib::AngFile::EulerAngles;
-        xtalName = EbsdLib::AngFile::CrystalStructures;
-      }
-      if(m_InputFileListInfo.FileExtension == EbsdLib::Ctf::FileExt)
-      {
-        phasesName = EbsdLib::CtfFile::Phases;
-        eulersName = EbsdLib::CtfFile::EulerAngles;
-        xtalName = EbsdLib::CtfFile::CrystalStructures;
-      }
-
-      DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(fname);
+      DataContainer::Pointer dc = tile.dca->getDataContainer(tile.dcName);
+      getDataContainerArray()->addOrReplaceDataContainer(dc);
       ImageGeom::Pointer imageGeom = dc->getGeometryAs<ImageGeom>();
 
       SizeVec3Type dims = imageGeom->getDimensions();
@@ -381,21 +725,8 @@ void ImportEbsdMontage::dataCheck()
       imageGeom->setOrigin(origin);
 
       // Now update the globalTileOrigin values
-      switch(m_DefineScanOverlap)
-      {
-      case OverlapType::None:
-        globalTileOrigin[0] = origin[0] + (dims[0] * spacing[0]);
-        tileHeight = (dims[1] * spacing[1]);
-        break;
-      case OverlapType::Pixels:
-        globalTileOrigin[0] = origin[0] + ((dims[0] - scanOverlapPixel[0]) * spacing[0]);
-        tileHeight = ((dims[1] - scanOverlapPixel[1]) * spacing[1]);
-        break;
-      case OverlapType::Percent:
-        globalTileOrigin[0] = origin[0] + ((dims[0] - scanOverlapPixel[0]) * spacing[0]);
-        tileHeight = ((dims[1] - scanOverlapPixel[1]) * spacing[1]);
-        break;
-      }
+      globalTileOrigin[0] = origin[0] + ((dims[0] - scanOverlapPixel[0]) * spacing[0]);
+      tileHeight = ((dims[1] - scanOverlapPixel[1]) * spacing[1]);
 
       // Set the montage's DataContainer for the current index
       gridMontage->setDataContainer(gridIndex, dc);
@@ -408,51 +739,7 @@ void ImportEbsdMontage::dataCheck()
 
       if(getGenerateIPFColorMap())
       {
-        if(getCellIPFColorsArrayName().isEmpty())
-        {
-          ss = QObject::tr("Generate IPF Colors is ENABLED. Please set name for the generated IPColors DataArray");
-          setErrorCondition(-23500, ss);
-        }
-        else
-        {
-          DataArrayPath dap(fname, getCellAttributeMatrixName(), getCellIPFColorsArrayName());
-          // QVector<size_t> cDims = {3};
-
-          GenerateIPFColors::Pointer generateIPFColors = GenerateIPFColors::New();
-          generateIPFColors->setDataContainerArray(getDataContainerArray());
-          generateIPFColors->setReferenceDir(m_ReferenceDir);
-          dap.setDataArrayName(phasesName);
-          generateIPFColors->setCellPhasesArrayPath(dap);
-          dap.setDataArrayName(eulersName);
-          generateIPFColors->setCellEulerAnglesArrayPath(dap);
-
-          dap.setAttributeMatrixName(getCellEnsembleAttributeMatrixName());
-          dap.setDataArrayName(xtalName);
-          generateIPFColors->setCrystalStructuresArrayPath(dap);
-          generateIPFColors->setUseGoodVoxels(false);
-
-          generateIPFColors->setCellIPFColorsArrayName(getCellIPFColorsArrayName());
-          if(getInPreflight())
-          {
-            generateIPFColors->preflight();
-            if(generateIPFColors->getErrorCode() < 0)
-            {
-              ss = QObject::tr("Preflight of GenerateIPFColors failed with error code ").arg(generateIPFColors->getErrorCode());
-              setErrorCondition(generateIPFColors->getErrorCode(), ss);
-            }
-          }
-          else
-          {
-            QString msg = QString("Generating IPF Colors: [%1/%2] %3").arg(tilesRead).arg(totalTiles).arg(tile2D.FileName);
-            notifyStatusMessage(msg);
-            generateIPFColors->execute();
-            if(generateIPFColors->getErrorCode() < 0)
-            {
-              ss = QObject::tr("GenerateIPFColors failed with error code ").arg(generateIPFColors->getErrorCode());
-              setErrorCondition(generateIPFColors->getErrorCode(), ss);
-            }
-          }
-        }
+        generateIPFColors(tile.dcName, QString("Generating IPF Colors: [%1/%2] %3").arg(tilesRead).arg(totalTiles).arg(tile.fileName), readData);
       }
     }
 
@@ -461,22 +748,18 @@ void ImportEbsdMontage::dataCheck()
     globalTileOrigin[1] += tileHeight;
   }
   getDataContainerArray()->addOrReplaceMontage(gridMontage);
-
-  m_FilterCache = newFilterCache; // Swap our maps. This dumps any previous instantiations of the reader filter that are not used any more.
   clearWarningCode();
 }
 
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 void ImportEbsdMontage::execute()
 {
   initialize();
-  dataCheck();
 
-  // The entire Reading of the data, whether that is in prefligth (so just read the header) or in execute is performed
-  // in the dataCheck() method so we essentially do nothing here.
+  // dataCheck() only reads the tile headers; the tiles themselves are read here
+  readMontage(true);
 }
 
 // -----------------------------------------------------------------------------
@@ -639,6 +922,18 @@ bool ImportEbsdMontage::getGenerateIPFColorMap() const
 {
   return m_GenerateIPFColorMap;
 }
+// -----------------------------------------------------------------------------
+void ImportEbsdMontage::setStitchTiles(bool value)
+{
+  m_StitchTiles = value;
+}
+
+// -----------------------------------------------------------------------------
+bool ImportEbsdMontage::getStitchTiles() const
+{
+  return m_StitchTiles;
+}
+
 // -----------------------------------------------------------------------------
 void ImportEbsdMontage::setCellIPFColorsArrayName(const QString& value)
 {
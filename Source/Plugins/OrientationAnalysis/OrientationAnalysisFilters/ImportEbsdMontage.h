@@ -68,6 +68,7 @@ class OrientationAnalysis_EXPORT ImportEbsdMontage : public AbstractFilter
   PYB11_PROPERTY(QString CellIPFColorsArrayName READ getCellIPFColorsArrayName WRITE setCellIPFColorsArrayName)
   PYB11_PROPERTY(int32_t DefineScanOverlap READ getDefineScanOverlap WRITE setDefineScanOverlap)
   PYB11_PROPERTY(FloatVec2Type ScanOverlapPercent READ getScanOverlapPercent WRITE setScanOverlapPercent)
+  PYB11_PROPERTY(bool StitchTiles READ getStitchTiles WRITE setStitchTiles)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -219,6 +220,17 @@ public:
   IntVec2Type getScanOverlapPixel() const;
   Q_PROPERTY(IntVec2Type ScanOverlapPixel READ getScanOverlapPixel WRITE setScanOverlapPixel)
 
+  /**
+   * @brief Setter property for StitchTiles
+   */
+  void setStitchTiles(bool value);
+  /**
+   * @brief Getter property for StitchTiles
+   * @return Value of StitchTiles
+   */
+  bool getStitchTiles() const;
+  Q_PROPERTY(bool StitchTiles READ getStitchTiles WRITE setStitchTiles)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -289,6 +301,21 @@ protected:
    */
   void initialize();
 
+  /**
+   * @brief readMontage Creates a reader for every tile and places the tiles, either as separate Data Containers
+   * of a GridMontage or stitched into one Data Container
+   * @param readData Whether the tiles are read completely or only their headers
+   */
+  void readMontage(bool readData);
+
+  /**
+   * @brief generateIPFColors Runs GenerateIPFColors on the scan data of a Data Container
+   * @param dcName Name of the Data Container
+   * @param statusMessage Message shown before the colors are generated
+   * @param readData Whether GenerateIPFColors is executed or only preflighted
+   */
+  void generateIPFColors(const QString& dcName, const QString& statusMessage, bool readData);
+
 private:
   QString m_MontageName = {"Montage"};
   DataArrayPath m_DataContainerName = {"EBSD", "", ""};
@@ -303,6 +330,7 @@ private:
   std::map<QString, AbstractFilter::Pointer> m_FilterCache;
   FloatVec3Type m_ReferenceDir = {0.0f, 0.0f, 1.0f};
 
+  bool m_StitchTiles = false;
   bool m_GenerateIPFColorMap = false;
   QString m_CellIPFColorsArrayName = QString(SIMPL::CellData::IPFColor);
 
@@ -44,6 +44,7 @@
 #include "SIMPLib/Common/Constants.h"
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
@@ -57,6 +58,7 @@
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/EbsdScanCache.h"
 
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -66,6 +68,18 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+namespace
+{
+// -----------------------------------------------------------------------------
+// The columns that copyRawEbsdData reads, which are the ones kept in the scan cache
+// -----------------------------------------------------------------------------
+QStringList scanCacheColumns()
+{
+  return QStringList({EbsdLib::Ang::PhaseData, EbsdLib::Ang::Phi1, EbsdLib::Ang::Phi, EbsdLib::Ang::Phi2, EbsdLib::Ang::ImageQuality, EbsdLib::Ang::ConfidenceIndex, EbsdLib::Ang::SEMSignal,
+                      EbsdLib::Ang::Fit, EbsdLib::Ang::XPosition, EbsdLib::Ang::YPosition});
+}
+} // namespace
+
 /**
  * @brief The ReadAngDataPrivate class is a private implementation of the ReadAngData class
  */
@@ -102,6 +116,7 @@ ReadAngData::ReadAngData()
 , m_FileWasRead(false)
 , m_MaterialNameArrayName(SIMPL::EnsembleData::MaterialName)
 , m_InputFile("")
+, m_UseScanCache(false)
 , m_RefFrameZDir(SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
 , m_Manufacturer(EbsdLib::OEM::Unknown)
 , d_ptr(new ReadAngDataPrivate(this))
@@ -165,6 +180,7 @@ void ReadAngData::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_INPUT_FILE_FP("Input File", InputFile, FilterParameter::Parameter, ReadAngData, "*.ang"));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Cache Decoded Scan Data", UseScanCache, FilterParameter::Parameter, ReadAngData));
   parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, ReadAngData));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
   parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Cell Attribute Matrix", CellAttributeMatrixName, DataContainerName, FilterParameter::CreatedArray, ReadAngData));
@@ -183,6 +199,7 @@ void ReadAngData::readFilterParameters(AbstractFilterParametersReader* reader, i
   setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName()));
   setCellEnsembleAttributeMatrixName(reader->readString("CellEnsembleAttributeMatrixName", getCellEnsembleAttributeMatrixName()));
   setInputFile(reader->readString("InputFile", getInputFile()));
+  setUseScanCache(reader->readValue("UseScanCache", getUseScanCache()));
   reader->closeFilterGroup();
 }
 
@@ -329,7 +346,7 @@ void ReadAngData::flushCache()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ReadAngData::readDataFile(AngReader* reader, DataContainer* m, std::vector<size_t>& tDims, ANG_READ_FLAG flag)
+void ReadAngData::readDataFile(AngReader* reader, DataContainer* m, std::vector<size_t>& tDims, ANG_READ_FLAG flag, EbsdScanCache* scanCache)
 {
   QFileInfo fi(m_InputFile);
   QDateTime timeStamp(fi.lastModified());
@@ -369,7 +386,15 @@ void ReadAngData::readDataFile(AngReader* reader, DataContainer* m, std::vector<
     }
     else
     {
-      int32_t err = reader->readFile();
+      // A current scan cache replaces the parse of the data section; the header is still read for the phase information
+      bool cacheLoaded = nullptr != scanCache && scanCache->load(m_InputFile, scanCacheColumns());
+      int32_t err = cacheLoaded ? reader->readHeaderOnly() : reader->readFile();
+      if(err >= 0 && cacheLoaded && scanCache->getNumberOfElements() != static_cast<size_t>(reader->getXDimension()) * static_cast<size_t>(reader->getYDimension()))
+      {
+        // The cache does not match the dimensions in the header, so parse the data section after all
+        scanCache->close();
+        err = reader->readFile();
+      }
       if(err < 0)
       {
         setErrorCondition(err, reader->getErrorMessage());
@@ -520,12 +545,15 @@ int32_t ReadAngData::loadMaterialInfo(AngReader* reader)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ReadAngData::copyRawEbsdData(AngReader* reader, std::vector<size_t>& tDims, std::vector<size_t>& cDims)
+void ReadAngData::copyRawEbsdData(AngReader* reader, const EbsdScanCache& scanCache, std::vector<size_t>& tDims, std::vector<size_t>& cDims)
 {
-  float* f1 = nullptr;
-  float* f2 = nullptr;
-  float* f3 = nullptr;
-  int* phasePtr = nullptr;
+  const float* f1 = nullptr;
+  const float* f2 = nullptr;
+  const float* f3 = nullptr;
+  const int32_t* phasePtr = nullptr;
+
+  // Columns come from the scan cache when it was loaded, otherwise from the reader that parsed the file
+  auto getColumn = [&](const QString& name) -> const void* { return scanCache.isLoaded() ? scanCache.getPointerByName(name) : reader->getPointerByName(name); };
 
   FloatArrayType::Pointer fArray = FloatArrayType::NullPointer();
   Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
@@ -544,24 +572,21 @@ void ReadAngData::copyRawEbsdData(AngReader* reader, std::vector<size_t>& tDims,
 
   // Adjust the values of the 'phase' data to correct for invalid values
   {
-    phasePtr = reinterpret_cast<int32_t*>(reader->getPointerByName(EbsdLib::Ang::PhaseData));
+    phasePtr = reinterpret_cast<const int32_t*>(getColumn(EbsdLib::Ang::PhaseData));
+    iArray = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases, true);
+    int32_t* cellPhases = iArray->getPointer(0);
     for(size_t i = 0; i < totalPoints; i++)
     {
-      if(phasePtr[i] < 1)
-      {
-        phasePtr[i] = 1;
-      }
+      cellPhases[i] = (phasePtr[i] < 1) ? 1 : phasePtr[i];
     }
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases, true);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
     ebsdAttrMat->insertOrAssign(iArray);
   }
 
   // Condense the Euler Angles from 3 separate arrays into a single 1x3 array
   {
-    f1 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ang::Phi1));
-    f2 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ang::Phi));
-    f3 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ang::Phi2));
+    f1 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ang::Phi1));
+    f2 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ang::Phi));
+    f3 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ang::Phi2));
     cDims[0] = 3;
     fArray = FloatArrayType::CreateArray(tDims, cDims, SIMPL::CellData::EulerAngles, true);
     float* cellEulerAngles = fArray->getPointer(0);
@@ -577,42 +602,42 @@ void ReadAngData::copyRawEbsdData(AngReader* reader, std::vector<size_t>& tDims,
 
   cDims[0] = 1;
   {
-    f1 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ang::ImageQuality));
+    f1 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ang::ImageQuality));
     fArray = FloatArrayType::CreateArray(tDims, cDims, EbsdLib::Ang::ImageQuality, true);
     ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
     ebsdAttrMat->insertOrAssign(fArray);
   }
 
   {
-    f1 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ang::ConfidenceIndex));
+    f1 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ang::ConfidenceIndex));
     fArray = FloatArrayType::CreateArray(tDims, cDims, EbsdLib::Ang::ConfidenceIndex, true);
     ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
     ebsdAttrMat->insertOrAssign(fArray);
   }
 
   {
-    f1 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ang::SEMSignal));
+    f1 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ang::SEMSignal));
     fArray = FloatArrayType::CreateArray(tDims, cDims, EbsdLib::Ang::SEMSignal, true);
     ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
     ebsdAttrMat->insertOrAssign(fArray);
   }
 
   {
-    f1 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ang::Fit));
+    f1 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ang::Fit));
     fArray = FloatArrayType::CreateArray(tDims, cDims, EbsdLib::Ang::Fit, true);
     ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
     ebsdAttrMat->insertOrAssign(fArray);
   }
 
   {
-    f1 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ang::XPosition));
+    f1 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ang::XPosition));
     fArray = FloatArrayType::CreateArray(tDims, cDims, EbsdLib::Ang::XPosition, true);
     ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
     ebsdAttrMat->insertOrAssign(fArray);
   }
 
   {
-    f1 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ang::YPosition));
+    f1 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ang::YPosition));
     fArray = FloatArrayType::CreateArray(tDims, cDims, EbsdLib::Ang::YPosition, true);
     ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
     ebsdAttrMat->insertOrAssign(fArray);
@@ -639,12 +664,24 @@ void ReadAngData::execute()
   AttributeMatrix::Pointer ebsdAttrMat = m->getAttributeMatrix(getCellAttributeMatrixName());
   ebsdAttrMat->setType(AttributeMatrix::Type::Cell);
 
-  readDataFile(reader.get(), m.get(), tDims, ANG_FULL_FILE);
+  EbsdScanCache scanCache;
+  readDataFile(reader.get(), m.get(), tDims, ANG_FULL_FILE, m_UseScanCache ? &scanCache : nullptr);
   if(getErrorCode() < 0)
   {
     return;
   }
-  copyRawEbsdData(reader.get(), tDims, cDims);
+  copyRawEbsdData(reader.get(), scanCache, tDims, cDims);
+
+  // Keep the decoded columns for the next read of this file
+  if(m_UseScanCache && !scanCache.isLoaded())
+  {
+    size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
+    if(!EbsdScanCache::Write(m_InputFile, reader.get(), scanCacheColumns(), totalPoints))
+    {
+      QString ss = QObject::tr("The scan cache for '%1' could not be written to '%2'").arg(m_InputFile).arg(EbsdScanCache::GetCacheFilePath(m_InputFile));
+      setWarningCondition(-1010, ss);
+    }
+  }
 
   // Set the file name and time stamp into the cache, if we are reading from the file and after all the reading has been done
   {
@@ -834,6 +871,18 @@ QString ReadAngData::getInputFile() const
   return m_InputFile;
 }
 
+// -----------------------------------------------------------------------------
+void ReadAngData::setUseScanCache(bool value)
+{
+  m_UseScanCache = value;
+}
+
+// -----------------------------------------------------------------------------
+bool ReadAngData::getUseScanCache() const
+{
+  return m_UseScanCache;
+}
+
 // -----------------------------------------------------------------------------
 void ReadAngData::setRefFrameZDir(uint32_t value)
 {
@@ -48,6 +48,7 @@
 #include "OrientationAnalysis/OrientationAnalysisDLLExport.h"
 
 class DataContainer;
+class EbsdScanCache;
 
 // our PIMPL private class
 class ReadAngDataPrivate;
@@ -67,6 +68,7 @@ class OrientationAnalysis_EXPORT ReadAngData : public AbstractFilter
   PYB11_PROPERTY(QString CellEnsembleAttributeMatrixName READ getCellEnsembleAttributeMatrixName WRITE setCellEnsembleAttributeMatrixName)
   PYB11_PROPERTY(QString CellAttributeMatrixName READ getCellAttributeMatrixName WRITE setCellAttributeMatrixName)
   PYB11_PROPERTY(QString InputFile READ getInputFile WRITE setInputFile)
+  PYB11_PROPERTY(bool UseScanCache READ getUseScanCache WRITE setUseScanCache)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -167,6 +169,17 @@ public:
   QString getInputFile() const;
   Q_PROPERTY(QString InputFile READ getInputFile WRITE setInputFile)
 
+  /**
+   * @brief Setter property for UseScanCache
+   */
+  void setUseScanCache(bool value);
+  /**
+   * @brief Getter property for UseScanCache
+   * @return Value of UseScanCache
+   */
+  bool getUseScanCache() const;
+  Q_PROPERTY(bool UseScanCache READ getUseScanCache WRITE setUseScanCache)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -302,10 +315,11 @@ protected:
   /**
   * @brief copyRawEbsdData Reads the Ang file and puts the data into the data container
    * @param reader AngReader instance pointer
+   * @param scanCache Scan cache; its columns are used instead of the reader's when it is loaded
    * @param tDims Tuple dimensions
    * @param cDims Component dimensions
    */
-  void copyRawEbsdData(AngReader* reader, std::vector<size_t>& tDims, std::vector<size_t>& cDims);
+  void copyRawEbsdData(AngReader* reader, const EbsdScanCache& scanCache, std::vector<size_t>& tDims, std::vector<size_t>& cDims);
 
   /**
   * @brief loadMaterialInfo Reads the values for the phase type, crystal structure
@@ -320,8 +334,9 @@ protected:
    * @param reader AngReader instance pointer
    * @param m DataContainer instance pointer
    * @param tDims Tuple dimensions
+   * @param scanCache If not null, a full read first tries to load the scan data from this cache and only parses the header
    */
-  void readDataFile(AngReader* reader, DataContainer* m, std::vector<size_t>& tDims, ANG_READ_FLAG = ANG_FULL_FILE);
+  void readDataFile(AngReader* reader, DataContainer* m, std::vector<size_t>& tDims, ANG_READ_FLAG = ANG_FULL_FILE, EbsdScanCache* scanCache = nullptr);
 
 private:
   std::weak_ptr<DataArray<int32_t>> m_CellPhasesPtr;
@@ -339,6 +354,7 @@ private:
   bool m_FileWasRead = {};
   QString m_MaterialNameArrayName = {};
   QString m_InputFile = {};
+  bool m_UseScanCache = {};
   uint32_t m_RefFrameZDir = {};
   EbsdLib::OEM m_Manufacturer = {};
 
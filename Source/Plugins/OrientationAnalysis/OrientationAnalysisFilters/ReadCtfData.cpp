@@ -33,6 +33,7 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
 #include <memory>
 
 #include "ReadCtfData.h"
@@ -60,6 +61,7 @@
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/EbsdScanCache.h"
 #include "ChangeAngleRepresentation.h"
 
 enum createdPathID : RenameDataPath::DataID_t
@@ -70,6 +72,18 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+namespace
+{
+// -----------------------------------------------------------------------------
+// The columns that copyRawEbsdData reads, which are the ones kept in the scan cache
+// -----------------------------------------------------------------------------
+QStringList scanCacheColumns()
+{
+  return QStringList({EbsdLib::Ctf::Phase, EbsdLib::Ctf::Euler1, EbsdLib::Ctf::Euler2, EbsdLib::Ctf::Euler3, EbsdLib::Ctf::Bands, EbsdLib::Ctf::Error, EbsdLib::Ctf::MAD, EbsdLib::Ctf::BC,
+                      EbsdLib::Ctf::BS, EbsdLib::Ctf::X, EbsdLib::Ctf::Y});
+}
+} // namespace
+
 /**
  * @brief The ReadCtfDataPrivate class is a private implementation of the ReadCtfData class
  */
@@ -109,6 +123,7 @@ ReadCtfData::ReadCtfData()
 , m_PhaseNameArrayName("")
 , m_MaterialNameArrayName(SIMPL::EnsembleData::MaterialName)
 , m_InputFile("")
+, m_UseScanCache(false)
 , m_RefFrameZDir(SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
 , m_Manufacturer(EbsdLib::OEM::Unknown)
 , d_ptr(new ReadCtfDataPrivate(this))
@@ -174,6 +189,7 @@ void ReadCtfData::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_INPUT_FILE_FP("Input File", InputFile, FilterParameter::Parameter, ReadCtfData, "*.ctf"));
   parameters.push_back(SIMPL_NEW_BOOL_FP("Convert Eulers to Radians", DegreesToRadians, FilterParameter::Parameter, ReadCtfData));
   parameters.push_back(SIMPL_NEW_BOOL_FP("Convert Hexagonal X-Axis to Edax Standard", EdaxHexagonalAlignment, FilterParameter::Parameter, ReadCtfData));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Cache Decoded Scan Data", UseScanCache, FilterParameter::Parameter, ReadCtfData));
   parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, ReadCtfData));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
   parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Cell Attribute Matrix", CellAttributeMatrixName, DataContainerName, FilterParameter::CreatedArray, ReadCtfData));
@@ -194,6 +210,7 @@ void ReadCtfData::readFilterParameters(AbstractFilterParametersReader* reader, i
   setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName()));
   setCellEnsembleAttributeMatrixName(reader->readString("CellEnsembleAttributeMatrixName", getCellEnsembleAttributeMatrixName()));
   setInputFile(reader->readString("InputFile", getInputFile()));
+  setUseScanCache(reader->readValue("UseScanCache", getUseScanCache()));
   reader->closeFilterGroup();
 }
 
@@ -340,7 +357,7 @@ void ReadCtfData::flushCache()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ReadCtfData::readDataFile(CtfReader* reader, DataContainer* m, std::vector<size_t>& tDims, CTF_READ_FLAG flag)
+void ReadCtfData::readDataFile(CtfReader* reader, DataContainer* m, std::vector<size_t>& tDims, CTF_READ_FLAG flag, EbsdScanCache* scanCache)
 {
   QFileInfo fi(m_InputFile);
   QDateTime timeStamp(fi.lastModified());
@@ -370,7 +387,15 @@ void ReadCtfData::readDataFile(CtfReader* reader, DataContainer* m, std::vector<
     }
     else
     {
-      int32_t err = reader->readFile();
+      // A current scan cache replaces the parse of the data section; the header is still read for the phase information
+      bool cacheLoaded = nullptr != scanCache && scanCache->load(m_InputFile, scanCacheColumns());
+      int32_t err = cacheLoaded ? reader->readHeaderOnly() : reader->readFile();
+      if(err >= 0 && cacheLoaded && scanCache->getNumberOfElements() != static_cast<size_t>(reader->getXCells()) * static_cast<size_t>(reader->getYCells()) * static_cast<size_t>(std::max(reader->getZCells(), 1)))
+      {
+        // The cache does not match the dimensions in the header, so parse the data section after all
+        scanCache->close();
+        err = reader->readFile();
+      }
       if(err < 0)
       {
         setErrorCondition(err, reader->getErrorMessage());
@@ -511,12 +536,15 @@ int32_t ReadCtfData::loadMaterialInfo(CtfReader* reader)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ReadCtfData::copyRawEbsdData(CtfReader* reader, std::vector<size_t>& tDims, std::vector<size_t>& cDims)
+void ReadCtfData::copyRawEbsdData(CtfReader* reader, const EbsdScanCache& scanCache, std::vector<size_t>& tDims, std::vector<size_t>& cDims)
 {
-  float* f1 = nullptr;
-  float* f2 = nullptr;
-  float* f3 = nullptr;
-  int* phasePtr = nullptr;
+  const float* f1 = nullptr;
+  const float* f2 = nullptr;
+  const float* f3 = nullptr;
+  const int32_t* phasePtr = nullptr;
+
+  // Columns come from the scan cache when it was loaded, otherwise from the reader that parsed the file
+  auto getColumn = [&](const QString& name) -> const void* { return scanCache.isLoaded() ? scanCache.getPointerByName(name) : reader->getPointerByName(name); };
 
   FloatArrayType::Pointer fArray = FloatArrayType::NullPointer();
   Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
@@ -543,23 +571,20 @@ void ReadCtfData::copyRawEbsdData(CtfReader* reader, std::vector<size_t>& tDims,
      * even if there is only a single phase. The next if statement converts all zeros to ones
      * if there is a single phase in the OIM data.
      */
-    phasePtr = reinterpret_cast<int32_t*>(reader->getPointerByName(EbsdLib::Ctf::Phase));
+    phasePtr = reinterpret_cast<const int32_t*>(getColumn(EbsdLib::Ctf::Phase));
+    iArray = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::Phases, true);
+    int32_t* cellPhases = iArray->getPointer(0);
     for(size_t i = 0; i < totalPoints; i++)
     {
-      if(phasePtr[i] < 1)
-      {
-        phasePtr[i] = 1;
-      }
+      cellPhases[i] = (phasePtr[i] < 1) ? 1 : phasePtr[i];
     }
-    iArray = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::Phases, true);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
     ebsdAttrMat->insertOrAssign(iArray);
   }
   {
     //  radianconversion = M_PI / 180.0;
-    f1 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ctf::Euler1));
-    f2 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ctf::Euler2));
-    f3 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ctf::Euler3));
+    f1 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ctf::Euler1));
+    f2 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ctf::Euler2));
+    f3 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ctf::Euler3));
     std::vector<size_t> dims(1, 3);
     fArray = FloatArrayType::CreateArray(totalPoints, dims, SIMPL::CellData::EulerAngles, true);
     float* cellEulerAngles = fArray->getPointer(0);
@@ -586,49 +611,49 @@ void ReadCtfData::copyRawEbsdData(CtfReader* reader, std::vector<size_t>& tDims,
   }
 
   {
-    phasePtr = reinterpret_cast<int32_t*>(reader->getPointerByName(EbsdLib::Ctf::Bands));
+    phasePtr = reinterpret_cast<const int32_t*>(getColumn(EbsdLib::Ctf::Bands));
     iArray = Int32ArrayType::CreateArray(totalPoints, EbsdLib::Ctf::Bands, true);
     ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
     ebsdAttrMat->insertOrAssign(iArray);
   }
 
   {
-    phasePtr = reinterpret_cast<int32_t*>(reader->getPointerByName(EbsdLib::Ctf::Error));
+    phasePtr = reinterpret_cast<const int32_t*>(getColumn(EbsdLib::Ctf::Error));
     iArray = Int32ArrayType::CreateArray(totalPoints, EbsdLib::Ctf::Error, true);
     ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
     ebsdAttrMat->insertOrAssign(iArray);
   }
 
   {
-    f1 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ctf::MAD));
+    f1 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ctf::MAD));
     fArray = FloatArrayType::CreateArray(totalPoints, EbsdLib::Ctf::MAD, true);
     ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
     ebsdAttrMat->insertOrAssign(fArray);
   }
 
   {
-    phasePtr = reinterpret_cast<int32_t*>(reader->getPointerByName(EbsdLib::Ctf::BC));
+    phasePtr = reinterpret_cast<const int32_t*>(getColumn(EbsdLib::Ctf::BC));
     iArray = Int32ArrayType::CreateArray(totalPoints, EbsdLib::Ctf::BC, true);
     ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
     ebsdAttrMat->insertOrAssign(iArray);
   }
 
   {
-    phasePtr = reinterpret_cast<int32_t*>(reader->getPointerByName(EbsdLib::Ctf::BS));
+    phasePtr = reinterpret_cast<const int32_t*>(getColumn(EbsdLib::Ctf::BS));
     iArray = Int32ArrayType::CreateArray(totalPoints, EbsdLib::Ctf::BS, true);
     ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
     ebsdAttrMat->insertOrAssign(iArray);
   }
 
   {
-    f1 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ctf::X));
+    f1 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ctf::X));
     fArray = FloatArrayType::CreateArray(tDims, cDims, EbsdLib::Ctf::X, true);
     ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
     ebsdAttrMat->insertOrAssign(fArray);
   }
 
   {
-    f1 = reinterpret_cast<float*>(reader->getPointerByName(EbsdLib::Ctf::Y));
+    f1 = reinterpret_cast<const float*>(getColumn(EbsdLib::Ctf::Y));
     fArray = FloatArrayType::CreateArray(tDims, cDims, EbsdLib::Ctf::Y, true);
     ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
     ebsdAttrMat->insertOrAssign(fArray);
@@ -655,13 +680,25 @@ void ReadCtfData::execute()
   AttributeMatrix::Pointer ebsdAttrMat = m->getAttributeMatrix(getCellAttributeMatrixName());
   ebsdAttrMat->setType(AttributeMatrix::Type::Cell);
 
-  readDataFile(reader.get(), m.get(), tDims, CTF_FULL_FILE);
+  EbsdScanCache scanCache;
+  readDataFile(reader.get(), m.get(), tDims, CTF_FULL_FILE, m_UseScanCache ? &scanCache : nullptr);
   if(getErrorCode() < 0)
   {
     return;
   }
 
-  copyRawEbsdData(reader.get(), tDims, cDims);
+  copyRawEbsdData(reader.get(), scanCache, tDims, cDims);
+
+  // Keep the decoded columns for the next read of this file
+  if(m_UseScanCache && !scanCache.isLoaded())
+  {
+    size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
+    if(!EbsdScanCache::Write(m_InputFile, reader.get(), scanCacheColumns(), totalPoints))
+    {
+      QString ss = QObject::tr("The scan cache for '%1' could not be written to '%2'").arg(m_InputFile).arg(EbsdScanCache::GetCacheFilePath(m_InputFile));
+      setWarningCondition(-2010, ss);
+    }
+  }
 
   // Set the file name and time stamp into the cache, if we are reading from the file and after all the reading has been done
   {
@@ -885,6 +922,18 @@ QString ReadCtfData::getInputFile() const
   return m_InputFile;
 }
 
+// -----------------------------------------------------------------------------
+void ReadCtfData::setUseScanCache(bool value)
+{
+  m_UseScanCache = value;
+}
+
+// -----------------------------------------------------------------------------
+bool ReadCtfData::getUseScanCache() const
+{
+  return m_UseScanCache;
+}
+
 // -----------------------------------------------------------------------------
 void ReadCtfData::setRefFrameZDir(uint32_t value)
 {
@@ -64,6 +64,7 @@ enum CTF_READ_FLAG
 };
 
 class DataContainer;
+class EbsdScanCache;
 using DataContainerShPtrType = std::shared_ptr<DataContainer>;
 
 // our PIMPL private class
@@ -86,6 +87,7 @@ class OrientationAnalysis_EXPORT ReadCtfData : public AbstractFilter
   PYB11_PROPERTY(QString InputFile READ getInputFile WRITE setInputFile)
   PYB11_PROPERTY(bool DegreesToRadians READ getDegreesToRadians WRITE setDegreesToRadians)
   PYB11_PROPERTY(bool EdaxHexagonalAlignment READ getEdaxHexagonalAlignment WRITE setEdaxHexagonalAlignment)
+  PYB11_PROPERTY(bool UseScanCache READ getUseScanCache WRITE setUseScanCache)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -218,6 +220,17 @@ public:
   QString getInputFile() const;
   Q_PROPERTY(QString InputFile READ getInputFile WRITE setInputFile)
 
+  /**
+   * @brief Setter property for UseScanCache
+   */
+  void setUseScanCache(bool value);
+  /**
+   * @brief Getter property for UseScanCache
+   * @return Value of UseScanCache
+   */
+  bool getUseScanCache() const;
+  Q_PROPERTY(bool UseScanCache READ getUseScanCache WRITE setUseScanCache)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -354,10 +367,11 @@ protected:
   /**
    * @brief copyRawEbsdData Reads the Ang file and puts the data into the data container
    * @param reader CtfReader instance pointer
+   * @param scanCache Scan cache; its columns are used instead of the reader's when it is loaded
    * @param tDims Tuple dimensions
    * @param cDims Component dimensions
    */
-  void copyRawEbsdData(CtfReader* reader, std::vector<size_t>& tDims, std::vector<size_t>& cDims);
+  void copyRawEbsdData(CtfReader* reader, const EbsdScanCache& scanCache, std::vector<size_t>& tDims, std::vector<size_t>& cDims);
 
   /**
    * @brief loadMaterialInfo Reads the values for the phase type, crystal structure
@@ -372,8 +386,9 @@ protected:
    * @param reader CtfReader instance pointer
    * @param m DataContainer instance pointer
    * @param tDims Tuple dimensions
+   * @param scanCache If not null, a full read first tries to load the scan data from this cache and only parses the header
    */
-  void readDataFile(CtfReader* reader, DataContainer* m, std::vector<size_t>& tDims, CTF_READ_FLAG flag);
+  void readDataFile(CtfReader* reader, DataContainer* m, std::vector<size_t>& tDims, CTF_READ_FLAG flag, EbsdScanCache* scanCache = nullptr);
 
 private:
   std::weak_ptr<DataArray<int32_t>> m_CellPhasesPtr;
@@ -394,6 +409,7 @@ private:
   QString m_PhaseNameArrayName = {};
   QString m_MaterialNameArrayName = {};
   QString m_InputFile = {};
+  bool m_UseScanCache = {};
   uint32_t m_RefFrameZDir = {};
   EbsdLib::OEM m_Manufacturer = {};
 
@@ -130,6 +130,11 @@ if(1)
   addIpfHelper(Trigonal)
 endif()
 
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/EbsdScanCache.h)
+ADD_SIMPL_SUPPORT_SOURCE(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/EbsdScanCache.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/SphericalNormalIndex.h)
+ADD_SIMPL_SUPPORT_SOURCE(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/SphericalNormalIndex.cpp)
+
 
 #---------------------
 # This macro must come last after we are done adding all the filters and support files.
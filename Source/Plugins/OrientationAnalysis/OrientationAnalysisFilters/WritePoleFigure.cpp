@@ -35,6 +35,7 @@
 
 #include "WritePoleFigure.h"
 
+#include <algorithm>
 #include <memory>
 #include <csetjmp>
 #include <vector>
@@ -77,6 +78,12 @@
 
 #include "hpdf.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 jmp_buf env;
 
 void error_handler(HPDF_STATUS error_no, HPDF_STATUS detail_no, void* /* user_data */)
@@ -407,13 +414,189 @@ EbsdLib::UInt8ArrayType::Pointer flipAndMirrorPoleFigure(EbsdLib::UInt8ArrayType
   return converted;
 }
 
+namespace
+{
+const size_t k_GatherChunkSize = 65536;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<EbsdLib::UInt8ArrayType::Pointer> makePoleFiguresForLaueClass(uint32_t crystalStructure, PoleFigureConfiguration_t& config)
+{
+  std::vector<EbsdLib::UInt8ArrayType::Pointer> figures;
+  switch(crystalStructure)
+  {
+  case EbsdLib::CrystalStructure::Cubic_High:
+    figures = makePoleFigures<CubicOps>(config);
+    break;
+  case EbsdLib::CrystalStructure::Cubic_Low:
+    figures = makePoleFigures<CubicLowOps>(config);
+    break;
+  case EbsdLib::CrystalStructure::Hexagonal_High:
+    figures = makePoleFigures<HexagonalOps>(config);
+    break;
+  case EbsdLib::CrystalStructure::Hexagonal_Low:
+    figures = makePoleFigures<HexagonalLowOps>(config);
+    break;
+  case EbsdLib::CrystalStructure::Trigonal_High:
+    figures = makePoleFigures<TrigonalOps>(config);
+    //   setWarningCondition(-1010, "Trigonal High Symmetry is not supported for Pole figures. This phase will be omitted from results");
+    break;
+  case EbsdLib::CrystalStructure::Trigonal_Low:
+    figures = makePoleFigures<TrigonalLowOps>(config);
+    //  setWarningCondition(-1010, "Trigonal Low Symmetry is not supported for Pole figures. This phase will be omitted from results");
+    break;
+  case EbsdLib::CrystalStructure::Tetragonal_High:
+    figures = makePoleFigures<TetragonalOps>(config);
+    //  setWarningCondition(-1010, "Tetragonal High Symmetry is not supported for Pole figures. This phase will be omitted from results");
+    break;
+  case EbsdLib::CrystalStructure::Tetragonal_Low:
+    figures = makePoleFigures<TetragonalLowOps>(config);
+    // setWarningCondition(-1010, "Tetragonal Low Symmetry is not supported for Pole figures. This phase will be omitted from results");
+    break;
+  case EbsdLib::CrystalStructure::OrthoRhombic:
+    figures = makePoleFigures<OrthoRhombicOps>(config);
+    break;
+  case EbsdLib::CrystalStructure::Monoclinic:
+    figures = makePoleFigures<MonoclinicOps>(config);
+    break;
+  case EbsdLib::CrystalStructure::Triclinic:
+    figures = makePoleFigures<TriclinicOps>(config);
+    break;
+  default:
+    break;
+  }
+  return figures;
+}
+
+/**
+ * @brief The PhasePoleFigures struct holds the orientations of a single phase and the pole figures made from them
+ */
+struct PhasePoleFigures
+{
+  size_t phase = 0;
+  size_t numSamples = 0; // Kept for the PDF labels after the orientations are released
+  EbsdLib::FloatArrayType::Pointer eulers;
+  PoleFigureConfiguration_t config;
+  std::vector<EbsdLib::UInt8ArrayType::Pointer> figures;
+};
+
+/**
+ * @brief The GatherPhaseEulersImpl class sorts the Euler angles into one array per phase. The points are split
+ * into fixed chunks; the counting pass records how many points of each phase every chunk holds and the scatter
+ * pass writes each chunk at its prefix-summed offsets, so the points keep their original order.
+ */
+class GatherPhaseEulersImpl
+{
+public:
+  GatherPhaseEulersImpl(const float* cellEulerAngles, const int32_t* cellPhases, const bool* goodVoxels, size_t numPoints, size_t numPhases, std::vector<size_t>& chunkCounts,
+                        std::vector<float*>* phaseEulers)
+  : m_CellEulerAngles(cellEulerAngles)
+  , m_CellPhases(cellPhases)
+  , m_GoodVoxels(goodVoxels)
+  , m_NumPoints(numPoints)
+  , m_NumPhases(numPhases)
+  , m_ChunkCounts(chunkCounts)
+  , m_PhaseEulers(phaseEulers)
+  {
+  }
+  virtual ~GatherPhaseEulersImpl() = default;
+
+  void convert(size_t startChunk, size_t endChunk) const
+  {
+    for(size_t chunk = startChunk; chunk < endChunk; chunk++)
+    {
+      size_t* counts = m_ChunkCounts.data() + chunk * m_NumPhases;
+      size_t end = std::min(m_NumPoints, (chunk + 1) * k_GatherChunkSize);
+      for(size_t i = chunk * k_GatherChunkSize; i < end; i++)
+      {
+        int32_t phase = m_CellPhases[i];
+        if(phase < 1 || static_cast<size_t>(phase) >= m_NumPhases || (nullptr != m_GoodVoxels && !m_GoodVoxels[i]))
+        {
+          continue;
+        }
+        if(nullptr == m_PhaseEulers)
+        {
+          counts[phase]++;
+          continue;
+        }
+        // In the scatter pass the counts hold the next free slot of this chunk
+        float* eu = (*m_PhaseEulers)[phase] + counts[phase] * 3;
+        eu[0] = m_CellEulerAngles[i * 3];
+        eu[1] = m_CellEulerAngles[i * 3 + 1];
+        eu[2] = m_CellEulerAngles[i * 3 + 2];
+        counts[phase]++;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const float* m_CellEulerAngles;
+  const int32_t* m_CellPhases;
+  const bool* m_GoodVoxels;
+  size_t m_NumPoints;
+  size_t m_NumPhases;
+  std::vector<size_t>& m_ChunkCounts;
+  std::vector<float*>* m_PhaseEulers;
+};
+
+/**
+ * @brief The GeneratePoleFiguresImpl class makes the pole figures of a range of phases and converts them to the
+ * row order and RGB layout that the PDF writer expects
+ */
+class GeneratePoleFiguresImpl
+{
+public:
+  GeneratePoleFiguresImpl(std::vector<PhasePoleFigures>& phases, const uint32_t* crystalStructures)
+  : m_Phases(phases)
+  , m_CrystalStructures(crystalStructures)
+  {
+  }
+  virtual ~GeneratePoleFiguresImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      PhasePoleFigures& phaseFigures = m_Phases[i];
+      phaseFigures.figures = makePoleFiguresForLaueClass(m_CrystalStructures[phaseFigures.phase], phaseFigures.config);
+      for(EbsdLib::UInt8ArrayType::Pointer& figure : phaseFigures.figures)
+      {
+        figure = flipAndMirrorPoleFigure(figure.get(), phaseFigures.config);
+      }
+      // The orientations are no longer needed once the figures exist
+      phaseFigures.config.eulers = nullptr;
+      phaseFigures.eulers.reset();
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  std::vector<PhasePoleFigures>& m_Phases;
+  const uint32_t* m_CrystalStructures;
+};
+} // namespace
+
 #define FLIP_Y(y, height) (height) - (y)
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void drawScalarBar(HPDF_Page page, const PoleFigureConfiguration_t& config, const std::pair<HPDF_REAL, HPDF_REAL>& position, float margins, float fontPtSize, HPDF_Font font, int32_t phaseNum,
-                   const QString& laueGroupName, const QString& materialName)
+void drawScalarBar(HPDF_Page page, const PoleFigureConfiguration_t& config, size_t numSamples, const std::pair<HPDF_REAL, HPDF_REAL>& position, float margins, float fontPtSize, HPDF_Font font,
+                   int32_t phaseNum, const QString& laueGroupName, const QString& materialName)
 {
 
   int numColors = config.numColors;
@@ -501,7 +684,7 @@ void drawScalarBar(HPDF_Page page, const PoleFigureConfiguration_t& config, cons
   HPDF_Page_ShowText(page, label.toLatin1());
   HPDF_Page_EndText(page);
 
-  label = QString("Samples: ") + QString::number(config.eulers->getNumberOfTuples());
+  label = QString("Samples: ") + QString::number(numSamples);
   HPDF_Page_SetRGBStroke(page, 0.0f, 0.0f, 0.0f);
   HPDF_Page_SetGrayStroke(page, 0.00f);
   HPDF_Page_BeginText(page);
@@ -547,8 +730,8 @@ void drawScalarBar(HPDF_Page page, const PoleFigureConfiguration_t& config, cons
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void drawDiscreteInfoArea(HPDF_Page page, const PoleFigureConfiguration_t& config, const std::pair<HPDF_REAL, HPDF_REAL>& position, float margins, float fontPtSize, HPDF_Font font, int32_t phaseNum,
-                          const QString& laueGroupName, const QString& materialName)
+void drawDiscreteInfoArea(HPDF_Page page, const PoleFigureConfiguration_t& config, size_t numSamples, const std::pair<HPDF_REAL, HPDF_REAL>& position, float margins, float fontPtSize,
+                          HPDF_Font font, int32_t phaseNum, const QString& laueGroupName, const QString& materialName)
 {
 
   int numColors = config.numColors;
@@ -604,7 +787,7 @@ void drawDiscreteInfoArea(HPDF_Page page, const PoleFigureConfiguration_t& confi
   HPDF_Page_ShowText(page, label.toLatin1());
   HPDF_Page_EndText(page);
 
-  label = QString("Samples: ") + QString::number(config.eulers->getNumberOfTuples());
+  label = QString("Samples: ") + QString::number(numSamples);
   HPDF_Page_SetRGBStroke(page, 0.0f, 0.0f, 0.0f);
   HPDF_Page_SetGrayStroke(page, 0.00f);
   HPDF_Page_BeginText(page);
@@ -646,51 +829,53 @@ void WritePoleFigure::execute()
   // Find how many phases we have by getting the number of Crystal Structures
   size_t numPhases = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
 
-  // Loop over all the voxels gathering the Eulers for a specific phase into an array
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+#endif
+
+  // Gather the Eulers of every phase in a single pass over the voxels: count the points of each phase per chunk,
+  // turn the counts into per chunk write offsets and then scatter the Eulers into one array per phase.
+  size_t numChunks = (numPoints + k_GatherChunkSize - 1) / k_GatherChunkSize;
+  std::vector<size_t> chunkCounts(numChunks * numPhases, 0);
+  const bool* goodVoxels = m_UseGoodVoxels ? m_GoodVoxels : nullptr;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks), GatherPhaseEulersImpl(m_CellEulerAngles, m_CellPhases, goodVoxels, numPoints, numPhases, chunkCounts, nullptr),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    GatherPhaseEulersImpl serial(m_CellEulerAngles, m_CellPhases, goodVoxels, numPoints, numPhases, chunkCounts, nullptr);
+    serial.convert(0, numChunks);
+  }
+
+  std::vector<PhasePoleFigures> phaseFiguresList;
+  std::vector<float*> phaseEulers(numPhases, nullptr);
   for(size_t phase = 1; phase < numPhases; ++phase)
   {
     size_t count = 0;
-    // First find out how many voxels we are going to have. This is probably faster to loop twice than to
-    // keep allocating memory everytime we find one.
-    for(size_t i = 0; i < numPoints; ++i)
+    for(size_t chunk = 0; chunk < numChunks; chunk++)
     {
-      if(m_CellPhases[i] == phase)
-      {
-        if(!m_UseGoodVoxels || m_GoodVoxels[i])
-        {
-          count++;
-        }
-      }
-    }
-    std::vector<size_t> eulerCompDim(1, 3);
-    EbsdLib::FloatArrayType::Pointer subEulers = EbsdLib::FloatArrayType::CreateArray(count, eulerCompDim, "Eulers_Per_Phase", true);
-    subEulers->initializeWithValue(std::numeric_limits<float>::signaling_NaN());
-    float* eu = subEulers->getPointer(0);
-
-    // Now loop through the eulers again and this time add them to the subEulers Array
-    count = 0;
-    for(size_t i = 0; i < numPoints; ++i)
-    {
-      if(m_CellPhases[i] == phase)
-      {
-        if(!m_UseGoodVoxels || m_GoodVoxels[i])
-        {
-          eu[count * 3] = m_CellEulerAngles[i * 3];
-          eu[count * 3 + 1] = m_CellEulerAngles[i * 3 + 1];
-          eu[count * 3 + 2] = m_CellEulerAngles[i * 3 + 2];
-          count++;
-        }
-      }
+      size_t chunkCount = chunkCounts[chunk * numPhases + phase];
+      chunkCounts[chunk * numPhases + phase] = count;
+      count += chunkCount;
     }
-    if(subEulers->getNumberOfTuples() == 0)
+    if(count == 0)
     {
       continue;
     } // Skip because we have no Pole Figure data
 
-    std::vector<EbsdLib::UInt8ArrayType::Pointer> figures;
+    PhasePoleFigures phaseFigures;
+    phaseFigures.phase = phase;
+    phaseFigures.numSamples = count;
+    std::vector<size_t> eulerCompDim(1, 3);
+    phaseFigures.eulers = EbsdLib::FloatArrayType::CreateArray(count, eulerCompDim, "Eulers_Per_Phase", true);
+    phaseEulers[phase] = phaseFigures.eulers->getPointer(0);
 
-    PoleFigureConfiguration_t config;
-    config.eulers = subEulers.get();
+    PoleFigureConfiguration_t& config = phaseFigures.config;
+    config.eulers = phaseFigures.eulers.get();
     config.imageDim = getImageSize();
     config.lambertDim = getLambertSize();
     config.numColors = getNumColors();
@@ -704,55 +889,45 @@ void WritePoleFigure::execute()
     }
 
     config.discreteHeatMap = m_UseDiscreteHeatMap;
+    phaseFiguresList.push_back(phaseFigures);
+  }
 
-    QString label("Phase_");
-    label.append(QString::number(phase));
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks), GatherPhaseEulersImpl(m_CellEulerAngles, m_CellPhases, goodVoxels, numPoints, numPhases, chunkCounts, &phaseEulers),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    GatherPhaseEulersImpl serial(m_CellEulerAngles, m_CellPhases, goodVoxels, numPoints, numPhases, chunkCounts, &phaseEulers);
+    serial.convert(0, numChunks);
+  }
 
-    QString ss = QObject::tr("Generating Pole Figures for Phase %1").arg(phase);
-    notifyStatusMessage(ss);
+  // The phases are independent, so their pole figures are generated concurrently
+  QString ss = QObject::tr("Generating Pole Figures for %1 Phases").arg(phaseFiguresList.size());
+  notifyStatusMessage(ss);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, phaseFiguresList.size(), 1), GeneratePoleFiguresImpl(phaseFiguresList, m_CrystalStructures), tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    GeneratePoleFiguresImpl serial(phaseFiguresList, m_CrystalStructures);
+    serial.convert(0, phaseFiguresList.size());
+  }
 
-    switch(m_CrystalStructures[phase])
-    {
-    case EbsdLib::CrystalStructure::Cubic_High:
-      figures = makePoleFigures<CubicOps>(config);
-      break;
-    case EbsdLib::CrystalStructure::Cubic_Low:
-      figures = makePoleFigures<CubicLowOps>(config);
-      break;
-    case EbsdLib::CrystalStructure::Hexagonal_High:
-      figures = makePoleFigures<HexagonalOps>(config);
-      break;
-    case EbsdLib::CrystalStructure::Hexagonal_Low:
-      figures = makePoleFigures<HexagonalLowOps>(config);
-      break;
-    case EbsdLib::CrystalStructure::Trigonal_High:
-      figures = makePoleFigures<TrigonalOps>(config);
-      //   setWarningCondition(-1010, "Trigonal High Symmetry is not supported for Pole figures. This phase will be omitted from results");
-      break;
-    case EbsdLib::CrystalStructure::Trigonal_Low:
-      figures = makePoleFigures<TrigonalLowOps>(config);
-      //  setWarningCondition(-1010, "Trigonal Low Symmetry is not supported for Pole figures. This phase will be omitted from results");
-      break;
-    case EbsdLib::CrystalStructure::Tetragonal_High:
-      figures = makePoleFigures<TetragonalOps>(config);
-      //  setWarningCondition(-1010, "Tetragonal High Symmetry is not supported for Pole figures. This phase will be omitted from results");
-      break;
-    case EbsdLib::CrystalStructure::Tetragonal_Low:
-      figures = makePoleFigures<TetragonalLowOps>(config);
-      // setWarningCondition(-1010, "Tetragonal Low Symmetry is not supported for Pole figures. This phase will be omitted from results");
-      break;
-    case EbsdLib::CrystalStructure::OrthoRhombic:
-      figures = makePoleFigures<OrthoRhombicOps>(config);
-      break;
-    case EbsdLib::CrystalStructure::Monoclinic:
-      figures = makePoleFigures<MonoclinicOps>(config);
-      break;
-    case EbsdLib::CrystalStructure::Triclinic:
-      figures = makePoleFigures<TriclinicOps>(config);
-      break;
-    default:
-      break;
-    }
+  for(PhasePoleFigures& phaseFigures : phaseFiguresList)
+  {
+    size_t phase = phaseFigures.phase;
+    const PoleFigureConfiguration_t& config = phaseFigures.config;
+    std::vector<EbsdLib::UInt8ArrayType::Pointer>& figures = phaseFigures.figures;
+
+    QString label("Phase_");
+    label.append(QString::number(phase));
 
     if(figures.size() == 3)
     {
@@ -823,7 +998,6 @@ void WritePoleFigure::execute()
       HPDF_ColorSpace colorSpace = HPDF_CS_DEVICE_RGB;
       for(int a = 0; a < figures.size(); a++)
       {
-        figures[a] = flipAndMirrorPoleFigure(figures[a].get(), config);
         HPDF_Image image = HPDF_LoadRawImageFromMem(pdf, figures[a]->getPointer(0), static_cast<HPDF_UINT>(config.imageDim), static_cast<HPDF_UINT>(config.imageDim), colorSpace, 8);
         pdfImages[a] = image;
       }
@@ -938,11 +1112,11 @@ void WritePoleFigure::execute()
       // Now draw the Color Scalar Bar if needed.
       if(config.discrete)
       {
-        drawDiscreteInfoArea(page, config, imagePositions[3], margins, imageHeight / 20.0f, font, static_cast<int32_t>(phase), laueNames[laueIndex], materialName);
+        drawDiscreteInfoArea(page, config, phaseFigures.numSamples, imagePositions[3], margins, imageHeight / 20.0f, font, static_cast<int32_t>(phase), laueNames[laueIndex], materialName);
       }
       else
       {
-        drawScalarBar(page, config, imagePositions[3], margins, imageHeight / 20.0f, font, static_cast<int32_t>(phase), laueNames[laueIndex], materialName);
+        drawScalarBar(page, config, phaseFigures.numSamples, imagePositions[3], margins, imageHeight / 20.0f, font, static_cast<int32_t>(phase), laueNames[laueIndex], materialName);
       }
 
       /* save the document to a file */
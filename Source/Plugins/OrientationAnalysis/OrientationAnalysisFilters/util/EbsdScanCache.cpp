@@ -0,0 +1,356 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "EbsdScanCache.h"
+
+#include <cstring>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+namespace
+{
+const char k_Magic[8] = {'D', '3', 'D', 'S', 'C', 'A', 'N', '\0'};
+const uint32_t k_Version = 1;
+const uint64_t k_Alignment = 64;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T> void appendValue(QByteArray& buffer, T value)
+{
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void appendString(QByteArray& buffer, const QString& value)
+{
+  QByteArray utf8 = value.toUtf8();
+  appendValue<uint32_t>(buffer, static_cast<uint32_t>(utf8.size()));
+  buffer.append(utf8);
+}
+
+/**
+ * @brief The HeaderCursor class reads values from the mapped header without ever stepping past the end of the file
+ */
+class HeaderCursor
+{
+public:
+  HeaderCursor(const uchar* data, uint64_t size)
+  : m_Data(data)
+  , m_Size(size)
+  {
+  }
+
+  template <typename T> bool read(T& value)
+  {
+    if(m_Position + sizeof(T) > m_Size)
+    {
+      return false;
+    }
+    ::memcpy(&value, m_Data + m_Position, sizeof(T));
+    m_Position += sizeof(T);
+    return true;
+  }
+
+  bool readString(QString& value)
+  {
+    uint32_t numBytes = 0;
+    if(!read(numBytes) || m_Position + numBytes > m_Size)
+    {
+      return false;
+    }
+    value = QString::fromUtf8(reinterpret_cast<const char*>(m_Data + m_Position), static_cast<int>(numBytes));
+    m_Position += numBytes;
+    return true;
+  }
+
+private:
+  const uchar* m_Data;
+  uint64_t m_Size;
+  uint64_t m_Position = 0;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t sourceTimeStamp(const QFileInfo& fi)
+{
+  return fi.lastModified().toMSecsSinceEpoch();
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdScanCache::EbsdScanCache() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdScanCache::~EbsdScanCache()
+{
+  close();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString EbsdScanCache::GetCacheFilePath(const QString& inputFile)
+{
+  QString absolutePath = QFileInfo(inputFile).absoluteFilePath();
+  QByteArray hash = QCryptographicHash::hash(absolutePath.toUtf8(), QCryptographicHash::Sha1).toHex();
+  QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  if(cacheDir.isEmpty())
+  {
+    cacheDir = QDir::tempPath();
+  }
+  return cacheDir + "/EbsdScanCache/" + QString::fromLatin1(hash) + ".bin";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdScanCache::load(const QString& inputFile, const QStringList& columnNames)
+{
+  close();
+
+  QFileInfo sourceInfo(inputFile);
+  if(!sourceInfo.exists())
+  {
+    return false;
+  }
+
+  m_File = std::make_unique<QFile>(GetCacheFilePath(inputFile));
+  if(!m_File->open(QIODevice::ReadOnly))
+  {
+    close();
+    return false;
+  }
+
+  uint64_t fileSize = static_cast<uint64_t>(m_File->size());
+  m_MappedData = m_File->map(0, m_File->size());
+  if(nullptr == m_MappedData)
+  {
+    close();
+    return false;
+  }
+
+  // The cache is only valid for the exact file it was written from
+  HeaderCursor cursor(m_MappedData, fileSize);
+  char magic[8];
+  uint32_t version = 0;
+  uint32_t numColumns = 0;
+  int64_t sourceSize = 0;
+  int64_t sourceModified = 0;
+  uint64_t cachedElements = 0;
+  QString sourcePath;
+  bool valid = cursor.read(magic) && ::memcmp(magic, k_Magic, sizeof(k_Magic)) == 0;
+  valid = valid && cursor.read(version) && version == k_Version;
+  valid = valid && cursor.read(numColumns) && cursor.read(sourceSize) && cursor.read(sourceModified) && cursor.read(cachedElements) && cursor.readString(sourcePath);
+  valid = valid && sourcePath == sourceInfo.absoluteFilePath() && sourceSize == sourceInfo.size() && sourceModified == sourceTimeStamp(sourceInfo);
+
+  for(uint32_t i = 0; valid && i < numColumns; i++)
+  {
+    QString name;
+    int32_t type = 0;
+    uint64_t offset = 0;
+    uint64_t numBytes = 0;
+    valid = cursor.readString(name) && cursor.read(type) && cursor.read(offset) && cursor.read(numBytes);
+    valid = valid && offset <= fileSize && numBytes <= fileSize - offset && numBytes == cachedElements * 4;
+    if(valid)
+    {
+      m_Columns[name] = m_MappedData + offset;
+    }
+  }
+
+  for(const QString& name : columnNames)
+  {
+    valid = valid && m_Columns.contains(name);
+  }
+
+  if(!valid)
+  {
+    close();
+    return false;
+  }
+  m_NumberOfElements = static_cast<size_t>(cachedElements);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdScanCache::isLoaded() const
+{
+  return nullptr != m_MappedData;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t EbsdScanCache::getNumberOfElements() const
+{
+  return m_NumberOfElements;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const void* EbsdScanCache::getPointerByName(const QString& name) const
+{
+  return m_Columns.value(name, nullptr);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EbsdScanCache::close()
+{
+  m_Columns.clear();
+  if(nullptr != m_MappedData && nullptr != m_File)
+  {
+    m_File->unmap(m_MappedData);
+  }
+  m_MappedData = nullptr;
+  m_NumberOfElements = 0;
+  m_File.reset();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdScanCache::WriteColumns(const QString& inputFile, const std::vector<Column>& columns, size_t numElements)
+{
+  QFileInfo sourceInfo(inputFile);
+  QString cacheFilePath = GetCacheFilePath(inputFile);
+  if(!QDir().mkpath(QFileInfo(cacheFilePath).absolutePath()))
+  {
+    return false;
+  }
+
+  // The header size depends on the column names, so build it once to measure it and again with the final offsets
+  QByteArray header;
+  std::vector<uint64_t> offsets(columns.size(), 0);
+  for(int pass = 0; pass < 2; pass++)
+  {
+    header.clear();
+    header.append(k_Magic, sizeof(k_Magic));
+    appendValue<uint32_t>(header, k_Version);
+    appendValue<uint32_t>(header, static_cast<uint32_t>(columns.size()));
+    appendValue<int64_t>(header, sourceInfo.size());
+    appendValue<int64_t>(header, sourceTimeStamp(sourceInfo));
+    appendValue<uint64_t>(header, static_cast<uint64_t>(numElements));
+    appendString(header, sourceInfo.absoluteFilePath());
+    for(size_t i = 0; i < columns.size(); i++)
+    {
+      appendString(header, columns[i].name);
+      appendValue<int32_t>(header, columns[i].type);
+      appendValue<uint64_t>(header, offsets[i]);
+      appendValue<uint64_t>(header, columns[i].numBytes);
+    }
+
+    uint64_t offset = static_cast<uint64_t>(header.size());
+    for(size_t i = 0; i < columns.size(); i++)
+    {
+      offset = (offset + k_Alignment - 1) / k_Alignment * k_Alignment;
+      offsets[i] = offset;
+      offset += columns[i].numBytes;
+    }
+  }
+
+  // Write to a temporary file that only replaces the cache once it is complete
+  QSaveFile file(cacheFilePath);
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    return false;
+  }
+
+  uint64_t position = static_cast<uint64_t>(header.size());
+  bool ok = file.write(header) == header.size();
+  const QByteArray padding(static_cast<int>(k_Alignment), '\0');
+  for(size_t i = 0; ok && i < columns.size(); i++)
+  {
+    ok = file.write(padding.constData(), static_cast<qint64>(offsets[i] - position)) == static_cast<qint64>(offsets[i] - position);
+    ok = ok && file.write(reinterpret_cast<const char*>(columns[i].data), static_cast<qint64>(columns[i].numBytes)) == static_cast<qint64>(columns[i].numBytes);
+    position = offsets[i] + columns[i].numBytes;
+  }
+
+  if(!ok)
+  {
+    file.cancelWriting();
+    return false;
+  }
+  if(!file.commit())
+  {
+    return false;
+  }
+
+  TrimCacheDirectory(cacheFilePath);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EbsdScanCache::TrimCacheDirectory(const QString& cacheFilePath)
+{
+  QFileInfo keepInfo(cacheFilePath);
+  QDir cacheDir = keepInfo.absoluteDir();
+
+  // Newest first, so the oldest files are the ones that go over the limit
+  QFileInfoList cacheFiles = cacheDir.entryInfoList(QStringList("*.bin"), QDir::Files, QDir::Time);
+  qint64 totalSize = keepInfo.size();
+  for(const QFileInfo& fi : cacheFiles)
+  {
+    if(fi.absoluteFilePath() == keepInfo.absoluteFilePath())
+    {
+      continue;
+    }
+    if(totalSize + fi.size() > k_MaxCacheDirectorySize)
+    {
+      QFile::remove(fi.absoluteFilePath());
+      continue;
+    }
+    totalSize += fi.size();
+  }
+}
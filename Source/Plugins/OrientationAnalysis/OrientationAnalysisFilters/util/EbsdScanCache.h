@@ -0,0 +1,170 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+/**
+ * @brief The EbsdScanCache class keeps the decoded data columns of an EBSD scan file (.ang, .ctf) in a binary
+ * file so that later reads of the same scan can skip the ASCII parse. The cache file lives in the user's cache
+ * directory, is named after a hash of the scan's absolute path and is only used while the scan's path, size and
+ * modification time still match. Columns are stored contiguously at aligned offsets so a loaded cache is simply a
+ * memory map of the file; the column pointers stay valid until the cache object is closed or destroyed. Writing a
+ * cache file removes the oldest cache files once the directory holds more than k_MaxCacheDirectorySize bytes.
+ */
+class EbsdScanCache
+{
+public:
+  EbsdScanCache();
+  virtual ~EbsdScanCache();
+
+  static const qint64 k_MaxCacheDirectorySize = 2LL * 1024 * 1024 * 1024;
+
+  /**
+   * @brief GetCacheFilePath Returns the location of the cache file for a scan file
+   * @param inputFile
+   * @return
+   */
+  static QString GetCacheFilePath(const QString& inputFile);
+
+  /**
+   * @brief load Maps the cache file for the scan if it is current and holds every requested column. The caller
+   * must still check getNumberOfElements() against the dimensions in the scan header.
+   * @param inputFile Scan file path
+   * @param columnNames Columns that must be present
+   * @return True if the cache was loaded
+   */
+  bool load(const QString& inputFile, const QStringList& columnNames);
+
+  /**
+   * @brief close Unmaps and closes the cache file
+   */
+  void close();
+
+  /**
+   * @brief isLoaded
+   * @return
+   */
+  bool isLoaded() const;
+
+  /**
+   * @brief getNumberOfElements Returns the number of scan points in each column of the loaded cache
+   * @return
+   */
+  size_t getNumberOfElements() const;
+
+  /**
+   * @brief getPointerByName Returns the mapped data of a column, or nullptr if the column is not cached. The data is read-only.
+   * @param name
+   * @return
+   */
+  const void* getPointerByName(const QString& name) const;
+
+  /**
+   * @brief Write Stores the requested columns of a fully read scan. Only 32 bit integer and float columns are supported.
+   * @param inputFile Scan file path
+   * @param reader AngReader or CtfReader that has read the full file
+   * @param columnNames
+   * @param numElements
+   * @return True if the cache file was written
+   */
+  template <typename ReaderType>
+  static bool Write(const QString& inputFile, ReaderType* reader, const QStringList& columnNames, size_t numElements)
+  {
+    std::vector<Column> columns;
+    for(const QString& name : columnNames)
+    {
+      EbsdLib::NumericTypes::Type type = reader->getPointerType(name);
+      void* ptr = reader->getPointerByName(name);
+      if(nullptr == ptr || (type != EbsdLib::NumericTypes::Type::Int32 && type != EbsdLib::NumericTypes::Type::Float))
+      {
+        return false;
+      }
+      Column column;
+      column.name = name;
+      column.type = static_cast<int32_t>(type);
+      column.data = ptr;
+      column.numBytes = numElements * 4;
+      columns.push_back(column);
+    }
+    return WriteColumns(inputFile, columns, numElements);
+  }
+
+private:
+  struct Column
+  {
+    QString name;
+    int32_t type = 0;
+    const void* data = nullptr;
+    uint64_t numBytes = 0;
+  };
+
+  std::unique_ptr<QFile> m_File;
+  uchar* m_MappedData = nullptr;
+  size_t m_NumberOfElements = 0;
+  QMap<QString, const void*> m_Columns;
+
+  /**
+   * @brief WriteColumns
+   * @param inputFile
+   * @param columns
+   * @param numElements
+   * @return
+   */
+  static bool WriteColumns(const QString& inputFile, const std::vector<Column>& columns, size_t numElements);
+
+  /**
+   * @brief TrimCacheDirectory Removes the least recently written cache files until the cache directory holds
+   * at most k_MaxCacheDirectorySize bytes. The given cache file is always kept.
+   * @param cacheFilePath
+   */
+  static void TrimCacheDirectory(const QString& cacheFilePath);
+
+public:
+  EbsdScanCache(const EbsdScanCache&) = delete;            // Copy Constructor Not Implemented
+  EbsdScanCache(EbsdScanCache&&) = delete;                 // Move Constructor Not Implemented
+  EbsdScanCache& operator=(const EbsdScanCache&) = delete; // Copy Assignment Not Implemented
+  EbsdScanCache& operator=(EbsdScanCache&&) = delete;      // Move Assignment Not Implemented
+};
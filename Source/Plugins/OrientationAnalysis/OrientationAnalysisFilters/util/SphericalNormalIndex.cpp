@@ -0,0 +1,161 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "SphericalNormalIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "SIMPLib/Common/Constants.h"
+
+namespace
+{
+// Vectors may be off unit length by this much and still be indexed
+const double k_LengthTolerance = 1.0E-3;
+// Added to the squared search radius to absorb the rounding of the callers' single precision angle tests
+const double k_RadiusSqSlack = 1.0E-4;
+// Keeps the grid at no more than 64^3 cells however small the query angle is
+const int k_MaxCellsPerAxis = 64;
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SphericalNormalIndex::SphericalNormalIndex(const float* normals, size_t numNormals, float maxAngle)
+: m_Normals(normals)
+, m_NumNormals(numNormals)
+{
+  // For |n|, |d| <= 1 + tol, acos(n . d) < maxAngle implies |n - d|^2 < 2 (1 + tol)^2 - 2 cos(maxAngle)
+  const double maxLength = 1.0 + k_LengthTolerance;
+  m_SearchRadiusSq = 2.0 * maxLength * maxLength - 2.0 * std::cos(std::min(static_cast<double>(maxAngle), SIMPLib::Constants::k_Pi)) + k_RadiusSqSlack;
+  double searchRadius = std::sqrt(m_SearchRadiusSq);
+
+  m_CellSize = std::max(searchRadius, 2.0 * maxLength / static_cast<double>(k_MaxCellsPerAxis));
+  m_CellsPerAxis = std::max(1, std::min(k_MaxCellsPerAxis, static_cast<int>(std::ceil(2.0 * maxLength / m_CellSize))));
+
+  // Counting sort of the vectors into their cells
+  size_t numCells = static_cast<size_t>(m_CellsPerAxis) * m_CellsPerAxis * m_CellsPerAxis;
+  std::vector<size_t> cellOfNormal(m_NumNormals, numCells);
+  m_CellStart.assign(numCells + 1, 0);
+  for(size_t i = 0; i < m_NumNormals; i++)
+  {
+    const float* n = m_Normals + 3 * i;
+    double lengthSq = static_cast<double>(n[0]) * n[0] + static_cast<double>(n[1]) * n[1] + static_cast<double>(n[2]) * n[2];
+    if(!(lengthSq <= maxLength * maxLength))
+    {
+      // Also catches NaN
+      m_Unindexed.push_back(i);
+      continue;
+    }
+    size_t cell = (static_cast<size_t>(cellCoordinate(n[2])) * m_CellsPerAxis + cellCoordinate(n[1])) * m_CellsPerAxis + cellCoordinate(n[0]);
+    cellOfNormal[i] = cell;
+    m_CellStart[cell + 1]++;
+  }
+  for(size_t cell = 0; cell < numCells; cell++)
+  {
+    m_CellStart[cell + 1] += m_CellStart[cell];
+  }
+  m_Entries.resize(m_CellStart[numCells]);
+  std::vector<size_t> fill(m_CellStart.begin(), m_CellStart.end() - 1);
+  for(size_t i = 0; i < m_NumNormals; i++)
+  {
+    if(cellOfNormal[i] < numCells)
+    {
+      m_Entries[fill[cellOfNormal[i]]++] = i;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SphericalNormalIndex::~SphericalNormalIndex() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SphericalNormalIndex::cellCoordinate(double value) const
+{
+  int cell = static_cast<int>(std::floor((value + 1.0 + k_LengthTolerance) / m_CellSize));
+  return std::max(0, std::min(m_CellsPerAxis - 1, cell));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SphericalNormalIndex::findCandidates(const float direction[3], std::vector<size_t>& candidates) const
+{
+  double d[3] = {direction[0], direction[1], direction[2]};
+  double lengthSq = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+  if(!(std::fabs(lengthSq - 1.0) <= k_LengthTolerance))
+  {
+    // The search radius assumes a unit direction
+    for(size_t i = 0; i < m_NumNormals; i++)
+    {
+      candidates.push_back(i);
+    }
+    return;
+  }
+
+  double searchRadius = std::sqrt(m_SearchRadiusSq);
+  int lo[3];
+  int hi[3];
+  for(int axis = 0; axis < 3; axis++)
+  {
+    lo[axis] = cellCoordinate(d[axis] - searchRadius);
+    hi[axis] = cellCoordinate(d[axis] + searchRadius);
+  }
+
+  for(int z = lo[2]; z <= hi[2]; z++)
+  {
+    for(int y = lo[1]; y <= hi[1]; y++)
+    {
+      size_t rowStart = (static_cast<size_t>(z) * m_CellsPerAxis + y) * m_CellsPerAxis;
+      for(size_t e = m_CellStart[rowStart + lo[0]]; e < m_CellStart[rowStart + hi[0] + 1]; e++)
+      {
+        size_t i = m_Entries[e];
+        const float* n = m_Normals + 3 * i;
+        double dx = n[0] - d[0];
+        double dy = n[1] - d[1];
+        double dz = n[2] - d[2];
+        if(dx * dx + dy * dy + dz * dz < m_SearchRadiusSq)
+        {
+          candidates.push_back(i);
+        }
+      }
+    }
+  }
+  candidates.insert(candidates.end(), m_Unindexed.begin(), m_Unindexed.end());
+}
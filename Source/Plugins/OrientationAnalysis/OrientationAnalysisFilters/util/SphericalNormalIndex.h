@@ -0,0 +1,91 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief The SphericalNormalIndex class buckets a set of (nearly) unit vectors into a uniform grid over the
+ * cube that bounds the unit sphere so that all vectors within a given angle of a direction can be found without
+ * visiting every vector. The cell size is matched to the largest query angle, so a query only touches the few
+ * cells around the direction. Queries return a superset of the matches; callers apply their own exact angle
+ * test to the candidates.
+ */
+class SphericalNormalIndex
+{
+public:
+  /**
+   * @brief SphericalNormalIndex
+   * @param normals Packed xyz triples
+   * @param numNormals Number of vectors in normals
+   * @param maxAngle Largest angle (radians) between a vector and a query direction that findCandidates must report
+   */
+  SphericalNormalIndex(const float* normals, size_t numNormals, float maxAngle);
+  virtual ~SphericalNormalIndex();
+
+  /**
+   * @brief findCandidates Appends to candidates the index of every vector n with acos(n . direction) < maxAngle,
+   * along with some vectors that are slightly farther away. Vectors longer than unit length (or not finite)
+   * are always reported.
+   * @param direction Unit query direction
+   * @param candidates
+   */
+  void findCandidates(const float direction[3], std::vector<size_t>& candidates) const;
+
+private:
+  const float* m_Normals = nullptr;
+  size_t m_NumNormals = 0;
+  double m_SearchRadiusSq = 0.0;
+  double m_CellSize = 1.0;
+  int m_CellsPerAxis = 1;
+  std::vector<size_t> m_CellStart;
+  std::vector<size_t> m_Entries;
+  std::vector<size_t> m_Unindexed;
+
+  /**
+   * @brief cellCoordinate Returns the grid cell along one axis that holds the coordinate
+   * @param value
+   * @return
+   */
+  int cellCoordinate(double value) const;
+
+public:
+  SphericalNormalIndex(const SphericalNormalIndex&) = delete;            // Copy Constructor Not Implemented
+  SphericalNormalIndex(SphericalNormalIndex&&) = delete;                 // Move Constructor Not Implemented
+  SphericalNormalIndex& operator=(const SphericalNormalIndex&) = delete; // Copy Assignment Not Implemented
+  SphericalNormalIndex& operator=(SphericalNormalIndex&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,201 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cstring>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+// Directly include the .cpp file instead of the header because of the way the unit
+// tests are compiled.
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/EbsdScanCache.cpp"
+
+/**
+ * @brief The ScanCacheTestReader class stands in for an AngReader or CtfReader that has read a full scan
+ */
+class ScanCacheTestReader
+{
+public:
+  std::vector<int32_t> phases;
+  std::vector<float> confidenceIndex;
+
+  EbsdLib::NumericTypes::Type getPointerType(const QString& name)
+  {
+    if(name == "Phase")
+    {
+      return EbsdLib::NumericTypes::Type::Int32;
+    }
+    if(name == "Confidence Index")
+    {
+      return EbsdLib::NumericTypes::Type::Float;
+    }
+    return EbsdLib::NumericTypes::Type::UnknownNumType;
+  }
+
+  void* getPointerByName(const QString& name)
+  {
+    if(name == "Phase")
+    {
+      return phases.data();
+    }
+    if(name == "Confidence Index")
+    {
+      return confidenceIndex.data();
+    }
+    return nullptr;
+  }
+};
+
+class EbsdScanCacheTest
+{
+public:
+  EbsdScanCacheTest() = default;
+  virtual ~EbsdScanCacheTest() = default;
+
+  /**
+   * @brief Returns the name of the class for EbsdScanCacheTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("EbsdScanCacheTest");
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(EbsdScanCache::GetCacheFilePath(UnitTest::EbsdScanCacheTest::SourceFile));
+    QFile::remove(UnitTest::EbsdScanCacheTest::SourceFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  // The cache only looks at the path, size and modification time of the scan file,
+  // so any content will do
+  // -----------------------------------------------------------------------------
+  void WriteSourceFile(const QByteArray& contents)
+  {
+    QFile file(UnitTest::EbsdScanCacheTest::SourceFile);
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    DREAM3D_REQUIRE_EQUAL(file.write(contents), contents.size())
+    file.close();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestHitMissAndInvalidation()
+  {
+    const QString sourceFile = UnitTest::EbsdScanCacheTest::SourceFile;
+    QFile::remove(EbsdScanCache::GetCacheFilePath(sourceFile));
+    WriteSourceFile(QByteArray("# Scan written by EbsdScanCacheTest\n"));
+
+    const size_t numElements = 1000;
+    ScanCacheTestReader reader;
+    reader.phases.resize(numElements);
+    reader.confidenceIndex.resize(numElements);
+    for(size_t i = 0; i < numElements; i++)
+    {
+      reader.phases[i] = static_cast<int32_t>(i % 3);
+      reader.confidenceIndex[i] = static_cast<float>(i) * 0.001f;
+    }
+    QStringList columnNames = {"Phase", "Confidence Index"};
+
+    // Miss: nothing has been written yet
+    EbsdScanCache scanCache;
+    DREAM3D_REQUIRE(!scanCache.load(sourceFile, columnNames))
+    DREAM3D_REQUIRE(!scanCache.isLoaded())
+
+    // Only 32 bit integer and float columns can be stored
+    DREAM3D_REQUIRE(!EbsdScanCache::Write(sourceFile, &reader, QStringList({"Phase", "Image Quality"}), numElements))
+
+    // Hit: the columns come back from the cache file unchanged
+    DREAM3D_REQUIRE(EbsdScanCache::Write(sourceFile, &reader, columnNames, numElements))
+    DREAM3D_REQUIRE(scanCache.load(sourceFile, columnNames))
+    DREAM3D_REQUIRE(scanCache.isLoaded())
+    DREAM3D_REQUIRE_EQUAL(scanCache.getNumberOfElements(), numElements)
+    const void* phases = scanCache.getPointerByName("Phase");
+    const void* confidenceIndex = scanCache.getPointerByName("Confidence Index");
+    DREAM3D_REQUIRE(nullptr != phases && nullptr != confidenceIndex)
+    DREAM3D_REQUIRE_EQUAL(::memcmp(phases, reader.phases.data(), numElements * sizeof(int32_t)), 0)
+    DREAM3D_REQUIRE_EQUAL(::memcmp(confidenceIndex, reader.confidenceIndex.data(), numElements * sizeof(float)), 0)
+    DREAM3D_REQUIRE(nullptr == scanCache.getPointerByName("Image Quality"))
+
+    // Miss: a column that was not cached is requested
+    DREAM3D_REQUIRE(!scanCache.load(sourceFile, QStringList({"Phase", "Image Quality"})))
+    DREAM3D_REQUIRE(!scanCache.isLoaded())
+
+    // Invalidation: the scan file changed after the cache was written
+    WriteSourceFile(QByteArray("# Scan rewritten by EbsdScanCacheTest with more data\n"));
+    DREAM3D_REQUIRE(!scanCache.load(sourceFile, columnNames))
+    DREAM3D_REQUIRE(!scanCache.isLoaded())
+    DREAM3D_REQUIRE_EQUAL(scanCache.getNumberOfElements(), 0)
+
+    // Rewriting the cache makes it current again
+    DREAM3D_REQUIRE(EbsdScanCache::Write(sourceFile, &reader, columnNames, numElements))
+    DREAM3D_REQUIRE(scanCache.load(sourceFile, columnNames))
+    scanCache.close();
+    DREAM3D_REQUIRE(!scanCache.isLoaded())
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start " << getNameOfClass().toStdString() << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestHitMissAndInvalidation())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  EbsdScanCacheTest(const EbsdScanCacheTest&); // Copy Constructor Not Implemented
+  void operator=(const EbsdScanCacheTest&);    // Move assignment Not Implemented
+};
@@ -0,0 +1,361 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+// Directly include the .cpp file instead of the header because of the way the unit
+// tests are compiled.
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/SphericalNormalIndex.cpp"
+
+class SphericalNormalIndexTest
+{
+public:
+  SphericalNormalIndexTest() = default;
+  virtual ~SphericalNormalIndexTest() = default;
+
+  /**
+   * @brief Returns the name of the class for SphericalNormalIndexTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("SphericalNormalIndexTest");
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RandomUnitVector(std::mt19937_64& generator, float v[3])
+  {
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    float length = 0.0f;
+    while(length < 1.0E-3f)
+    {
+      v[0] = distribution(generator);
+      v[1] = distribution(generator);
+      v[2] = distribution(generator);
+      length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    }
+    v[0] /= length;
+    v[1] /= length;
+    v[2] /= length;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Unit normals, a cluster of near duplicates of the first query direction, a zero vector
+  // and a few vectors the index can not place (too long, NaN)
+  // -----------------------------------------------------------------------------
+  std::vector<float> MakeNormals(std::mt19937_64& generator, size_t numNormals, const float clusterDirection[3])
+  {
+    std::uniform_real_distribution<float> jitter(-1.0E-4f, 1.0E-4f);
+    std::vector<float> normals(3 * numNormals);
+    for(size_t i = 0; i < numNormals; i++)
+    {
+      RandomUnitVector(generator, normals.data() + 3 * i);
+    }
+    for(size_t i = 0; i < numNormals / 10; i++)
+    {
+      for(size_t c = 0; c < 3; c++)
+      {
+        normals[3 * i + c] = clusterDirection[c] + jitter(generator);
+      }
+    }
+    normals[3 * (numNormals - 1) + 0] = 2.0f;
+    normals[3 * (numNormals - 2) + 0] = 0.0f;
+    normals[3 * (numNormals - 2) + 1] = 0.0f;
+    normals[3 * (numNormals - 2) + 2] = 0.0f;
+    normals[3 * (numNormals - 3) + 1] = std::numeric_limits<float>::quiet_NaN();
+    return normals;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every vector passing the single precision test the GBCD/GBPD probes used on the
+  // full list must be a candidate
+  // -----------------------------------------------------------------------------
+  int TestCandidatesCoverBruteForce()
+  {
+    std::mt19937_64 generator(13579);
+    const float maxAngles[] = {0.005f, 0.0349f, 0.2f, 1.0f, 3.0f, 4.0f};
+    const size_t numNormals = 3000;
+
+    for(float maxAngle : maxAngles)
+    {
+      std::vector<float> directions(3 * 200);
+      for(size_t q = 0; q < 200; q++)
+      {
+        RandomUnitVector(generator, directions.data() + 3 * q);
+      }
+      std::vector<float> normals = MakeNormals(generator, numNormals, directions.data());
+      SphericalNormalIndex normalIndex(normals.data(), numNormals, maxAngle);
+
+      std::vector<size_t> candidates;
+      std::vector<char> isCandidate(numNormals, 0);
+      size_t totalCandidates = 0;
+      for(size_t q = 0; q < 200; q++)
+      {
+        const float* direction = directions.data() + 3 * q;
+        candidates.clear();
+        normalIndex.findCandidates(direction, candidates);
+        totalCandidates += candidates.size();
+
+        std::fill(isCandidate.begin(), isCandidate.end(), 0);
+        for(size_t candidate : candidates)
+        {
+          DREAM3D_REQUIRED(candidate, <, numNormals)
+          DREAM3D_REQUIRE_EQUAL(isCandidate[candidate], 0)
+          isCandidate[candidate] = 1;
+        }
+
+        for(size_t i = 0; i < numNormals; i++)
+        {
+          const float* n = normals.data() + 3 * i;
+          float gamma = acosf(direction[0] * n[0] + direction[1] * n[1] + direction[2] * n[2]);
+          if(gamma < maxAngle)
+          {
+            DREAM3D_REQUIRE_EQUAL(isCandidate[i], 1)
+          }
+          float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+          if(!(length < 1.01f))
+          {
+            DREAM3D_REQUIRE_EQUAL(isCandidate[i], 1)
+          }
+        }
+      }
+      // Small query angles must actually prune the list
+      if(maxAngle < 0.25f)
+      {
+        DREAM3D_REQUIRED(totalCandidates, <, 200 * numNormals / 4)
+      }
+    }
+
+    // A direction that is not unit length gets every vector
+    std::vector<float> normals = MakeNormals(generator, 100, std::vector<float>{1.0f, 0.0f, 0.0f}.data());
+    SphericalNormalIndex normalIndex(normals.data(), 100, 0.1f);
+    std::vector<size_t> candidates;
+    float longDirection[3] = {0.0f, 0.0f, 2.0f};
+    normalIndex.findCandidates(longDirection, candidates);
+    DREAM3D_REQUIRE_EQUAL(candidates.size(), 100)
+
+    // No vectors at all
+    SphericalNormalIndex emptyIndex(nullptr, 0, 0.1f);
+    candidates.clear();
+    emptyIndex.findCandidates(directions(), candidates);
+    DREAM3D_REQUIRE_EQUAL(candidates.size(), 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  const float* directions()
+  {
+    static const float direction[3] = {0.0f, 1.0f, 0.0f};
+    return direction;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void Multiply(const float m[3][3], const float v[3], float out[3])
+  {
+    for(int r = 0; r < 3; r++)
+    {
+      out[r] = m[r][0] * v[0] + m[r][1] * v[1] + m[r][2] * v[2];
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The metric based GBPD probe: the area within limitDist of a sampling direction over
+  // every symmetrized normal and its inverse. The full loop (as before the index) and the
+  // indexed lookup of transpose(sym) * p with hits summed in loop order must agree exactly.
+  // -----------------------------------------------------------------------------
+  int TestSymmetrizedProbe()
+  {
+    std::mt19937_64 generator(97531);
+    std::uniform_real_distribution<double> areaDistribution(0.1, 2.0);
+
+    // The 24 proper rotations of the cube
+    std::vector<std::vector<std::vector<float>>> symOps;
+    const int perms[6][3] = {{0, 1, 2}, {1, 2, 0}, {2, 0, 1}, {1, 0, 2}, {0, 2, 1}, {2, 1, 0}};
+    for(int p = 0; p < 6; p++)
+    {
+      float parity = (p < 3) ? 1.0f : -1.0f;
+      for(int s = 0; s < 8; s++)
+      {
+        float signs[3] = {(s & 1) ? -1.0f : 1.0f, (s & 2) ? -1.0f : 1.0f, (s & 4) ? -1.0f : 1.0f};
+        if(parity * signs[0] * signs[1] * signs[2] < 0.0f)
+        {
+          continue;
+        }
+        std::vector<std::vector<float>> op(3, std::vector<float>(3, 0.0f));
+        for(int r = 0; r < 3; r++)
+        {
+          op[r][perms[p][r]] = signs[r];
+        }
+        symOps.push_back(op);
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(symOps.size(), 24)
+
+    const size_t numTris = 400;
+    std::vector<float> normals(6 * numTris);
+    std::vector<double> areas(numTris);
+    for(size_t t = 0; t < numTris; t++)
+    {
+      RandomUnitVector(generator, normals.data() + 6 * t);
+      RandomUnitVector(generator, normals.data() + 6 * t + 3);
+      areas[t] = areaDistribution(generator);
+    }
+
+    for(float limitDist : {0.0349f, 0.1745f})
+    {
+      SphericalNormalIndex normalIndex(normals.data(), 2 * numTris, limitDist);
+      std::vector<size_t> candidates;
+      std::vector<uint64_t> hits;
+      for(size_t ptIdx = 0; ptIdx < 100; ptIdx++)
+      {
+        float probeNormal[3] = {0.0f, 0.0f, 0.0f};
+        RandomUnitVector(generator, probeNormal);
+        // Some probes sit right on a normal
+        if(ptIdx % 10 == 0)
+        {
+          std::copy(normals.data() + 3 * ptIdx, normals.data() + 3 * ptIdx + 3, probeNormal);
+        }
+
+        double bruteForce = 0.0;
+        double __c = 0.0;
+        for(size_t t = 0; t < numTris; t++)
+        {
+          for(const auto& op : symOps)
+          {
+            float sym[3][3] = {{op[0][0], op[0][1], op[0][2]}, {op[1][0], op[1][1], op[1][2]}, {op[2][0], op[2][1], op[2][2]}};
+            float sym_normal1[3] = {0.0f, 0.0f, 0.0f};
+            float sym_normal2[3] = {0.0f, 0.0f, 0.0f};
+            Multiply(sym, normals.data() + 6 * t, sym_normal1);
+            Multiply(sym, normals.data() + 6 * t + 3, sym_normal2);
+            for(int inversion = 0; inversion <= 1; inversion++)
+            {
+              float sign = (inversion == 1) ? -1.0f : 1.0f;
+              float gamma1 = acosf(sign * (probeNormal[0] * sym_normal1[0] + probeNormal[1] * sym_normal1[1] + probeNormal[2] * sym_normal1[2]));
+              float gamma2 = acosf(sign * (probeNormal[0] * sym_normal2[0] + probeNormal[1] * sym_normal2[1] + probeNormal[2] * sym_normal2[2]));
+              for(float gamma : {gamma1, gamma2})
+              {
+                if(gamma < limitDist)
+                {
+                  double __y = areas[t] - __c;
+                  double __t = bruteForce + __y;
+                  __c = (__t - bruteForce);
+                  __c -= __y;
+                  bruteForce = __t;
+                }
+              }
+            }
+          }
+        }
+
+        hits.clear();
+        uint64_t nsym = symOps.size();
+        for(uint64_t j = 0; j < nsym; j++)
+        {
+          const auto& op = symOps[j];
+          float sym[3][3] = {{op[0][0], op[0][1], op[0][2]}, {op[1][0], op[1][1], op[1][2]}, {op[2][0], op[2][1], op[2][2]}};
+          float symT[3][3] = {{op[0][0], op[1][0], op[2][0]}, {op[0][1], op[1][1], op[2][1]}, {op[0][2], op[1][2], op[2][2]}};
+          float symProbe[3] = {0.0f, 0.0f, 0.0f};
+          Multiply(symT, probeNormal, symProbe);
+          for(int inversion = 0; inversion <= 1; inversion++)
+          {
+            float sign = (inversion == 1) ? -1.0f : 1.0f;
+            float direction[3] = {sign * symProbe[0], sign * symProbe[1], sign * symProbe[2]};
+            candidates.clear();
+            normalIndex.findCandidates(direction, candidates);
+            for(size_t candidate : candidates)
+            {
+              float sym_normal[3] = {0.0f, 0.0f, 0.0f};
+              Multiply(sym, normals.data() + 3 * candidate, sym_normal);
+              float gamma = acosf(sign * (probeNormal[0] * sym_normal[0] + probeNormal[1] * sym_normal[1] + probeNormal[2] * sym_normal[2]));
+              if(gamma < limitDist)
+              {
+                hits.push_back(((static_cast<uint64_t>(candidate / 2) * nsym + j) * 2 + inversion) * 2 + candidate % 2);
+              }
+            }
+          }
+        }
+        std::sort(hits.begin(), hits.end());
+        double indexed = 0.0;
+        __c = 0.0;
+        for(uint64_t hit : hits)
+        {
+          double __y = areas[hit / 4 / nsym] - __c;
+          double __t = indexed + __y;
+          __c = (__t - indexed);
+          __c -= __y;
+          indexed = __t;
+        }
+
+        DREAM3D_REQUIRE_EQUAL(indexed, bruteForce)
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start " << getNameOfClass().toStdString() << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestCandidatesCoverBruteForce())
+    DREAM3D_REGISTER_TEST(TestSymmetrizedProbe())
+  }
+
+private:
+  SphericalNormalIndexTest(const SphericalNormalIndexTest&); // Copy Constructor Not Implemented
+  void operator=(const SphericalNormalIndexTest&);           // Move assignment Not Implemented
+};
@@ -0,0 +1,182 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <random>
+#include <vector>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/StringDataArray.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/WritePoleFigure.h"
+#include "OrientationAnalysisTestFileLocations.h"
+
+class WritePoleFigureTest
+{
+public:
+  WritePoleFigureTest() = default;
+  virtual ~WritePoleFigureTest() = default;
+
+  /**
+   * @brief Returns the name of the class for WritePoleFigureTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("WritePoleFigureTest");
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QDir(UnitTest::WritePoleFigureTest::OutputDir).removeRecursively();
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds two phases of random orientations; phase 2 only gets every fifth point
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("Data Container");
+    dca->addOrReplaceDataContainer(dc);
+
+    std::vector<size_t> tDims = {2000};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, "Cell Data", AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+
+    std::vector<size_t> cDims = {3};
+    FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(tDims, cDims, "EulerAngles", true);
+    cDims[0] = 1;
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(tDims, cDims, "Phases", true);
+    cellAM->addOrReplaceAttributeArray(eulers);
+    cellAM->addOrReplaceAttributeArray(phases);
+
+    std::mt19937_64 generator(12345);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    for(size_t i = 0; i < tDims[0]; i++)
+    {
+      eulers->setComponent(i, 0, distribution(generator) * 6.2831853f);
+      eulers->setComponent(i, 1, distribution(generator) * 3.1415927f);
+      eulers->setComponent(i, 2, distribution(generator) * 6.2831853f);
+      phases->setValue(i, (i % 5 == 0) ? 2 : 1);
+    }
+
+    std::vector<size_t> eDims = {3};
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New(eDims, "Ensemble Data", AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(eDims, cDims, "CrystalStructures", true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, EbsdLib::CrystalStructure::Cubic_High);
+    crystalStructures->setValue(2, EbsdLib::CrystalStructure::Hexagonal_High);
+    ensembleAM->addOrReplaceAttributeArray(crystalStructures);
+    StringDataArray::Pointer materialNames = StringDataArray::CreateArray(eDims[0], "MaterialName", true);
+    materialNames->setValue(0, "Invalid Phase");
+    materialNames->setValue(1, "Cubic");
+    materialNames->setValue(2, "Hexagonal");
+    ensembleAM->addOrReplaceAttributeArray(materialNames);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the filter with both generation algorithms, which label the PDF with the
+  // scalar bar and the discrete info area respectively
+  // -----------------------------------------------------------------------------
+  int TestWritePoleFigurePdf()
+  {
+    for(WritePoleFigure::Algorithm algorithm : {WritePoleFigure::Algorithm::LambertProjection, WritePoleFigure::Algorithm::Discrete})
+    {
+      RemoveTestFiles();
+
+      QString prefix = QString("Algorithm%1_").arg(static_cast<int>(algorithm));
+      WritePoleFigure::Pointer filter = WritePoleFigure::New();
+      filter->setDataContainerArray(createDataStructure());
+      filter->setOutputPath(UnitTest::WritePoleFigureTest::OutputDir);
+      filter->setImagePrefix(prefix);
+      filter->setTitle("WritePoleFigureTest");
+      filter->setImageSize(128);
+      filter->setLambertSize(32);
+      filter->setNumColors(32);
+      filter->setGenerationAlgorithm(static_cast<int>(algorithm));
+      filter->setUseGoodVoxels(false);
+      filter->setCellEulerAnglesArrayPath(DataArrayPath("Data Container", "Cell Data", "EulerAngles"));
+      filter->setCellPhasesArrayPath(DataArrayPath("Data Container", "Cell Data", "Phases"));
+      filter->setCrystalStructuresArrayPath(DataArrayPath("Data Container", "Ensemble Data", "CrystalStructures"));
+      filter->setMaterialNameArrayPath(DataArrayPath("Data Container", "Ensemble Data", "MaterialName"));
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+      for(int32_t phase = 1; phase <= 2; phase++)
+      {
+        QFileInfo pdf(UnitTest::WritePoleFigureTest::OutputDir + "/" + prefix + QString("Phase_%1.pdf").arg(phase));
+        DREAM3D_REQUIRE(pdf.exists())
+        DREAM3D_REQUIRED(pdf.size(), >, 0)
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start " << getNameOfClass().toStdString() << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestWritePoleFigurePdf())
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  WritePoleFigureTest(const WritePoleFigureTest&); // Copy Constructor Not Implemented
+  void operator=(const WritePoleFigureTest&);      // Move assignment Not Implemented
+};
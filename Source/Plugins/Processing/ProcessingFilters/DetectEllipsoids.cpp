@@ -72,6 +72,7 @@
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 #include "ProcessingFilters/HelperClasses/DetectEllipsoidsImpl.h"
+#include "ProcessingFilters/HelperClasses/FFTConvolution.h"
 
 #include <cmath>
 #include <limits>
@@ -358,21 +359,17 @@ void DetectEllipsoids::execute()
     {
       QString ss = QObject::tr("There was an internal error.  Please ask the DREAM.3D developers for more information.");
       setErrorCondition(-31001, ss);
+      return;
     }
 
-    // This convolution function fills the convCoords_X, convCoords_Y, and convCoords_Z arrays with values
+    // This convolution function fills the convCoords_X and convCoords_Y arrays with values
     DE_ComplexDoubleVector convCoords_X;
     DE_ComplexDoubleVector convCoords_Y;
-    DE_ComplexDoubleVector convCoords_Z;
-    convolutionFilter(orientArray, houghCircleVector, convCoords_X, convCoords_Y, convCoords_Z);
-
-    // Reverse these kernels now so that we don't have to reverse them during every single convolution run on each feature id
-    std::reverse(std::begin(convCoords_X), std::end(convCoords_X));
-    std::reverse(std::begin(convCoords_Y), std::end(convCoords_Y));
-    std::reverse(std::begin(convCoords_Z), std::end(convCoords_Z));
+    convolutionFilter(orientArray, houghCircleVector, convCoords_X, convCoords_Y);
 
-    // Create offset array to use for convolutions
-    Int32ArrayType::Pointer convOffsetArray = createOffsetArray(orient_tDims);
+    // The kernels are applied in frequency space; their spectra are computed once per padded object size and shared by all threads.
+    // The spectra are released when this execution finishes.
+    std::shared_ptr<FFTConvolution> houghConvolution = std::make_shared<FFTConvolution>(convCoords_X, convCoords_Y, orient_tDims[0], orient_tDims[1]);
 
     // Execute the smoothing filter
     int n_size = 3;
@@ -402,9 +399,8 @@ void DetectEllipsoids::execute()
       for(int i = 0; i < threads; i++)
       {
         m_ThreadWork[i] = 0;
-        g->run(DetectEllipsoidsImpl(i, this, cellFeatureIdsPtr, imageDims, corners, convCoords_X, convCoords_Y, convCoords_Z, orient_tDims, convOffsetArray, smoothFil, smoothOffsetArray, axis_min,
-                                    axis_max, m_HoughTransformThreshold, m_MinAspectRatio, m_CenterCoordinatesPtr, m_MajorAxisLengthArrayPtr, m_MinorAxisLengthArrayPtr, m_RotationalAnglesArrayPtr,
-                                    m_EllipseFeatureAttributeMatrixPtr));
+        g->run(DetectEllipsoidsImpl(i, this, cellFeatureIdsPtr, imageDims, corners, houghConvolution, smoothFil, smoothOffsetArray, axis_min, axis_max, m_HoughTransformThreshold,
+                                    m_MinAspectRatio, m_CenterCoordinatesPtr, m_MajorAxisLengthArrayPtr, m_MinorAxisLengthArrayPtr, m_RotationalAnglesArrayPtr, m_EllipseFeatureAttributeMatrixPtr));
       }
 
       g->wait();
@@ -412,9 +408,8 @@ void DetectEllipsoids::execute()
     else
 #endif
     {
-      DetectEllipsoidsImpl impl(0, this, cellFeatureIdsPtr, imageDims, corners, convCoords_X, convCoords_Y, convCoords_Z, orient_tDims, convOffsetArray, smoothFil, smoothOffsetArray, axis_min,
-                                axis_max, m_HoughTransformThreshold, m_MinAspectRatio, m_CenterCoordinatesPtr, m_MajorAxisLengthArrayPtr, m_MinorAxisLengthArrayPtr, m_RotationalAnglesArrayPtr,
-                                m_EllipseFeatureAttributeMatrixPtr);
+      DetectEllipsoidsImpl impl(0, this, cellFeatureIdsPtr, imageDims, corners, houghConvolution, smoothFil, smoothOffsetArray, axis_min, axis_max, m_HoughTransformThreshold, m_MinAspectRatio,
+                                m_CenterCoordinatesPtr, m_MajorAxisLengthArrayPtr, m_MinorAxisLengthArrayPtr, m_RotationalAnglesArrayPtr, m_EllipseFeatureAttributeMatrixPtr);
       m_ThreadWork[0] = 0;
       impl();
     }
@@ -573,14 +568,17 @@ DE_ComplexDoubleVector DetectEllipsoids::houghCircleFilter(int minAxisLength, in
 //
 // -----------------------------------------------------------------------------
 void DetectEllipsoids::convolutionFilter(DoubleArrayType::Pointer orientationFilter, DE_ComplexDoubleVector houghCircleFilter, DE_ComplexDoubleVector& convCoords_X,
-                                         DE_ComplexDoubleVector& convCoords_Y, DE_ComplexDoubleVector& convCoords_Z)
+                                         DE_ComplexDoubleVector& convCoords_Y)
 {
   if(orientationFilter->getNumberOfTuples() != houghCircleFilter.size() || orientationFilter->getNumberOfComponents() != 3)
   {
     return;
   }
 
-  for(int i = 0; i < orientationFilter->getNumberOfTuples(); i++)
+  size_t numTuples = orientationFilter->getNumberOfTuples();
+  convCoords_X.reserve(numTuples);
+  convCoords_Y.reserve(numTuples);
+  for(size_t i = 0; i < numTuples; i++)
   {
     std::complex<double> hcValue = houghCircleFilter[i];
 
@@ -591,10 +589,6 @@ void DetectEllipsoids::convolutionFilter(DoubleArrayType::Pointer orientationFil
     double orientValue_Y = orientationFilter->getComponent(i, 1);
     std::complex<double> valueY = orientValue_Y * hcValue;
     convCoords_Y.push_back(valueY);
-
-    double orientValue_Z = orientationFilter->getComponent(i, 2);
-    std::complex<double> valueZ = orientValue_Z * hcValue;
-    convCoords_Z.push_back(valueZ);
   }
 }
 
@@ -412,11 +412,9 @@ private:
    * @param houghCircleFilter HoughCircleFilter array input
    * @param convCoords_X
    * @param convCoords_Y
-   * @param convCoords_Z
    * @return
    */
-  void convolutionFilter(DoubleArrayType::Pointer orientationFilter, DE_ComplexDoubleVector houghCircleFilter, DE_ComplexDoubleVector& convCoords_X, DE_ComplexDoubleVector& convCoords_Y,
-                         DE_ComplexDoubleVector& convCoords_Z);
+  void convolutionFilter(DoubleArrayType::Pointer orientationFilter, DE_ComplexDoubleVector houghCircleFilter, DE_ComplexDoubleVector& convCoords_X, DE_ComplexDoubleVector& convCoords_Y);
 
   /**
    * @brief createConvOffsetArray
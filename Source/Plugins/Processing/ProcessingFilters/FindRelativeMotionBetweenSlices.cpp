@@ -33,7 +33,11 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "FindRelativeMotionBetweenSlices.h"
 
@@ -64,53 +68,133 @@
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
+/**
+ * @brief The RelativeMotionPlane struct maps the plane of interest onto the image geometry. The first two axes
+ * span the plane that patches are extracted from, and the third axis is the direction slices are stepped along.
+ */
+struct RelativeMotionPlane
+{
+  int64_t dims[3] = {0, 0, 0};    // Number of points along each plane axis
+  int64_t strides[3] = {0, 0, 0}; // Index stride of each plane axis in the cell array
+  int32_t axes[3] = {0, 1, 2};    // Which of X, Y and Z each plane axis corresponds to
+};
+
 /**
  * @brief The CalcRelativeMotion class implements a templated threaded algorithm for
  * determining the relative motion between a series of slices through a 3D volume.
+ *
+ * Each slice is matched against the slice one step further along. Rather than summing the squared differences
+ * over every patch point for every search offset, the squared difference image of the two slices is formed once
+ * per search offset and reduced to a summed-area table, so the patch sum of any point is four table lookups.
+ * Work is split into slabs of consecutive slices; each call allocates its plane sized buffers once and reuses
+ * them for every slice of its slabs.
  */
 template <typename T> class CalcRelativeMotion
 {
 
 public:
-  CalcRelativeMotion(T* data, float* motionDir, int32_t* patchPoints, int32_t* searchPoints, bool* validPoints, size_t numPP, size_t numSP)
+  CalcRelativeMotion(T* data, float* motionDir, const RelativeMotionPlane& plane, int32_t pSize1, int32_t pSize2, int32_t sSize1, int32_t sSize2, int32_t sliceStep,
+                     const std::vector<size_t>& slabBegins)
   : m_Data(data)
   , m_MotionDirection(motionDir)
-  , m_PatchPoints(patchPoints)
-  , m_SearchPoints(searchPoints)
-  , m_ValidPoints(validPoints)
-  , m_NumPatchPoints(numPP)
-  , m_NumSearchPoints(numSP)
+  , m_Plane(plane)
+  , m_PSize1(pSize1)
+  , m_PSize2(pSize2)
+  , m_SSize1(sSize1)
+  , m_SSize2(sSize2)
+  , m_SliceStep(sliceStep)
+  , m_SlabBegins(slabBegins)
   {
   }
   virtual ~CalcRelativeMotion() = default;
 
-  void convert(size_t start, size_t end) const
+  void convert(size_t startSlab, size_t endSlab) const
   {
-    int32_t patchPoint = 0, comparePoint = 0;
-    float val = 0.0f, minVal = 0.0f;
-    for(size_t i = start; i < end; i++)
+    const int64_t nu = m_Plane.dims[0];
+    const int64_t nv = m_Plane.dims[1];
+    const int64_t tableWidth = nu + 1;
+
+    // Points whose patch, shifted by any search offset, stays inside the slice
+    const int64_t uBuffer = (m_PSize1 / 2) + (m_SSize1 / 2);
+    const int64_t vBuffer = (m_PSize2 / 2) + (m_SSize2 / 2);
+    if(nu - uBuffer <= uBuffer || nv - vBuffer <= vBuffer)
+    {
+      return;
+    }
+
+    // The patch covers [-PSize/2, PSize/2) around each point
+    const int64_t uLow = -(m_PSize1 / 2);
+    const int64_t uHigh = (m_PSize1 / 2);
+    const int64_t vLow = -(m_PSize2 / 2);
+    const int64_t vHigh = (m_PSize2 / 2);
+
+    std::vector<double> slice(nu * nv, 0.0);
+    std::vector<double> shifted(nu * nv, 0.0);
+    std::vector<double> table(tableWidth * (nv + 1), 0.0);
+    std::vector<double> minVal(nu * nv, 0.0);
+    std::vector<int32_t> minOffset(2 * nu * nv, 0);
+
+    for(size_t w = m_SlabBegins[startSlab]; w < m_SlabBegins[endSlab]; w++)
     {
-      if(m_ValidPoints[i] == true)
+      // Copy both slices into contiguous buffers so every pass below runs with unit stride
+      copySlice(static_cast<int64_t>(w), slice);
+      copySlice(static_cast<int64_t>(w) + m_SliceStep, shifted);
+      std::fill(minVal.begin(), minVal.end(), std::numeric_limits<double>::max());
+
+      for(int32_t dv = -(m_SSize2 / 2); dv <= (m_SSize2 / 2); dv++)
       {
-        minVal = std::numeric_limits<float>::max();
-        for(size_t j = 0; j < m_NumSearchPoints; j++)
+        for(int32_t du = -(m_SSize1 / 2); du <= (m_SSize1 / 2); du++)
         {
-          val = 0;
-          for(size_t k = 0; k < m_NumPatchPoints; k++)
+          // Summed-area table of the squared differences for this offset; points whose partner falls outside the slice contribute nothing
+          const int64_t uStart = std::max<int64_t>(0, -du);
+          const int64_t uEnd = std::min<int64_t>(nu, nu - du);
+          for(int64_t v = 0; v < nv; v++)
           {
-            patchPoint = i + m_PatchPoints[k];
-            comparePoint = patchPoint + m_SearchPoints[4 * j];
-            val += float((m_Data[patchPoint] - m_Data[comparePoint])) * float((m_Data[patchPoint] - m_Data[comparePoint]));
+            const double* above = table.data() + (v * tableWidth);
+            double* row = table.data() + ((v + 1) * tableWidth);
+            double rowSum = 0.0;
+            const bool vInside = (v + dv >= 0 && v + dv < nv);
+            for(int64_t u = 0; u < nu; u++)
+            {
+              if(vInside && u >= uStart && u < uEnd)
+              {
+                double diff = slice[v * nu + u] - shifted[(v + dv) * nu + (u + du)];
+                rowSum += diff * diff;
+              }
+              row[u + 1] = above[u + 1] + rowSum;
+            }
           }
-          if(val < minVal)
+
+          for(int64_t v = vBuffer; v < nv - vBuffer; v++)
           {
-            minVal = val;
-            m_MotionDirection[3 * i + 0] = m_SearchPoints[4 * j + 1];
-            m_MotionDirection[3 * i + 1] = m_SearchPoints[4 * j + 2];
-            m_MotionDirection[3 * i + 2] = m_SearchPoints[4 * j + 3];
+            const double* top = table.data() + ((v + vLow) * tableWidth);
+            const double* bottom = table.data() + ((v + vHigh) * tableWidth);
+            for(int64_t u = uBuffer; u < nu - uBuffer; u++)
+            {
+              double val = bottom[u + uHigh] - bottom[u + uLow] - top[u + uHigh] + top[u + uLow];
+              size_t index = v * nu + u;
+              if(val < minVal[index])
+              {
+                minVal[index] = val;
+                minOffset[2 * index] = du;
+                minOffset[2 * index + 1] = dv;
+              }
+            }
           }
         }
       }
+
+      for(int64_t v = vBuffer; v < nv - vBuffer; v++)
+      {
+        for(int64_t u = uBuffer; u < nu - uBuffer; u++)
+        {
+          size_t index = v * nu + u;
+          size_t point = w * m_Plane.strides[2] + v * m_Plane.strides[1] + u * m_Plane.strides[0];
+          m_MotionDirection[3 * point + m_Plane.axes[0]] = minOffset[2 * index];
+          m_MotionDirection[3 * point + m_Plane.axes[1]] = minOffset[2 * index + 1];
+          m_MotionDirection[3 * point + m_Plane.axes[2]] = m_SliceStep;
+        }
+      }
     }
   }
 
@@ -123,11 +207,28 @@ public:
 private:
   T* m_Data;
   float* m_MotionDirection;
-  int32_t* m_PatchPoints;
-  int32_t* m_SearchPoints;
-  bool* m_ValidPoints;
-  size_t m_NumPatchPoints;
-  size_t m_NumSearchPoints;
+  RelativeMotionPlane m_Plane;
+  int32_t m_PSize1;
+  int32_t m_PSize2;
+  int32_t m_SSize1;
+  int32_t m_SSize2;
+  int32_t m_SliceStep;
+  const std::vector<size_t>& m_SlabBegins;
+
+  void copySlice(int64_t w, std::vector<double>& slice) const
+  {
+    const int64_t nu = m_Plane.dims[0];
+    const int64_t nv = m_Plane.dims[1];
+    for(int64_t v = 0; v < nv; v++)
+    {
+      const T* src = m_Data + (w * m_Plane.strides[2] + v * m_Plane.strides[1]);
+      double* dst = slice.data() + (v * nu);
+      for(int64_t u = 0; u < nu; u++)
+      {
+        dst[u] = static_cast<double>(src[u * m_Plane.strides[0]]);
+      }
+    }
+  }
 };
 
 // -----------------------------------------------------------------------------
@@ -330,146 +431,57 @@ void FindRelativeMotionBetweenSlices::execute()
   int64_t zP = static_cast<int64_t>(image->getZPoints());
   size_t totalPoints = xP * yP * zP;
 
-  int32_t buffer1 = (m_PSize1 / 2) + (m_SSize1 / 2);
-  int32_t buffer2 = (m_PSize2 / 2) + (m_SSize1 / 2);
-
-  std::vector<size_t> cDims(1, 4);
-  Int32ArrayType::Pointer patchPointsPtr = Int32ArrayType::CreateArray((m_PSize1 * m_PSize2), "_INTERNAL_USE_ONLY_patchPoints", true);
-  Int32ArrayType::Pointer searchPointsPtr = Int32ArrayType::CreateArray((m_SSize1 * m_SSize2), cDims, "_INTERNAL_USE_ONLY_searchPoints", true);
-  BoolArrayType::Pointer validPointsPtr = BoolArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_validPoints", true);
-  validPointsPtr->initializeWithValue(false);
-  int32_t* patchPoints = patchPointsPtr->getPointer(0);
-  int32_t* searchPoints = searchPointsPtr->getPointer(0);
-  bool* validPoints = validPointsPtr->getPointer(0);
-  int64_t yStride = 0, zStride = 0;
-  size_t count = 0;
-  size_t numPatchPoints = 0, numSearchPoints = 0;
-
+  // Lay the plane of interest out as (first patch axis, second patch axis, slice axis)
+  RelativeMotionPlane plane;
   if(m_Plane == 0)
   {
-    for(int32_t j = -(m_PSize2 / 2); j < (m_PSize2 / 2); j++)
-    {
-      yStride = j * xP;
-      for(int32_t i = -(m_PSize1 / 2); i < (m_PSize1 / 2); i++)
-      {
-        patchPoints[count] = yStride + i;
-        count++;
-      }
-    }
-    numPatchPoints = count;
-    count = 0;
-    for(int32_t j = -(m_SSize2 / 2); j <= (m_SSize2 / 2); j++)
-    {
-      yStride = j * xP;
-      for(int32_t i = -(m_SSize1 / 2); i <= (m_SSize1 / 2); i++)
-      {
-        searchPoints[4 * count] = (m_SliceStep * xP * yP) + yStride + i;
-        searchPoints[4 * count + 1] = i;
-        searchPoints[4 * count + 2] = j;
-        searchPoints[4 * count + 3] = m_SliceStep;
-        count++;
-      }
-    }
-    numSearchPoints = count;
-    for(int64_t k = 0; k < zP - m_SliceStep; k++)
-    {
-      zStride = k * xP * yP;
-      for(int64_t j = buffer2; j < (yP - buffer2); j++)
-      {
-        yStride = j * xP;
-        for(int64_t i = buffer1; i < (xP - buffer1); i++)
-        {
-          validPoints[zStride + yStride + i] = true;
-        }
-      }
-    }
+    plane.dims[0] = xP;
+    plane.dims[1] = yP;
+    plane.dims[2] = zP;
+    plane.strides[0] = 1;
+    plane.strides[1] = xP;
+    plane.strides[2] = xP * yP;
+    plane.axes[0] = 0;
+    plane.axes[1] = 1;
+    plane.axes[2] = 2;
   }
-
-  if(m_Plane == 1)
-  {
-    for(int32_t j = -(m_PSize2 / 2); j < (m_PSize2 / 2); j++)
-    {
-      yStride = (j * xP * yP);
-      for(int32_t i = -(m_PSize1 / 2); i < (m_PSize1 / 2); i++)
-      {
-        patchPoints[count] = yStride + i;
-        count++;
-      }
-    }
-    numPatchPoints = count;
-    count = 0;
-    for(int32_t j = -(m_SSize2 / 2); j <= (m_SSize2 / 2); j++)
-    {
-      yStride = (j * xP * yP);
-      for(int32_t i = -(m_SSize1 / 2); i <= (m_SSize1 / 2); i++)
-      {
-        searchPoints[count] = (m_SliceStep * xP) + yStride + i;
-        searchPoints[4 * count + 1] = i;
-        searchPoints[4 * count + 2] = m_SliceStep;
-        searchPoints[4 * count + 3] = j;
-        count++;
-      }
-    }
-    numSearchPoints = count;
-    for(int64_t k = buffer2; k < (zP - buffer2); k++)
-    {
-      zStride = k * xP * yP;
-      for(int64_t j = 0; j < yP - m_SliceStep; j++)
-      {
-        yStride = j * xP;
-        for(int64_t i = buffer1; i < (xP - buffer1); i++)
-        {
-          validPoints[zStride + yStride + i] = true;
-        }
-      }
-    }
+  else if(m_Plane == 1)
+  {
+    plane.dims[0] = xP;
+    plane.dims[1] = zP;
+    plane.dims[2] = yP;
+    plane.strides[0] = 1;
+    plane.strides[1] = xP * yP;
+    plane.strides[2] = xP;
+    plane.axes[0] = 0;
+    plane.axes[1] = 2;
+    plane.axes[2] = 1;
   }
-
-  if(m_Plane == 2)
+  else
   {
-    for(int32_t j = -(m_PSize2 / 2); j < (m_PSize2 / 2); j++)
-    {
-      yStride = (j * xP * yP);
-      for(int32_t i = -(m_PSize1 / 2); i < (m_PSize1 / 2); i++)
-      {
-        patchPoints[count] = yStride + (i * xP);
-        count++;
-      }
-    }
-    numPatchPoints = count;
-    count = 0;
-    for(int32_t j = -(m_SSize2 / 2); j <= (m_SSize2 / 2); j++)
-    {
-      yStride = (j * xP * yP);
-      for(int32_t i = -(m_SSize1 / 2); i <= (m_SSize1 / 2); i++)
-      {
-        searchPoints[count] = (m_SliceStep) + yStride + (i * xP);
-        searchPoints[4 * count + 1] = m_SliceStep;
-        searchPoints[4 * count + 2] = i;
-        searchPoints[4 * count + 3] = j;
-        count++;
-      }
-    }
-    numSearchPoints = count;
-    for(int64_t k = buffer2; k < (zP - buffer2); k++)
-    {
-      zStride = k * xP * yP;
-      for(int64_t j = buffer1; j < (yP - buffer1); j++)
-      {
-        yStride = j * xP;
-        for(int64_t i = 0; i < xP - m_SliceStep; i++)
-        {
-          validPoints[zStride + yStride + i] = true;
-        }
-      }
-    }
+    plane.dims[0] = yP;
+    plane.dims[1] = zP;
+    plane.dims[2] = xP;
+    plane.strides[0] = xP;
+    plane.strides[1] = xP * yP;
+    plane.strides[2] = 1;
+    plane.axes[0] = 1;
+    plane.axes[1] = 2;
+    plane.axes[2] = 0;
   }
 
-  if(nullptr == patchPoints || nullptr == searchPoints || nullptr == validPoints)
+  // Every slice that has a partner one step further along is matched. The slices are split into one slab per
+  // thread so the plane sized buffers are allocated once per slab rather than once per task.
+  size_t numSlices = static_cast<size_t>(plane.dims[2] - m_SliceStep);
+  size_t numSlabs = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  numSlabs = std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+#endif
+  numSlabs = std::max(std::min(numSlabs, numSlices), static_cast<size_t>(1));
+  std::vector<size_t> slabBegins(numSlabs + 1, 0);
+  for(size_t s = 0; s <= numSlabs; s++)
   {
-    QString ss = QObject::tr("Unable to establish search space for supplied parameters");
-    setErrorCondition(-11001, ss);
-    return;
+    slabBegins[s] = numSlices * s / numSlabs;
   }
 
   if(TemplateHelpers::CanDynamicCast<Int8ArrayType>()(m_InDataPtr.lock()))
@@ -479,14 +491,14 @@ void FindRelativeMotionBetweenSlices::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(doParallel)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<int8_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                        tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1),
+                        CalcRelativeMotion<int8_t>(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins), tbb::simple_partitioner());
     }
     else
 #endif
     {
-      CalcRelativeMotion<int8_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-      serial.convert(0, totalPoints);
+      CalcRelativeMotion<int8_t> serial(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins);
+      serial.convert(0, numSlabs);
     }
   }
   else if(TemplateHelpers::CanDynamicCast<UInt8ArrayType>()(m_InDataPtr.lock()))
@@ -496,14 +508,14 @@ void FindRelativeMotionBetweenSlices::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(doParallel)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<uint8_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                        tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1),
+                        CalcRelativeMotion<uint8_t>(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins), tbb::simple_partitioner());
     }
     else
 #endif
     {
-      CalcRelativeMotion<uint8_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-      serial.convert(0, totalPoints);
+      CalcRelativeMotion<uint8_t> serial(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins);
+      serial.convert(0, numSlabs);
     }
   }
   else if(TemplateHelpers::CanDynamicCast<Int16ArrayType>()(m_InDataPtr.lock()))
@@ -513,14 +525,14 @@ void FindRelativeMotionBetweenSlices::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(doParallel)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<int16_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                        tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1),
+                        CalcRelativeMotion<int16_t>(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins), tbb::simple_partitioner());
     }
     else
 #endif
     {
-      CalcRelativeMotion<int16_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-      serial.convert(0, totalPoints);
+      CalcRelativeMotion<int16_t> serial(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins);
+      serial.convert(0, numSlabs);
     }
   }
   else if(TemplateHelpers::CanDynamicCast<UInt16ArrayType>()(m_InDataPtr.lock()))
@@ -530,14 +542,14 @@ void FindRelativeMotionBetweenSlices::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(doParallel)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<uint16_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                        tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1),
+                        CalcRelativeMotion<uint16_t>(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins), tbb::simple_partitioner());
     }
     else
 #endif
     {
-      CalcRelativeMotion<uint16_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-      serial.convert(0, totalPoints);
+      CalcRelativeMotion<uint16_t> serial(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins);
+      serial.convert(0, numSlabs);
     }
   }
   else if(TemplateHelpers::CanDynamicCast<Int32ArrayType>()(m_InDataPtr.lock()))
@@ -547,14 +559,14 @@ void FindRelativeMotionBetweenSlices::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(doParallel)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<int32_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                        tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1),
+                        CalcRelativeMotion<int32_t>(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins), tbb::simple_partitioner());
     }
     else
 #endif
     {
-      CalcRelativeMotion<int32_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-      serial.convert(0, totalPoints);
+      CalcRelativeMotion<int32_t> serial(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins);
+      serial.convert(0, numSlabs);
     }
   }
   else if(TemplateHelpers::CanDynamicCast<UInt32ArrayType>()(m_InDataPtr.lock()))
@@ -564,14 +576,14 @@ void FindRelativeMotionBetweenSlices::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(doParallel)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<uint32_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                        tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1),
+                        CalcRelativeMotion<uint32_t>(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins), tbb::simple_partitioner());
     }
     else
 #endif
     {
-      CalcRelativeMotion<uint32_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-      serial.convert(0, totalPoints);
+      CalcRelativeMotion<uint32_t> serial(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins);
+      serial.convert(0, numSlabs);
     }
   }
   else if(TemplateHelpers::CanDynamicCast<Int64ArrayType>()(m_InDataPtr.lock()))
@@ -581,14 +593,14 @@ void FindRelativeMotionBetweenSlices::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(doParallel)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<int64_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                        tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1),
+                        CalcRelativeMotion<int64_t>(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins), tbb::simple_partitioner());
     }
     else
 #endif
     {
-      CalcRelativeMotion<int64_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-      serial.convert(0, totalPoints);
+      CalcRelativeMotion<int64_t> serial(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins);
+      serial.convert(0, numSlabs);
     }
   }
   else if(TemplateHelpers::CanDynamicCast<UInt64ArrayType>()(m_InDataPtr.lock()))
@@ -598,14 +610,14 @@ void FindRelativeMotionBetweenSlices::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(doParallel)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<uint64_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                        tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1),
+                        CalcRelativeMotion<uint64_t>(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins), tbb::simple_partitioner());
     }
     else
 #endif
     {
-      CalcRelativeMotion<uint64_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-      serial.convert(0, totalPoints);
+      CalcRelativeMotion<uint64_t> serial(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins);
+      serial.convert(0, numSlabs);
     }
   }
   else if(TemplateHelpers::CanDynamicCast<FloatArrayType>()(m_InDataPtr.lock()))
@@ -615,14 +627,14 @@ void FindRelativeMotionBetweenSlices::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(doParallel)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<float>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                        tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1),
+                        CalcRelativeMotion<float>(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins), tbb::simple_partitioner());
     }
     else
 #endif
     {
-      CalcRelativeMotion<float> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-      serial.convert(0, totalPoints);
+      CalcRelativeMotion<float> serial(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins);
+      serial.convert(0, numSlabs);
     }
   }
   else if(TemplateHelpers::CanDynamicCast<DoubleArrayType>()(m_InDataPtr.lock()))
@@ -632,14 +644,14 @@ void FindRelativeMotionBetweenSlices::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(doParallel)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<double>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                        tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1),
+                        CalcRelativeMotion<double>(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins), tbb::simple_partitioner());
     }
     else
 #endif
     {
-      CalcRelativeMotion<double> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-      serial.convert(0, totalPoints);
+      CalcRelativeMotion<double> serial(cPtr, m_MotionDirection, plane, m_PSize1, m_PSize2, m_SSize1, m_SSize2, m_SliceStep, slabBegins);
+      serial.convert(0, numSlabs);
     }
   }
   else
@@ -0,0 +1,495 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ConnectedComponents.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+namespace
+{
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t findRoot(int64_t* parents, int64_t index)
+{
+  while(parents[index] != index)
+  {
+    parents[index] = parents[parents[index]];
+    index = parents[index];
+  }
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t findComponent(const std::vector<int64_t>& roots, int64_t root)
+{
+  return static_cast<size_t>(std::lower_bound(roots.begin(), roots.end(), root) - roots.begin());
+}
+
+/**
+ * @brief The LabelComponentsImpl class runs the union-find passes of the labeling. Each pass only writes the
+ * parents of its own slab, which keeps the slabs independent.
+ */
+class LabelComponentsImpl
+{
+public:
+  LabelComponentsImpl(bool flatten, std::vector<ConnectedComponents::Slab>& slabs, int64_t* parents, const std::array<size_t, 3>& dims, const bool* mask, bool value)
+  : m_Flatten(flatten)
+  , m_Slabs(slabs)
+  , m_Parents(parents)
+  , m_Dims(dims)
+  , m_Mask(mask)
+  , m_Value(value)
+  {
+  }
+  virtual ~LabelComponentsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t s = start; s < end; s++)
+    {
+      if(m_Flatten)
+      {
+        flatten(m_Slabs[s]);
+      }
+      else
+      {
+        label(m_Slabs[s]);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  bool m_Flatten;
+  std::vector<ConnectedComponents::Slab>& m_Slabs;
+  int64_t* m_Parents;
+  std::array<size_t, 3> m_Dims;
+  const bool* m_Mask;
+  bool m_Value;
+
+  void unite(int64_t a, int64_t b) const
+  {
+    int64_t rootA = findRoot(m_Parents, a);
+    int64_t rootB = findRoot(m_Parents, b);
+    if(rootA < rootB)
+    {
+      m_Parents[rootB] = rootA;
+    }
+    else if(rootB < rootA)
+    {
+      m_Parents[rootA] = rootB;
+    }
+  }
+
+  /**
+   * @brief label Joins each cell with its -X, -Y and -Z neighbors inside the slab. Roots are always the lowest
+   * index of their set, so every parent index is lower than the index of its child.
+   */
+  void label(ConnectedComponents::Slab& slab) const
+  {
+    int64_t xPoints = static_cast<int64_t>(m_Dims[0]);
+    int64_t yPoints = static_cast<int64_t>(m_Dims[1]);
+    int64_t planeSize = xPoints * yPoints;
+    int64_t begin = static_cast<int64_t>(slab.begin);
+    for(int64_t i = begin; i < static_cast<int64_t>(slab.end); i++)
+    {
+      if(m_Mask[i] != m_Value)
+      {
+        m_Parents[i] = -1;
+        continue;
+      }
+      m_Parents[i] = i;
+      if(i % xPoints > 0 && m_Parents[i - 1] >= 0)
+      {
+        unite(i - 1, i);
+      }
+      if(i - xPoints >= begin && (i / xPoints) % yPoints > 0 && m_Parents[i - xPoints] >= 0)
+      {
+        unite(i - xPoints, i);
+      }
+      if(i - planeSize >= begin && m_Parents[i - planeSize] >= 0)
+      {
+        unite(i - planeSize, i);
+      }
+    }
+  }
+
+  /**
+   * @brief flatten Points every cell at its final root. Parents outside the slab belong to roots that were joined
+   * while merging the seams and already hold their final root.
+   */
+  void flatten(ConnectedComponents::Slab& slab) const
+  {
+    int64_t begin = static_cast<int64_t>(slab.begin);
+    slab.roots.clear();
+    for(int64_t i = begin; i < static_cast<int64_t>(slab.end); i++)
+    {
+      int64_t parent = m_Parents[i];
+      if(parent == i)
+      {
+        slab.roots.push_back(i);
+      }
+      else if(parent >= begin)
+      {
+        m_Parents[i] = m_Parents[parent];
+      }
+    }
+  }
+};
+
+/**
+ * @brief The ComponentRunsImpl class walks the flattened labels of each slab one run of equal components at a
+ * time, either adding the runs to the component sizes or writing a per component value into a mask
+ */
+class ComponentRunsImpl
+{
+public:
+  ComponentRunsImpl(const std::vector<ConnectedComponents::Slab>& slabs, const int64_t* parents, const std::array<size_t, 3>& dims, const std::vector<int64_t>& roots)
+  : m_Slabs(slabs)
+  , m_Parents(parents)
+  , m_Dims(dims)
+  , m_Roots(roots)
+  {
+  }
+  virtual ~ComponentRunsImpl() = default;
+
+  void setMeasurement(std::vector<std::atomic<uint64_t>>* sizes, std::vector<std::atomic<bool>>* touchesBoundary)
+  {
+    m_Sizes = sizes;
+    m_TouchesBoundary = touchesBoundary;
+  }
+
+  void setAssignment(bool* output, const std::vector<uint8_t>* values)
+  {
+    m_Output = output;
+    m_Values = values;
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t s = start; s < end; s++)
+    {
+      if(nullptr != m_Output)
+      {
+        assign(m_Slabs[s]);
+      }
+      else
+      {
+        measure(m_Slabs[s]);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<ConnectedComponents::Slab>& m_Slabs;
+  const int64_t* m_Parents;
+  std::array<size_t, 3> m_Dims;
+  const std::vector<int64_t>& m_Roots;
+  std::vector<std::atomic<uint64_t>>* m_Sizes = nullptr;
+  std::vector<std::atomic<bool>>* m_TouchesBoundary = nullptr;
+  bool* m_Output = nullptr;
+  const std::vector<uint8_t>* m_Values = nullptr;
+
+  void measure(const ConnectedComponents::Slab& slab) const
+  {
+    size_t xPoints = m_Dims[0];
+    size_t yPoints = m_Dims[1];
+    size_t zPoints = m_Dims[2];
+    int64_t runRoot = -1;
+    size_t runComponent = 0;
+    uint64_t runLength = 0;
+    bool runTouchesBoundary = false;
+
+    auto flush = [&]() {
+      if(runLength > 0)
+      {
+        (*m_Sizes)[runComponent].fetch_add(runLength, std::memory_order_relaxed);
+        if(runTouchesBoundary && !(*m_TouchesBoundary)[runComponent].load(std::memory_order_relaxed))
+        {
+          (*m_TouchesBoundary)[runComponent].store(true, std::memory_order_relaxed);
+        }
+      }
+      runLength = 0;
+      runTouchesBoundary = false;
+    };
+
+    for(size_t i = slab.begin; i < slab.end; i++)
+    {
+      int64_t root = m_Parents[i];
+      if(root < 0)
+      {
+        flush();
+        runRoot = -1;
+        continue;
+      }
+      if(root != runRoot)
+      {
+        flush();
+        runRoot = root;
+        runComponent = findComponent(m_Roots, root);
+      }
+      runLength++;
+      if(!runTouchesBoundary)
+      {
+        size_t x = i % xPoints;
+        size_t y = (i / xPoints) % yPoints;
+        size_t z = i / (xPoints * yPoints);
+        runTouchesBoundary = x == 0 || x == xPoints - 1 || y == 0 || y == yPoints - 1 || z == 0 || z == zPoints - 1;
+      }
+    }
+    flush();
+  }
+
+  void assign(const ConnectedComponents::Slab& slab) const
+  {
+    int64_t runRoot = -1;
+    bool runValue = false;
+    for(size_t i = slab.begin; i < slab.end; i++)
+    {
+      int64_t root = m_Parents[i];
+      if(root < 0)
+      {
+        continue;
+      }
+      if(root != runRoot)
+      {
+        runRoot = root;
+        runValue = (*m_Values)[findComponent(m_Roots, root)] != 0;
+      }
+      m_Output[i] = runValue;
+    }
+  }
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ConnectedComponents::ConnectedComponents(const bool* mask, const std::array<size_t, 3>& dims, bool value)
+: m_Dims(dims)
+{
+  size_t totalPoints = dims[0] * dims[1] * dims[2];
+  m_Parents.resize(totalPoints);
+
+  // Slabs are whole planes so that the only neighbors across a seam are the -Z neighbors of the first plane
+  size_t layerSize = dims[0] * dims[1];
+  size_t numLayers = dims[2];
+  if(numLayers == 1)
+  {
+    layerSize = dims[0];
+    numLayers = dims[1];
+  }
+  size_t numSlabs = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  numSlabs = std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+#endif
+  numSlabs = std::max(std::min(numSlabs, numLayers), static_cast<size_t>(1));
+  m_Slabs.resize(numSlabs);
+  for(size_t s = 0; s < numSlabs; s++)
+  {
+    m_Slabs[s].begin = (numLayers * s / numSlabs) * layerSize;
+    m_Slabs[s].end = (numLayers * (s + 1) / numSlabs) * layerSize;
+  }
+
+  LabelComponentsImpl labelImpl(false, m_Slabs, m_Parents.data(), m_Dims, mask, value);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), labelImpl, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    labelImpl.convert(0, numSlabs);
+  }
+
+  // Merge the seams. Only roots are linked here, always to the lower root, and the chains are not compressed so
+  // that no cell outside of a slab's own range is rewritten.
+  std::vector<int64_t> linkedRoots;
+  int64_t* parents = m_Parents.data();
+  auto findLinkedRoot = [parents](int64_t index) {
+    while(parents[index] != index)
+    {
+      index = parents[index];
+    }
+    return index;
+  };
+  for(size_t s = 1; s < numSlabs; s++)
+  {
+    int64_t begin = static_cast<int64_t>(m_Slabs[s].begin);
+    int64_t offset = static_cast<int64_t>(layerSize);
+    for(int64_t i = begin; i < begin + offset; i++)
+    {
+      if(parents[i] < 0 || parents[i - offset] < 0)
+      {
+        continue;
+      }
+      int64_t rootA = findLinkedRoot(i);
+      int64_t rootB = findLinkedRoot(i - offset);
+      if(rootA != rootB)
+      {
+        parents[std::max(rootA, rootB)] = std::min(rootA, rootB);
+        linkedRoots.push_back(std::max(rootA, rootB));
+      }
+    }
+  }
+  std::sort(linkedRoots.begin(), linkedRoots.end());
+  for(int64_t root : linkedRoots)
+  {
+    parents[root] = parents[parents[root]];
+  }
+
+  LabelComponentsImpl flattenImpl(true, m_Slabs, m_Parents.data(), m_Dims, mask, value);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), flattenImpl, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    flattenImpl.convert(0, numSlabs);
+  }
+
+  for(Slab& slab : m_Slabs)
+  {
+    m_Roots.insert(m_Roots.end(), slab.roots.begin(), slab.roots.end());
+    std::vector<int64_t>().swap(slab.roots);
+  }
+
+  std::vector<std::atomic<uint64_t>> sizes(m_Roots.size());
+  std::vector<std::atomic<bool>> touchesBoundary(m_Roots.size());
+  ComponentRunsImpl measureImpl(m_Slabs, m_Parents.data(), m_Dims, m_Roots);
+  measureImpl.setMeasurement(&sizes, &touchesBoundary);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), measureImpl, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    measureImpl.convert(0, numSlabs);
+  }
+
+  m_Sizes.resize(m_Roots.size());
+  m_TouchesBoundary.resize(m_Roots.size());
+  for(size_t c = 0; c < m_Roots.size(); c++)
+  {
+    m_Sizes[c] = sizes[c].load();
+    m_TouchesBoundary[c] = touchesBoundary[c].load() ? 1 : 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ConnectedComponents::~ConnectedComponents() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ConnectedComponents::getNumberOfComponents() const
+{
+  return m_Roots.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t ConnectedComponents::getComponent(size_t index) const
+{
+  int64_t root = m_Parents[index];
+  if(root < 0)
+  {
+    return -1;
+  }
+  return static_cast<int64_t>(findComponent(m_Roots, root));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<uint64_t>& ConnectedComponents::getSizes() const
+{
+  return m_Sizes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<uint8_t>& ConnectedComponents::getTouchesBoundary() const
+{
+  return m_TouchesBoundary;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ConnectedComponents::assignMask(bool* mask, const std::vector<uint8_t>& values) const
+{
+  ComponentRunsImpl assignImpl(m_Slabs, m_Parents.data(), m_Dims, m_Roots);
+  assignImpl.setAssignment(mask, &values);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, m_Slabs.size(), 1), assignImpl, tbb::simple_partitioner());
+#else
+  assignImpl.convert(0, m_Slabs.size());
+#endif
+}
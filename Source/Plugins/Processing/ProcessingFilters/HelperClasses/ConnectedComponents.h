@@ -0,0 +1,117 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The ConnectedComponents class labels the face connected (6 neighbor) regions of the cells of an image
+ * volume whose mask value equals a given value. The volume is cut into slabs of planes (rows for a single plane)
+ * that are labeled in parallel with a union-find; the seams between slabs are then merged and the union-find is
+ * flattened in parallel. Components are numbered in the order of their first cell, which matches a serial scan
+ * of the volume. Only the parent table is kept per cell, so the memory cost is one 64 bit integer per cell.
+ */
+class ConnectedComponents
+{
+public:
+  /**
+   * @brief ConnectedComponents Labels the volume
+   * @param mask Cell mask, X fastest
+   * @param dims X, Y and Z dimensions of the volume
+   * @param value Mask value of the cells to label
+   */
+  ConnectedComponents(const bool* mask, const std::array<size_t, 3>& dims, bool value);
+  virtual ~ConnectedComponents();
+
+  /**
+   * @brief getNumberOfComponents
+   * @return
+   */
+  size_t getNumberOfComponents() const;
+
+  /**
+   * @brief getComponent Returns the component of a cell or -1 if the cell was not labeled
+   * @param index
+   * @return
+   */
+  int64_t getComponent(size_t index) const;
+
+  /**
+   * @brief getSizes Number of cells of each component
+   * @return
+   */
+  const std::vector<uint64_t>& getSizes() const;
+
+  /**
+   * @brief getTouchesBoundary Non zero for each component with a cell on the outer surface of the volume
+   * @return
+   */
+  const std::vector<uint8_t>& getTouchesBoundary() const;
+
+  /**
+   * @brief assignMask Sets mask[i] to values[component] for every labeled cell i. Other cells are left unchanged.
+   * @param mask
+   * @param values One value per component
+   */
+  void assignMask(bool* mask, const std::vector<uint8_t>& values) const;
+
+  /**
+   * @brief The Slab struct describes a range of cells that is labeled by a single task
+   */
+  struct Slab
+  {
+    size_t begin = 0;
+    size_t end = 0;
+    std::vector<int64_t> roots;
+  };
+
+private:
+  std::array<size_t, 3> m_Dims = {{0, 0, 0}};
+  std::vector<int64_t> m_Parents;
+  std::vector<int64_t> m_Roots;
+  std::vector<Slab> m_Slabs;
+  std::vector<uint64_t> m_Sizes;
+  std::vector<uint8_t> m_TouchesBoundary;
+
+public:
+  ConnectedComponents(const ConnectedComponents&) = delete;            // Copy Constructor Not Implemented
+  ConnectedComponents(ConnectedComponents&&) = delete;                 // Move Constructor Not Implemented
+  ConnectedComponents& operator=(const ConnectedComponents&) = delete; // Copy Assignment Not Implemented
+  ConnectedComponents& operator=(ConnectedComponents&&) = delete;      // Move Assignment Not Implemented
+};
@@ -35,26 +35,74 @@
 
 #include "DetectEllipsoidsImpl.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include "ProcessingFilters/HelperClasses/ComputeGradient.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+namespace
+{
+/**
+ * @brief The FitEdgePairsImpl class fits a candidate ellipse to each edge pair of a sub-object. Every edge pair
+ * writes only its own slot, so the candidates come back in edge pair order regardless of scheduling.
+ */
+class FitEdgePairsImpl
+{
+public:
+  FitEdgePairsImpl(const DetectEllipsoidsImpl* impl, const SizeTArrayType::Pointer& obj_edge_pair_a1, const SizeTArrayType::Pointer& obj_edge_pair_b1, const std::vector<size_t>& obj_tDims,
+                   const Int8ArrayType::Pointer& obj_mask_edge, std::vector<DetectEllipsoidsImpl::EllipseCandidate>& candidates, std::vector<uint8_t>& accepted)
+  : m_Impl(impl)
+  , m_EdgePairA1(obj_edge_pair_a1)
+  , m_EdgePairB1(obj_edge_pair_b1)
+  , m_ObjDims(obj_tDims)
+  , m_ObjMaskEdge(obj_mask_edge)
+  , m_Candidates(candidates)
+  , m_Accepted(accepted)
+  {
+  }
+
+  void fit(size_t start, size_t end) const
+  {
+    for(size_t k = start; k < end; k++)
+    {
+      m_Accepted[k] = m_Impl->fitEdgePair(m_EdgePairA1, m_EdgePairB1, k, m_ObjDims, m_ObjMaskEdge, m_Candidates[k]) ? 1 : 0;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    fit(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const DetectEllipsoidsImpl* m_Impl;
+  const SizeTArrayType::Pointer& m_EdgePairA1;
+  const SizeTArrayType::Pointer& m_EdgePairB1;
+  const std::vector<size_t>& m_ObjDims;
+  const Int8ArrayType::Pointer& m_ObjMaskEdge;
+  std::vector<DetectEllipsoidsImpl::EllipseCandidate>& m_Candidates;
+  std::vector<uint8_t>& m_Accepted;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 DetectEllipsoidsImpl::DetectEllipsoidsImpl(int threadIndex, DetectEllipsoids* filter, int* cellFeatureIdsPtr, std::vector<size_t> cellFeatureIdsDims, UInt32ArrayType::Pointer corners,
-                                           DE_ComplexDoubleVector convCoords_X, DE_ComplexDoubleVector convCoords_Y, DE_ComplexDoubleVector convCoords_Z, std::vector<size_t> kernel_tDims,
-                                           Int32ArrayType::Pointer convOffsetArray, std::vector<double> smoothFil, Int32ArrayType::Pointer smoothOffsetArray, double axis_min, double axis_max,
-                                           float tol_ellipse, float ba_min, DoubleArrayType::Pointer center, DoubleArrayType::Pointer majaxis, DoubleArrayType::Pointer minaxis,
+                                           std::shared_ptr<FFTConvolution> houghConvolution, std::vector<double> smoothFil, Int32ArrayType::Pointer smoothOffsetArray, double axis_min,
+                                           double axis_max, float tol_ellipse, float ba_min, DoubleArrayType::Pointer center, DoubleArrayType::Pointer majaxis, DoubleArrayType::Pointer minaxis,
                                            DoubleArrayType::Pointer rotangle, AttributeMatrix::Pointer ellipseFeatureAM)
 : m_Filter(filter)
 , m_CellFeatureIdsPtr(cellFeatureIdsPtr)
 , m_CellFeatureIdsDims(cellFeatureIdsDims)
 , m_Corners(corners)
-, m_ConvCoords_X(convCoords_X)
-, m_ConvCoords_Y(convCoords_Y)
-, m_ConvCoords_Z(convCoords_Z)
-, m_ConvKernel_tDims(kernel_tDims)
-, m_ConvOffsetArray(convOffsetArray)
+, m_HoughConvolution(houghConvolution)
 , m_SmoothKernel(smoothFil)
 , m_SmoothOffsetArray(smoothOffsetArray)
 , m_Axis_Min(axis_min)
@@ -80,43 +128,6 @@ DetectEllipsoidsImpl::~DetectEllipsoidsImpl() = default;
 // -----------------------------------------------------------------------------
 void DetectEllipsoidsImpl::operator()() const
 {
-  // Initialize temporary arrays for candidate ellipse and accumulation counter
-  DoubleArrayType::Pointer cenx_can = DoubleArrayType::CreateArray(10, std::vector<size_t>(1, 1), "cenx_can", true); // x-coordinate of ellipse
-  for(int i = 0; i < cenx_can->getNumberOfTuples(); i++)
-  {
-    cenx_can->setComponent(i, 0, std::numeric_limits<double>::quiet_NaN());
-  }
-
-  DoubleArrayType::Pointer ceny_can = DoubleArrayType::CreateArray(10, std::vector<size_t>(1, 1), "ceny_can", true); // y-coordinate of ellipse
-  for(int i = 0; i < ceny_can->getNumberOfTuples(); i++)
-  {
-    ceny_can->setComponent(i, 0, std::numeric_limits<double>::quiet_NaN());
-  }
-
-  DoubleArrayType::Pointer maj_can = DoubleArrayType::CreateArray(10, std::vector<size_t>(1, 1), "maj_can", true); // major semi-axis
-  for(int i = 0; i < maj_can->getNumberOfTuples(); i++)
-  {
-    maj_can->setComponent(i, 0, std::numeric_limits<double>::quiet_NaN());
-  }
-
-  DoubleArrayType::Pointer min_can = DoubleArrayType::CreateArray(10, std::vector<size_t>(1, 1), "min_can", true); // minor semi-axis
-  for(int i = 0; i < min_can->getNumberOfTuples(); i++)
-  {
-    min_can->setComponent(i, 0, std::numeric_limits<double>::quiet_NaN());
-  }
-
-  DoubleArrayType::Pointer rot_can = DoubleArrayType::CreateArray(10, std::vector<size_t>(1, 1), "rot_can", true); // Counter clockwise rotation from x-axis
-  for(int i = 0; i < rot_can->getNumberOfTuples(); i++)
-  {
-    rot_can->setComponent(i, 0, std::numeric_limits<double>::quiet_NaN());
-  }
-
-  DoubleArrayType::Pointer accum_can = DoubleArrayType::CreateArray(10, std::vector<size_t>(1, 1), "accum_can", true); // Accumulation matrix
-  for(int i = 0; i < accum_can->getNumberOfTuples(); i++)
-  {
-    accum_can->setComponent(i, 0, std::numeric_limits<double>::quiet_NaN());
-  }
-
   // Run the ellipse detection algorithm on each object
   int32_t featureId = m_Filter->getNextFeatureId();
   while(featureId > 0)
@@ -191,16 +202,14 @@ void DetectEllipsoidsImpl::operator()() const
       DoubleArrayType::Pointer gradX = grad.getGradX();
       DoubleArrayType::Pointer gradY = grad.getGradY();
 
-      // Convolute Gradient of object with convolution kernel
-      DE_ComplexDoubleVector gradX_conv = convoluteImage(gradX, m_ConvCoords_X, m_ConvOffsetArray, paddedObj_tDims);
-      DE_ComplexDoubleVector gradY_conv = convoluteImage(gradY, m_ConvCoords_Y, m_ConvOffsetArray, paddedObj_tDims);
+      // Convolute Gradient of object with convolution kernel. The kernels span the whole axis range, so this is done in frequency space.
+      DE_ComplexDoubleVector obj_conv = m_HoughConvolution->convolvePair(gradX->getPointer(0), gradY->getPointer(0), paddedObj_xDim, paddedObj_yDim);
 
       // Calculate the magnitude matrix of the convolution.
-      DoubleArrayType::Pointer obj_conv_mag = DoubleArrayType::CreateArray(gradX_conv.size(), std::vector<size_t>(1, 1), "obj_conv_mag", true);
-      for(int i = 0; i < gradX_conv.size(); i++)
+      DoubleArrayType::Pointer obj_conv_mag = DoubleArrayType::CreateArray(obj_conv.size(), std::vector<size_t>(1, 1), "obj_conv_mag", true);
+      for(int i = 0; i < obj_conv.size(); i++)
       {
-        std::complex<double> complexValue = gradX_conv[i] + gradY_conv[i];
-        double value = std::abs(complexValue);
+        double value = std::abs(obj_conv[i]);
         obj_conv_mag->setValue(i, value);
       }
 
@@ -330,19 +339,39 @@ void DetectEllipsoidsImpl::operator()() const
         obj_edge_pair_b1->resizeTuples(count);
 
         // Analyze each edge pair using an accumulation array to gain votes to help determine that the sub-object is an ellipse
-        size_t can_num = 0;
-        for(int k = 0; k < obj_edge_pair_a1->getNumberOfTuples(); k++)
+        size_t edgePairCount = obj_edge_pair_a1->getNumberOfTuples();
+        std::vector<EllipseCandidate> candidates(edgePairCount);
+        std::vector<uint8_t> accepted(edgePairCount, 0);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+        bool doParallel = true;
+        if(doParallel)
         {
-          analyzeEdgePair(obj_edge_pair_a1, obj_edge_pair_b1, k, paddedObj_tDims, edgeArray, can_num, cenx_can, ceny_can, maj_can, min_can, rot_can, accum_can);
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, edgePairCount), FitEdgePairsImpl(this, obj_edge_pair_a1, obj_edge_pair_b1, paddedObj_tDims, edgeArray, candidates, accepted),
+                            tbb::auto_partitioner());
+        }
+        else
+#endif
+        {
+          FitEdgePairsImpl serial(this, obj_edge_pair_a1, obj_edge_pair_b1, paddedObj_tDims, edgeArray, candidates, accepted);
+          serial.fit(0, edgePairCount);
+        }
+
+        // Assume the accepted candidate with the most votes is the ellipse; ties go to the first edge pair
+        int bestCandidate = -1;
+        for(size_t k = 0; k < edgePairCount; k++)
+        {
+          if(accepted[k] != 0 && (bestCandidate < 0 || candidates[k].accum > candidates[bestCandidate].accum))
+          {
+            bestCandidate = static_cast<int>(k);
+          }
         }
 
         // If the sub-object has enough votes, it is found to be an ellipse
-        if(can_num > 0) // Assume best match is the ellipse
+        if(bestCandidate >= 0)
         {
           // Increment the ellipse counter
           m_Filter->incrementEllipseCount();
-          // Get the index into the ellipse value arrays that has the most votes
-          int accum_idx = getIdOfMax<double>(accum_can);
 
           /* If this is another ellipse in the same overall object,
            * create a new feature id and resize our output arrays */
@@ -353,12 +382,13 @@ void DetectEllipsoidsImpl::operator()() const
             m_EllipseFeatureAM->resizeAttributeArrays(std::vector<size_t>(1, objId + 1));
           }
 
-          double cenx_val = cenx_can->getValue(accum_idx);
-          double ceny_val = ceny_can->getValue(accum_idx);
-          double majaxis_val = maj_can->getValue(accum_idx);
-          double minaxis_val = min_can->getValue(accum_idx);
+          const EllipseCandidate& candidate = candidates[bestCandidate];
+          double cenx_val = candidate.cenx;
+          double ceny_val = candidate.ceny;
+          double majaxis_val = candidate.maj;
+          double minaxis_val = candidate.min;
 
-          double rotangle_val = rot_can->getValue(accum_idx);
+          double rotangle_val = candidate.rot;
 
           // Convert rotational angle until it is within -pi/2 and pi/2
           while(rotangle_val > SIMPLib::Constants::k_PiOver2 || rotangle_val < -SIMPLib::Constants::k_PiOver2)
@@ -399,9 +429,6 @@ void DetectEllipsoidsImpl::operator()() const
           m_Center->setComponent(objId, 0, m_Center->getComponent(objId, 0) + obj_x_min);
           m_Center->setComponent(objId, 1, m_Center->getComponent(objId, 1) + obj_y_min);
 
-          // Clear Accumulator
-          accum_can->initializeWithZeros();
-
           // Find all indices of non-zero elements in the featureObjArray
           objPixelsArray = findNonZeroIndices<double>(featureObjArray, paddedObj_tDims);
 
@@ -757,43 +784,15 @@ QPair<size_t, size_t> DetectEllipsoidsImpl::plotlineEdgeInter(int x0, int y0, in
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-SizeTArrayType::Pointer DetectEllipsoidsImpl::bitwiseMatrixCombination(SizeTArrayType::Pointer matrix1, Int8ArrayType::Pointer matrix2) const
-{
-  SizeTArrayType::Pointer result;
-
-  if(matrix1->getNumberOfTuples() != matrix2->getNumberOfTuples() || matrix1->getNumberOfComponents() != matrix2->getNumberOfComponents())
-  {
-    result = nullptr;
-  }
-  else
-  {
-    result = SizeTArrayType::CreateArray(matrix1->getNumberOfTuples(), matrix1->getComponentDimensions(), "Bitwise Matrix Combination", true);
-
-    for(int y = 0; y < matrix1->getNumberOfTuples(); y++)
-    {
-      for(int x = 0; x < matrix1->getNumberOfComponents(); x++)
-      {
-        result->setComponent(y, x, matrix1->getComponent(y, x) & matrix2->getComponent(y, x));
-      }
-    }
-  }
-
-  return result;
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void DetectEllipsoidsImpl::analyzeEdgePair(SizeTArrayType::Pointer obj_edge_pair_a1, SizeTArrayType::Pointer obj_edge_pair_b1, size_t index, std::vector<size_t> obj_tDims,
-                                           Int8ArrayType::Pointer obj_mask_edge, size_t& can_num, DoubleArrayType::Pointer cenx_can, DoubleArrayType::Pointer ceny_can,
-                                           DoubleArrayType::Pointer maj_can, DoubleArrayType::Pointer min_can, DoubleArrayType::Pointer rot_can, DoubleArrayType::Pointer accum_can) const
+bool DetectEllipsoidsImpl::fitEdgePair(const SizeTArrayType::Pointer& obj_edge_pair_a1, const SizeTArrayType::Pointer& obj_edge_pair_b1, size_t index, const std::vector<size_t>& obj_tDims,
+                                       const Int8ArrayType::Pointer& obj_mask_edge, EllipseCandidate& candidate) const
 {
   const int daxis = m_Axis_Max - m_Axis_Min;
   int axis_min_sq = m_Axis_Min * m_Axis_Min;
 
   // Matlab is column-based, so x & y are swapped
-  double dobj_x = obj_tDims[1];
-  double dobj_y = obj_tDims[0];
+  int obj_x = static_cast<int>(obj_tDims[1]);
+  int obj_y = static_cast<int>(obj_tDims[0]);
 
   double x1 = obj_edge_pair_a1->getComponent(index, 1);
   double y1 = obj_edge_pair_a1->getComponent(index, 0);
@@ -806,151 +805,126 @@ void DetectEllipsoidsImpl::analyzeEdgePair(SizeTArrayType::Pointer obj_edge_pair
   double a = sqrt(std::pow((x2 - x1), 2) + std::pow((y2 - y1), 2)) / 2;
   double alpha = atan2(y2 - y1, x2 - x1);
 
-  SizeTArrayType::Pointer accum = SizeTArrayType::CreateArray(daxis, std::vector<size_t>(1, 1), "Accumulator", true);
-  accum->initializeWithZeros();
-
-  if(a >= m_Axis_Min && a <= m_Axis_Max)
+  if(a < m_Axis_Min || a > m_Axis_Max)
   {
-    for(int k = 0; k < obj_edge_pair_a1->getNumberOfTuples(); k++)
-    {
+    return false;
+  }
 
-      double x3 = obj_edge_pair_a1->getComponent(k, 1);
-      double y3 = obj_edge_pair_a1->getComponent(k, 0);
+  // Votes for each minor axis length; bidx may reach daxis, so keep one extra bin
+  std::vector<size_t> accum(daxis + 1, 0);
+  size_t edgePairCount = obj_edge_pair_a1->getNumberOfTuples();
+  for(size_t k = 0; k < edgePairCount; k++)
+  {
+    double x3 = obj_edge_pair_a1->getComponent(k, 1);
+    double y3 = obj_edge_pair_a1->getComponent(k, 0);
 
-      double dsq = std::pow((x3 - x0), 2) + std::pow((y3 - y0), 2);
-      double asq = a * a;
+    double dsq = std::pow((x3 - x0), 2) + std::pow((y3 - y0), 2);
+    double asq = a * a;
 
-      if(dsq > axis_min_sq && dsq < asq)
-      {
-        double d = sqrt(dsq);
-        double fsq = std::pow((x3 - x2), 2) + std::pow((y3 - y2), 2);
+    if(dsq > axis_min_sq && dsq < asq)
+    {
+      double d = sqrt(dsq);
+      double fsq = std::pow((x3 - x2), 2) + std::pow((y3 - y2), 2);
 
-        double costau = (asq + dsq - fsq) / (2 * a * d);
+      double costau = (asq + dsq - fsq) / (2 * a * d);
 
-        double costau_sq = costau * costau;
-        double sintau_sq = 1 - costau_sq;
+      double costau_sq = costau * costau;
+      double sintau_sq = 1 - costau_sq;
 
-        double bsq = (asq * dsq * sintau_sq) / (asq - dsq * costau_sq);
+      double bsq = (asq * dsq * sintau_sq) / (asq - dsq * costau_sq);
 
-        double b = sqrt(bsq);
+      double b = sqrt(bsq);
 
-        // Add one to count from one
-        int bidx = static_cast<int>(std::round(b) - m_Axis_Min);
+      // Add one to count from one
+      int bidx = static_cast<int>(std::round(b) - m_Axis_Min);
 
-        if(bidx <= daxis && bidx > 0)
-        {
-          size_t value = accum->getValue(bidx);
-          accum->setValue(bidx, value + 1);
-        }
+      if(bidx <= daxis && bidx > 0)
+      {
+        accum[bidx]++;
       }
     }
+  }
 
-    int accum_idx = getIdOfMax<size_t>(accum);
-    double accum_max = accum->getValue(accum_idx);
-
-    if(accum_max > 5)
+  int accum_idx = 0;
+  for(int i = 1; i < static_cast<int>(accum.size()); i++)
+  {
+    if(accum[i] > accum[accum_idx])
     {
-      double b = accum_idx + m_Axis_Min;
-
-      if(b / a > m_Ba_Min)
-      {
-        // Draw ellipse and compare to object
-        size_t count = 0;
-        DoubleArrayType::Pointer ellipseCoords = m_Filter->plotEllipsev2(std::round(x0), std::round(y0), std::round(a), std::round(b), alpha, count);
-
-        // create I_check as a 2D array and assign all values to zero
-        std::vector<size_t> I_check_dims;
-        I_check_dims.push_back(dobj_y);
-        I_check_dims.push_back(dobj_x);
-
-        SizeTArrayType::Pointer I_check = SizeTArrayType::CreateArray(I_check_dims, std::vector<size_t>(1, 1), "I_check", true);
-        I_check->initializeWithZeros();
+      accum_idx = i;
+    }
+  }
+  double accum_max = accum[accum_idx];
 
-        for(int k = 0; k < ellipseCoords->getNumberOfTuples(); k++)
-        {
-          double x = ellipseCoords->getComponent(k, 0);
-          double y = ellipseCoords->getComponent(k, 1);
-          double z = 0; // 3DIM: This can be changed later to handle 3-dimensions
+  if(accum_max <= 5)
+  {
+    return false;
+  }
 
-          if(x >= 0 && x < dobj_x && y >= 0 && y < dobj_y)
-          {
-            size_t index = m_Filter->sub2ind(I_check_dims, y, x, z);
-            I_check->setValue(index, 1);
+  double b = accum_idx + m_Axis_Min;
+  if(b / a <= m_Ba_Min)
+  {
+    return false;
+  }
 
-            if(x + 1 < dobj_x)
-            {
-              index = m_Filter->sub2ind(I_check_dims, y, x + 1, z);
-              I_check->setValue(index, 1);
-            }
-            if(x - 1 >= 0)
-            {
-              index = m_Filter->sub2ind(I_check_dims, y, x - 1, z);
-              I_check->setValue(index, 1);
-            }
-            if(y + 1 < dobj_y)
-            {
-              index = m_Filter->sub2ind(I_check_dims, y + 1, x, z);
-              I_check->setValue(index, 1);
-            }
-            if(y - 1 >= 0)
-            {
-              index = m_Filter->sub2ind(I_check_dims, y - 1, x, z);
-              I_check->setValue(index, 1);
-            }
-            if(x + 1 < dobj_x && y + 1 < dobj_y)
-            {
-              index = m_Filter->sub2ind(I_check_dims, y + 1, x + 1, z);
-              I_check->setValue(index, 1);
-            }
-            if(x - 1 >= 0 && y + 1 < dobj_y)
-            {
-              index = m_Filter->sub2ind(I_check_dims, y + 1, x - 1, z);
-              I_check->setValue(index, 1);
-            }
-            if(x + 1 < dobj_x && y - 1 >= 0)
-            {
-              index = m_Filter->sub2ind(I_check_dims, y - 1, x + 1, z);
-              I_check->setValue(index, 1);
-            }
-            if(x - 1 >= 0 && y - 1 >= 0)
-            {
-              index = m_Filter->sub2ind(I_check_dims, y - 1, x - 1, z);
-              I_check->setValue(index, 1);
-            }
-          }
-        }
+  // Draw ellipse and compare to object
+  size_t count = 0;
+  DoubleArrayType::Pointer ellipseCoords = m_Filter->plotEllipsev2(std::round(x0), std::round(y0), std::round(a), std::round(b), alpha, count);
 
-        SizeTArrayType::Pointer combinedMatrix = bitwiseMatrixCombination(I_check, obj_mask_edge);
-        SizeTArrayType::Pointer overlap = findNonZeroIndices<size_t>(combinedMatrix, I_check_dims);
+  // Mark the drawn ellipse, thickened by one pixel in every direction, in I_check
+  std::vector<size_t> I_check_dims;
+  I_check_dims.push_back(obj_y);
+  I_check_dims.push_back(obj_x);
+  std::vector<uint8_t> I_check(I_check_dims[0] * I_check_dims[1], 0);
 
-        // Estimate perimeter length using Ramanujan'a approximation.
-        double perim = SIMPLib::Constants::k_Pi * (3 * (a + b) - sqrt((3 * a + b) * (a + 3 * b)));
-        // Calculate pixel tolerance based on
-        // the calculated perimeter
-        double tol_pix = std::round(perim * m_TolEllipse);
+  for(size_t k = 0; k < ellipseCoords->getNumberOfTuples(); k++)
+  {
+    double x = ellipseCoords->getComponent(k, 0);
+    double y = ellipseCoords->getComponent(k, 1);
+    double z = 0; // 3DIM: This can be changed later to handle 3-dimensions
 
-        if(overlap->getNumberOfTuples() > tol_pix)
+    if(x >= 0 && x < obj_x && y >= 0 && y < obj_y)
+    {
+      for(int dy = -1; dy <= 1; dy++)
+      {
+        for(int dx = -1; dx <= 1; dx++)
         {
-          // Accept point as a new candidate
-          if(can_num >= cenx_can->getNumberOfTuples())
+          if(x + dx >= 0 && x + dx < obj_x && y + dy >= 0 && y + dy < obj_y)
           {
-            cenx_can->resizeTuples(cenx_can->getNumberOfTuples() + 5);
-            ceny_can->resizeTuples(cenx_can->getNumberOfTuples() + 5);
-            maj_can->resizeTuples(cenx_can->getNumberOfTuples() + 5);
-            min_can->resizeTuples(cenx_can->getNumberOfTuples() + 5);
-            rot_can->resizeTuples(cenx_can->getNumberOfTuples() + 5);
-            accum_can->resizeTuples(cenx_can->getNumberOfTuples() + 5);
+            I_check[m_Filter->sub2ind(I_check_dims, y + dy, x + dx, z)] = 1;
           }
-
-          cenx_can->setComponent(can_num, 0, std::round(x0)); // x - coordinate of ellipse
-          ceny_can->setComponent(can_num, 0, std::round(y0)); // y - coordinate of ellipse
-          maj_can->setComponent(can_num, 0, std::round(a));   // major semi - axis
-          min_can->setComponent(can_num, 0, std::round(b));   // minor semi - axis
-          rot_can->setComponent(can_num, 0, alpha);           // Counter clockwise rotation from x - axis
-          accum_can->setComponent(can_num, 0, accum_max);     // Accumulation matrix
-          can_num++;
         }
       }
     }
   }
+
+  // Count the object edge pixels covered by the ellipse
+  size_t overlap = 0;
+  const int8_t* edgePtr = obj_mask_edge->getPointer(0);
+  for(size_t i = 0; i < I_check.size(); i++)
+  {
+    if(I_check[i] != 0 && edgePtr[i] != 0)
+    {
+      overlap++;
+    }
+  }
+
+  // Estimate perimeter length using Ramanujan'a approximation.
+  double perim = SIMPLib::Constants::k_Pi * (3 * (a + b) - sqrt((3 * a + b) * (a + 3 * b)));
+  // Calculate pixel tolerance based on
+  // the calculated perimeter
+  double tol_pix = std::round(perim * m_TolEllipse);
+
+  if(overlap <= tol_pix)
+  {
+    return false;
+  }
+
+  // Accept point as a new candidate
+  candidate.cenx = std::round(x0);
+  candidate.ceny = std::round(y0);
+  candidate.maj = std::round(a);
+  candidate.min = std::round(b);
+  candidate.rot = alpha;
+  candidate.accum = accum_max;
+  return true;
 }
@@ -35,6 +35,7 @@
 #pragma once
 
 #include <complex>
+#include <memory>
 #include <vector>
 
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -42,6 +43,7 @@
 #include "SIMPLib/DataArrays/DataArray.hpp"
 
 #include "Processing/ProcessingFilters/DetectEllipsoids.h"
+#include "Processing/ProcessingFilters/HelperClasses/FFTConvolution.h"
 
 
 class DetectEllipsoids;
@@ -54,10 +56,23 @@ using DE_ComplexDoubleVector = std::vector<std::complex<double>>;
 class DetectEllipsoidsImpl
 {
 public:
-  DetectEllipsoidsImpl(int threadIndex, DetectEllipsoids* filter, int* cellFeatureIdsPtr, std::vector<size_t> cellFeatureIdsDims, UInt32ArrayType::Pointer corners, DE_ComplexDoubleVector convCoords_X,
-                       DE_ComplexDoubleVector convCoords_Y, DE_ComplexDoubleVector convCoords_Z, std::vector<size_t> kernel_tDims, Int32ArrayType::Pointer convOffsetArray,
-                       std::vector<double> smoothFil, Int32ArrayType::Pointer smoothOffsetArray, double axis_min, double axis_max, float tol_ellipse, float ba_min, DoubleArrayType::Pointer center,
-                       DoubleArrayType::Pointer majaxis, DoubleArrayType::Pointer minaxis, DoubleArrayType::Pointer rotangle, AttributeMatrix::Pointer ellipseFeatureAM);
+  /**
+   * @brief The EllipseCandidate struct holds the parameters of an ellipse fitted to a single edge pair
+   */
+  struct EllipseCandidate
+  {
+    double cenx = 0.0;  // x-coordinate of ellipse
+    double ceny = 0.0;  // y-coordinate of ellipse
+    double maj = 0.0;   // major semi-axis
+    double min = 0.0;   // minor semi-axis
+    double rot = 0.0;   // Counter clockwise rotation from x-axis
+    double accum = 0.0; // Accumulation count
+  };
+
+  DetectEllipsoidsImpl(int threadIndex, DetectEllipsoids* filter, int* cellFeatureIdsPtr, std::vector<size_t> cellFeatureIdsDims, UInt32ArrayType::Pointer corners,
+                       std::shared_ptr<FFTConvolution> houghConvolution, std::vector<double> smoothFil, Int32ArrayType::Pointer smoothOffsetArray, double axis_min, double axis_max,
+                       float tol_ellipse, float ba_min, DoubleArrayType::Pointer center, DoubleArrayType::Pointer majaxis, DoubleArrayType::Pointer minaxis, DoubleArrayType::Pointer rotangle,
+                       AttributeMatrix::Pointer ellipseFeatureAM);
 
   virtual ~DetectEllipsoidsImpl();
 
@@ -298,42 +313,26 @@ public:
   }
 
   /**
-   * @brief bitwiseMatrixCombination
-   * @param matrix1
-   * @param matrix2
-   * @return
-   */
-  SizeTArrayType::Pointer bitwiseMatrixCombination(SizeTArrayType::Pointer matrix1, Int8ArrayType::Pointer matrix2) const;
-
-  /**
-   * @brief analyzeEdgePair
+   * @brief fitEdgePair Votes for the minor axis of an ellipse whose major axis spans the given edge pair and
+   * accepts it as a candidate when enough of its perimeter overlaps the object edge. This only reads shared
+   * state, so edge pairs can be fitted concurrently.
    * @param obj_edge_pair_a1
    * @param obj_edge_pair_b1
    * @param index
    * @param obj_tDims
    * @param obj_mask_edge
-   * @param can_num
-   * @param cenx_can
-   * @param ceny_can
-   * @param maj_can
-   * @param min_can
-   * @param rot_can
-   * @param accum_can
+   * @param candidate
+   * @return True if the edge pair produced a candidate
    */
-  void analyzeEdgePair(SizeTArrayType::Pointer obj_edge_pair_a1, SizeTArrayType::Pointer obj_edge_pair_b1, size_t index, std::vector<size_t> obj_tDims, Int8ArrayType::Pointer obj_mask_edge,
-                       size_t& can_num, DoubleArrayType::Pointer cenx_can, DoubleArrayType::Pointer ceny_can, DoubleArrayType::Pointer maj_can, DoubleArrayType::Pointer min_can,
-                       DoubleArrayType::Pointer rot_can, DoubleArrayType::Pointer accum_can) const;
+  bool fitEdgePair(const SizeTArrayType::Pointer& obj_edge_pair_a1, const SizeTArrayType::Pointer& obj_edge_pair_b1, size_t index, const std::vector<size_t>& obj_tDims,
+                   const Int8ArrayType::Pointer& obj_mask_edge, EllipseCandidate& candidate) const;
 
 private:
   DetectEllipsoids* m_Filter;
   int* m_CellFeatureIdsPtr;
   std::vector<size_t> m_CellFeatureIdsDims;
   UInt32ArrayType::Pointer m_Corners;
-  DE_ComplexDoubleVector m_ConvCoords_X;
-  DE_ComplexDoubleVector m_ConvCoords_Y;
-  DE_ComplexDoubleVector m_ConvCoords_Z;
-  std::vector<size_t> m_ConvKernel_tDims;
-  Int32ArrayType::Pointer m_ConvOffsetArray;
+  std::shared_ptr<FFTConvolution> m_HoughConvolution;
   std::vector<double> m_SmoothKernel;
   Int32ArrayType::Pointer m_SmoothOffsetArray;
   double m_Axis_Min;
@@ -0,0 +1,268 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FFTConvolution.h"
+
+#include <QtCore/QMutexLocker>
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t nextPowerOfTwo(size_t value)
+{
+  size_t result = 1;
+  while(result < value)
+  {
+    result <<= 1;
+  }
+  return result;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FFTConvolution::FFTConvolution(ComplexVector kernelX, ComplexVector kernelY, size_t kernelXDim, size_t kernelYDim)
+: m_KernelX(std::move(kernelX))
+, m_KernelY(std::move(kernelY))
+, m_KernelXDim(kernelXDim)
+, m_KernelYDim(kernelYDim)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FFTConvolution::~FFTConvolution() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FFTConvolution::ComplexVector FFTConvolution::convolvePair(const double* imageX, const double* imageY, size_t xDim, size_t yDim) const
+{
+  // Pad to a power of two that holds the full linear convolution so nothing wraps around
+  size_t nx = nextPowerOfTwo(xDim + m_KernelXDim - 1);
+  size_t ny = nextPowerOfTwo(yDim + m_KernelYDim - 1);
+  std::shared_ptr<const Spectrum> spectrum = getSpectrum(nx, ny);
+
+  // Both images are real, so pack them into one complex transform: z = imageX + i * imageY
+  ComplexVector packed(nx * ny);
+  for(size_t y = 0; y < yDim; y++)
+  {
+    for(size_t x = 0; x < xDim; x++)
+    {
+      size_t index = (xDim * y) + x;
+      packed[(nx * y) + x] = std::complex<double>(imageX[index], imageY[index]);
+    }
+  }
+  transform2D(packed, *spectrum, false);
+
+  // Separate the two image spectra using conjugate symmetry, multiply by the kernel spectra and sum
+  ComplexVector product(nx * ny);
+  const std::complex<double> minusHalfI(0.0, -0.5);
+  for(size_t v = 0; v < ny; v++)
+  {
+    size_t mirrorV = (ny - v) % ny;
+    for(size_t u = 0; u < nx; u++)
+    {
+      size_t mirrorU = (nx - u) % nx;
+      size_t index = (nx * v) + u;
+      std::complex<double> z = packed[index];
+      std::complex<double> zMirror = std::conj(packed[(nx * mirrorV) + mirrorU]);
+      std::complex<double> specX = 0.5 * (z + zMirror);
+      std::complex<double> specY = minusHalfI * (z - zMirror);
+      product[index] = specX * spectrum->kernelX[index] + specY * spectrum->kernelY[index];
+    }
+  }
+  transform2D(product, *spectrum, true);
+
+  // Crop the 'same' sized window centered on the kernel and normalize the inverse transform
+  size_t xOffset = m_KernelXDim / 2;
+  size_t yOffset = m_KernelYDim / 2;
+  double scale = 1.0 / static_cast<double>(nx * ny);
+  ComplexVector result(xDim * yDim);
+  for(size_t y = 0; y < yDim; y++)
+  {
+    for(size_t x = 0; x < xDim; x++)
+    {
+      result[(xDim * y) + x] = product[(nx * (y + yOffset)) + (x + xOffset)] * scale;
+    }
+  }
+
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::shared_ptr<const FFTConvolution::Spectrum> FFTConvolution::getSpectrum(size_t nx, size_t ny) const
+{
+  QMutexLocker locker(&m_SpectraMutex);
+
+  std::pair<size_t, size_t> key(nx, ny);
+  auto iter = m_Spectra.find(key);
+  if(iter != m_Spectra.end())
+  {
+    return iter->second;
+  }
+
+  std::shared_ptr<Spectrum> spectrum = std::make_shared<Spectrum>();
+  spectrum->rows = createTransform(nx);
+  spectrum->columns = createTransform(ny);
+
+  spectrum->kernelX.assign(nx * ny, std::complex<double>(0.0, 0.0));
+  spectrum->kernelY.assign(nx * ny, std::complex<double>(0.0, 0.0));
+  for(size_t y = 0; y < m_KernelYDim; y++)
+  {
+    for(size_t x = 0; x < m_KernelXDim; x++)
+    {
+      size_t kernelIndex = (m_KernelXDim * y) + x;
+      spectrum->kernelX[(nx * y) + x] = m_KernelX[kernelIndex];
+      spectrum->kernelY[(nx * y) + x] = m_KernelY[kernelIndex];
+    }
+  }
+  transform2D(spectrum->kernelX, *spectrum, false);
+  transform2D(spectrum->kernelY, *spectrum, false);
+
+  m_Spectra[key] = spectrum;
+  return spectrum;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FFTConvolution::Transform1D FFTConvolution::createTransform(size_t size)
+{
+  Transform1D transform;
+  transform.size = size;
+
+  size_t bits = 0;
+  while((static_cast<size_t>(1) << bits) < size)
+  {
+    bits++;
+  }
+
+  transform.bitReverse.resize(size);
+  for(size_t i = 0; i < size; i++)
+  {
+    size_t reversed = 0;
+    for(size_t b = 0; b < bits; b++)
+    {
+      if((i >> b) & 1)
+      {
+        reversed |= static_cast<size_t>(1) << (bits - 1 - b);
+      }
+    }
+    transform.bitReverse[i] = reversed;
+  }
+
+  transform.twiddles.resize(size / 2);
+  for(size_t k = 0; k < size / 2; k++)
+  {
+    double angle = -2.0 * SIMPLib::Constants::k_Pi * static_cast<double>(k) / static_cast<double>(size);
+    transform.twiddles[k] = std::complex<double>(std::cos(angle), std::sin(angle));
+  }
+
+  return transform;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FFTConvolution::transform(std::complex<double>* data, const Transform1D& transform, bool inverse)
+{
+  size_t n = transform.size;
+  for(size_t i = 0; i < n; i++)
+  {
+    size_t j = transform.bitReverse[i];
+    if(i < j)
+    {
+      std::swap(data[i], data[j]);
+    }
+  }
+
+  for(size_t length = 2; length <= n; length <<= 1)
+  {
+    size_t half = length / 2;
+    size_t step = n / length;
+    for(size_t start = 0; start < n; start += length)
+    {
+      for(size_t k = 0; k < half; k++)
+      {
+        std::complex<double> w = transform.twiddles[k * step];
+        if(inverse)
+        {
+          w = std::conj(w);
+        }
+        std::complex<double> even = data[start + k];
+        std::complex<double> odd = data[start + k + half] * w;
+        data[start + k] = even + odd;
+        data[start + k + half] = even - odd;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FFTConvolution::transform2D(ComplexVector& data, const Spectrum& spectrum, bool inverse)
+{
+  size_t nx = spectrum.rows.size;
+  size_t ny = spectrum.columns.size;
+
+  for(size_t y = 0; y < ny; y++)
+  {
+    transform(data.data() + (nx * y), spectrum.rows, inverse);
+  }
+
+  ComplexVector column(ny);
+  for(size_t x = 0; x < nx; x++)
+  {
+    for(size_t y = 0; y < ny; y++)
+    {
+      column[y] = data[(nx * y) + x];
+    }
+    transform(column.data(), spectrum.columns, inverse);
+    for(size_t y = 0; y < ny; y++)
+    {
+      data[(nx * y) + x] = column[y];
+    }
+  }
+}
@@ -0,0 +1,139 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <complex>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QMutex>
+
+/**
+ * @brief The FFTConvolution class convolves a pair of real 2D images with a pair of complex kernels and
+ * returns the sum of the two results, which is how DetectEllipsoids applies its orientation weighted Hough
+ * kernels to the X and Y gradients of an object. The convolution is computed with an in-tree radix-2 FFT.
+ * Both real images are packed into a single complex transform and the kernel spectra are cached for every
+ * padded transform size that is requested, so each kernel is only transformed once per size. The output
+ * matches a zero padded 'same' convolution centered on the kernel. This class is safe to share between threads.
+ */
+class FFTConvolution
+{
+public:
+  using ComplexVector = std::vector<std::complex<double>>;
+
+  /**
+   * @brief FFTConvolution
+   * @param kernelX Kernel applied to the first image, stored X fastest
+   * @param kernelY Kernel applied to the second image, stored X fastest
+   * @param kernelXDim Kernel X dimension. Must be odd.
+   * @param kernelYDim Kernel Y dimension. Must be odd.
+   */
+  FFTConvolution(ComplexVector kernelX, ComplexVector kernelY, size_t kernelXDim, size_t kernelYDim);
+  virtual ~FFTConvolution();
+
+  /**
+   * @brief convolvePair Computes conv(imageX, kernelX) + conv(imageY, kernelY)
+   * @param imageX
+   * @param imageY
+   * @param xDim
+   * @param yDim
+   * @return Complex result with the same dimensions as the images
+   */
+  ComplexVector convolvePair(const double* imageX, const double* imageY, size_t xDim, size_t yDim) const;
+
+private:
+  struct Transform1D
+  {
+    size_t size = 0;
+    std::vector<size_t> bitReverse;
+    ComplexVector twiddles;
+  };
+
+  struct Spectrum
+  {
+    Transform1D rows;
+    Transform1D columns;
+    ComplexVector kernelX;
+    ComplexVector kernelY;
+  };
+
+  ComplexVector m_KernelX;
+  ComplexVector m_KernelY;
+  size_t m_KernelXDim = 0;
+  size_t m_KernelYDim = 0;
+
+  mutable QMutex m_SpectraMutex;
+  mutable std::map<std::pair<size_t, size_t>, std::shared_ptr<const Spectrum>> m_Spectra;
+
+  /**
+   * @brief getSpectrum Returns the cached transform tables and kernel spectra for a padded size, creating them if needed
+   * @param nx
+   * @param ny
+   * @return
+   */
+  std::shared_ptr<const Spectrum> getSpectrum(size_t nx, size_t ny) const;
+
+  /**
+   * @brief createTransform Builds the bit reversal and twiddle tables for a power of two length
+   * @param size
+   * @return
+   */
+  static Transform1D createTransform(size_t size);
+
+  /**
+   * @brief transform Performs an in-place 1D FFT over contiguous data
+   * @param data
+   * @param transform
+   * @param inverse
+   */
+  static void transform(std::complex<double>* data, const Transform1D& transform, bool inverse);
+
+  /**
+   * @brief transform2D Performs an in-place, unnormalized 2D FFT over an array stored X fastest
+   * @param data
+   * @param spectrum
+   * @param inverse
+   */
+  static void transform2D(ComplexVector& data, const Spectrum& spectrum, bool inverse);
+
+public:
+  FFTConvolution(const FFTConvolution&) = delete;            // Copy Constructor Not Implemented
+  FFTConvolution(FFTConvolution&&) = delete;                 // Move Constructor Not Implemented
+  FFTConvolution& operator=(const FFTConvolution&) = delete; // Copy Assignment Not Implemented
+  FFTConvolution& operator=(FFTConvolution&&) = delete;      // Move Assignment Not Implemented
+};
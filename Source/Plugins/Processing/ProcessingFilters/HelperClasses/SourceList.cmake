@@ -5,11 +5,13 @@ set(${PLUGIN_NAME}_HelperClasses_SRCS "")
 set(${PLUGIN_NAME}_HelperClasses_HDRS ${${PLUGIN_NAME}_HelperClasses_HDRS}
     ${${PLUGIN_NAME}_SOURCE_DIR}/HelperClasses/ComputeGradient.h
     ${${PLUGIN_NAME}_SOURCE_DIR}/HelperClasses/DetectEllipsoidsImpl.h
+    ${${PLUGIN_NAME}_SOURCE_DIR}/HelperClasses/FFTConvolution.h
 )
 
 set(${PLUGIN_NAME}_HelperClasses_SRCS ${${PLUGIN_NAME}_HelperClasses_SRCS}
     ${${PLUGIN_NAME}_SOURCE_DIR}/HelperClasses/ComputeGradient.cpp
     ${${PLUGIN_NAME}_SOURCE_DIR}/HelperClasses/DetectEllipsoidsImpl.cpp
+    ${${PLUGIN_NAME}_SOURCE_DIR}/HelperClasses/FFTConvolution.cpp
 )
 
 
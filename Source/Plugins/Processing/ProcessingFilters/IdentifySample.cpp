@@ -32,7 +32,9 @@
 *    United States Prime Contract Navy N00173-07-C-2068
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <array>
 #include <memory>
+#include <vector>
 
 #include "IdentifySample.h"
 
@@ -51,6 +53,7 @@
 
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
+#include "ProcessingFilters/HelperClasses/ConnectedComponents.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -133,178 +136,45 @@ void IdentifySample::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_GoodVoxelsArrayPath.getDataContainerName());
-  int64_t totalPoints = static_cast<int64_t>(m_GoodVoxelsPtr.lock()->getNumberOfTuples());
-
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
-  int64_t dims[3] = {
-      static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
-  };
+  std::array<size_t, 3> dims = {{udims[0], udims[1], udims[2]}};
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  int64_t xp = dims[0];
-  int64_t yp = dims[1];
-  int64_t zp = dims[2];
-
-  neighpoints[0] = -(xp * yp);
-  neighpoints[1] = -xp;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xp;
-  neighpoints[5] = (xp * yp);
-  std::vector<int64_t> currentvlist;
-  std::vector<bool> checked(totalPoints, false);
-  std::vector<bool> sample(totalPoints, false);
-  int64_t biggestBlock = 0;
-  size_t count = 0;
-  int32_t good = 0;
-  int64_t neighbor = 0;
-  int64_t column = 0, row = 0, plane = 0;
-  int64_t index = 0;
-
-  // In this loop over the data we are finding the biggest contiguous set of GoodVoxels and calling that the 'sample'  All GoodVoxels that do not touch the 'sample'
-  // are flipped to be called 'bad' voxels or 'not sample'
-  for(int64_t i = 0; i < totalPoints; i++)
+  // Find the biggest contiguous set of GoodVoxels and call that the 'sample'. All GoodVoxels that do not touch the 'sample'
+  // are flipped to be called 'bad' voxels or 'not sample'. Components are numbered in scan order, so on a tie the block
+  // found last wins.
   {
-    if(!checked[i] && m_GoodVoxels[i])
+    ConnectedComponents goodComponents(m_GoodVoxels, dims, true);
+    const std::vector<uint64_t>& sizes = goodComponents.getSizes();
+    std::vector<uint8_t> sample(sizes.size(), 0);
+    if(!sizes.empty())
     {
-      currentvlist.push_back(i);
-      count = 0;
-      while(count < currentvlist.size())
+      size_t biggestBlock = 0;
+      for(size_t c = 1; c < sizes.size(); c++)
       {
-        index = currentvlist[count];
-        column = index % xp;
-        row = (index / xp) % yp;
-        plane = index / (xp * yp);
-        for(int32_t j = 0; j < 6; j++)
+        if(sizes[c] >= sizes[biggestBlock])
         {
-          good = 1;
-          neighbor = index + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = 0;
-          }
-          if(j == 5 && plane == (zp - 1))
-          {
-            good = 0;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = 0;
-          }
-          if(j == 4 && row == (yp - 1))
-          {
-            good = 0;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = 0;
-          }
-          if(j == 3 && column == (xp - 1))
-          {
-            good = 0;
-          }
-          if(good == 1 && !checked[neighbor] && m_GoodVoxels[neighbor])
-          {
-            currentvlist.push_back(neighbor);
-            checked[neighbor] = true;
-          }
+          biggestBlock = c;
         }
-        count++;
       }
-      if(static_cast<int64_t>(currentvlist.size()) >= biggestBlock)
-      {
-        biggestBlock = currentvlist.size();
-        sample.assign(totalPoints, false);
-        for(int64_t j = 0; j < biggestBlock; j++)
-        {
-          sample[currentvlist[j]] = true;
-        }
-      }
-      currentvlist.clear();
+      sample[biggestBlock] = 1;
     }
+    goodComponents.assignMask(m_GoodVoxels, sample);
   }
-  for(int64_t i = 0; i < totalPoints; i++)
-  {
-    if(!sample[i] && m_GoodVoxels[i])
-    {
-      m_GoodVoxels[i] = false;
-    }
-  }
-  sample.clear();
-  checked.assign(totalPoints, false);
 
-  // In this loop we are going to 'close' all of the 'holes' inside of the region already identified as the 'sample' if the user chose to do so.
+  // 'Close' all of the 'holes' inside of the region already identified as the 'sample' if the user chose to do so.
   // This is done by flipping all 'bad' voxel features that do not touch the outside of the sample (i.e. they are fully contained inside of the 'sample'.
   if(m_FillHoles)
   {
-    bool touchesBoundary = false;
-    for(int64_t i = 0; i < totalPoints; i++)
+    ConnectedComponents badComponents(m_GoodVoxels, dims, false);
+    const std::vector<uint8_t>& touchesBoundary = badComponents.getTouchesBoundary();
+    std::vector<uint8_t> holes(touchesBoundary.size(), 0);
+    for(size_t c = 0; c < touchesBoundary.size(); c++)
     {
-      if(!checked[i] && !m_GoodVoxels[i])
-      {
-        currentvlist.push_back(i);
-        count = 0;
-        touchesBoundary = false;
-        while(count < currentvlist.size())
-        {
-          index = currentvlist[count];
-          column = index % xp;
-          row = (index / xp) % yp;
-          plane = index / (xp * yp);
-          if(column == 0 || column == (xp - 1) || row == 0 || row == (yp - 1) || plane == 0 || plane == (zp - 1))
-          {
-            touchesBoundary = true;
-          }
-          for(int32_t j = 0; j < 6; j++)
-          {
-            good = 1;
-            neighbor = index + neighpoints[j];
-            if(j == 0 && plane == 0)
-            {
-              good = 0;
-            }
-            if(j == 5 && plane == (zp - 1))
-            {
-              good = 0;
-            }
-            if(j == 1 && row == 0)
-            {
-              good = 0;
-            }
-            if(j == 4 && row == (yp - 1))
-            {
-              good = 0;
-            }
-            if(j == 2 && column == 0)
-            {
-              good = 0;
-            }
-            if(j == 3 && column == (xp - 1))
-            {
-              good = 0;
-            }
-            if(good == 1 && !checked[neighbor] && !m_GoodVoxels[neighbor])
-            {
-              currentvlist.push_back(neighbor);
-              checked[neighbor] = true;
-            }
-          }
-          count++;
-        }
-        if(!touchesBoundary)
-        {
-          for(size_t j = 0; j < currentvlist.size(); j++)
-          {
-            m_GoodVoxels[currentvlist[j]] = true;
-          }
-        }
-        currentvlist.clear();
-      }
+      holes[c] = touchesBoundary[c] != 0 ? 0 : 1;
     }
+    badComponents.assignMask(m_GoodVoxels, holes);
   }
-  checked.clear();
-
 
 }
 
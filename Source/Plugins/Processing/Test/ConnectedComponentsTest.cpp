@@ -0,0 +1,206 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "ProcessingTestFileLocations.h"
+
+// Directly include the .cpp file instead of the header because of the way the unit
+// tests are compiled.
+#include "Processing/ProcessingFilters/HelperClasses/ConnectedComponents.cpp"
+
+class ConnectedComponentsTest
+{
+public:
+  ConnectedComponentsTest() = default;
+  virtual ~ConnectedComponentsTest() = default;
+
+  /**
+   * @brief Returns the name of the class for ConnectedComponentsTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("ConnectedComponentsTest");
+  }
+
+  /**
+   * @brief The ReferenceComponents struct holds the result of the serial flood fill
+   */
+  struct ReferenceComponents
+  {
+    std::vector<int64_t> components;
+    std::vector<uint64_t> sizes;
+    std::vector<uint8_t> touchesBoundary;
+  };
+
+  // -----------------------------------------------------------------------------
+  // Flood fills the cells in scan order the way IdentifySample did before the parallel
+  // labeling, so components are numbered in the order of their first cell.
+  // -----------------------------------------------------------------------------
+  ReferenceComponents FloodFill(const std::vector<bool>& mask, const std::array<size_t, 3>& dims, bool value)
+  {
+    int64_t xp = static_cast<int64_t>(dims[0]);
+    int64_t yp = static_cast<int64_t>(dims[1]);
+    int64_t zp = static_cast<int64_t>(dims[2]);
+    int64_t totalPoints = xp * yp * zp;
+    int64_t neighpoints[6] = {-(xp * yp), -xp, -1, 1, xp, (xp * yp)};
+
+    ReferenceComponents reference;
+    reference.components.assign(totalPoints, -1);
+    std::vector<int64_t> currentvlist;
+    for(int64_t i = 0; i < totalPoints; i++)
+    {
+      if(reference.components[i] != -1 || mask[i] != value)
+      {
+        continue;
+      }
+      int64_t component = static_cast<int64_t>(reference.sizes.size());
+      bool touchesBoundary = false;
+      currentvlist.assign(1, i);
+      reference.components[i] = component;
+      for(size_t count = 0; count < currentvlist.size(); count++)
+      {
+        int64_t index = currentvlist[count];
+        int64_t column = index % xp;
+        int64_t row = (index / xp) % yp;
+        int64_t plane = index / (xp * yp);
+        if(column == 0 || column == xp - 1 || row == 0 || row == yp - 1 || plane == 0 || plane == zp - 1)
+        {
+          touchesBoundary = true;
+        }
+        bool good[6] = {plane > 0, row > 0, column > 0, column < xp - 1, row < yp - 1, plane < zp - 1};
+        for(int32_t j = 0; j < 6; j++)
+        {
+          int64_t neighbor = index + neighpoints[j];
+          if(good[j] && reference.components[neighbor] == -1 && mask[neighbor] == value)
+          {
+            reference.components[neighbor] = component;
+            currentvlist.push_back(neighbor);
+          }
+        }
+      }
+      reference.sizes.push_back(currentvlist.size());
+      reference.touchesBoundary.push_back(touchesBoundary ? 1 : 0);
+    }
+    return reference;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareWithFloodFill(const std::array<size_t, 3>& dims, double fraction, bool value, std::mt19937_64& generator)
+  {
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+    std::bernoulli_distribution distribution(fraction);
+    std::vector<bool> mask(totalPoints);
+    std::unique_ptr<bool[]> maskData(new bool[totalPoints]);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      mask[i] = distribution(generator);
+      maskData[i] = mask[i];
+    }
+
+    ConnectedComponents components(maskData.get(), dims, value);
+    ReferenceComponents reference = FloodFill(mask, dims, value);
+
+    DREAM3D_REQUIRE_EQUAL(components.getNumberOfComponents(), reference.sizes.size())
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(components.getComponent(i), reference.components[i])
+    }
+    for(size_t c = 0; c < reference.sizes.size(); c++)
+    {
+      DREAM3D_REQUIRE_EQUAL(components.getSizes()[c], reference.sizes[c])
+      DREAM3D_REQUIRE_EQUAL(components.getTouchesBoundary()[c], reference.touchesBoundary[c])
+    }
+
+    // Flip every other component; cells that were not labeled keep their value
+    std::vector<uint8_t> values(components.getNumberOfComponents());
+    for(size_t c = 0; c < values.size(); c++)
+    {
+      values[c] = (c % 2 == 0) ? 1 : 0;
+    }
+    components.assignMask(maskData.get(), values);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      bool expected = (reference.components[i] == -1) ? mask[i] : (values[reference.components[i]] != 0);
+      DREAM3D_REQUIRE_EQUAL(maskData[i], expected)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestLabeling()
+  {
+    std::mt19937_64 generator(98765);
+    const std::array<size_t, 3> shapes[] = {{{1, 1, 1}}, {{200, 1, 1}}, {{1, 150, 1}}, {{64, 40, 1}}, {{1, 30, 20}}, {{17, 13, 11}}, {{40, 40, 40}}};
+    const double fractions[] = {0.3, 0.55, 0.75};
+    for(const std::array<size_t, 3>& dims : shapes)
+    {
+      for(double fraction : fractions)
+      {
+        CompareWithFloodFill(dims, fraction, true, generator);
+        CompareWithFloodFill(dims, fraction, false, generator);
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start " << getNameOfClass().toStdString() << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestLabeling())
+  }
+
+private:
+  ConnectedComponentsTest(const ConnectedComponentsTest&); // Copy Constructor Not Implemented
+  void operator=(const ConnectedComponentsTest&);          // Move assignment Not Implemented
+};
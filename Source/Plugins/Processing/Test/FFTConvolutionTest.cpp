@@ -0,0 +1,174 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "ProcessingTestFileLocations.h"
+
+// Directly include the .cpp file instead of the header because of the way the unit
+// tests are compiled.
+#include "Processing/ProcessingFilters/HelperClasses/FFTConvolution.cpp"
+
+class FFTConvolutionTest
+{
+public:
+  FFTConvolutionTest() = default;
+  virtual ~FFTConvolutionTest() = default;
+
+  /**
+   * @brief Returns the name of the class for FFTConvolutionTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("FFTConvolutionTest");
+  }
+
+  // -----------------------------------------------------------------------------
+  // Direct convolution as DetectEllipsoids computed it before the FFT: the kernel is
+  // reversed and each output pixel sums the kernel against the image window centered
+  // on it, skipping pixels outside the image.
+  // -----------------------------------------------------------------------------
+  FFTConvolution::ComplexVector ReferenceConvolution(const std::vector<double>& image, size_t xDim, size_t yDim, FFTConvolution::ComplexVector kernel, size_t kernelXDim,
+                                                     size_t kernelYDim)
+  {
+    std::reverse(kernel.begin(), kernel.end());
+
+    FFTConvolution::ComplexVector result(xDim * yDim);
+    for(size_t y = 0; y < yDim; y++)
+    {
+      for(size_t x = 0; x < xDim; x++)
+      {
+        std::complex<double> accumulator = 0;
+        for(size_t ky = 0; ky < kernelYDim; ky++)
+        {
+          for(size_t kx = 0; kx < kernelXDim; kx++)
+          {
+            int64_t imageX = static_cast<int64_t>(x + kx) - static_cast<int64_t>(kernelXDim / 2);
+            int64_t imageY = static_cast<int64_t>(y + ky) - static_cast<int64_t>(kernelYDim / 2);
+            if(imageX < 0 || imageX >= static_cast<int64_t>(xDim) || imageY < 0 || imageY >= static_cast<int64_t>(yDim))
+            {
+              continue;
+            }
+            accumulator += kernel[(kernelXDim * ky) + kx] * image[(xDim * imageY) + imageX];
+          }
+        }
+        result[(xDim * y) + x] = accumulator;
+      }
+    }
+    return result;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  FFTConvolution::ComplexVector RandomKernel(std::mt19937_64& generator, size_t size)
+  {
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    FFTConvolution::ComplexVector kernel(size);
+    for(std::complex<double>& value : kernel)
+    {
+      value = std::complex<double>(distribution(generator), distribution(generator));
+    }
+    return kernel;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestConvolvePair()
+  {
+    std::mt19937_64 generator(54321);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    const size_t kernelXDim = 7;
+    const size_t kernelYDim = 5;
+    FFTConvolution::ComplexVector kernelX = RandomKernel(generator, kernelXDim * kernelYDim);
+    FFTConvolution::ComplexVector kernelY = RandomKernel(generator, kernelXDim * kernelYDim);
+    FFTConvolution convolution(kernelX, kernelY, kernelXDim, kernelYDim);
+
+    // Several object sizes, including a repeated one that is served from the cached spectra
+    const size_t sizes[4][2] = {{1, 1}, {13, 9}, {32, 3}, {13, 9}};
+    for(const size_t* size : sizes)
+    {
+      size_t xDim = size[0];
+      size_t yDim = size[1];
+      std::vector<double> imageX(xDim * yDim);
+      std::vector<double> imageY(xDim * yDim);
+      for(size_t i = 0; i < imageX.size(); i++)
+      {
+        imageX[i] = distribution(generator);
+        imageY[i] = distribution(generator);
+      }
+
+      FFTConvolution::ComplexVector result = convolution.convolvePair(imageX.data(), imageY.data(), xDim, yDim);
+      FFTConvolution::ComplexVector referenceX = ReferenceConvolution(imageX, xDim, yDim, kernelX, kernelXDim, kernelYDim);
+      FFTConvolution::ComplexVector referenceY = ReferenceConvolution(imageY, xDim, yDim, kernelY, kernelXDim, kernelYDim);
+
+      DREAM3D_REQUIRE_EQUAL(result.size(), xDim * yDim)
+      for(size_t i = 0; i < result.size(); i++)
+      {
+        double error = std::abs(result[i] - (referenceX[i] + referenceY[i]));
+        DREAM3D_REQUIRED(error, <, 1.0E-9)
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start " << getNameOfClass().toStdString() << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestConvolvePair())
+  }
+
+private:
+  FFTConvolutionTest(const FFTConvolutionTest&); // Copy Constructor Not Implemented
+  void operator=(const FFTConvolutionTest&);     // Move assignment Not Implemented
+};
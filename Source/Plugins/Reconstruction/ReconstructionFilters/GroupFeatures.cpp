@@ -47,6 +47,7 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 
+#include "Reconstruction/ReconstructionFilters/util/FeatureGraph.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -159,6 +160,63 @@ bool GroupFeatures::growGrouping(int32_t referenceFeature, int32_t neighborFeatu
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GroupFeatures::supportsPairGrouping() const
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GroupFeatures::determinePairGrouping(int32_t feature1, int32_t feature2) const
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* GroupFeatures::getGroupingParentIds()
+{
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GroupFeatures::resizeGroupedFeatures(int32_t numParents)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t GroupFeatures::assignGroups(const std::vector<int32_t>& groupRoots, int32_t* featureParentIds) const
+{
+  int32_t numfeatures = static_cast<int32_t>(groupRoots.size());
+
+  std::vector<int32_t> rootParentIds(numfeatures, -1);
+  int32_t parentcount = 0;
+  for(int32_t i = 0; i < numfeatures; i++)
+  {
+    if(featureParentIds[i] != -1)
+    {
+      continue;
+    }
+    int32_t root = groupRoots[i];
+    if(rootParentIds[root] == -1)
+    {
+      parentcount++;
+      rootParentIds[root] = parentcount;
+    }
+    featureParentIds[i] = rootParentIds[root];
+  }
+  return parentcount;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -175,6 +233,28 @@ void GroupFeatures::execute()
   NeighborList<int32_t>& neighborlist = *(m_ContiguousNeighborList.lock());
   NeighborList<int32_t>* nonContigNeighList = m_NonContiguousNeighborList.lock().get();
 
+  if(!m_PatchGrouping && supportsPairGrouping())
+  {
+    // Evaluate every unique neighbor pair once and group the connected Features
+    FeatureGraph graph(neighborlist.getNumberOfTuples());
+    graph.addNeighborList(neighborlist);
+    if(m_UseNonContiguousNeighbors)
+    {
+      graph.addNeighborList(*nonContigNeighList);
+    }
+    graph.build();
+
+    std::vector<uint8_t> grouped;
+    graph.evaluateEdges(grouped, [this](int32_t feature1, int32_t feature2) -> uint8_t { return determinePairGrouping(feature1, feature2) ? 1 : 0; });
+    if(getCancel())
+    {
+      return;
+    }
+    int32_t parentcount = assignGroups(graph.findGroups(grouped), getGroupingParentIds());
+    resizeGroupedFeatures(parentcount + 1);
+    return;
+  }
+
   std::vector<int32_t> grouplist;
 
   int32_t parentcount = 0;
@@ -36,6 +36,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/NeighborList.hpp"
@@ -243,6 +244,46 @@ protected:
    */
   virtual bool growGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid);
 
+  /**
+   * @brief supportsPairGrouping Returns whether determinePairGrouping alone decides if two neighboring
+   * Features belong to the same group, independent of the order the groups are grown in. When it does,
+   * execute() evaluates each unique neighbor pair once, in parallel, and finds the groups with union-find
+   * instead of growing them from random seeds
+   * @return Boolean check for whether the Feature graph can be used
+   */
+  virtual bool supportsPairGrouping() const;
+
+  /**
+   * @brief determinePairGrouping Determines if two neighboring Features belong to the same group. This is
+   * called from several threads at once and must not modify the filter
+   * @param feature1 First Feature of the pair
+   * @param feature2 Second Feature of the pair
+   * @return Boolean check for whether the Features should be grouped
+   */
+  virtual bool determinePairGrouping(int32_t feature1, int32_t feature2) const;
+
+  /**
+   * @brief getGroupingParentIds Returns the Feature parent Ids filled in by the Feature graph grouping, with
+   * -1 for Features that are not yet grouped. Subclasses that support pair grouping must reimplement this
+   * @return Pointer to the Feature parent Ids
+   */
+  virtual int32_t* getGroupingParentIds();
+
+  /**
+   * @brief resizeGroupedFeatures Resizes the new Feature Attribute Matrix after the Feature graph grouping
+   * @param numParents Number of parent Ids, including parent 0
+   */
+  virtual void resizeGroupedFeatures(int32_t numParents);
+
+  /**
+   * @brief assignGroups Assigns parent Ids to the groups found from the Feature graph, numbering the groups
+   * in order of their smallest Feature Id. Features that already have a parent keep it
+   * @param groupRoots Smallest Feature Id in the group of each Feature
+   * @param featureParentIds Parent Id of each Feature
+   * @return Largest parent Id assigned
+   */
+  int32_t assignGroups(const std::vector<int32_t>& groupRoots, int32_t* featureParentIds) const;
+
 private:
   DataArrayPath m_ContiguousNeighborListArrayPath = {};
   DataArrayPath m_NonContiguousNeighborListArrayPath = {};
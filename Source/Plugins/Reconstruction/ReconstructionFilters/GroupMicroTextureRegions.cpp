@@ -415,34 +415,27 @@ int32_t GroupMicroTextureRegions::getSeed(int32_t newFid)
 // -----------------------------------------------------------------------------
 bool GroupMicroTextureRegions::determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid)
 {
+  if(!m_UseRunningAverage)
+  {
+    if(m_FeatureParentIds[neighborFeature] == -1 && determinePairGrouping(referenceFeature, neighborFeature))
+    {
+      m_FeatureParentIds[neighborFeature] = newFid;
+      return true;
+    }
+    return false;
+  }
+
+  // The running average c-axis depends on the order the group grows in, so this path stays with the seeded growth
   uint32_t phase1 = 0, phase2 = 0;
   float w = 0.0f;
-  float g1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
   float g2[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-  float g1t[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
   float g2t[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-  float c1[3] = {0.0f, 0.0f, 0.0f};
   float c2[3] = {0.0f, 0.0f, 0.0f};
   float caxis[3] = {0.0f, 0.0f, 1.0f};
-  //  QuatF q1 = QuaternionMathF::New(0.0f, 0.0f, 0.0f, 0.0f);
-  //  QuatF q2 = QuaternionMathF::New(0.0f, 0.0f, 0.0f, 0.0f);
-  //  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
   if(m_FeatureParentIds[neighborFeature] == -1 && m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
   {
-    if(!m_UseRunningAverage)
-    {
-      QuatF q1(m_AvgQuats + referenceFeature * 4);
-      phase1 = m_CrystalStructures[m_FeaturePhases[referenceFeature]];
-      OrientationTransformation::qu2om<QuatF, Orientation<float>>(q1).toGMatrix(g1);
-      // transpose the g matrix so when caxis is multiplied by it
-      // it will give the sample direction that the caxis is along
-      MatrixMath::Transpose3x3(g1, g1t);
-      MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
-      // normalize so that the dot product can be taken below without
-      // dividing by the magnitudes (they would be 1)
-      MatrixMath::Normalize3x1(c1);
-    }
+    phase1 = m_CrystalStructures[m_FeaturePhases[referenceFeature]];
     phase2 = m_CrystalStructures[m_FeaturePhases[neighborFeature]];
     if(phase1 == phase2 && (phase1 == EbsdLib::CrystalStructure::Hexagonal_High))
     {
@@ -457,24 +450,14 @@ bool GroupMicroTextureRegions::determineGrouping(int32_t referenceFeature, int32
       // dividing by the magnitudes (they would be 1)
       MatrixMath::Normalize3x1(c2);
 
-      if(m_UseRunningAverage)
-      {
-        w = GeometryMath::CosThetaBetweenVectors(m_AvgCAxes, c2);
-      }
-      else
-      {
-        w = GeometryMath::CosThetaBetweenVectors(c1, c2);
-      }
+      w = GeometryMath::CosThetaBetweenVectors(m_AvgCAxes, c2);
       SIMPLibMath::bound(w, -1.0f, 1.0f);
       w = acosf(w);
       if(w <= m_CAxisToleranceRad || (SIMPLib::Constants::k_Pi - w) <= m_CAxisToleranceRad)
       {
         m_FeatureParentIds[neighborFeature] = newFid;
-        if(m_UseRunningAverage)
-        {
-          MatrixMath::Multiply3x1withConstant(c2, m_Volumes[neighborFeature]);
-          MatrixMath::Add3x1s(m_AvgCAxes, c2, m_AvgCAxes);
-        }
+        MatrixMath::Multiply3x1withConstant(c2, m_Volumes[neighborFeature]);
+        MatrixMath::Add3x1s(m_AvgCAxes, c2, m_AvgCAxes);
         return true;
       }
     }
@@ -482,6 +465,79 @@ bool GroupMicroTextureRegions::determineGrouping(int32_t referenceFeature, int32
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GroupMicroTextureRegions::determinePairGrouping(int32_t feature1, int32_t feature2) const
+{
+  float w = 0.0f;
+  float g1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+  float g2[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+  float g1t[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+  float g2t[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+  float c1[3] = {0.0f, 0.0f, 0.0f};
+  float c2[3] = {0.0f, 0.0f, 0.0f};
+  float caxis[3] = {0.0f, 0.0f, 1.0f};
+
+  if(m_FeaturePhases[feature1] <= 0 || m_FeaturePhases[feature2] <= 0)
+  {
+    return false;
+  }
+  uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[feature1]];
+  uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[feature2]];
+  if(phase1 != phase2 || phase1 != EbsdLib::CrystalStructure::Hexagonal_High)
+  {
+    return false;
+  }
+
+  QuatF q1(m_AvgQuats + feature1 * 4);
+  OrientationTransformation::qu2om<QuatF, Orientation<float>>(q1).toGMatrix(g1);
+  QuatF q2(m_AvgQuats + feature2 * 4);
+  OrientationTransformation::qu2om<QuatF, Orientation<float>>(q2).toGMatrix(g2);
+
+  // transpose the g matrices so when caxis is multiplied by them
+  // they will give the sample directions that the caxes are along
+  MatrixMath::Transpose3x3(g1, g1t);
+  MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
+  MatrixMath::Transpose3x3(g2, g2t);
+  MatrixMath::Multiply3x3with3x1(g2t, caxis, c2);
+  // normalize so that the dot product can be taken below without
+  // dividing by the magnitudes (they would be 1)
+  MatrixMath::Normalize3x1(c1);
+  MatrixMath::Normalize3x1(c2);
+
+  w = GeometryMath::CosThetaBetweenVectors(c1, c2);
+  SIMPLibMath::bound(w, -1.0f, 1.0f);
+  w = acosf(w);
+  return w <= m_CAxisToleranceRad || (SIMPLib::Constants::k_Pi - w) <= m_CAxisToleranceRad;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GroupMicroTextureRegions::supportsPairGrouping() const
+{
+  return !m_UseRunningAverage;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* GroupMicroTextureRegions::getGroupingParentIds()
+{
+  return m_FeatureParentIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GroupMicroTextureRegions::resizeGroupedFeatures(int32_t numParents)
+{
+  std::vector<size_t> tDims(1, numParents);
+  getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -313,6 +313,26 @@ protected:
    */
   virtual bool determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid);
 
+  /**
+   * @brief supportsPairGrouping Reimplemented from @see GroupFeatures class
+   */
+  virtual bool supportsPairGrouping() const;
+
+  /**
+   * @brief determinePairGrouping Reimplemented from @see GroupFeatures class
+   */
+  virtual bool determinePairGrouping(int32_t feature1, int32_t feature2) const;
+
+  /**
+   * @brief getGroupingParentIds Reimplemented from @see GroupFeatures class
+   */
+  virtual int32_t* getGroupingParentIds();
+
+  /**
+   * @brief resizeGroupedFeatures Reimplemented from @see GroupFeatures class
+   */
+  virtual void resizeGroupedFeatures(int32_t numParents);
+
   /**
    * @brief randomizeGrainIds Randomizes Feature Ids
    * @param totalPoints Size of Feature Ids array to randomize
@@ -393,87 +393,111 @@ int32_t MergeColonies::getSeed(int32_t newFid)
 //
 // -----------------------------------------------------------------------------
 bool MergeColonies::determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid)
+{
+  if(m_FeatureParentIds[neighborFeature] == -1 && determinePairGrouping(referenceFeature, neighborFeature))
+  {
+    m_FeatureParentIds[neighborFeature] = newFid;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MergeColonies::determinePairGrouping(int32_t feature1, int32_t feature2) const
 {
   double w = 0.0f;
   bool colony = false;
 
-  // QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
-  if(m_FeatureParentIds[neighborFeature] == -1 && m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
+  if(m_FeaturePhases[feature1] <= 0 || m_FeaturePhases[feature2] <= 0)
   {
-    w = std::numeric_limits<double>::max();
-    float* avgQuatPtr = m_AvgQuats + referenceFeature * 4;
-    QuatType q1(avgQuatPtr[0], avgQuatPtr[1], avgQuatPtr[2], avgQuatPtr[3]);
-    avgQuatPtr = m_AvgQuats + neighborFeature * 4;
-    QuatType q2(avgQuatPtr[0], avgQuatPtr[1], avgQuatPtr[2], avgQuatPtr[3]);
+    return false;
+  }
 
-    uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[referenceFeature]];
-    uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[neighborFeature]];
-    if(phase1 == phase2 && (phase1 == EbsdLib::CrystalStructure::Hexagonal_High))
-    {
-      OrientationD ax = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
+  w = std::numeric_limits<double>::max();
+  float* avgQuatPtr = m_AvgQuats + feature1 * 4;
+  QuatType q1(avgQuatPtr[0], avgQuatPtr[1], avgQuatPtr[2], avgQuatPtr[3]);
+  avgQuatPtr = m_AvgQuats + feature2 * 4;
+  QuatType q2(avgQuatPtr[0], avgQuatPtr[1], avgQuatPtr[2], avgQuatPtr[3]);
 
-      OrientationD rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(ax);
-      rod = m_OrientationOps[phase1]->getMDFFZRod(rod);
-      ax = OrientationTransformation::ro2ax<OrientationD, OrientationD>(rod);
+  uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[feature1]];
+  uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[feature2]];
+  if(phase1 == phase2 && (phase1 == EbsdLib::CrystalStructure::Hexagonal_High))
+  {
+    OrientationD ax = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
 
-      w = ax[3] * (SIMPLib::Constants::k_180OverPi);
-      float angdiff1 = std::fabs(w - 10.53f);
-      float axisdiff1 = std::acos(/*std::fabs(n1) * 0.0000f + std::fabs(n2) * 0.0000f +*/ std::fabs(ax[2]) /* * 1.0000f */);
-      if(angdiff1 < m_AngleTolerance && axisdiff1 < m_AxisToleranceRad)
-      {
-        colony = true;
-      }
-      float angdiff2 = std::fabs(w - 90.00f);
-      float axisdiff2 = std::acos(std::fabs(ax[0]) * 0.9958f + std::fabs(ax[1]) * 0.0917f /* + std::fabs(n3) * 0.0000f */);
-      if(angdiff2 < m_AngleTolerance && axisdiff2 < m_AxisToleranceRad)
-      {
-        colony = true;
-      }
-      float angdiff3 = std::fabs(w - 60.00f);
-      float axisdiff3 = std::acos(std::fabs(ax[0]) /* * 1.0000f + std::fabs(n2) * 0.0000f + std::fabs(n3) * 0.0000f*/);
-      if(angdiff3 < m_AngleTolerance && axisdiff3 < m_AxisToleranceRad)
-      {
-        colony = true;
-      }
-      float angdiff4 = std::fabs(w - 60.83f);
-      float axisdiff4 = std::acos(std::fabs(ax[0]) * 0.9834f + std::fabs(ax[1]) * 0.0905f + std::fabs(ax[2]) * 0.1570f);
-      if(angdiff4 < m_AngleTolerance && axisdiff4 < m_AxisToleranceRad)
-      {
-        colony = true;
-      }
-      float angdiff5 = std::fabs(w - 63.26f);
-      float axisdiff5 = std::acos(std::fabs(ax[0]) * 0.9549f /* + std::fabs(n2) * 0.0000f */ + std::fabs(ax[2]) * 0.2969f);
-      if(angdiff5 < m_AngleTolerance && axisdiff5 < m_AxisToleranceRad)
-      {
-        colony = true;
-      }
-      if(colony)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
+    OrientationD rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(ax);
+    rod = m_OrientationOps[phase1]->getMDFFZRod(rod);
+    ax = OrientationTransformation::ro2ax<OrientationD, OrientationD>(rod);
+
+    w = ax[3] * (SIMPLib::Constants::k_180OverPi);
+    float angdiff1 = std::fabs(w - 10.53f);
+    float axisdiff1 = std::acos(/*std::fabs(n1) * 0.0000f + std::fabs(n2) * 0.0000f +*/ std::fabs(ax[2]) /* * 1.0000f */);
+    if(angdiff1 < m_AngleTolerance && axisdiff1 < m_AxisToleranceRad)
+    {
+      colony = true;
     }
-    else if(EbsdLib::CrystalStructure::Cubic_High == phase2 && EbsdLib::CrystalStructure::Hexagonal_High == phase1)
+    float angdiff2 = std::fabs(w - 90.00f);
+    float axisdiff2 = std::acos(std::fabs(ax[0]) * 0.9958f + std::fabs(ax[1]) * 0.0917f /* + std::fabs(n3) * 0.0000f */);
+    if(angdiff2 < m_AngleTolerance && axisdiff2 < m_AxisToleranceRad)
     {
-      colony = check_for_burgers(q2, q1);
-      if(colony)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
+      colony = true;
     }
-    else if(EbsdLib::CrystalStructure::Cubic_High == phase1 && EbsdLib::CrystalStructure::Hexagonal_High == phase2)
+    float angdiff3 = std::fabs(w - 60.00f);
+    float axisdiff3 = std::acos(std::fabs(ax[0]) /* * 1.0000f + std::fabs(n2) * 0.0000f + std::fabs(n3) * 0.0000f*/);
+    if(angdiff3 < m_AngleTolerance && axisdiff3 < m_AxisToleranceRad)
     {
-      colony = check_for_burgers(q1, q2);
-      if(colony)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
+      colony = true;
+    }
+    float angdiff4 = std::fabs(w - 60.83f);
+    float axisdiff4 = std::acos(std::fabs(ax[0]) * 0.9834f + std::fabs(ax[1]) * 0.0905f + std::fabs(ax[2]) * 0.1570f);
+    if(angdiff4 < m_AngleTolerance && axisdiff4 < m_AxisToleranceRad)
+    {
+      colony = true;
+    }
+    float angdiff5 = std::fabs(w - 63.26f);
+    float axisdiff5 = std::acos(std::fabs(ax[0]) * 0.9549f /* + std::fabs(n2) * 0.0000f */ + std::fabs(ax[2]) * 0.2969f);
+    if(angdiff5 < m_AngleTolerance && axisdiff5 < m_AxisToleranceRad)
+    {
+      colony = true;
     }
   }
-  return false;
+  else if(EbsdLib::CrystalStructure::Cubic_High == phase2 && EbsdLib::CrystalStructure::Hexagonal_High == phase1)
+  {
+    colony = check_for_burgers(q2, q1);
+  }
+  else if(EbsdLib::CrystalStructure::Cubic_High == phase1 && EbsdLib::CrystalStructure::Hexagonal_High == phase2)
+  {
+    colony = check_for_burgers(q1, q2);
+  }
+  return colony;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MergeColonies::supportsPairGrouping() const
+{
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* MergeColonies::getGroupingParentIds()
+{
+  return m_FeatureParentIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MergeColonies::resizeGroupedFeatures(int32_t numParents)
+{
+  std::vector<size_t> tDims(1, numParents);
+  getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 }
 
 // -----------------------------------------------------------------------------
@@ -85,6 +85,8 @@ MergeTwins::MergeTwins()
 , m_FeatureParentIdsArrayName(SIMPL::FeatureData::ParentIds)
 , m_ActiveArrayName(SIMPL::FeatureData::Active)
 {
+  m_OrientationOps = LaueOps::GetAllOrientationOps();
+
   initialize();
 }
 
@@ -316,38 +318,65 @@ int32_t MergeTwins::getSeed(int32_t newFid)
 // -----------------------------------------------------------------------------
 bool MergeTwins::determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid)
 {
-  // float w = 0.0f;
-  // float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  bool twin = false;
-  std::vector<LaueOps::Pointer> m_OrientationOps = LaueOps::GetAllOrientationOps();
-
-  if(m_FeatureParentIds[neighborFeature] == -1 && m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
+  if(m_FeatureParentIds[neighborFeature] == -1 && determinePairGrouping(referenceFeature, neighborFeature))
   {
-    QuatF q1(m_AvgQuats + referenceFeature * 4);
+    m_FeatureParentIds[neighborFeature] = newFid;
+    return true;
+  }
+  return false;
+}
 
-    uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[referenceFeature]];
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MergeTwins::determinePairGrouping(int32_t feature1, int32_t feature2) const
+{
+  if(m_FeaturePhases[feature1] <= 0 || m_FeaturePhases[feature2] <= 0)
+  {
+    return false;
+  }
 
-    QuatF q2(m_AvgQuats + neighborFeature * 4);
-    uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[neighborFeature]];
-    if(phase1 == phase2 && (phase1 == EbsdLib::CrystalStructure::Cubic_High))
-    {
-      OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-      double w = axisAngle[3];
-      w = w * (SIMPLib::Constants::k_180OverPi);
-      double axisdiff111 = acosf(fabs(axisAngle[0]) * 0.57735f + fabs(axisAngle[1]) * 0.57735f + fabs(axisAngle[2]) * 0.57735f);
-      double angdiff60 = fabs(w - 60.0f);
-      if(axisdiff111 < m_AxisToleranceRad && angdiff60 < m_AngleTolerance)
-      {
-        twin = true;
-      }
-      if(twin)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
-    }
+  uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[feature1]];
+  uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[feature2]];
+  if(phase1 != phase2 || phase1 != EbsdLib::CrystalStructure::Cubic_High)
+  {
+    return false;
   }
-  return false;
+
+  QuatF q1(m_AvgQuats + feature1 * 4);
+  QuatF q2(m_AvgQuats + feature2 * 4);
+  OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
+  double w = axisAngle[3];
+  w = w * (SIMPLib::Constants::k_180OverPi);
+  double axisdiff111 = acosf(fabs(axisAngle[0]) * 0.57735f + fabs(axisAngle[1]) * 0.57735f + fabs(axisAngle[2]) * 0.57735f);
+  double angdiff60 = fabs(w - 60.0f);
+  return axisdiff111 < m_AxisToleranceRad && angdiff60 < m_AngleTolerance;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MergeTwins::supportsPairGrouping() const
+{
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* MergeTwins::getGroupingParentIds()
+{
+  return m_FeatureParentIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MergeTwins::resizeGroupedFeatures(int32_t numParents)
+{
+  std::vector<size_t> tDims(1, numParents);
+  getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 }
 
 // -----------------------------------------------------------------------------
@@ -43,6 +43,10 @@
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 
+class LaueOps;
+using LaueOpsShPtrType = std::shared_ptr<LaueOps>;
+using LaueOpsContainer = std::vector<LaueOpsShPtrType>;
+
 #include "Reconstruction/ReconstructionDLLExport.h"
 #include "Reconstruction/ReconstructionFilters/GroupFeatures.h"
 
@@ -306,6 +310,26 @@ protected:
    */
   virtual bool determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid);
 
+  /**
+   * @brief supportsPairGrouping Reimplemented from @see GroupFeatures class
+   */
+  virtual bool supportsPairGrouping() const;
+
+  /**
+   * @brief determinePairGrouping Reimplemented from @see GroupFeatures class
+   */
+  virtual bool determinePairGrouping(int32_t feature1, int32_t feature2) const;
+
+  /**
+   * @brief getGroupingParentIds Reimplemented from @see GroupFeatures class
+   */
+  virtual int32_t* getGroupingParentIds();
+
+  /**
+   * @brief resizeGroupedFeatures Reimplemented from @see GroupFeatures class
+   */
+  virtual void resizeGroupedFeatures(int32_t numParents);
+
   /**
    * @brief characterize_twins Characterizes twins; CURRENTLY NOT IMPLEMENTED
    */
@@ -339,6 +363,7 @@ private:
   QString m_FeatureParentIdsArrayName = {};
   QString m_ActiveArrayName = {};
 
+  LaueOpsContainer m_OrientationOps;
   float m_AxisToleranceRad = 0.0f;
 
   /**
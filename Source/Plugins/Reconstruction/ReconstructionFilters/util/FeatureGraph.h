@@ -0,0 +1,428 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+
+/**
+ * @brief The FeatureGraph class stores the Feature adjacency described by one or more
+ * NeighborLists as a compressed sparse row (CSR) edge table. Every unordered pair of
+ * neighboring Features is stored once: row i holds the neighbors j > i of Feature i, so
+ * edge e joins getEdgeRow(e) and getEdgeColumn(e), which lets per-edge values (a grouping
+ * criterion, a misorientation) be computed once, in parallel. On request, build() also maps
+ * each NeighborList entry to the edge it refers to so the values can be read back from either
+ * side of the boundary without a search.
+ */
+class FeatureGraph
+{
+public:
+  static const size_t k_InvalidEdge = std::numeric_limits<size_t>::max();
+
+  explicit FeatureGraph(size_t numFeatures)
+  : m_NumFeatures(numFeatures)
+  {
+  }
+
+  ~FeatureGraph() = default;
+
+  /**
+   * @brief addNeighborList Adds the pairs of a NeighborList to the graph. Must be called before build()
+   * @param neighborList NeighborList with one list per Feature
+   * @return Index used to look up the edge of a list entry with getEdgeIndex()
+   */
+  size_t addNeighborList(NeighborList<int32_t>& neighborList)
+  {
+    size_t numLists = std::min(m_NumFeatures, neighborList.getNumberOfTuples());
+    EntryTable table;
+    table.offsets.assign(m_NumFeatures + 1, 0);
+    for(size_t i = 0; i < numLists; i++)
+    {
+      table.offsets[i + 1] = table.offsets[i] + neighborList[i].size();
+    }
+    for(size_t i = numLists; i < m_NumFeatures; i++)
+    {
+      table.offsets[i + 1] = table.offsets[i];
+    }
+
+    // Keep the packed pair for now; build() replaces it with the edge index
+    table.edges.resize(table.offsets[m_NumFeatures]);
+    for(size_t i = 0; i < numLists; i++)
+    {
+      NeighborList<int32_t>::VectorType& list = neighborList[i];
+      size_t offset = table.offsets[i];
+      for(size_t j = 0; j < list.size(); j++)
+      {
+        table.edges[offset + j] = PackPair(static_cast<int64_t>(i), static_cast<int64_t>(list[j]));
+      }
+    }
+    m_EntryTables.push_back(std::move(table));
+    return m_EntryTables.size() - 1;
+  }
+
+  /**
+   * @brief build Sorts the unique Feature pairs into the CSR table
+   * @param mapListEntries Also map every NeighborList entry to its edge for getEdgeIndex(). Otherwise the
+   * entries are released once the table is built.
+   */
+  void build(bool mapListEntries = false)
+  {
+    std::vector<uint64_t> keys;
+    size_t numEntries = 0;
+    for(const EntryTable& table : m_EntryTables)
+    {
+      numEntries += table.edges.size();
+    }
+    keys.reserve(numEntries);
+    for(const EntryTable& table : m_EntryTables)
+    {
+      for(const uint64_t& key : table.edges)
+      {
+        if(key != k_InvalidKey)
+        {
+          keys.push_back(key);
+        }
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_sort(keys.begin(), keys.end());
+#else
+    std::sort(keys.begin(), keys.end());
+#endif
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    size_t numEdges = keys.size();
+    m_RowOffsets.assign(m_NumFeatures + 1, 0);
+    m_Rows.resize(numEdges);
+    m_Columns.resize(numEdges);
+    for(size_t e = 0; e < numEdges; e++)
+    {
+      m_Rows[e] = static_cast<int32_t>(keys[e] >> 32);
+      m_Columns[e] = static_cast<int32_t>(keys[e] & 0xFFFFFFFFULL);
+      m_RowOffsets[m_Rows[e] + 1]++;
+    }
+    for(size_t i = 0; i < m_NumFeatures; i++)
+    {
+      m_RowOffsets[i + 1] += m_RowOffsets[i];
+    }
+
+    if(!mapListEntries)
+    {
+      std::vector<EntryTable>().swap(m_EntryTables);
+      return;
+    }
+    for(EntryTable& table : m_EntryTables)
+    {
+      MapEntriesImpl impl(keys, table.edges);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, table.edges.size()), impl, tbb::auto_partitioner());
+#else
+      impl.map(0, table.edges.size());
+#endif
+    }
+  }
+
+  /**
+   * @brief getNumberOfFeatures
+   * @return Number of Features (rows) in the graph
+   */
+  size_t getNumberOfFeatures() const
+  {
+    return m_NumFeatures;
+  }
+
+  /**
+   * @brief getNumberOfEdges
+   * @return Number of unique Feature pairs
+   */
+  size_t getNumberOfEdges() const
+  {
+    return m_Columns.size();
+  }
+
+  /**
+   * @brief getRowOffsets Edges [offsets[i], offsets[i + 1]) are the edges whose smaller Feature is i
+   */
+  const std::vector<size_t>& getRowOffsets() const
+  {
+    return m_RowOffsets;
+  }
+
+  /**
+   * @brief getEdgeRow Returns the smaller Feature Id of an edge
+   */
+  int32_t getEdgeRow(size_t edge) const
+  {
+    return m_Rows[edge];
+  }
+
+  /**
+   * @brief getEdgeColumn Returns the larger Feature Id of an edge
+   */
+  int32_t getEdgeColumn(size_t edge) const
+  {
+    return m_Columns[edge];
+  }
+
+  /**
+   * @brief getEdgeIndex Returns the edge referred to by a NeighborList entry. Requires build(true)
+   * @param listIndex Value returned by addNeighborList()
+   * @param feature Feature that owns the list
+   * @param entry Index into the Feature's list
+   * @return Edge index or k_InvalidEdge for self references and out of range Feature Ids
+   */
+  size_t getEdgeIndex(size_t listIndex, size_t feature, size_t entry) const
+  {
+    const EntryTable& table = m_EntryTables[listIndex];
+    return static_cast<size_t>(table.edges[table.offsets[feature] + entry]);
+  }
+
+  /**
+   * @brief findEdge Looks up the edge between two Features
+   * @return Edge index or k_InvalidEdge if the Features are not neighbors
+   */
+  size_t findEdge(int32_t feature1, int32_t feature2) const
+  {
+    if(feature1 > feature2)
+    {
+      std::swap(feature1, feature2);
+    }
+    if(feature1 < 0 || feature1 == feature2 || static_cast<size_t>(feature2) >= m_NumFeatures)
+    {
+      return k_InvalidEdge;
+    }
+    std::vector<int32_t>::const_iterator begin = m_Columns.begin() + m_RowOffsets[feature1];
+    std::vector<int32_t>::const_iterator end = m_Columns.begin() + m_RowOffsets[feature1 + 1];
+    std::vector<int32_t>::const_iterator iter = std::lower_bound(begin, end, feature2);
+    if(iter == end || *iter != feature2)
+    {
+      return k_InvalidEdge;
+    }
+    return static_cast<size_t>(iter - m_Columns.begin());
+  }
+
+  /**
+   * @brief evaluateEdges Computes one value per edge. The function is called as
+   * function(smallerFeature, largerFeature) from several threads at once, so it must not
+   * modify shared state. Use uint8_t rather than bool for flags.
+   * @param values Output, resized to getNumberOfEdges()
+   * @param function Per edge function
+   */
+  template <typename T, typename Function>
+  void evaluateEdges(std::vector<T>& values, Function function) const
+  {
+    values.resize(getNumberOfEdges());
+    EvaluateEdgesImpl<T, Function> impl(m_Rows, m_Columns, values, function);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, values.size()), impl, tbb::auto_partitioner());
+#else
+    impl.evaluate(0, values.size());
+#endif
+  }
+
+  /**
+   * @brief findGroups Finds the connected components formed by the accepted edges with union-find
+   * @param accepted One flag per edge
+   * @return The smallest Feature Id of the group each Feature belongs to
+   */
+  std::vector<int32_t> findGroups(const std::vector<uint8_t>& accepted) const
+  {
+    std::vector<int32_t> roots(m_NumFeatures);
+    std::iota(roots.begin(), roots.end(), 0);
+    for(size_t e = 0; e < accepted.size(); e++)
+    {
+      if(accepted[e] == 0)
+      {
+        continue;
+      }
+      int32_t root1 = FindRoot(roots, m_Rows[e]);
+      int32_t root2 = FindRoot(roots, m_Columns[e]);
+      // Always link to the smaller Id so every root is the minimum of its group
+      if(root1 < root2)
+      {
+        roots[root2] = root1;
+      }
+      else if(root2 < root1)
+      {
+        roots[root1] = root2;
+      }
+    }
+    // Parents always have smaller Ids, so one ascending pass flattens every path
+    for(size_t i = 0; i < m_NumFeatures; i++)
+    {
+      roots[i] = roots[roots[i]];
+    }
+    return roots;
+  }
+
+protected:
+  static const uint64_t k_InvalidKey = std::numeric_limits<uint64_t>::max();
+
+  /**
+   * @brief PackPair Packs an unordered Feature pair into one sortable key, smaller Id first
+   */
+  uint64_t PackPair(int64_t feature1, int64_t feature2) const
+  {
+    if(feature1 > feature2)
+    {
+      std::swap(feature1, feature2);
+    }
+    if(feature1 < 0 || feature1 == feature2 || static_cast<size_t>(feature2) >= m_NumFeatures)
+    {
+      return k_InvalidKey;
+    }
+    return (static_cast<uint64_t>(feature1) << 32) | static_cast<uint64_t>(feature2);
+  }
+
+  static int32_t FindRoot(std::vector<int32_t>& roots, int32_t feature)
+  {
+    while(roots[feature] != feature)
+    {
+      roots[feature] = roots[roots[feature]];
+      feature = roots[feature];
+    }
+    return feature;
+  }
+
+  /**
+   * @brief The EntryTable struct holds the edge index of every entry of one NeighborList
+   */
+  struct EntryTable
+  {
+    std::vector<size_t> offsets;
+    std::vector<uint64_t> edges;
+  };
+
+  /**
+   * @brief The MapEntriesImpl class replaces packed pairs with their index in the sorted edge list
+   */
+  class MapEntriesImpl
+  {
+    const std::vector<uint64_t>& m_Keys;
+    std::vector<uint64_t>& m_Entries;
+
+  public:
+    MapEntriesImpl(const std::vector<uint64_t>& keys, std::vector<uint64_t>& entries)
+    : m_Keys(keys)
+    , m_Entries(entries)
+    {
+    }
+
+    void map(size_t start, size_t end) const
+    {
+      for(size_t i = start; i < end; i++)
+      {
+        if(m_Entries[i] == k_InvalidKey)
+        {
+          m_Entries[i] = static_cast<uint64_t>(k_InvalidEdge);
+          continue;
+        }
+        std::vector<uint64_t>::const_iterator iter = std::lower_bound(m_Keys.begin(), m_Keys.end(), m_Entries[i]);
+        m_Entries[i] = static_cast<uint64_t>(iter - m_Keys.begin());
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      map(r.begin(), r.end());
+    }
+#endif
+  };
+
+  /**
+   * @brief The EvaluateEdgesImpl class calls the per edge function over a range of edges
+   */
+  template <typename T, typename Function>
+  class EvaluateEdgesImpl
+  {
+    const std::vector<int32_t>& m_Rows;
+    const std::vector<int32_t>& m_Columns;
+    std::vector<T>& m_Values;
+    Function m_Function;
+
+  public:
+    EvaluateEdgesImpl(const std::vector<int32_t>& rows, const std::vector<int32_t>& columns, std::vector<T>& values, Function function)
+    : m_Rows(rows)
+    , m_Columns(columns)
+    , m_Values(values)
+    , m_Function(function)
+    {
+    }
+
+    void evaluate(size_t start, size_t end) const
+    {
+      for(size_t e = start; e < end; e++)
+      {
+        m_Values[e] = m_Function(m_Rows[e], m_Columns[e]);
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      evaluate(r.begin(), r.end());
+    }
+#endif
+  };
+
+private:
+  size_t m_NumFeatures = 0;
+  std::vector<size_t> m_RowOffsets;
+  std::vector<int32_t> m_Rows;
+  std::vector<int32_t> m_Columns;
+  std::vector<EntryTable> m_EntryTables;
+
+public:
+  FeatureGraph(const FeatureGraph&) = delete;            // Copy Constructor Not Implemented
+  FeatureGraph(FeatureGraph&&) = delete;                 // Move Constructor Not Implemented
+  FeatureGraph& operator=(const FeatureGraph&) = delete; // Copy Assignment Not Implemented
+  FeatureGraph& operator=(FeatureGraph&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,241 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+
+#include "UnitTestSupport.hpp"
+
+#include "ReconstructionTestFileLocations.h"
+
+#include "Reconstruction/ReconstructionFilters/util/FeatureGraph.h"
+
+class FeatureGraphTest
+{
+public:
+  FeatureGraphTest() = default;
+  virtual ~FeatureGraphTest() = default;
+
+  /**
+   * @brief Returns the name of the class for FeatureGraphTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("FeatureGraphTest");
+  }
+
+  // -----------------------------------------------------------------------------
+  // Grows each group from its smallest unvisited Feature over the accepted neighbor
+  // pairs, the way GroupFeatures does without the graph, and labels every Feature
+  // with the smallest Feature Id of its group.
+  // -----------------------------------------------------------------------------
+  std::vector<int32_t> ReferenceGroups(std::vector<NeighborList<int32_t>*> neighborLists, const std::vector<int32_t>& values)
+  {
+    size_t numFeatures = values.size();
+    std::vector<int32_t> groups(numFeatures, -1);
+    for(size_t seed = 0; seed < numFeatures; seed++)
+    {
+      if(groups[seed] != -1)
+      {
+        continue;
+      }
+      std::vector<int32_t> grouplist(1, static_cast<int32_t>(seed));
+      groups[seed] = static_cast<int32_t>(seed);
+      for(size_t j = 0; j < grouplist.size(); j++)
+      {
+        int32_t feature = grouplist[j];
+        for(NeighborList<int32_t>* neighborList : neighborLists)
+        {
+          NeighborList<int32_t>::VectorType& list = (*neighborList)[feature];
+          for(int32_t neighbor : list)
+          {
+            if(groups[neighbor] == -1 && Accept(values, feature, neighbor))
+            {
+              groups[neighbor] = static_cast<int32_t>(seed);
+              grouplist.push_back(neighbor);
+            }
+          }
+        }
+      }
+    }
+    return groups;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  static bool Accept(const std::vector<int32_t>& values, int32_t feature1, int32_t feature2)
+  {
+    return values[feature1] == values[feature2];
+  }
+
+  // -----------------------------------------------------------------------------
+  // Adds a symmetric pair to a NeighborList
+  // -----------------------------------------------------------------------------
+  void AddPair(NeighborList<int32_t>& neighborList, int32_t feature1, int32_t feature2)
+  {
+    neighborList.addEntry(feature1, feature2);
+    neighborList.addEntry(feature2, feature1);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestEdgeTable()
+  {
+    NeighborList<int32_t>::Pointer neighborList = NeighborList<int32_t>::CreateArray(6, "NeighborList", true);
+    AddPair(*neighborList, 1, 2);
+    AddPair(*neighborList, 1, 3);
+    AddPair(*neighborList, 2, 3);
+    AddPair(*neighborList, 4, 5);
+    AddPair(*neighborList, 1, 2); // Repeated pair
+    neighborList->addEntry(3, 3); // Self reference
+    neighborList->addEntry(5, 9); // Out of range
+
+    FeatureGraph graph(6);
+    size_t listIndex = graph.addNeighborList(*neighborList);
+    graph.build(true);
+
+    DREAM3D_REQUIRE_EQUAL(graph.getNumberOfEdges(), 4)
+    DREAM3D_REQUIRE_EQUAL(graph.findEdge(5, 9), FeatureGraph::k_InvalidEdge)
+    DREAM3D_REQUIRE_EQUAL(graph.findEdge(1, 4), FeatureGraph::k_InvalidEdge)
+    DREAM3D_REQUIRE_EQUAL(graph.findEdge(3, 3), FeatureGraph::k_InvalidEdge)
+
+    const std::vector<size_t>& offsets = graph.getRowOffsets();
+    for(size_t i = 0; i < 6; i++)
+    {
+      for(size_t e = offsets[i]; e < offsets[i + 1]; e++)
+      {
+        DREAM3D_REQUIRE_EQUAL(graph.getEdgeRow(e), static_cast<int32_t>(i))
+        DREAM3D_REQUIRED(graph.getEdgeRow(e), <, graph.getEdgeColumn(e))
+      }
+    }
+
+    // Both sides of every boundary map to the same edge
+    for(size_t i = 0; i < 6; i++)
+    {
+      NeighborList<int32_t>::VectorType& list = (*neighborList)[i];
+      for(size_t j = 0; j < list.size(); j++)
+      {
+        size_t edge = graph.getEdgeIndex(listIndex, i, j);
+        DREAM3D_REQUIRE_EQUAL(edge, graph.findEdge(static_cast<int32_t>(i), list[j]))
+        if(list[j] == static_cast<int32_t>(i) || list[j] >= 6)
+        {
+          DREAM3D_REQUIRE_EQUAL(edge, FeatureGraph::k_InvalidEdge)
+        }
+        else
+        {
+          DREAM3D_REQUIRE_EQUAL(edge, graph.findEdge(list[j], static_cast<int32_t>(i)))
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFindGroups()
+  {
+    const int32_t numFeatures = 500;
+    std::mt19937_64 generator(12345);
+    std::uniform_int_distribution<int32_t> featureDistribution(1, numFeatures - 1);
+    std::uniform_int_distribution<int32_t> valueDistribution(0, 2);
+
+    std::vector<int32_t> values(numFeatures, 0);
+    for(int32_t& value : values)
+    {
+      value = valueDistribution(generator);
+    }
+
+    NeighborList<int32_t>::Pointer contiguous = NeighborList<int32_t>::CreateArray(numFeatures, "Contiguous", true);
+    NeighborList<int32_t>::Pointer nonContiguous = NeighborList<int32_t>::CreateArray(numFeatures, "NonContiguous", true);
+    for(int32_t i = 0; i < numFeatures; i++)
+    {
+      AddPair(*contiguous, featureDistribution(generator), featureDistribution(generator));
+      AddPair(*nonContiguous, featureDistribution(generator), featureDistribution(generator));
+    }
+
+    std::vector<NeighborList<int32_t>*> lists = {contiguous.get()};
+    for(size_t pass = 0; pass < 2; pass++)
+    {
+      FeatureGraph graph(numFeatures);
+      std::vector<size_t> listIndices;
+      for(NeighborList<int32_t>* list : lists)
+      {
+        listIndices.push_back(graph.addNeighborList(*list));
+      }
+      graph.build();
+
+      std::vector<uint8_t> accepted;
+      graph.evaluateEdges(accepted, [&values](int32_t feature1, int32_t feature2) -> uint8_t { return Accept(values, feature1, feature2) ? 1 : 0; });
+      DREAM3D_REQUIRE_EQUAL(accepted.size(), graph.getNumberOfEdges())
+
+      std::vector<int32_t> groups = graph.findGroups(accepted);
+      std::vector<int32_t> reference = ReferenceGroups(lists, values);
+      for(int32_t i = 0; i < numFeatures; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(groups[i], reference[i])
+      }
+
+      lists.push_back(nonContiguous.get());
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start " << getNameOfClass().toStdString() << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestEdgeTable())
+    DREAM3D_REGISTER_TEST(TestFindGroups())
+  }
+
+private:
+  FeatureGraphTest(const FeatureGraphTest&); // Copy Constructor Not Implemented
+  void operator=(const FeatureGraphTest&);   // Move assignment Not Implemented
+};
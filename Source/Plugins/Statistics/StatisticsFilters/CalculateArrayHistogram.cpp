@@ -37,6 +37,10 @@
 
 #include "CalculateArrayHistogram.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -55,6 +59,7 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 
 #include "Statistics/StatisticsConstants.h"
+#include "Statistics/StatisticsFilters/util/ParallelHistogram.h"
 #include "Statistics/StatisticsVersion.h"
 
 enum createdPathID : RenameDataPath::DataID_t
@@ -249,9 +254,11 @@ void findHistogram(IDataArray::Pointer inDataPtr, int32_t numberOfBins, bool use
 
   T* inputArrayPtr = inputDataPtr->getPointer(0);
   size_t numPoints = inputDataPtr->getNumberOfTuples();
-  int32_t bin = 0;
   float min = std::numeric_limits<float>::max();
   float max = -1.0 * std::numeric_limits<float>::max();
+  // Bounds on the values; for 8 and 16 bit integers the whole range of the type is small enough to count per value
+  T minValue = std::numeric_limits<T>::lowest();
+  T maxValue = std::numeric_limits<T>::max();
   if(userRange)
   {
     min = static_cast<float>(minRange);
@@ -259,16 +266,12 @@ void findHistogram(IDataArray::Pointer inDataPtr, int32_t numberOfBins, bool use
   }
   else
   {
-    for(size_t i = 0; i < numPoints; i++) // min and max in the input array
+    // The conversion to float is monotonic, so the range of the converted values is the converted range of the values
+    ParallelHistogram<T>::FindRange(inputArrayPtr, 0, numPoints, minValue, maxValue);
+    if(!(maxValue < minValue))
     {
-      if(static_cast<float>(inputArrayPtr[i]) > max)
-      {
-        max = static_cast<float>(inputArrayPtr[i]);
-      }
-      if(static_cast<float>(inputArrayPtr[i]) < min)
-      {
-        min = static_cast<float>(inputArrayPtr[i]);
-      }
+      min = std::min(min, static_cast<float>(minValue));
+      max = std::max(max, static_cast<float>(maxValue));
     }
   }
 
@@ -280,17 +283,19 @@ void findHistogram(IDataArray::Pointer inDataPtr, int32_t numberOfBins, bool use
   }
   else
   {
-    for(size_t i = 0; i < numPoints; i++) // sort into bins to create the histogram
-    {
-      bin = size_t((inputArrayPtr[i] - min) / increment); // find bin for this input array value
-      if((bin >= 0) && (bin < numberOfBins))              // make certain bin is in range
-      {
-        newDataArrayPtr[bin * 2 + 1]++; // increment histogram element corresponding to this input array value
-      }
-      else
+    auto binOf = [min, increment, numberOfBins](T value) -> int64_t {
+      int32_t bin = size_t((value - min) / increment); // find bin for this input array value
+      if((bin >= 0) && (bin < numberOfBins))           // make certain bin is in range
       {
-        overflow++;
+        return bin;
       }
+      return -1;
+    };
+    std::vector<uint64_t> counts;
+    overflow = static_cast<int>(ParallelHistogram<T>::CountValues(inputArrayPtr, 0, numPoints, minValue, maxValue, numberOfBins, binOf, counts));
+    for(int32_t i = 0; i < numberOfBins; i++)
+    {
+      newDataArrayPtr[i * 2 + 1] = static_cast<double>(counts[i]);
     }
   }
 
@@ -6,6 +6,8 @@
 
 #include "ComputeMomentInvariants2D.h"
 
+#include <vector>
+
 #include <Eigen/Dense>
 
 #include <QtCore/QTextStream>
@@ -25,6 +27,12 @@
 #include "Statistics/StatisticsFilters/util/MomentInvariants2D.h"
 #include "Statistics/StatisticsVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -34,6 +42,131 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID33 = 33,
 };
 
+/**
+ * @brief The ComputeMomentInvariants2DImpl class computes the 2D moment invariants of a range of Features. The raw
+ * moments of each Feature are summed straight from the Feature Ids inside its rectangle, so no square copy of the
+ * rectangle is made. Features that are not strictly 2D in the XY plane are marked in the skipped array.
+ */
+class ComputeMomentInvariants2DImpl
+{
+public:
+  ComputeMomentInvariants2DImpl(const int32_t* featureIds, const uint32_t* featureRect, const SizeVec3Type& volDims, bool normalize, float* omega1, float* omega2, float* centralMoments,
+                                uint8_t* skipped)
+  : m_FeatureIds(featureIds)
+  , m_FeatureRect(featureRect)
+  , m_VolDims(volDims)
+  , m_Normalize(normalize)
+  , m_Omega1(omega1)
+  , m_Omega2(omega2)
+  , m_CentralMoments(centralMoments)
+  , m_Skipped(skipped)
+  {
+  }
+  virtual ~ComputeMomentInvariants2DImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    const size_t max_order = 2;
+    MomentInvariants2D moments;
+    MomentInvariants2D::DoubleMatrixType mnk(max_order + 1, max_order + 1);
+
+    for(size_t featureId = start; featureId < end; featureId++)
+    {
+      const uint32_t* corner = m_FeatureRect + featureId * 6;
+
+      // Figure the largest X || Y dimension so we can create a square matrix
+      uint32_t xDim = corner[3] - corner[0] + 1;
+      uint32_t yDim = corner[4] - corner[1] + 1;
+      uint32_t zDim = corner[5] - corner[2] + 1;
+
+      if(zDim != 1)
+      {
+        m_Omega1[featureId] = 0.0f;
+        m_Omega2[featureId] = 0.0f;
+        m_Skipped[featureId] = 1;
+        continue;
+      }
+
+      size_t dim = xDim; // Assume XDim is the largest value
+      if(yDim > xDim)
+      {
+        dim = yDim; // Nope, YDim is largest
+      }
+
+      // mnk = bigX^T * input * bigX, where input is 1 on the Feature's cells. Each row of the rectangle sums the
+      // x terms of its Feature cells first, then adds them into mnk with the row's y terms.
+      MomentInvariants2D::DoubleMatrixType bigX = moments.getBigX(max_order, dim);
+      mnk.setZero();
+      int32_t id = static_cast<int32_t>(featureId);
+      size_t planeOffset = m_VolDims[1] * m_VolDims[0] * corner[2];
+      for(uint32_t y = corner[1]; y <= corner[4]; y++)
+      {
+        double rowSums[max_order + 1] = {0.0, 0.0, 0.0};
+        const int32_t* row = m_FeatureIds + planeOffset + m_VolDims[0] * y;
+        for(uint32_t x = corner[0]; x <= corner[3]; x++)
+        {
+          if(row[x] == id)
+          {
+            for(size_t l = 0; l <= max_order; l++)
+            {
+              rowSums[l] += bigX(x - corner[0], l);
+            }
+          }
+        }
+        for(size_t k = 0; k <= max_order; k++)
+        {
+          double yTerm = bigX(y - corner[1], k);
+          for(size_t l = 0; l <= max_order; l++)
+          {
+            mnk(k, l) += yTerm * rowSums[l];
+          }
+        }
+      }
+
+      MomentInvariants2D::DoubleMatrixType m2D = moments.computeCentralMoments(mnk, dim, max_order);
+      // compute the second order moment invariants
+      double omega1 = 2.0 * (m2D(0, 0) * m2D(0, 0)) / (m2D(0, 2) + m2D(2, 0));
+      double omega2 = std::pow(m2D(0, 0), 4) / (m2D(2, 0) * m2D(0, 2) - std::pow(m2D(1, 1), 2));
+
+      if(m_Normalize)
+      {
+        // normalize the invariants by those of the circle
+        double circle_omega[2] = {4.0 * M_PI, 16.0 * M_PI * M_PI};
+        omega1 /= circle_omega[0];
+        omega2 /= circle_omega[1];
+      }
+      m_Omega1[featureId] = static_cast<float>(omega1);
+      m_Omega2[featureId] = static_cast<float>(omega2);
+
+      if(nullptr != m_CentralMoments)
+      {
+        double* m2DInternal = m2D.array().data();
+        for(size_t comp = 0; comp < 9; comp++)
+        {
+          m_CentralMoments[featureId * 9UL + comp] = static_cast<float>(m2DInternal[comp]);
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int32_t* m_FeatureIds;
+  const uint32_t* m_FeatureRect;
+  SizeVec3Type m_VolDims;
+  bool m_Normalize;
+  float* m_Omega1;
+  float* m_Omega2;
+  float* m_CentralMoments;
+  uint8_t* m_Skipped;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -186,107 +319,36 @@ void ComputeMomentInvariants2D::execute()
   ImageGeom::Pointer imageGeom = std::dynamic_pointer_cast<ImageGeom>(igeom);
   SizeVec3Type volDims = imageGeom->getDimensions();
 
-  Int32ArrayType::Pointer featureIdArray = m_FeatureIdsPtr.lock();
-  int32_t numFeatures = static_cast<int32_t>(m_FeatureRectPtr.lock()->getNumberOfTuples());
-
-//  static const double k_Pi14 = std::pow(SIMPLib::Constants::k_Pi, 0.25);
-//  static const double k_Root2 = std::sqrt(2.0);
+  size_t numFeatures = m_FeatureRectPtr.lock()->getNumberOfTuples();
+  if(numFeatures < 2)
+  {
+    return;
+  }
 
-  // This loop SHOULD be parallelized
+  float* centralMoments = getSaveCentralMoments() ? m_CentralMoments : nullptr;
+  std::vector<uint8_t> skipped(numFeatures, 0);
 
-  for(int32_t featureId = 1; featureId < numFeatures; featureId++)
+  ComputeMomentInvariants2DImpl impl(m_FeatureIds, m_FeatureRect, volDims, getNormalizeMomentInvariants(), m_Omega1, m_Omega2, centralMoments, skipped.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
   {
-    uint32_t* corner = m_FeatureRectPtr.lock()->getTuplePointer(featureId);
-    MomentInvariants2D moments;
-    size_t max_order = 2;
-    //size_t mDim = max_order + 1;
-
-    // Figure the largest X || Y dimension so we can create a square matrix
-    uint32_t xDim = corner[3] - corner[0] + 1;
-    uint32_t yDim = corner[4] - corner[1] + 1;
-    uint32_t zDim = corner[5] - corner[2] + 1;
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, numFeatures), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(1, numFeatures);
+  }
 
-    if(zDim != 1)
+  for(size_t featureId = 1; featureId < numFeatures; featureId++)
+  {
+    if(skipped[featureId] != 0)
     {
-      m_Omega1[featureId] = 0.0f;
-      m_Omega2[featureId] = 0.0f;
       QString ss = QObject::tr("Feature %1 is NOT strictly 2D in the XY plane. Skipping this feature.").arg(featureId);
       setWarningCondition(-3000, ss);
-      continue;
-    }
-
-    size_t dim = xDim; // Assume XDim is the largest value
-    if(yDim > xDim)
-    {
-      dim = yDim; // Nope, YDim is largest
-    }
-
-    MomentInvariants2D::DoubleMatrixType input2D(dim, dim);
-    input2D.setZero();
-
-    uint32_t height = 0;
-
-    for(uint32_t y = corner[1]; y <= corner[4]; y++)
-    {
-      for(uint32_t x = corner[0]; x <= corner[3]; x++)
-      {
-        size_t index =  (volDims[1] * volDims[0] * height) + (volDims[0] * y) + x;
-        if( *(m_FeatureIds + index) == featureId)
-        {
-          input2D(y - corner[1], x - corner[0]) = 1;
-        }
-        else
-        {
-          input2D(y - corner[1], x - corner[0]) = 0;
-        }
-      }
     }
-
-    size_t inputDims[2] = { dim, dim };
-    MomentInvariants2D::DoubleMatrixType m2D = moments.computeMomentInvariants(input2D, inputDims, max_order);
-    //std::cout << "Central Moments=\n" << m2D << std::endl;
-    // compute the second order moment invariants
-    double omega1 = 2.0 * (m2D(0,0)* m2D(0,0)) / (m2D(0,2) + m2D(2,0));
-    double omega2 = std::pow(m2D(0,0), 4) / ( m2D(2,0)*m2D(0,2) - std::pow(m2D(1,1), 2) );
-    //std::cout << ",'2D moment invariants : " << omega1 << "\t" << omega2 << " (should be 12 and 144)" << std::endl;
-
-    if(getNormalizeMomentInvariants())
-    {
-      // normalize the invariants by those of the circle
-      double circle_omega[2] = { 4.0*M_PI, 16.0 * M_PI*M_PI };
-      omega1 /= circle_omega[0];
-      omega2 /= circle_omega[1];
-      //    std::cout << "normalized moment invariants: " << omega1 << "\t" << omega2 << std::endl;
-    }
-    m_Omega1[featureId] = static_cast<float>(omega1);
-    m_Omega2[featureId] = static_cast<float>(omega2);
-
-    if(getSaveCentralMoments())
-    {
-      double* m2DInternal = m2D.array().data();
-      for(size_t comp = 0; comp < 9; comp++)
-      {
-        m_CentralMoments[static_cast<size_t>(featureId) * 9UL + comp] = static_cast<float>(m2DInternal[comp]);
-      }
-    }
-
-#if 0
-/** This section computes the Ellipse Major and Minor Axis lengths. As a double check if the
- * aspect ratio is > 1.0 then the shape is NOT an ellipse.
- */
-    double ellipseAspctRatio = std::sqrt((m2D(0,2)/m2D(2,0)));
-    double ellipseMajorAxis = (k_Root2 * std::pow(m2D(2,0), 3.0/8.0) ) / (std::pow(m2D(0,2), (1.0/8.0)) * k_Pi14);
-    double ellipseMinorAxis = ellipseMajorAxis / ellipseAspctRatio;
-    if(ellipseMinorAxis > ellipseMajorAxis)
-    {
-        std::cout << featureId << " " << omega1 << ", " << omega2 << "    " << ellipseMajorAxis << "," << ellipseMinorAxis << std::endl;
-    }
-#endif
-
-    QString ss = QObject::tr("[%1/%2] Completed:").arg(featureId).arg(numFeatures);
-    notifyStatusMessage(ss);
   }
-
 }
 
 // -----------------------------------------------------------------------------
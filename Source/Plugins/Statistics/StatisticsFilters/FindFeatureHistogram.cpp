@@ -37,6 +37,10 @@
 
 #include "FindFeatureHistogram.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -53,6 +57,7 @@
 #include "Statistics/DistributionAnalysisOps/BetaOps.h"
 #include "Statistics/DistributionAnalysisOps/LogNormalOps.h"
 #include "Statistics/DistributionAnalysisOps/PowerLawOps.h"
+#include "Statistics/StatisticsFilters/util/ParallelHistogram.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -180,7 +185,7 @@ void FindFeatureHistogram::dataCheck()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-template <typename T> void findHistogram(IDataArray::Pointer inputData, int32_t* ensembleArray, int32_t* eIds, int NumberOfBins, bool removeBiasedFeatures, bool* biasedFeatures)
+template <typename T> void findHistogram(IDataArray::Pointer inputData, int32_t* ensembleArray, size_t ensembleArraySize, int32_t* eIds, int NumberOfBins, bool removeBiasedFeatures, bool* biasedFeatures)
 {
   typename DataArray<T>::Pointer featureArray = std::dynamic_pointer_cast<DataArray<T>>(inputData);
   if(nullptr == featureArray)
@@ -190,38 +195,42 @@ template <typename T> void findHistogram(IDataArray::Pointer inputData, int32_t*
 
   T* fPtr = featureArray->getPointer(0);
   size_t numfeatures = featureArray->getNumberOfTuples();
+  if(numfeatures < 2)
+  {
+    return;
+  }
 
-  int32_t bin;
-  int32_t ensemble;
+  // The conversion to float is monotonic, so the range of the converted values is the converted range of the values
   float min = 1000000.0f;
   float max = 0.0f;
-  float value;
-  for(size_t i = 1; i < numfeatures; i++)
+  T minValue = std::numeric_limits<T>::max();
+  T maxValue = std::numeric_limits<T>::lowest();
+  ParallelHistogram<T>::FindRange(fPtr, 1, numfeatures, minValue, maxValue);
+  if(!(maxValue < minValue))
   {
-    value = fPtr[i];
-    if(value > max)
-    {
-      max = value;
-    }
-    if(value < min)
-    {
-      min = value;
-    }
+    min = std::min(min, static_cast<float>(minValue));
+    max = std::max(max, static_cast<float>(maxValue));
   }
   float stepsize = (max - min) / NumberOfBins;
 
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if(!removeBiasedFeatures || !biasedFeatures[i])
+  auto slotOf = [=](size_t i) -> int64_t {
+    if(removeBiasedFeatures && biasedFeatures[i])
+    {
+      return -1;
+    }
+    int32_t ensemble = eIds[i];
+    int32_t bin = (fPtr[i] - min) / stepsize;
+    if(bin >= NumberOfBins)
     {
-      ensemble = eIds[i];
-      bin = (fPtr[i] - min) / stepsize;
-      if(bin >= NumberOfBins)
-      {
-        bin = NumberOfBins - 1;
-      }
-      ensembleArray[(NumberOfBins * ensemble) + bin]++;
+      bin = NumberOfBins - 1;
     }
+    return static_cast<int64_t>(NumberOfBins) * ensemble + bin;
+  };
+  std::vector<uint64_t> counts;
+  ParallelHistogram<T>::CountSlots(1, numfeatures, ensembleArraySize, slotOf, counts);
+  for(size_t i = 0; i < ensembleArraySize; i++)
+  {
+    ensembleArray[i] += static_cast<int32_t>(counts[i]);
   }
 }
 
@@ -251,50 +260,51 @@ void FindFeatureHistogram::execute()
   }
 
   QString dType = inputData->getTypeAsString();
+  size_t ensembleArraySize = m_NewEnsembleArrayPtr.lock()->getSize();
   IDataArray::Pointer p = IDataArray::NullPointer();
   if(dType.compare("int8_t") == 0)
   {
-    findHistogram<int8_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<int8_t>(inputData, m_NewEnsembleArray, ensembleArraySize, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("uint8_t") == 0)
   {
-    findHistogram<uint8_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<uint8_t>(inputData, m_NewEnsembleArray, ensembleArraySize, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("int16_t") == 0)
   {
-    findHistogram<int16_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<int16_t>(inputData, m_NewEnsembleArray, ensembleArraySize, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("uint16_t") == 0)
   {
-    findHistogram<uint16_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<uint16_t>(inputData, m_NewEnsembleArray, ensembleArraySize, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("int32_t") == 0)
   {
-    findHistogram<int32_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<int32_t>(inputData, m_NewEnsembleArray, ensembleArraySize, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("uint32_t") == 0)
   {
-    findHistogram<uint32_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<uint32_t>(inputData, m_NewEnsembleArray, ensembleArraySize, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("int64_t") == 0)
   {
-    findHistogram<int64_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<int64_t>(inputData, m_NewEnsembleArray, ensembleArraySize, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("uint64_t") == 0)
   {
-    findHistogram<uint64_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<uint64_t>(inputData, m_NewEnsembleArray, ensembleArraySize, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("float") == 0)
   {
-    findHistogram<float>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<float>(inputData, m_NewEnsembleArray, ensembleArraySize, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("double") == 0)
   {
-    findHistogram<double>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<double>(inputData, m_NewEnsembleArray, ensembleArraySize, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("bool") == 0)
   {
-    findHistogram<bool>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<bool>(inputData, m_NewEnsembleArray, ensembleArraySize, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
 
 }
@@ -37,6 +37,10 @@
 
 #include "FindLargestCrossSections.h"
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -53,6 +57,91 @@
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+/**
+ * @brief The FindLargestCrossSectionsImpl class counts the cells of each Feature in every plane of a slab of planes
+ * and keeps the largest per plane count seen for each Feature in that slab. One dense counter is shared by all the
+ * planes (and slabs) a call visits; only the Features that are present in a plane are touched when that plane is
+ * finished, so the cost of a plane does not depend on the number of Features. Counts are 32 bit, which holds any
+ * plane of fewer than 2^32 cells.
+ */
+class FindLargestCrossSectionsImpl
+{
+public:
+  FindLargestCrossSectionsImpl(const int32_t* featureIds, size_t numFeatures, const std::vector<size_t>& slabBegins, size_t inPlane1, size_t inPlane2,
+                               size_t stride1, size_t stride2, size_t stride3, std::vector<std::vector<uint32_t>>& maxCounts)
+  : m_FeatureIds(featureIds)
+  , m_NumFeatures(numFeatures)
+  , m_SlabBegins(slabBegins)
+  , m_InPlane1(inPlane1)
+  , m_InPlane2(inPlane2)
+  , m_Stride1(stride1)
+  , m_Stride2(stride2)
+  , m_Stride3(stride3)
+  , m_MaxCounts(maxCounts)
+  {
+  }
+  virtual ~FindLargestCrossSectionsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    std::vector<uint32_t> counts(m_NumFeatures, 0);
+    std::vector<size_t> present;
+    for(size_t s = start; s < end; s++)
+    {
+      std::vector<uint32_t>& maxCounts = m_MaxCounts[s];
+      maxCounts.assign(m_NumFeatures, 0);
+      for(size_t i = m_SlabBegins[s]; i < m_SlabBegins[s + 1]; i++)
+      {
+        // The in plane direction with the unit stride is walked innermost
+        size_t istride = i * m_Stride1;
+        for(size_t k = 0; k < m_InPlane2; k++)
+        {
+          size_t kstride = istride + k * m_Stride3;
+          for(size_t j = 0; j < m_InPlane1; j++)
+          {
+            size_t gnum = static_cast<size_t>(m_FeatureIds[kstride + j * m_Stride2]);
+            if(counts[gnum] == 0)
+            {
+              present.push_back(gnum);
+            }
+            counts[gnum]++;
+          }
+        }
+        for(const size_t& gnum : present)
+        {
+          maxCounts[gnum] = std::max(maxCounts[gnum], counts[gnum]);
+          counts[gnum] = 0;
+        }
+        present.clear();
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int32_t* m_FeatureIds;
+  size_t m_NumFeatures;
+  const std::vector<size_t>& m_SlabBegins;
+  size_t m_InPlane1;
+  size_t m_InPlane2;
+  size_t m_Stride1;
+  size_t m_Stride2;
+  size_t m_Stride3;
+  std::vector<std::vector<uint32_t>>& m_MaxCounts;
+};
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -175,14 +264,9 @@ void FindLargestCrossSections::find_crosssections()
 
   size_t numfeatures = m_LargestCrossSectionsPtr.lock()->getNumberOfTuples();
 
-  DoubleArrayType::Pointer m_FeatureCounts = DoubleArrayType::CreateArray(numfeatures, "_INTERNAL_USE_ONLY_FeatureCounts", true);
-  double* featurecounts = m_FeatureCounts->getPointer(0);
-
   size_t outPlane = 0, inPlane1 = 0, inPlane2 = 0;
-  float res_scalar = 0.0f, area = 0.0f;
+  float res_scalar = 0.0f;
   size_t stride1 = 0, stride2 = 0, stride3 = 0;
-  size_t istride = 0, jstride = 0, kstride = 0;
-  size_t point = 0, gnum = 0;
 
   FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
 
@@ -217,31 +301,53 @@ void FindLargestCrossSections::find_crosssections()
     stride2 = inPlane1;
     stride3 = inPlane1 * inPlane2;
   }
-  for(size_t i = 0; i < outPlane; i++)
+
+  if(outPlane == 0 || numfeatures == 0)
+  {
+    return;
+  }
+
+  // Each slab of planes keeps the largest per plane cell count of every Feature; the slabs are reduced afterwards.
+  // Fewer slabs are used when the per slab counters would get large
+  const size_t maxCounterBytes = 256 * 1024 * 1024;
+  size_t numSlabs = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  numSlabs = std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+#endif
+  size_t counterBytes = 2 * numfeatures * sizeof(uint32_t);
+  numSlabs = std::max(std::min(numSlabs, maxCounterBytes / counterBytes), static_cast<size_t>(1));
+  numSlabs = std::min(numSlabs, outPlane);
+  std::vector<size_t> slabBegins(numSlabs + 1, 0);
+  for(size_t s = 0; s <= numSlabs; s++)
   {
-    for(size_t g = 0; g < numfeatures * 1; g++)
-    {
-      featurecounts[g] = 0.0f;
-    }
-    istride = i * stride1;
-    for(size_t j = 0; j < inPlane1; j++)
+    slabBegins[s] = outPlane * s / numSlabs;
+  }
+  std::vector<std::vector<uint32_t>> maxCounts(numSlabs);
+
+  FindLargestCrossSectionsImpl impl(m_FeatureIds, numfeatures, slabBegins, inPlane1, inPlane2, stride1, stride2, stride3, maxCounts);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), impl, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(0, numSlabs);
+  }
+
+  for(size_t g = 1; g < numfeatures; g++)
+  {
+    uint32_t count = 0;
+    for(size_t s = 0; s < numSlabs; s++)
     {
-      jstride = j * stride2;
-      for(size_t k = 0; k < inPlane2; k++)
-      {
-        kstride = k * stride3;
-        point = istride + jstride + kstride;
-        gnum = m_FeatureIds[point];
-        featurecounts[gnum]++;
-      }
+      count = std::max(count, maxCounts[s][g]);
     }
-    for(size_t g = 1; g < numfeatures; g++)
+    float area = static_cast<double>(count) * res_scalar;
+    if(area > m_LargestCrossSections[g])
     {
-      area = featurecounts[g] * res_scalar;
-      if(area > m_LargestCrossSections[g])
-      {
-        m_LargestCrossSections[g] = area;
-      }
+      m_LargestCrossSections[g] = area;
     }
   }
 }
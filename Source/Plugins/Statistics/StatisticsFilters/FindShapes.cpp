@@ -36,6 +36,9 @@
 
 #include "FindShapes.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -58,6 +61,465 @@
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+/**
+ * @brief The FindShapesMomentsImpl class sums the second order moments and the cell count of each Feature over
+ * whole slabs of rows. Each slab writes its own table of k_TableStride doubles per Feature.
+ */
+class FindShapesMomentsImpl
+{
+public:
+  static const size_t k_TableStride = 7;
+
+  FindShapesMomentsImpl(const int32_t* featureIds, const float* centroids, size_t numFeatures, size_t xPoints, size_t yPoints, const float modRes[3], const float origin[3], float scale,
+                        bool twoD, const std::vector<size_t>& slabRows, std::vector<std::vector<double>>& tables)
+  : m_FeatureIds(featureIds)
+  , m_Centroids(centroids)
+  , m_NumFeatures(numFeatures)
+  , m_XPoints(xPoints)
+  , m_YPoints(yPoints)
+  , m_ModRes{modRes[0], modRes[1], modRes[2]}
+  , m_Origin{origin[0], origin[1], origin[2]}
+  , m_Scale(scale)
+  , m_TwoD(twoD)
+  , m_SlabRows(slabRows)
+  , m_Tables(tables)
+  {
+  }
+  virtual ~FindShapesMomentsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t s = start; s < end; s++)
+    {
+      std::vector<double>& table = m_Tables[s];
+      table.assign(m_NumFeatures * k_TableStride, 0.0);
+      for(size_t row = m_SlabRows[s]; row < m_SlabRows[s + 1]; row++)
+      {
+        size_t j = row % m_YPoints;
+        size_t i = row / m_YPoints;
+        const int32_t* featureIds = m_FeatureIds + row * m_XPoints;
+        float y = float(j * m_ModRes[1]) + m_Origin[1];
+        float z = float(i * m_ModRes[2]) + m_Origin[2];
+        float y1 = y + (m_ModRes[1] / 4.0f);
+        float y2 = y - (m_ModRes[1] / 4.0f);
+        float z1 = z + (m_ModRes[2] / 4.0f);
+        float z2 = z - (m_ModRes[2] / 4.0f);
+        for(size_t k = 0; k < m_XPoints; k++)
+        {
+          int32_t gnum = featureIds[k];
+          float x = float(k * m_ModRes[0]) + m_Origin[0];
+          float x1 = x + (m_ModRes[0] / 4.0f);
+          float x2 = x - (m_ModRes[0] / 4.0f);
+          // Each cell is split into 2x2x2 (2x2 in 2D) sub cells; the sums run over the sub cells in the same order as
+          // the original expanded expressions
+          float cx = m_Centroids[gnum * 3 + 0] * m_Scale;
+          float cy = m_Centroids[gnum * 3 + 1] * m_Scale;
+          float cz = m_Centroids[gnum * 3 + 2] * m_Scale;
+          float xdist[2] = {x1 - cx, x2 - cx};
+          float ydist[2] = {y1 - cy, y2 - cy};
+          float zdist[2] = {z1 - cz, z2 - cz};
+          double* moments = table.data() + static_cast<size_t>(gnum) * k_TableStride;
+          if(m_TwoD)
+          {
+            float xx = 0.0f, yy = 0.0f, xy = 0.0f;
+            for(size_t a = 0; a < 2; a++)
+            {
+              for(size_t b = 0; b < 2; b++)
+              {
+                xx += ydist[b] * ydist[b];
+                yy += xdist[a] * xdist[a];
+                xy += xdist[a] * ydist[b];
+              }
+            }
+            moments[0] += xx;
+            moments[1] += yy;
+            moments[2] += xy;
+          }
+          else
+          {
+            float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, yz = 0.0f, xz = 0.0f;
+            for(size_t a = 0; a < 2; a++)
+            {
+              for(size_t b = 0; b < 2; b++)
+              {
+                for(size_t c = 0; c < 2; c++)
+                {
+                  xx += ydist[b] * ydist[b];
+                  xx += zdist[c] * zdist[c];
+                  yy += xdist[a] * xdist[a];
+                  yy += zdist[c] * zdist[c];
+                  zz += xdist[a] * xdist[a];
+                  zz += ydist[b] * ydist[b];
+                  xy += xdist[a] * ydist[b];
+                  yz += ydist[b] * zdist[c];
+                  xz += xdist[a] * zdist[c];
+                }
+              }
+            }
+            moments[0] += static_cast<double>(xx);
+            moments[1] += static_cast<double>(yy);
+            moments[2] += static_cast<double>(zz);
+            moments[3] += static_cast<double>(xy);
+            moments[4] += static_cast<double>(yz);
+            moments[5] += static_cast<double>(xz);
+          }
+          moments[6] += 1.0;
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int32_t* m_FeatureIds;
+  const float* m_Centroids;
+  size_t m_NumFeatures;
+  size_t m_XPoints;
+  size_t m_YPoints;
+  float m_ModRes[3];
+  float m_Origin[3];
+  float m_Scale;
+  bool m_TwoD;
+  const std::vector<size_t>& m_SlabRows;
+  std::vector<std::vector<double>>& m_Tables;
+};
+
+/**
+ * @brief The FindShapesMergeMomentsImpl class adds the slab tables of each Feature together in slab order
+ */
+class FindShapesMergeMomentsImpl
+{
+public:
+  FindShapesMergeMomentsImpl(const std::vector<std::vector<double>>& tables, double* featureMoments, float* volumes)
+  : m_Tables(tables)
+  , m_FeatureMoments(featureMoments)
+  , m_Volumes(volumes)
+  {
+  }
+  virtual ~FindShapesMergeMomentsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    const size_t stride = FindShapesMomentsImpl::k_TableStride;
+    for(size_t g = start; g < end; g++)
+    {
+      double count = 0.0;
+      for(size_t c = 0; c < 6; c++)
+      {
+        m_FeatureMoments[g * 6 + c] = 0.0;
+      }
+      for(const std::vector<double>& table : m_Tables)
+      {
+        for(size_t c = 0; c < 6; c++)
+        {
+          m_FeatureMoments[g * 6 + c] += table[g * stride + c];
+        }
+        count += table[g * stride + 6];
+      }
+      m_Volumes[g] = static_cast<float>(m_Volumes[g] + count);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<std::vector<double>>& m_Tables;
+  double* m_FeatureMoments;
+  float* m_Volumes;
+};
+
+/**
+ * @brief The FindShapesAxesImpl class solves the characteristic cubic of each Feature's moment matrix for its
+ * eigenvalues and derives the axis lengths and aspect ratios from them
+ */
+class FindShapesAxesImpl
+{
+public:
+  FindShapesAxesImpl(const double* featureMoments, double* featureEigenVals, float* axisLengths, float* aspectRatios, double scaleFactor)
+  : m_FeatureMoments(featureMoments)
+  , m_FeatureEigenVals(featureEigenVals)
+  , m_AxisLengths(axisLengths)
+  , m_AspectRatios(aspectRatios)
+  , m_ScaleFactor(scaleFactor)
+  {
+  }
+  virtual ~FindShapesAxesImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      double Ixx = m_FeatureMoments[i * 6 + 0];
+      double Iyy = m_FeatureMoments[i * 6 + 1];
+      double Izz = m_FeatureMoments[i * 6 + 2];
+
+      double Ixy = m_FeatureMoments[i * 6 + 3];
+      double Iyz = m_FeatureMoments[i * 6 + 4];
+      double Ixz = m_FeatureMoments[i * 6 + 5];
+
+      double a = 1.0;
+      double b = (-Ixx - Iyy - Izz);
+      double c = ((Ixx * Izz) + (Ixx * Iyy) + (Iyy * Izz) - (Ixz * Ixz) - (Ixy * Ixy) - (Iyz * Iyz));
+      double d = ((Ixz * Iyy * Ixz) + (Ixy * Izz * Ixy) + (Iyz * Ixx * Iyz) - (Ixx * Iyy * Izz) - (Ixy * Iyz * Ixz) - (Ixy * Iyz * Ixz));
+      // f and g are the p and q values when reducing the cubic equation to t^3 + pt + q = 0
+      double f = ((3.0 * c / a) - ((b / a) * (b / a))) / 3.0;
+      double g = ((2.0 * (b / a) * (b / a) * (b / a)) - (9.0 * b * c / (a * a)) + (27.0 * (d / a))) / 27.0;
+      double h = (g * g / 4.0) + (f * f * f / 27.0);
+      double rsquare = (g * g / 4.0) - h;
+      double r = sqrt(rsquare);
+      if(rsquare < 0.0)
+      {
+        r = 0.0;
+      }
+      double theta = 0;
+      if(r != 0)
+      {
+        double value = -g / (2.0 * r);
+        if(value > 1)
+        {
+          value = 1.0;
+        }
+        if(value < -1)
+        {
+          value = -1.0;
+        }
+        theta = acos(value);
+      }
+      double const1 = pow(r, 0.33333333333);
+      double const2 = cos(theta / 3.0);
+      double const3 = b / (3.0 * a);
+      double const4 = 1.7320508 * sin(theta / 3.0);
+
+      double r1 = 2 * const1 * const2 - (const3);
+      double r2 = -const1 * (const2 - (const4)) - const3;
+      double r3 = -const1 * (const2 + (const4)) - const3;
+      m_FeatureEigenVals[3 * i] = r1;
+      m_FeatureEigenVals[3 * i + 1] = r2;
+      m_FeatureEigenVals[3 * i + 2] = r3;
+
+      double I1 = (15.0 * r1) / (4.0 * M_PI);
+      double I2 = (15.0 * r2) / (4.0 * M_PI);
+      double I3 = (15.0 * r3) / (4.0 * M_PI);
+      double A = (I1 + I2 - I3) / 2.0;
+      double B = (I1 + I3 - I2) / 2.0;
+      double C = (I2 + I3 - I1) / 2.0;
+      a = (A * A * A * A) / (B * C);
+      a = pow(a, 0.1);
+      b = B / A;
+      b = sqrt(b) * a;
+      c = A / (a * a * a * b);
+
+      m_AxisLengths[3 * i] = static_cast<float>(a / m_ScaleFactor);
+      m_AxisLengths[3 * i + 1] = static_cast<float>(b / m_ScaleFactor);
+      m_AxisLengths[3 * i + 2] = static_cast<float>(c / m_ScaleFactor);
+      float bovera = static_cast<float>(b / a);
+      float covera = static_cast<float>(c / a);
+      if(A == 0.0 || B == 0.0 || C == 0.0)
+      {
+        bovera = 0.0f;
+        covera = 0.0f;
+      }
+      m_AspectRatios[2 * i] = bovera;
+      m_AspectRatios[2 * i + 1] = covera;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const double* m_FeatureMoments;
+  double* m_FeatureEigenVals;
+  float* m_AxisLengths;
+  float* m_AspectRatios;
+  double m_ScaleFactor;
+};
+
+/**
+ * @brief The FindShapesAxisEulersImpl class finds the eigenvectors of each Feature's moment matrix and converts the
+ * resulting principal axis frame to Euler angles
+ */
+class FindShapesAxisEulersImpl
+{
+public:
+  FindShapesAxisEulersImpl(const double* featureMoments, const double* featureEigenVals, float* axisEulerAngles)
+  : m_FeatureMoments(featureMoments)
+  , m_FeatureEigenVals(featureEigenVals)
+  , m_AxisEulerAngles(axisEulerAngles)
+  {
+  }
+  virtual ~FindShapesAxisEulersImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      double Ixx = m_FeatureMoments[i * 6 + 0];
+      double Iyy = m_FeatureMoments[i * 6 + 1];
+      double Izz = m_FeatureMoments[i * 6 + 2];
+      double Ixy = m_FeatureMoments[i * 6 + 3];
+      double Iyz = m_FeatureMoments[i * 6 + 4];
+      double Ixz = m_FeatureMoments[i * 6 + 5];
+      double radius1 = m_FeatureEigenVals[3 * i];
+      double radius2 = m_FeatureEigenVals[3 * i + 1];
+      double radius3 = m_FeatureEigenVals[3 * i + 2];
+
+      double e[3][1];
+      double vect[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+      e[0][0] = radius1;
+      e[1][0] = radius2;
+      e[2][0] = radius3;
+      double uber[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+      double bmat[3][1];
+      bmat[0][0] = 0.0000001;
+      bmat[1][0] = 0.0000001;
+      bmat[2][0] = 0.0000001;
+
+      for(int32_t j = 0; j < 3; j++)
+      {
+        uber[0][0] = Ixx - e[j][0];
+        uber[0][1] = Ixy;
+        uber[0][2] = Ixz;
+        uber[1][0] = Ixy;
+        uber[1][1] = Iyy - e[j][0];
+        uber[1][2] = Iyz;
+        uber[2][0] = Ixz;
+        uber[2][1] = Iyz;
+        uber[2][2] = Izz - e[j][0];
+        double uberelim[3][3];
+        double uberbelim[3][1];
+        int32_t elimcount = 0;
+        int32_t elimcount1 = 0;
+        double q = 0.0;
+        double sum = 0.0;
+        double c = 0.0;
+        for(int32_t a = 0; a < 3; a++)
+        {
+          elimcount1 = 0;
+          for(int32_t b = 0; b < 3; b++)
+          {
+            uberelim[elimcount][elimcount1] = uber[a][b];
+            elimcount1++;
+          }
+          uberbelim[elimcount][0] = bmat[a][0];
+          elimcount++;
+        }
+        for(int32_t k = 0; k < elimcount - 1; k++)
+        {
+          for(int32_t l = k + 1; l < elimcount; l++)
+          {
+            c = uberelim[l][k] / uberelim[k][k];
+            for(int32_t r = k + 1; r < elimcount; r++)
+            {
+              uberelim[l][r] = uberelim[l][r] - c * uberelim[k][r];
+            }
+            uberbelim[l][0] = uberbelim[l][0] - c * uberbelim[k][0];
+          }
+        }
+        uberbelim[elimcount - 1][0] = uberbelim[elimcount - 1][0] / uberelim[elimcount - 1][elimcount - 1];
+        for(int32_t l = 1; l < elimcount; l++)
+        {
+          int32_t r = (elimcount - 1) - l;
+          sum = 0.0;
+          for(int32_t n = r + 1; n < elimcount; n++)
+          {
+            sum = sum + (uberelim[r][n] * uberbelim[n][0]);
+          }
+          uberbelim[r][0] = (uberbelim[r][0] - sum) / uberelim[r][r];
+        }
+        for(int32_t p = 0; p < elimcount; p++)
+        {
+          q = uberbelim[p][0];
+          vect[j][p] = q;
+        }
+      }
+
+      double n1x = vect[0][0];
+      double n1y = vect[0][1];
+      double n1z = vect[0][2];
+      double n2x = vect[1][0];
+      double n2y = vect[1][1];
+      double n2z = vect[1][2];
+      double n3x = vect[2][0];
+      double n3y = vect[2][1];
+      double n3z = vect[2][2];
+      double norm1 = sqrt(((n1x * n1x) + (n1y * n1y) + (n1z * n1z)));
+      double norm2 = sqrt(((n2x * n2x) + (n2y * n2y) + (n2z * n2z)));
+      double norm3 = sqrt(((n3x * n3x) + (n3y * n3y) + (n3z * n3z)));
+      n1x = n1x / norm1;
+      n1y = n1y / norm1;
+      n1z = n1z / norm1;
+      n2x = n2x / norm2;
+      n2y = n2y / norm2;
+      n2z = n2z / norm2;
+      n3x = n3x / norm3;
+      n3y = n3y / norm3;
+      n3z = n3z / norm3;
+
+      // insert principal unit vectors into rotation matrix representing Feature reference frame within the sample reference frame
+      //(Note that the 3 direction is actually the long axis and the 1 direction is actually the short axis)
+      float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+      g[0][0] = n3x;
+      g[0][1] = n3y;
+      g[0][2] = n3z;
+      g[1][0] = n2x;
+      g[1][1] = n2y;
+      g[1][2] = n2z;
+      g[2][0] = n1x;
+      g[2][1] = n1y;
+      g[2][2] = n1z;
+
+      // check for right-handedness
+      OrientationTransformation::ResultType result = OrientationTransformation::om_check(OrientationF(g));
+      if(result.result == 0)
+      {
+        g[2][0] *= -1.0f;
+        g[2][1] *= -1.0f;
+        g[2][2] *= -1.0f;
+      }
+
+      OrientationF eu = OrientationTransformation::om2eu<OrientationF, OrientationF>(OrientationF(g));
+
+      m_AxisEulerAngles[3 * i] = eu[0];
+      m_AxisEulerAngles[3 * i + 1] = eu[1];
+      m_AxisEulerAngles[3 * i + 2] = eu[2];
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const double* m_FeatureMoments;
+  const double* m_FeatureEigenVals;
+  float* m_AxisEulerAngles;
+};
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -233,13 +695,11 @@ void FindShapes::find_moments()
   float u110 = 0.0f;
   float u011 = 0.0f;
   float u101 = 0.0f;
-  float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
 
   size_t xPoints = imageGeom->getXPoints();
   size_t yPoints = imageGeom->getYPoints();
   size_t zPoints = imageGeom->getZPoints();
   FloatVec3Type spacing = imageGeom->getSpacing();
-  FloatVec3Type origin = imageGeom->getOrigin();
 
   // using a modified resolution to keep the moment calculations "small" and prevent exceeding numerical bounds.
   // scaleFactor is applied later to rescale the calculated axis lengths
@@ -249,90 +709,8 @@ void FindShapes::find_moments()
 
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
-  for(size_t i = 0; i < numfeatures; i++)
-  {
-    m_FeatureMoments[6 * i + 0] = 0.0;
-    m_FeatureMoments[6 * i + 1] = 0.0;
-    m_FeatureMoments[6 * i + 2] = 0.0;
-    m_FeatureMoments[6 * i + 3] = 0.0;
-    m_FeatureMoments[6 * i + 4] = 0.0;
-    m_FeatureMoments[6 * i + 5] = 0.0;
-  }
+  accumulate_moments(xPoints, yPoints, zPoints, modXRes, modYRes, modZRes, false);
 
-  float x = 0.0f, y = 0.0f, z = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f, z1 = 0.0f, z2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f, xdist5 = 0.0f, xdist6 = 0.0f, xdist7 = 0.0f, xdist8 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f, ydist5 = 0.0f, ydist6 = 0.0f, ydist7 = 0.0f, ydist8 = 0.0f;
-  float zdist1 = 0.0f, zdist2 = 0.0f, zdist3 = 0.0f, zdist4 = 0.0f, zdist5 = 0.0f, zdist6 = 0.0f, zdist7 = 0.0f, zdist8 = 0.0f;
-  size_t zStride = 0, yStride = 0;
-  for(size_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for(size_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for(size_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        x = float(k * modXRes) + (origin[0] * static_cast<float>(m_ScaleFactor));
-        y = float(j * modYRes) + (origin[1] * static_cast<float>(m_ScaleFactor));
-        z = float(i * modZRes) + (origin[2] * static_cast<float>(m_ScaleFactor));
-        x1 = x + (modXRes / 4.0f);
-        x2 = x - (modXRes / 4.0f);
-        y1 = y + (modYRes / 4.0f);
-        y2 = y - (modYRes / 4.0f);
-        z1 = z + (modZRes / 4.0f);
-        z2 = z - (modZRes / 4.0f);
-        xdist1 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist1 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist1 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist2 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist2 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist2 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist3 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist3 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist3 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist4 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist4 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist4 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist5 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist5 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist5 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist6 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist6 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist6 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist7 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist7 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist7 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist8 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist8 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist8 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-
-        xx = ((ydist1) * (ydist1)) + ((zdist1) * (zdist1)) + ((ydist2) * (ydist2)) + ((zdist2) * (zdist2)) + ((ydist3) * (ydist3)) + ((zdist3) * (zdist3)) + ((ydist4) * (ydist4)) +
-             ((zdist4) * (zdist4)) + ((ydist5) * (ydist5)) + ((zdist5) * (zdist5)) + ((ydist6) * (ydist6)) + ((zdist6) * (zdist6)) + ((ydist7) * (ydist7)) + ((zdist7) * (zdist7)) +
-             ((ydist8) * (ydist8)) + ((zdist8) * (zdist8));
-        yy = ((xdist1) * (xdist1)) + ((zdist1) * (zdist1)) + ((xdist2) * (xdist2)) + ((zdist2) * (zdist2)) + ((xdist3) * (xdist3)) + ((zdist3) * (zdist3)) + ((xdist4) * (xdist4)) +
-             ((zdist4) * (zdist4)) + ((xdist5) * (xdist5)) + ((zdist5) * (zdist5)) + ((xdist6) * (xdist6)) + ((zdist6) * (zdist6)) + ((xdist7) * (xdist7)) + ((zdist7) * (zdist7)) +
-             ((xdist8) * (xdist8)) + ((zdist8) * (zdist8));
-        zz = ((xdist1) * (xdist1)) + ((ydist1) * (ydist1)) + ((xdist2) * (xdist2)) + ((ydist2) * (ydist2)) + ((xdist3) * (xdist3)) + ((ydist3) * (ydist3)) + ((xdist4) * (xdist4)) +
-             ((ydist4) * (ydist4)) + ((xdist5) * (xdist5)) + ((ydist5) * (ydist5)) + ((xdist6) * (xdist6)) + ((ydist6) * (ydist6)) + ((xdist7) * (xdist7)) + ((ydist7) * (ydist7)) +
-             ((xdist8) * (xdist8)) + ((ydist8) * (ydist8));
-        xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4)) + ((xdist5) * (ydist5)) + ((xdist6) * (ydist6)) + ((xdist7) * (ydist7)) +
-             ((xdist8) * (ydist8));
-        yz = ((ydist1) * (zdist1)) + ((ydist2) * (zdist2)) + ((ydist3) * (zdist3)) + ((ydist4) * (zdist4)) + ((ydist5) * (zdist5)) + ((ydist6) * (zdist6)) + ((ydist7) * (zdist7)) +
-             ((ydist8) * (zdist8));
-        xz = ((xdist1) * (zdist1)) + ((xdist2) * (zdist2)) + ((xdist3) * (zdist3)) + ((xdist4) * (zdist4)) + ((xdist5) * (zdist5)) + ((xdist6) * (zdist6)) + ((xdist7) * (zdist7)) +
-             ((xdist8) * (zdist8));
-
-        m_FeatureMoments[gnum * 6 + 0] = m_FeatureMoments[gnum * 6 + 0] + static_cast<double>(xx);
-        m_FeatureMoments[gnum * 6 + 1] = m_FeatureMoments[gnum * 6 + 1] + static_cast<double>(yy);
-        m_FeatureMoments[gnum * 6 + 2] = m_FeatureMoments[gnum * 6 + 2] + static_cast<double>(zz);
-        m_FeatureMoments[gnum * 6 + 3] = m_FeatureMoments[gnum * 6 + 3] + static_cast<double>(xy);
-        m_FeatureMoments[gnum * 6 + 4] = m_FeatureMoments[gnum * 6 + 4] + static_cast<double>(yz);
-        m_FeatureMoments[gnum * 6 + 5] = m_FeatureMoments[gnum * 6 + 5] + static_cast<double>(xz);
-        m_Volumes[gnum] = m_Volumes[gnum] + 1.0;
-      }
-    }
-  }
   double sphere = (2000.0 * M_PI * M_PI) / 9.0;
   // constant for moments because voxels are broken into smaller voxels
   double konst1 = static_cast<double>((modXRes / 2.0) * (modYRes / 2.0) * (modZRes / 2.0));
@@ -381,7 +759,6 @@ void FindShapes::find_moments2D()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
   ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
 
-  float xx = 0.0f, yy = 0.0f, xy = 0.0f;
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
   size_t xPoints = 0, yPoints = 0;
@@ -409,46 +786,8 @@ void FindShapes::find_moments2D()
   float modXRes = spacing[0] * m_ScaleFactor;
   float modYRes = spacing[1] * m_ScaleFactor;
 
-  FloatVec3Type origin = imageGeom->getOrigin();
-
-  for(size_t i = 0; i < 6 * numfeatures; i++)
-  {
-    m_FeatureMoments[i] = 0.0;
-  }
+  accumulate_moments(xPoints, yPoints, 1, modXRes, modYRes, 0.0f, true);
 
-  float x = 0.0f, y = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f;
-  size_t yStride = 0;
-  for(size_t j = 0; j < yPoints; j++)
-  {
-    yStride = j * xPoints;
-    for(size_t k = 0; k < xPoints; k++)
-    {
-      int32_t gnum = m_FeatureIds[yStride + k];
-      x = float(k * modXRes) + (origin[0] * static_cast<float>(m_ScaleFactor));
-      y = float(j * modYRes) + (origin[1] * static_cast<float>(m_ScaleFactor));
-      x1 = x + (modXRes / 4.0f);
-      x2 = x - (modXRes / 4.0f);
-      y1 = y + (modYRes / 4.0f);
-      y2 = y - (modYRes / 4.0f);
-      xdist1 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      ydist1 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      xdist2 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      ydist2 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      xdist3 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      ydist3 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      xdist4 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      ydist4 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      xx = ((ydist1) * (ydist1)) + ((ydist2) * (ydist2)) + ((ydist3) * (ydist3)) + ((ydist4) * (ydist4));
-      yy = ((xdist1) * (xdist1)) + ((xdist2) * (xdist2)) + ((xdist3) * (xdist3)) + ((xdist4) * (xdist4));
-      xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4));
-      m_FeatureMoments[gnum * 6 + 0] = m_FeatureMoments[gnum * 6 + 0] + xx;
-      m_FeatureMoments[gnum * 6 + 1] = m_FeatureMoments[gnum * 6 + 1] + yy;
-      m_FeatureMoments[gnum * 6 + 2] = m_FeatureMoments[gnum * 6 + 2] + xy;
-      m_Volumes[gnum] = m_Volumes[gnum] + 1.0;
-    }
-  }
   double konst1 = static_cast<double>( (modXRes / 2.0f) * (modYRes / 2.0f));
   double konst2 = static_cast<double>(spacing[0] * spacing[1]);
   for(size_t i = 1; i < numfeatures; i++)
@@ -467,99 +806,79 @@ void FindShapes::find_moments2D()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void FindShapes::find_axes()
+void FindShapes::accumulate_moments(size_t xPoints, size_t yPoints, size_t zPoints, float modXRes, float modYRes, float modZRes, bool twoD)
 {
-  double I1 = 0.0, I2 = 0.0, I3 = 0.0;
-  double Ixx = 0.0, Iyy = 0.0, Izz = 0.0, Ixy = 0.0, Ixz = 0.0, Iyz = 0.0;
-  double a = 0.0, b = 0.0, c = 0.0, d = 0.0, f = 0.0, g = 0.0, h = 0.0;
-  double rsquare = 0.0, r = 0.0, theta = 0.0;
-  double A = 0.0, B = 0.0, C = 0.0;
-  double r1 = 0.0, r2 = 0.0, r3 = 0.0;
-  float bovera = 0.0f, covera = 0.0f;
-  double value = 0.0;
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
+  FloatVec3Type origin = m->getGeometryAs<ImageGeom>()->getOrigin();
 
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
+  size_t numRows = yPoints * zPoints;
+  if(numfeatures == 0 || numRows == 0)
+  {
+    return;
+  }
 
+  float scale = static_cast<float>(m_ScaleFactor);
+  float modRes[3] = {modXRes, modYRes, modZRes};
+  float scaledOrigin[3] = {origin[0] * scale, origin[1] * scale, origin[2] * scale};
+
+  // The slab count is fixed rather than taken from the thread count, so the summation order, and with it the
+  // rounding of the moments, is the same on every machine and in serial builds. Fewer slabs are used when the
+  // per slab tables would get large.
+  const size_t k_NumSlabs = 32;
+  const size_t maxTableBytes = 256 * 1024 * 1024;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+#endif
+  size_t numSlabs = k_NumSlabs;
+  size_t tableBytes = numfeatures * FindShapesMomentsImpl::k_TableStride * sizeof(double);
+  numSlabs = std::max(std::min(numSlabs, maxTableBytes / tableBytes), static_cast<size_t>(1));
+  numSlabs = std::min(numSlabs, numRows);
+  std::vector<size_t> slabRows(numSlabs + 1, 0);
+  for(size_t s = 0; s <= numSlabs; s++)
+  {
+    slabRows[s] = numRows * s / numSlabs;
+  }
+  std::vector<std::vector<double>> tables(numSlabs);
 
-  for(size_t i = 1; i < numfeatures; i++)
+  FindShapesMomentsImpl sweepImpl(m_FeatureIds, m_Centroids, numfeatures, xPoints, yPoints, modRes, scaledOrigin, scale, twoD, slabRows, tables);
+  FindShapesMergeMomentsImpl mergeImpl(tables, m_FeatureMoments, m_Volumes);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    Ixx = m_FeatureMoments[i * 6 + 0];
-    Iyy = m_FeatureMoments[i * 6 + 1];
-    Izz = m_FeatureMoments[i * 6 + 2];
-
-    Ixy = m_FeatureMoments[i * 6 + 3];
-    Iyz = m_FeatureMoments[i * 6 + 4];
-    Ixz = m_FeatureMoments[i * 6 + 5];
-
-    a = 1.0;
-    b = (-Ixx - Iyy - Izz);
-    c = ((Ixx * Izz) + (Ixx * Iyy) + (Iyy * Izz) - (Ixz * Ixz) - (Ixy * Ixy) - (Iyz * Iyz));
-    d = 0.0;
-    d = ((Ixz * Iyy * Ixz) + (Ixy * Izz * Ixy) + (Iyz * Ixx * Iyz) - (Ixx * Iyy * Izz) - (Ixy * Iyz * Ixz) - (Ixy * Iyz * Ixz));
-    // f and g are the p and q values when reducing the cubic equation to t^3 + pt + q = 0
-    f = ((3.0 * c / a) - ((b / a) * (b / a))) / 3.0;
-    g = ((2.0 * (b / a) * (b / a) * (b / a)) - (9.0 * b * c / (a * a)) + (27.0 * (d / a))) / 27.0;
-    h = (g * g / 4.0) + (f * f * f / 27.0);
-    rsquare = (g * g / 4.0) - h;
-    r = sqrt(rsquare);
-    if(rsquare < 0.0)
-    {
-      r = 0.0;
-    }
-    theta = 0;
-    if(r == 0)
-    {
-      theta = 0;
-    }
-    if(r != 0)
-    {
-      value = -g / (2.0 * r);
-      if(value > 1)
-      {
-        value = 1.0;
-      }
-      if(value < -1)
-      {
-        value = -1.0;
-      }
-      theta = acos(value);
-    }
-    double const1 = pow(r, 0.33333333333);
-    double const2 = cos(theta / 3.0);
-    double const3 = b / (3.0 * a);
-    double const4 = 1.7320508 * sin(theta / 3.0);
-
-    r1 = 2 * const1 * const2 - (const3);
-    r2 = -const1 * (const2 - (const4)) - const3;
-    r3 = -const1 * (const2 + (const4)) - const3;
-    m_FeatureEigenVals[3 * i] = r1;
-    m_FeatureEigenVals[3 * i + 1] = r2;
-    m_FeatureEigenVals[3 * i + 2] = r3;
-
-    I1 = (15.0 * r1) / (4.0 * M_PI);
-    I2 = (15.0 * r2) / (4.0 * M_PI);
-    I3 = (15.0 * r3) / (4.0 * M_PI);
-    A = (I1 + I2 - I3) / 2.0;
-    B = (I1 + I3 - I2) / 2.0;
-    C = (I2 + I3 - I1) / 2.0;
-    a = (A * A * A * A) / (B * C);
-    a = pow(a, 0.1);
-    b = B / A;
-    b = sqrt(b) * a;
-    c = A / (a * a * a * b);
-
-    m_AxisLengths[3 * i] = static_cast<float>(a / m_ScaleFactor);
-    m_AxisLengths[3 * i + 1] = static_cast<float>(b / m_ScaleFactor);
-    m_AxisLengths[3 * i + 2] = static_cast<float>(c / m_ScaleFactor);
-    bovera = static_cast<float>(b / a);
-    covera = static_cast<float>(c / a);
-    if(A == 0.0 || B == 0.0 || C == 0.0)
-    {
-      bovera = 0.0f;
-      covera = 0.0f;
-    }
-    m_AspectRatios[2 * i] = bovera;
-    m_AspectRatios[2 * i + 1] = covera;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), sweepImpl, tbb::simple_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numfeatures), mergeImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    sweepImpl.convert(0, numSlabs);
+    mergeImpl.convert(0, numfeatures);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindShapes::find_axes()
+{
+  size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
+  if(numfeatures < 2)
+  {
+    return;
+  }
+
+  FindShapesAxesImpl impl(m_FeatureMoments, m_FeatureEigenVals, m_AxisLengths, m_AspectRatios, m_ScaleFactor);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, numfeatures), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(1, numfeatures);
   }
 }
 
@@ -647,151 +966,22 @@ void FindShapes::find_axes2D()
 void FindShapes::find_axiseulers()
 {
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
-  for(size_t i = 1; i < numfeatures; i++)
+  if(numfeatures < 2)
   {
-    double Ixx = m_FeatureMoments[i * 6 + 0];
-    double Iyy = m_FeatureMoments[i * 6 + 1];
-    double Izz = m_FeatureMoments[i * 6 + 2];
-    double Ixy = m_FeatureMoments[i * 6 + 3];
-    double Iyz = m_FeatureMoments[i * 6 + 4];
-    double Ixz = m_FeatureMoments[i * 6 + 5];
-    double radius1 = m_FeatureEigenVals[3 * i];
-    double radius2 = m_FeatureEigenVals[3 * i + 1];
-    double radius3 = m_FeatureEigenVals[3 * i + 2];
-
-    double e[3][1];
-    double vect[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
-    e[0][0] = radius1;
-    e[1][0] = radius2;
-    e[2][0] = radius3;
-    double uber[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
-    double bmat[3][1];
-    bmat[0][0] = 0.0000001;
-    bmat[1][0] = 0.0000001;
-    bmat[2][0] = 0.0000001;
-
-    for(int32_t j = 0; j < 3; j++)
-    {
-      uber[0][0] = Ixx - e[j][0];
-      uber[0][1] = Ixy;
-      uber[0][2] = Ixz;
-      uber[1][0] = Ixy;
-      uber[1][1] = Iyy - e[j][0];
-      uber[1][2] = Iyz;
-      uber[2][0] = Ixz;
-      uber[2][1] = Iyz;
-      uber[2][2] = Izz - e[j][0];
-      double** uberelim;
-      double** uberbelim;
-      uberelim = new double*[3];
-      uberbelim = new double*[3];
-      for(int32_t d = 0; d < 3; d++)
-      {
-        uberelim[d] = new double[3];
-        uberbelim[d] = new double[1];
-      }
-      int32_t elimcount = 0;
-      int32_t elimcount1 = 0;
-      double q = 0.0;
-      double sum = 0.0;
-      double c = 0.0;
-      for(int32_t a = 0; a < 3; a++)
-      {
-        elimcount1 = 0;
-        for(int32_t b = 0; b < 3; b++)
-        {
-          uberelim[elimcount][elimcount1] = uber[a][b];
-          elimcount1++;
-        }
-        uberbelim[elimcount][0] = bmat[a][0];
-        elimcount++;
-      }
-      for(int32_t k = 0; k < elimcount - 1; k++)
-      {
-        for(int32_t l = k + 1; l < elimcount; l++)
-        {
-          c = uberelim[l][k] / uberelim[k][k];
-          for(int32_t r = k + 1; r < elimcount; r++)
-          {
-            uberelim[l][r] = uberelim[l][r] - c * uberelim[k][r];
-          }
-          uberbelim[l][0] = uberbelim[l][0] - c * uberbelim[k][0];
-        }
-      }
-      uberbelim[elimcount - 1][0] = uberbelim[elimcount - 1][0] / uberelim[elimcount - 1][elimcount - 1];
-      for(int32_t l = 1; l < elimcount; l++)
-      {
-        int32_t r = (elimcount - 1) - l;
-        sum = 0.0;
-        for(int32_t n = r + 1; n < elimcount; n++)
-        {
-          sum = sum + (uberelim[r][n] * uberbelim[n][0]);
-        }
-        uberbelim[r][0] = (uberbelim[r][0] - sum) / uberelim[r][r];
-      }
-      for(int32_t p = 0; p < elimcount; p++)
-      {
-        q = uberbelim[p][0];
-        vect[j][p] = q;
-      }
-      for(int32_t d = 0; d < 3; d++)
-      {
-        delete uberelim[d];
-        delete uberbelim[d];
-      }
-      delete uberelim;
-      delete uberbelim;
-    }
-
-    double n1x = vect[0][0];
-    double n1y = vect[0][1];
-    double n1z = vect[0][2];
-    double n2x = vect[1][0];
-    double n2y = vect[1][1];
-    double n2z = vect[1][2];
-    double n3x = vect[2][0];
-    double n3y = vect[2][1];
-    double n3z = vect[2][2];
-    double norm1 = sqrt(((n1x * n1x) + (n1y * n1y) + (n1z * n1z)));
-    double norm2 = sqrt(((n2x * n2x) + (n2y * n2y) + (n2z * n2z)));
-    double norm3 = sqrt(((n3x * n3x) + (n3y * n3y) + (n3z * n3z)));
-    n1x = n1x / norm1;
-    n1y = n1y / norm1;
-    n1z = n1z / norm1;
-    n2x = n2x / norm2;
-    n2y = n2y / norm2;
-    n2z = n2z / norm2;
-    n3x = n3x / norm3;
-    n3y = n3y / norm3;
-    n3z = n3z / norm3;
-
-    // insert principal unit vectors into rotation matrix representing Feature reference frame within the sample reference frame
-    //(Note that the 3 direction is actually the long axis and the 1 direction is actually the short axis)
-    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-    g[0][0] = n3x;
-    g[0][1] = n3y;
-    g[0][2] = n3z;
-    g[1][0] = n2x;
-    g[1][1] = n2y;
-    g[1][2] = n2z;
-    g[2][0] = n1x;
-    g[2][1] = n1y;
-    g[2][2] = n1z;
-
-    // check for right-handedness
-    OrientationTransformation::ResultType result = OrientationTransformation::om_check(OrientationF(g));
-    if(result.result == 0)
-    {
-      g[2][0] *= -1.0f;
-      g[2][1] *= -1.0f;
-      g[2][2] *= -1.0f;
-    }
-
-    OrientationF eu = OrientationTransformation::om2eu<OrientationF, OrientationF>(OrientationF(g));
+    return;
+  }
 
-    m_AxisEulerAngles[3 * i] = eu[0];
-    m_AxisEulerAngles[3 * i + 1] = eu[1];
-    m_AxisEulerAngles[3 * i + 2] = eu[2];
+  FindShapesAxisEulersImpl impl(m_FeatureMoments, m_FeatureEigenVals, m_AxisEulerAngles);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, numfeatures), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(1, numfeatures);
   }
 }
 
@@ -287,6 +287,19 @@ protected:
    */
   void find_moments2D();
 
+  /**
+   * @brief accumulate_moments Sums the second order moments and the cell count of each Feature in one sweep over the
+   * FeatureIds; the rows of the volume are split into slabs that are scanned in parallel and merged in slab order
+   * @param xPoints Cells per row
+   * @param yPoints Rows per plane
+   * @param zPoints Planes; 1 for the 2D version
+   * @param modXRes Scaled X resolution
+   * @param modYRes Scaled Y resolution
+   * @param modZRes Scaled Z resolution; unused for the 2D version
+   * @param twoD Accumulate the 2D moments (xx, yy, xy) instead of the 3D moments
+   */
+  void accumulate_moments(size_t xPoints, size_t yPoints, size_t zPoints, float modXRes, float modYRes, float modZRes, bool twoD);
+
   /**
    * @brief find_axes Determine principal axis lengths for each Feature
    */
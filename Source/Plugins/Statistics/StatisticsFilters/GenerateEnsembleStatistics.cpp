@@ -35,6 +35,9 @@
 
 #include "GenerateEnsembleStatistics.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <QtCore/QTextStream>
 #include <QtCore/QDebug>
 
@@ -71,6 +74,209 @@
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_group.h>
+#endif
+
+/**
+ * @brief The GenerateEnsembleStatisticsOdfBinsImpl class finds the ODF bin of each Feature that is not on the surface;
+ * surface Features get a bin of -1
+ */
+class GenerateEnsembleStatisticsOdfBinsImpl
+{
+public:
+  GenerateEnsembleStatisticsOdfBinsImpl(const std::vector<LaueOps::Pointer>& orientationOps, const float* eulerAngles, const int32_t* featurePhases, const unsigned int* crystalStructures,
+                                        const bool* surfaceFeatures, std::vector<int32_t>& bins)
+  : m_OrientationOps(orientationOps)
+  , m_EulerAngles(eulerAngles)
+  , m_FeaturePhases(featurePhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_SurfaceFeatures(surfaceFeatures)
+  , m_Bins(bins)
+  {
+  }
+  virtual ~GenerateEnsembleStatisticsOdfBinsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      m_Bins[i] = -1;
+      if(!m_SurfaceFeatures[i])
+      {
+        uint32_t phase = m_CrystalStructures[m_FeaturePhases[i]];
+        Orientation<float> eu(m_EulerAngles[3 * i], m_EulerAngles[3 * i + 1], m_EulerAngles[3 * i + 2]);
+        Orientation<double> rod = OrientationTransformation::eu2ro<Orientation<float>, Orientation<double>>(eu);
+        m_Bins[i] = m_OrientationOps[phase]->getOdfBin(rod);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<LaueOps::Pointer>& m_OrientationOps;
+  const float* m_EulerAngles;
+  const int32_t* m_FeaturePhases;
+  const unsigned int* m_CrystalStructures;
+  const bool* m_SurfaceFeatures;
+  std::vector<int32_t>& m_Bins;
+};
+
+/**
+ * @brief The GenerateEnsembleStatisticsAxisOdfBinsImpl class finds the orthorhombic ODF bin of the principal axes of
+ * each unbiased Feature; biased Features get a bin of -1
+ */
+class GenerateEnsembleStatisticsAxisOdfBinsImpl
+{
+public:
+  GenerateEnsembleStatisticsAxisOdfBinsImpl(const LaueOps::Pointer& orthoOps, const float* axisEulerAngles, const bool* biasedFeatures, std::vector<int32_t>& bins)
+  : m_OrthoOps(orthoOps)
+  , m_AxisEulerAngles(axisEulerAngles)
+  , m_BiasedFeatures(biasedFeatures)
+  , m_Bins(bins)
+  {
+  }
+  virtual ~GenerateEnsembleStatisticsAxisOdfBinsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      m_Bins[i] = -1;
+      if(!m_BiasedFeatures[i])
+      {
+        Orientation<float> eu(m_AxisEulerAngles[3 * i], m_AxisEulerAngles[3 * i + 1], m_AxisEulerAngles[3 * i + 2]);
+        Orientation<double> rod = OrientationTransformation::eu2ro<Orientation<float>, Orientation<double>>(eu);
+        m_OrthoOps->getODFFZRod(rod);
+        m_Bins[i] = m_OrthoOps->getOdfBin(rod);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const LaueOps::Pointer& m_OrthoOps;
+  const float* m_AxisEulerAngles;
+  const bool* m_BiasedFeatures;
+  std::vector<int32_t>& m_Bins;
+};
+
+/**
+ * @brief The GenerateEnsembleStatisticsMisoBinsImpl class finds the MDF bin of every Feature/neighbor pair that
+ * contributes to the MDF. The bins are written at the pair's offset into the flattened neighbor lists; pairs that
+ * do not contribute get a bin of -1.
+ */
+class GenerateEnsembleStatisticsMisoBinsImpl
+{
+public:
+  GenerateEnsembleStatisticsMisoBinsImpl(const std::vector<LaueOps*>& ensembleOps, NeighborList<int32_t>& neighborList, const float* avgQuats, const int32_t* featurePhases,
+                                         const unsigned int* crystalStructures, const bool* surfaceFeatures, const std::vector<size_t>& pairOffsets, std::vector<int32_t>& bins)
+  : m_EnsembleOps(ensembleOps)
+  , m_NeighborList(neighborList)
+  , m_AvgQuats(avgQuats)
+  , m_FeaturePhases(featurePhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_SurfaceFeatures(surfaceFeatures)
+  , m_PairOffsets(pairOffsets)
+  , m_Bins(bins)
+  {
+  }
+  virtual ~GenerateEnsembleStatisticsMisoBinsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    for(size_t i = start; i < end; i++)
+    {
+      QuatF q1(m_AvgQuats + 4 * i);
+      uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[i]];
+      NeighborList<int32_t>::VectorType& neighbors = m_NeighborList[i];
+      int32_t* bins = m_Bins.data() + m_PairOffsets[i];
+      for(size_t j = 0; j < neighbors.size(); j++)
+      {
+        bins[j] = -1;
+        int32_t nname = neighbors[j];
+        uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[nname]];
+        if(phase1 != phase2 || !(static_cast<size_t>(nname) > i || m_SurfaceFeatures[nname]))
+        {
+          continue;
+        }
+        LaueOps* ops = m_EnsembleOps[m_FeaturePhases[i]];
+        if(nullptr == ops)
+        {
+          continue;
+        }
+        QuatF q2(m_AvgQuats + 4 * nname);
+        OrientationD axisAngle = ops->calculateMisorientation(q1, q2);
+        float w = axisAngle[3];
+        Orientation<double> rod = OrientationTransformation::ax2ro<OrientationF, OrientationD>(OrientationF(n1, n2, n3, w));
+        bins[j] = ops->getMisoBin(rod);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<LaueOps*>& m_EnsembleOps;
+  NeighborList<int32_t>& m_NeighborList;
+  const float* m_AvgQuats;
+  const int32_t* m_FeaturePhases;
+  const unsigned int* m_CrystalStructures;
+  const bool* m_SurfaceFeatures;
+  const std::vector<size_t>& m_PairOffsets;
+  std::vector<int32_t>& m_Bins;
+};
+
+/**
+ * @brief The GenerateEnsembleStatisticsTaskImpl class runs a chain of gatherers one after the other so that chains
+ * that do not depend on each other can run as concurrent tasks
+ */
+class GenerateEnsembleStatisticsTaskImpl
+{
+public:
+  using Gatherer = void (GenerateEnsembleStatistics::*)();
+
+  GenerateEnsembleStatisticsTaskImpl(GenerateEnsembleStatistics* filter, const std::vector<Gatherer>& gatherers)
+  : m_Filter(filter)
+  , m_Gatherers(gatherers)
+  {
+  }
+  virtual ~GenerateEnsembleStatisticsTaskImpl() = default;
+
+  void operator()() const
+  {
+    for(const Gatherer& gatherer : m_Gatherers)
+    {
+      (m_Filter->*gatherer)();
+    }
+  }
+
+private:
+  GenerateEnsembleStatistics* m_Filter;
+  std::vector<Gatherer> m_Gatherers;
+};
+
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -1017,10 +1223,8 @@ void GenerateEnsembleStatistics::gatherODFStats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
   std::vector<LaueOps::Pointer> m_OrientationOps = LaueOps::GetAllOrientationOps();
-  size_t bin = 0;
   size_t numfeatures = m_FeatureEulerAnglesPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
-  int32_t phase = 0;
   std::vector<float> totalvol;
   std::vector<FloatArrayType::Pointer> eulerodf;
 
@@ -1056,16 +1260,25 @@ void GenerateEnsembleStatistics::gatherODFStats()
       totalvol[m_FeaturePhases[i]] = totalvol[m_FeaturePhases[i]] + m_Volumes[i];
     }
   }
+  size_t firstFeature = std::min(static_cast<size_t>(1), numfeatures);
+  std::vector<int32_t> bins(numfeatures, -1);
+  GenerateEnsembleStatisticsOdfBinsImpl binsImpl(m_OrientationOps, m_FeatureEulerAngles, m_FeaturePhases, m_CrystalStructures, m_SurfaceFeatures, bins);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(firstFeature, numfeatures), binsImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    binsImpl.convert(firstFeature, numfeatures);
+  }
   for(size_t i = 1; i < numfeatures; i++)
   {
-    if(!m_SurfaceFeatures[i])
+    if(bins[i] >= 0)
     {
-      phase = m_CrystalStructures[m_FeaturePhases[i]];
-      Orientation<float> eu(m_AxisEulerAngles[3 * i], m_FeatureEulerAngles[3 * i + 1], m_FeatureEulerAngles[3 * i + 2]);
-
-      Orientation<double> rod = OrientationTransformation::eu2ro<Orientation<float>, Orientation<double>>(eu);
-      bin = m_OrientationOps[phase]->getOdfBin(rod);
-      eulerodf[m_FeaturePhases[i]]->setValue(bin, (eulerodf[m_FeaturePhases[i]]->getValue(bin) + (m_Volumes[i] / totalvol[m_FeaturePhases[i]])));
+      eulerodf[m_FeaturePhases[i]]->setValue(bins[i], (eulerodf[m_FeaturePhases[i]]->getValue(bins[i]) + (m_Volumes[i] / totalvol[m_FeaturePhases[i]])));
     }
   }
   for(size_t i = 1; i < numensembles; i++)
@@ -1102,15 +1315,8 @@ void GenerateEnsembleStatistics::gatherMDFStats()
   // And we do the same for the SharedSurfaceArea list
   NeighborList<float>& neighborsurfacearealist = *(m_SharedSurfaceAreaList.lock());
 
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  int32_t mbin = 0;
-  float w = 0.0f;
-
-  // QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
   size_t numfeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
-  uint32_t phase1 = 0, phase2 = 0;
   QVector<float> totalSurfaceArea;
   QVector<FloatArrayType::Pointer> misobin;
   int32_t numbins = 0;
@@ -1136,36 +1342,47 @@ void GenerateEnsembleStatistics::gatherMDFStats()
       misobin[i]->setValue(j, 0.0);
     }
   }
-  int32_t nname = 0;
-  float nsa = 0.0f;
-  for(size_t i = 1; i < numfeatures; i++)
+  // Cache the Laue class of each Ensemble so the pair loop does not look it up through the crystal structures
+  std::vector<LaueOps*> ensembleOps(numensembles, nullptr);
+  for(size_t i = 1; i < numensembles; i++)
   {
-    QuatF q1(m_AvgQuatsPtr.lock()->getTuplePointer(i));
-    phase1 = m_CrystalStructures[m_FeaturePhases[i]];
-    for(size_t j = 0; j < neighborlist[i].size(); j++)
+    if(m_CrystalStructures[i] < m_OrientationOps.size())
     {
-      w = 10000.0f;
-      nname = neighborlist[i][j];
+      ensembleOps[i] = m_OrientationOps[m_CrystalStructures[i]].get();
+    }
+  }
 
-      QuatF q2(m_AvgQuatsPtr.lock()->getTuplePointer(nname));
+  std::vector<size_t> pairOffsets(numfeatures + 1, 0);
+  for(size_t i = 1; i < numfeatures; i++)
+  {
+    pairOffsets[i + 1] = pairOffsets[i] + neighborlist[i].size();
+  }
+  size_t firstFeature = std::min(static_cast<size_t>(1), numfeatures);
+  std::vector<int32_t> bins(pairOffsets[numfeatures], -1);
+  GenerateEnsembleStatisticsMisoBinsImpl binsImpl(ensembleOps, neighborlist, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, m_SurfaceFeatures, pairOffsets, bins);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(firstFeature, numfeatures), binsImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    binsImpl.convert(firstFeature, numfeatures);
+  }
 
-      phase2 = m_CrystalStructures[m_FeaturePhases[nname]];
-      if(phase1 == phase2)
-      {
-        OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-        w = axisAngle[3];
-      }
-      if(phase1 == phase2)
+  // The bins are accumulated serially in Feature and neighbor order so the sums do not depend on the thread schedule
+  for(size_t i = 1; i < numfeatures; i++)
+  {
+    for(size_t j = 0; j < neighborlist[i].size(); j++)
+    {
+      int32_t mbin = bins[pairOffsets[i] + j];
+      if(mbin >= 0)
       {
-        Orientation<double> rod = OrientationTransformation::ax2ro<OrientationF, OrientationD>(OrientationF(n1, n2, n3, w));
-
-        if((nname > i || m_SurfaceFeatures[nname]))
-        {
-          mbin = m_OrientationOps[phase1]->getMisoBin(rod);
-          nsa = neighborsurfacearealist[i][j];
-          misobin[m_FeaturePhases[i]]->setValue(mbin, (misobin[m_FeaturePhases[i]]->getValue(mbin) + nsa));
-          totalSurfaceArea[m_FeaturePhases[i]] = totalSurfaceArea[m_FeaturePhases[i]] + nsa;
-        }
+        float nsa = neighborsurfacearealist[i][j];
+        misobin[m_FeaturePhases[i]]->setValue(mbin, (misobin[m_FeaturePhases[i]]->getValue(mbin) + nsa));
+        totalSurfaceArea[m_FeaturePhases[i]] = totalSurfaceArea[m_FeaturePhases[i]] + nsa;
       }
     }
   }
@@ -1204,7 +1421,6 @@ void GenerateEnsembleStatistics::gatherAxisODFStats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
   std::vector<LaueOps::Pointer> m_OrientationOps = LaueOps::GetAllOrientationOps();
-  int32_t bin = 0;
   QVector<FloatArrayType::Pointer> axisodf;
   QVector<float> totalaxes;
   size_t numfeatures = m_AxisEulerAnglesPtr.lock()->getNumberOfTuples();
@@ -1227,17 +1443,25 @@ void GenerateEnsembleStatistics::gatherAxisODFStats()
       totalaxes[m_FeaturePhases[i]]++;
     }
   }
+  size_t firstFeature = std::min(static_cast<size_t>(1), numfeatures);
+  std::vector<int32_t> bins(numfeatures, -1);
+  GenerateEnsembleStatisticsAxisOdfBinsImpl binsImpl(m_OrientationOps[EbsdLib::CrystalStructure::OrthoRhombic], m_AxisEulerAngles, m_BiasedFeatures, bins);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(firstFeature, numfeatures), binsImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    binsImpl.convert(firstFeature, numfeatures);
+  }
   for(size_t i = 1; i < numfeatures; i++)
   {
-    if(!m_BiasedFeatures[i])
+    if(bins[i] >= 0)
     {
-
-      Orientation<float> eu(m_AxisEulerAngles + 3 * i, 3); // Wrap the pointer
-      Orientation<double> rod = OrientationTransformation::eu2ro<Orientation<float>, Orientation<double>>(eu);
-
-      m_OrientationOps[EbsdLib::CrystalStructure::OrthoRhombic]->getODFFZRod(rod);
-      bin = m_OrientationOps[EbsdLib::CrystalStructure::OrthoRhombic]->getOdfBin(rod);
-      axisodf[m_FeaturePhases[i]]->setValue(bin, (axisodf[m_FeaturePhases[i]]->getValue(bin) + static_cast<float>((1.0 / totalaxes[m_FeaturePhases[i]]))));
+      axisodf[m_FeaturePhases[i]]->setValue(bins[i], (axisodf[m_FeaturePhases[i]]->getValue(bins[i]) + static_cast<float>((1.0 / totalaxes[m_FeaturePhases[i]]))));
     }
   }
 
@@ -1424,37 +1648,68 @@ void GenerateEnsembleStatistics::execute()
     m_StatsDataArray->fillArrayWithNewStatsData(m_PhaseTypesPtr.lock()->getNumberOfTuples(), m_PhaseTypes);
   }
 
+  // The size statistics define the bins that the aspect ratio, Omega3 and neighborhood statistics are correlated
+  // with, so those run as one chain. The ODF, MDF and axis ODF do not depend on anything else and run as their own
+  // tasks.
+  using Gatherer = GenerateEnsembleStatisticsTaskImpl::Gatherer;
+  std::vector<Gatherer> featureStats;
   if(m_ComputeSizeDistribution)
   {
-    gatherSizeStats();
+    featureStats.push_back(&GenerateEnsembleStatistics::gatherSizeStats);
   }
   if(m_ComputeAspectRatioDistribution)
   {
-    gatherAspectRatioStats();
+    featureStats.push_back(&GenerateEnsembleStatistics::gatherAspectRatioStats);
   }
   if(m_ComputeOmega3Distribution)
   {
-    gatherOmega3Stats();
+    featureStats.push_back(&GenerateEnsembleStatistics::gatherOmega3Stats);
   }
   if(m_ComputeNeighborhoodDistribution)
   {
-    gatherNeighborhoodStats();
+    featureStats.push_back(&GenerateEnsembleStatistics::gatherNeighborhoodStats);
+  }
+  if(m_IncludeRadialDistFunc)
+  {
+    featureStats.push_back(&GenerateEnsembleStatistics::gatherRadialDistFunc);
+  }
+
+  std::vector<GenerateEnsembleStatisticsTaskImpl> tasks;
+  if(!featureStats.empty())
+  {
+    tasks.emplace_back(this, featureStats);
   }
   if(m_CalculateODF)
   {
-    gatherODFStats();
+    tasks.emplace_back(this, std::vector<Gatherer>(1, &GenerateEnsembleStatistics::gatherODFStats));
   }
   if(m_CalculateMDF)
   {
-    gatherMDFStats();
+    tasks.emplace_back(this, std::vector<Gatherer>(1, &GenerateEnsembleStatistics::gatherMDFStats));
   }
   if(m_CalculateAxisODF)
   {
-    gatherAxisODFStats();
+    tasks.emplace_back(this, std::vector<Gatherer>(1, &GenerateEnsembleStatistics::gatherAxisODFStats));
   }
-  if(m_IncludeRadialDistFunc)
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
   {
-    gatherRadialDistFunc();
+    std::shared_ptr<tbb::task_group> taskGroup(new tbb::task_group);
+    for(const GenerateEnsembleStatisticsTaskImpl& task : tasks)
+    {
+      taskGroup->run(task);
+    }
+    taskGroup->wait();
+  }
+  else
+#endif
+  {
+    for(const GenerateEnsembleStatisticsTaskImpl& task : tasks)
+    {
+      task();
+    }
   }
 
   calculatePPTBoundaryFrac();
@@ -89,21 +89,6 @@ MomentInvariants2D::DoubleMatrixType MomentInvariants2D::getBigX(size_t max_orde
   double fnorm = xx.maxCoeff();
   xx = xx / fnorm;
 
-  DoubleMatrixType D(dRows, dCols);
-  D.setZero();
-
-  IntMatrixType j(1, dRows);
-  for(int c = 0; c < dRows; c++)
-  {
-    j(0, c) = c;
-  }
-
-  for(int r = 0; r < dRows; r++)
-  {
-    D(r, r) = -1.0;
-    D(r, r + 1) = 1.0;
-  }
-
   // Set the Scale Factors
   DoubleMatrixType sc(1, max_order + 1);
   int mop1 = static_cast<int>(max_order + 1);
@@ -115,6 +100,8 @@ MomentInvariants2D::DoubleMatrixType MomentInvariants2D::getBigX(size_t max_orde
   DoubleMatrixType bigx(dim, max_order + 1);
   bigx.setZero();
 
+  // Each column is yy * D^T scaled by sc, where D has -1 on the diagonal and 1 just above it, so row r of the
+  // product is the forward difference yy(r + 1) - yy(r). Taking the difference directly avoids building D.
   DoubleMatrixType yy;
   for(int i = 0; i < mop1; i++)
   {
@@ -127,9 +114,10 @@ MomentInvariants2D::DoubleMatrixType MomentInvariants2D::getBigX(size_t max_orde
       yy = yy.cwiseProduct(xx);
     }
 
-    DoubleMatrixType mm = yy * D.transpose();
-    mm = mm * sc(0, i);
-    bigx.col(i) = mm.row(0);
+    for(int r = 0; r < dRows; r++)
+    {
+      bigx(r, i) = (yy(0, r + 1) - yy(0, r)) * sc(0, i);
+    }
   }
 
   return bigx;
@@ -144,19 +132,24 @@ MomentInvariants2D::DoubleMatrixType MomentInvariants2D::computeMomentInvariants
   size_t dim = inputDims[0];
   DoubleMatrixType bigX = getBigX(max_order, inputDims[0]);
 
+  DoubleMatrixType inter = input * bigX;
+
+  DoubleMatrixType mnk = bigX.transpose() * inter;
+
+  return computeCentralMoments(mnk, dim, max_order);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MomentInvariants2D::DoubleMatrixType MomentInvariants2D::computeCentralMoments(DoubleMatrixType& mnk, size_t dim, size_t max_order)
+{
   int mDim = static_cast<int>(max_order + 1);
   double fnorm = static_cast<double>(dim - 1) / 2.0;
 
   // precompute the binomial coefficients for central moment conversion;  (could be hard-coded for max_order = 2)
   DoubleMatrixType bn = binomial(max_order);
 
-  DoubleMatrixType mnk(mDim, mDim);
-  mnk.setZero();
-
-  DoubleMatrixType inter = input * bigX;
-
-  mnk = bigX.transpose() * inter;
-
   for(int c = 0; c < mDim; c++)
   {
     for(int r = 0; r < mDim; r++)
@@ -76,6 +76,16 @@ class MomentInvariants2D
      */
     DoubleMatrixType computeMomentInvariants(DoubleMatrixType &input, size_t* inputDims, size_t max_order);
 
+    /**
+     * @brief computeCentralMoments Normalizes the raw moments bigX^T * input * bigX of a dim x dim input and
+     * converts them to central moments. This lets callers accumulate the raw moments directly from their own data.
+     * @param mnk The raw moments; normalized in place
+     * @param dim
+     * @param max_order
+     * @return
+     */
+    DoubleMatrixType computeCentralMoments(DoubleMatrixType& mnk, size_t dim, size_t max_order);
+
 #if 0
     /**
      * @brief binomial
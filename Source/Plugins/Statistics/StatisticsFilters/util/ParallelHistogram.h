@@ -0,0 +1,361 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+/**
+ * @brief The ParallelHistogram class counts the elements of a flat array into bins in parallel. The elements are
+ * split into slabs that each count into their own table, and the tables are added together afterwards, so the counts
+ * are exact and do not depend on the thread schedule. Integer arrays whose values span a small range are first
+ * counted per value, and each distinct value is then binned once. Multi component arrays are binned in one pass by
+ * passing the range of all of their elements.
+ */
+template <typename T>
+class ParallelHistogram
+{
+public:
+  static const size_t k_MaxTableBytes = 256 * 1024 * 1024;
+  static const size_t k_MinSlabElements = 64 * 1024;
+  static const uint64_t k_MaxDirectValues = 64 * 1024;
+
+  /**
+   * @brief FindRange Finds the smallest and largest value of [start, end). NaN values are skipped. If there are no
+   * values, min stays at the largest and max at the lowest value of T.
+   */
+  static void FindRange(const T* values, size_t start, size_t end, T& min, T& max)
+  {
+    size_t numSlabs = NumSlabs(end - start, 0);
+    std::vector<SlabRange> ranges(numSlabs);
+    RangeImpl impl(values, start, end, ranges);
+    Run(impl, numSlabs);
+
+    min = std::numeric_limits<T>::max();
+    max = std::numeric_limits<T>::lowest();
+    for(const SlabRange& range : ranges)
+    {
+      min = std::min(min, range.min);
+      max = std::max(max, range.max);
+    }
+  }
+
+  /**
+   * @brief CountSlots Counts the elements of [start, end) into numSlots slots
+   * @param slotOf Returns the slot of an element index, or a negative value if the element is not counted
+   * @param counts Resized to numSlots and filled with the counts
+   * @return The number of elements that were not counted
+   */
+  template <typename SlotFunction>
+  static uint64_t CountSlots(size_t start, size_t end, size_t numSlots, const SlotFunction& slotOf, std::vector<uint64_t>& counts)
+  {
+    size_t numSlabs = NumSlabs(end - start, numSlots * sizeof(uint64_t));
+    std::vector<std::vector<uint64_t>> tables(numSlabs);
+    std::vector<uint64_t> skipped(numSlabs, 0);
+    CountImpl<SlotFunction> impl(slotOf, start, end, numSlots, tables, skipped);
+    Run(impl, numSlabs);
+
+    counts.assign(numSlots, 0);
+    uint64_t notCounted = 0;
+    for(size_t s = 0; s < numSlabs; s++)
+    {
+      for(size_t b = 0; b < numSlots; b++)
+      {
+        counts[b] += tables[s][b];
+      }
+      notCounted += skipped[s];
+    }
+    return notCounted;
+  }
+
+  /**
+   * @brief CountValues Counts the values of [start, end) into numBins bins. All values must lie in [min, max]; for
+   * integer types the direct per value path is taken when that range is small, so passing the full range of T is
+   * enough for 8 and 16 bit types.
+   * @param binOf Returns the bin of a value, or a negative value if the value does not fall into any bin
+   * @param counts Resized to numBins and filled with the counts
+   * @return The number of values that did not fall into any bin
+   */
+  template <typename BinFunction>
+  static uint64_t CountValues(const T* values, size_t start, size_t end, T min, T max, size_t numBins, const BinFunction& binOf, std::vector<uint64_t>& counts)
+  {
+    uint64_t span = k_MaxDirectValues;
+    if(std::is_integral<T>::value && !(max < min))
+    {
+      span = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+    }
+    if(span >= k_MaxDirectValues)
+    {
+      return CountSlots(start, end, numBins, ValueSlot<BinFunction>(values, binOf), counts);
+    }
+
+    std::vector<uint64_t> valueCounts;
+    CountSlots(start, end, static_cast<size_t>(span + 1), ValueOffset(values, min), valueCounts);
+
+    counts.assign(numBins, 0);
+    uint64_t notCounted = 0;
+    for(size_t v = 0; v < valueCounts.size(); v++)
+    {
+      if(valueCounts[v] == 0)
+      {
+        continue;
+      }
+      int64_t bin = binOf(static_cast<T>(static_cast<uint64_t>(min) + v));
+      if(bin >= 0 && static_cast<size_t>(bin) < numBins)
+      {
+        counts[bin] += valueCounts[v];
+      }
+      else
+      {
+        notCounted += valueCounts[v];
+      }
+    }
+    return notCounted;
+  }
+
+private:
+  /**
+   * @brief The SlabRange struct holds the smallest and largest value of one slab. It is a struct rather than two
+   * vectors so that std::vector<bool> never packs the results of different slabs into the same word.
+   */
+  struct SlabRange
+  {
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::lowest();
+  };
+
+  /**
+   * @brief NumSlabs Splits numElements into slabs of at least k_MinSlabElements, using fewer slabs when the per slab
+   * tables would get large
+   */
+  static size_t NumSlabs(size_t numElements, size_t tableBytes)
+  {
+    size_t numSlabs = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    numSlabs = std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1)) * 4;
+#endif
+    if(tableBytes > 0)
+    {
+      numSlabs = std::min(numSlabs, k_MaxTableBytes / tableBytes);
+    }
+    numSlabs = std::min(numSlabs, numElements / k_MinSlabElements);
+    return std::max(numSlabs, static_cast<size_t>(1));
+  }
+
+  template <typename Impl>
+  static void Run(const Impl& impl, size_t numSlabs)
+  {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(numSlabs > 1)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), impl, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(0, numSlabs);
+    }
+  }
+
+  /**
+   * @brief The ValueSlot class bins an element by its value
+   */
+  template <typename BinFunction>
+  class ValueSlot
+  {
+  public:
+    ValueSlot(const T* values, const BinFunction& binOf)
+    : m_Values(values)
+    , m_BinOf(binOf)
+    {
+    }
+
+    int64_t operator()(size_t index) const
+    {
+      return m_BinOf(m_Values[index]);
+    }
+
+  private:
+    const T* m_Values;
+    const BinFunction& m_BinOf;
+  };
+
+  /**
+   * @brief The ValueOffset class maps an integer element to its offset from the smallest value
+   */
+  class ValueOffset
+  {
+  public:
+    ValueOffset(const T* values, T min)
+    : m_Values(values)
+    , m_Min(static_cast<uint64_t>(min))
+    {
+    }
+
+    int64_t operator()(size_t index) const
+    {
+      return static_cast<int64_t>(static_cast<uint64_t>(m_Values[index]) - m_Min);
+    }
+
+  private:
+    const T* m_Values;
+    uint64_t m_Min;
+  };
+
+  /**
+   * @brief The RangeImpl class finds the smallest and largest value of each slab
+   */
+  class RangeImpl
+  {
+  public:
+    RangeImpl(const T* values, size_t start, size_t end, std::vector<SlabRange>& ranges)
+    : m_Values(values)
+    , m_Start(start)
+    , m_End(end)
+    , m_Ranges(ranges)
+    {
+    }
+    virtual ~RangeImpl() = default;
+
+    void convert(size_t start, size_t end) const
+    {
+      size_t numElements = m_End - m_Start;
+      size_t numSlabs = m_Ranges.size();
+      for(size_t s = start; s < end; s++)
+      {
+        T min = std::numeric_limits<T>::max();
+        T max = std::numeric_limits<T>::lowest();
+        size_t last = m_Start + numElements * (s + 1) / numSlabs;
+        for(size_t i = m_Start + numElements * s / numSlabs; i < last; i++)
+        {
+          if(m_Values[i] < min)
+          {
+            min = m_Values[i];
+          }
+          if(m_Values[i] > max)
+          {
+            max = m_Values[i];
+          }
+        }
+        m_Ranges[s].min = min;
+        m_Ranges[s].max = max;
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const T* m_Values;
+    size_t m_Start;
+    size_t m_End;
+    std::vector<SlabRange>& m_Ranges;
+  };
+
+  /**
+   * @brief The CountImpl class counts the elements of each slab into the slab's own table
+   */
+  template <typename SlotFunction>
+  class CountImpl
+  {
+  public:
+    CountImpl(const SlotFunction& slotOf, size_t start, size_t end, size_t numSlots, std::vector<std::vector<uint64_t>>& tables, std::vector<uint64_t>& skipped)
+    : m_SlotOf(slotOf)
+    , m_Start(start)
+    , m_End(end)
+    , m_NumSlots(numSlots)
+    , m_Tables(tables)
+    , m_Skipped(skipped)
+    {
+    }
+    virtual ~CountImpl() = default;
+
+    void convert(size_t start, size_t end) const
+    {
+      size_t numElements = m_End - m_Start;
+      size_t numSlabs = m_Tables.size();
+      for(size_t s = start; s < end; s++)
+      {
+        std::vector<uint64_t>& table = m_Tables[s];
+        table.assign(m_NumSlots, 0);
+        uint64_t skipped = 0;
+        size_t last = m_Start + numElements * (s + 1) / numSlabs;
+        for(size_t i = m_Start + numElements * s / numSlabs; i < last; i++)
+        {
+          int64_t slot = m_SlotOf(i);
+          if(slot >= 0 && static_cast<size_t>(slot) < m_NumSlots)
+          {
+            table[slot]++;
+          }
+          else
+          {
+            skipped++;
+          }
+        }
+        m_Skipped[s] = skipped;
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const SlotFunction& m_SlotOf;
+    size_t m_Start;
+    size_t m_End;
+    size_t m_NumSlots;
+    std::vector<std::vector<uint64_t>>& m_Tables;
+    std::vector<uint64_t>& m_Skipped;
+  };
+};
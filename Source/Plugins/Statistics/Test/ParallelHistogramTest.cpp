@@ -0,0 +1,309 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+#include "Statistics/StatisticsFilters/util/ParallelHistogram.h"
+
+class ParallelHistogramTest
+{
+public:
+  ParallelHistogramTest() = default;
+  virtual ~ParallelHistogramTest() = default;
+
+  /**
+   * @brief Returns the name of the class for ParallelHistogramTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("ParallelHistogramTest");
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  std::vector<T> MakeValues(std::mt19937_64& generator, size_t numValues, double low, double high)
+  {
+    std::vector<T> values(numValues);
+    if(std::is_integral<T>::value)
+    {
+      std::uniform_int_distribution<int64_t> distribution(static_cast<int64_t>(low), static_cast<int64_t>(high));
+      for(T& value : values)
+      {
+        value = static_cast<T>(distribution(generator));
+      }
+    }
+    else
+    {
+      std::uniform_real_distribution<double> distribution(low, high);
+      for(T& value : values)
+      {
+        value = static_cast<T>(distribution(generator));
+      }
+    }
+    return values;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Compares CalculateArrayHistogram's parallel path with its former serial loops, with the
+  // range taken from the data and with a user range that leaves values outside
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void CompareWithSerialHistogram(const std::vector<T>& values, int32_t numberOfBins, bool userRange, float minRange, float maxRange)
+  {
+    const T* inputArrayPtr = values.data();
+    size_t numPoints = values.size();
+
+    // Serial
+    float min = std::numeric_limits<float>::max();
+    float max = -1.0 * std::numeric_limits<float>::max();
+    if(userRange)
+    {
+      min = minRange;
+      max = maxRange;
+    }
+    else
+    {
+      for(size_t i = 0; i < numPoints; i++)
+      {
+        if(static_cast<float>(inputArrayPtr[i]) > max)
+        {
+          max = static_cast<float>(inputArrayPtr[i]);
+        }
+        if(static_cast<float>(inputArrayPtr[i]) < min)
+        {
+          min = static_cast<float>(inputArrayPtr[i]);
+        }
+      }
+    }
+    float increment = (max - min) / (numberOfBins);
+    std::vector<double> serialCounts(numberOfBins, 0.0);
+    int serialOverflow = 0;
+    int32_t bin = 0;
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      bin = size_t((inputArrayPtr[i] - min) / increment);
+      if((bin >= 0) && (bin < numberOfBins))
+      {
+        serialCounts[bin]++;
+      }
+      else
+      {
+        serialOverflow++;
+      }
+    }
+
+    // Parallel
+    float parallelMin = std::numeric_limits<float>::max();
+    float parallelMax = -1.0 * std::numeric_limits<float>::max();
+    T minValue = std::numeric_limits<T>::lowest();
+    T maxValue = std::numeric_limits<T>::max();
+    if(userRange)
+    {
+      parallelMin = minRange;
+      parallelMax = maxRange;
+    }
+    else
+    {
+      ParallelHistogram<T>::FindRange(inputArrayPtr, 0, numPoints, minValue, maxValue);
+      if(!(maxValue < minValue))
+      {
+        parallelMin = std::min(parallelMin, static_cast<float>(minValue));
+        parallelMax = std::max(parallelMax, static_cast<float>(maxValue));
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(parallelMin, min)
+    DREAM3D_REQUIRE_EQUAL(parallelMax, max)
+
+    auto binOf = [min, increment, numberOfBins](T value) -> int64_t {
+      int32_t bin = size_t((value - min) / increment);
+      if((bin >= 0) && (bin < numberOfBins))
+      {
+        return bin;
+      }
+      return -1;
+    };
+    std::vector<uint64_t> counts;
+    int overflow = static_cast<int>(ParallelHistogram<T>::CountValues(inputArrayPtr, 0, numPoints, minValue, maxValue, numberOfBins, binOf, counts));
+
+    DREAM3D_REQUIRE_EQUAL(overflow, serialOverflow)
+    DREAM3D_REQUIRE_EQUAL(counts.size(), static_cast<size_t>(numberOfBins))
+    for(int32_t i = 0; i < numberOfBins; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(static_cast<double>(counts[i]), serialCounts[i])
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void CompareType(std::mt19937_64& generator, double low, double high)
+  {
+    // Large enough to be split into several slabs
+    const size_t numValues = 20 * ParallelHistogram<T>::k_MinSlabElements + 17;
+    std::vector<T> values = MakeValues<T>(generator, numValues, low, high);
+    for(int32_t numberOfBins : {2, 7, 256})
+    {
+      CompareWithSerialHistogram(values, numberOfBins, false, 0.0f, 0.0f);
+      CompareWithSerialHistogram(values, numberOfBins, true, static_cast<float>(low + (high - low) / 4.0), static_cast<float>(high - (high - low) / 3.0));
+    }
+    // A short array stays in a single slab
+    std::vector<T> shortValues(values.begin(), values.begin() + 1000);
+    CompareWithSerialHistogram(shortValues, 10, false, 0.0f, 0.0f);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestCalculateArrayHistogram()
+  {
+    std::mt19937_64 generator(112358);
+    CompareType<int8_t>(generator, -128.0, 127.0);
+    CompareType<uint8_t>(generator, 10.0, 200.0);
+    CompareType<int16_t>(generator, -30000.0, 30000.0);
+    CompareType<uint16_t>(generator, 0.0, 1000.0);
+    CompareType<int32_t>(generator, -50.0, 5000.0);
+    CompareType<int32_t>(generator, -2000000000.0, 2000000000.0);
+    CompareType<uint32_t>(generator, 0.0, 4000000000.0);
+    CompareType<int64_t>(generator, -1.0E12, 1.0E12);
+    CompareType<float>(generator, -3.5, 12.25);
+    CompareType<double>(generator, 0.0, 1.0E-3);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFindRange()
+  {
+    std::mt19937_64 generator(314159);
+    std::vector<float> values = MakeValues<float>(generator, 10 * ParallelHistogram<float>::k_MinSlabElements, -1.0, 1.0);
+    values[12345] = std::numeric_limits<float>::quiet_NaN();
+    values[577777] = 5.0f;
+    values[3] = -7.0f;
+
+    // Sub ranges skip the first element, as FindFeatureHistogram does for Feature 0
+    float min = 0.0f;
+    float max = 0.0f;
+    ParallelHistogram<float>::FindRange(values.data(), 1, values.size(), min, max);
+    float serialMin = std::numeric_limits<float>::max();
+    float serialMax = std::numeric_limits<float>::lowest();
+    for(size_t i = 1; i < values.size(); i++)
+    {
+      serialMin = (values[i] < serialMin) ? values[i] : serialMin;
+      serialMax = (values[i] > serialMax) ? values[i] : serialMax;
+    }
+    DREAM3D_REQUIRE_EQUAL(min, -7.0f)
+    DREAM3D_REQUIRE_EQUAL(max, 5.0f)
+    DREAM3D_REQUIRE_EQUAL(min, serialMin)
+    DREAM3D_REQUIRE_EQUAL(max, serialMax)
+
+    // No values
+    ParallelHistogram<float>::FindRange(values.data(), 5, 5, min, max);
+    DREAM3D_REQUIRE_EQUAL(min, std::numeric_limits<float>::max())
+    DREAM3D_REQUIRE_EQUAL(max, std::numeric_limits<float>::lowest())
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // FindFeatureHistogram counts Features per ensemble and skips ids outside the ensembles
+  // -----------------------------------------------------------------------------
+  int TestCountSlots()
+  {
+    std::mt19937_64 generator(271828);
+    const size_t numFeatures = 9 * ParallelHistogram<int32_t>::k_MinSlabElements + 5;
+    const size_t numEnsembles = 6;
+    std::vector<int32_t> ensembles = MakeValues<int32_t>(generator, numFeatures, -1.0, 7.0);
+
+    auto slotOf = [&ensembles, numEnsembles](size_t index) -> int64_t {
+      int32_t ensemble = ensembles[index];
+      if(ensemble < 0 || static_cast<size_t>(ensemble) >= numEnsembles)
+      {
+        return -1;
+      }
+      return ensemble;
+    };
+    std::vector<uint64_t> counts;
+    uint64_t notCounted = ParallelHistogram<int32_t>::CountSlots(1, numFeatures, numEnsembles, slotOf, counts);
+
+    std::vector<uint64_t> serialCounts(numEnsembles, 0);
+    uint64_t serialNotCounted = 0;
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      if(ensembles[i] >= 0 && static_cast<size_t>(ensembles[i]) < numEnsembles)
+      {
+        serialCounts[ensembles[i]]++;
+      }
+      else
+      {
+        serialNotCounted++;
+      }
+    }
+    DREAM3D_REQUIRE(counts == serialCounts)
+    DREAM3D_REQUIRE_EQUAL(notCounted, serialNotCounted)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start " << getNameOfClass().toStdString() << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFindRange())
+    DREAM3D_REGISTER_TEST(TestCountSlots())
+    DREAM3D_REGISTER_TEST(TestCalculateArrayHistogram())
+  }
+
+private:
+  ParallelHistogramTest(const ParallelHistogramTest&); // Copy Constructor Not Implemented
+  void operator=(const ParallelHistogramTest&);        // Move assignment Not Implemented
+};
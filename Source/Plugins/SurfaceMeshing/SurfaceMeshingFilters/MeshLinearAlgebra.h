@@ -43,10 +43,20 @@
 
 // LinearAlgebra.h
 #pragma once
+#include<algorithm>
+#include<utility>
 #include<vector>
 #include<cmath>
 #include<iostream>
 
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 
 namespace MFE
 {
@@ -401,6 +411,203 @@ namespace MFE
     return norm;
   }
 
+  /**
+   * @brief The CSRMatrix class stores a sparse matrix in compressed sparse row form. The sparsity
+   * pattern is fixed when the matrix is created; only the values change afterwards, so a matrix that is
+   * reassembled every step keeps its storage and entries are found with a binary search of the row.
+   */
+  template<typename vtype = double>
+  class CSRMatrix
+  {
+    public:
+      /**
+       * @brief CSRMatrix
+       * @param m Number of rows
+       * @param n Number of columns
+       * @param rowStart m + 1 offsets into columns
+       * @param columns Column index of every entry, sorted within each row
+       */
+      CSRMatrix(int m, int n, std::vector<size_t> rowStart, std::vector<int> columns)
+      : d1(m)
+      , d2(n)
+      , start(std::move(rowStart))
+      , column(std::move(columns))
+      {
+        data.assign(column.size(), 0.0);
+      }
+      /**
+       * @brief Returns the entry at (i, j), which must be part of the sparsity pattern
+       */
+      vtype& operator()(int i, int j)
+      {
+        return data[find(i, j)];
+      }
+      vtype operator()(int i, int j) const
+      {
+        size_t k = find(i, j);
+        return k < data.size() ? data[k] : 0.0;
+      }
+      /**
+       * @brief Returns the position of entry (i, j) in the value storage, or the number of entries if (i, j) is not part of the pattern
+       */
+      size_t find(int i, int j) const
+      {
+        auto begin = column.begin() + start[i];
+        auto end = column.begin() + start[i + 1];
+        auto it = std::lower_bound(begin, end, j);
+        if(it == end || *it != j) { return data.size(); }
+        return static_cast<size_t>(it - column.begin());
+      }
+      size_t rowBegin(int i) const
+      {
+        return start[i];
+      }
+      size_t rowEnd(int i) const
+      {
+        return start[i + 1];
+      }
+      int index(size_t k) const
+      {
+        return column[k];
+      }
+      vtype value(size_t k) const
+      {
+        return data[k];
+      }
+      void zero()
+      {
+        std::fill(data.begin(), data.end(), 0.0);
+      }
+      void multiply(const Vector<vtype>& x, Vector<vtype>& b) const;
+      Vector<vtype> operator*(const Vector<vtype>& x) const
+      {
+        Vector<vtype> b(d1);
+        multiply(x, b);
+        return b;
+      }
+      int dimension1() const
+      {
+        return d1;
+      }
+      int dimension2() const
+      {
+        return d2;
+      }
+    private:
+      int d1;
+      int d2;
+      std::vector<size_t> start;
+      std::vector<int> column;
+      std::vector<vtype> data;
+  };
+
+  /**
+   * @brief The CSRMultiplyImpl class computes rows of b = A * x
+   */
+  template<typename vtype>
+  class CSRMultiplyImpl
+  {
+    public:
+      CSRMultiplyImpl(const CSRMatrix<vtype>& A, const Vector<vtype>& x, Vector<vtype>& b)
+      : m_A(A)
+      , m_X(x)
+      , m_B(b)
+      {
+      }
+      virtual ~CSRMultiplyImpl() = default;
+
+      void compute(size_t start, size_t end) const
+      {
+        for (size_t i = start; i < end; i++)
+        {
+          vtype sum = 0.0;
+          for (size_t k = m_A.rowBegin(i); k < m_A.rowEnd(i); k++)
+          { sum += m_A.value(k) * m_X[m_A.index(k)]; }
+          m_B[i] = sum;
+        }
+      }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        compute(r.begin(), r.end());
+      }
+#endif
+    private:
+      const CSRMatrix<vtype>& m_A;
+      const Vector<vtype>& m_X;
+      Vector<vtype>& m_B;
+  };
+
+  template<typename vtype>
+  void CSRMatrix<vtype>::multiply(const Vector<vtype>& x, Vector<vtype>& b) const
+  {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, d1), CSRMultiplyImpl<vtype>(*this, x, b), tbb::auto_partitioner());
+#else
+    CSRMultiplyImpl<vtype>(*this, x, b).compute(0, d1);
+#endif
+  }
+
+  /**
+   * @brief The BlockInnerImpl class computes the inner product of each fixed size block of two vectors.
+   * Summing the block results in order keeps the result independent of the number of threads.
+   */
+  template<typename vtype>
+  class BlockInnerImpl
+  {
+    public:
+      static const int k_BlockSize = 4096;
+
+      BlockInnerImpl(const Vector<vtype>& x, const Vector<vtype>& y, std::vector<vtype>& blockSums)
+      : m_X(x)
+      , m_Y(y)
+      , m_BlockSums(blockSums)
+      {
+      }
+      virtual ~BlockInnerImpl() = default;
+
+      void compute(size_t startBlock, size_t endBlock) const
+      {
+        int n = m_X.dimension();
+        for (size_t block = startBlock; block < endBlock; block++)
+        {
+          int end = std::min(n, static_cast<int>(block + 1) * k_BlockSize);
+          vtype sum = 0.0;
+          for (int i = static_cast<int>(block) * k_BlockSize; i < end; i++)
+          { sum += m_X[i] * m_Y[i]; }
+          m_BlockSums[block] = sum;
+        }
+      }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        compute(r.begin(), r.end());
+      }
+#endif
+    private:
+      const Vector<vtype>& m_X;
+      const Vector<vtype>& m_Y;
+      std::vector<vtype>& m_BlockSums;
+  };
+
+  template<typename vtype>
+  vtype parallelInner(const Vector<vtype>& x, const Vector<vtype>& y)
+  {
+    size_t numBlocks = (x.dimension() + BlockInnerImpl<vtype>::k_BlockSize - 1) / BlockInnerImpl<vtype>::k_BlockSize;
+    std::vector<vtype> blockSums(numBlocks, 0.0);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), BlockInnerImpl<vtype>(x, y, blockSums), tbb::auto_partitioner());
+#else
+    BlockInnerImpl<vtype>(x, y, blockSums).compute(0, numBlocks);
+#endif
+    vtype sum = 0.0;
+    for (const auto& blockSum : blockSums)
+    { sum += blockSum; }
+    return sum;
+  }
+
 // Iterative solution methods
 
   template<typename matrix, typename vector, typename type>
@@ -486,6 +693,61 @@ namespace MFE
     return -1;
   }
 
+  template<typename vtype>
+  int PCG(const CSRMatrix<vtype>& A, Vector<vtype>& x, const Vector<vtype>& b, int max, vtype tolerance)
+  {
+    // Jacobi preconditioned conjugate gradient algorithm
+    // Use for solving symmetric positive definite linear systems; x holds the starting guess
+    int n = x.dimension();
+    Vector<vtype> r(n), z(n), p(n), q(n), invDiag(n);
+
+    A.multiply(x, q);
+    for (int i = 0; i < n; i++)
+    {
+      r[i] = b[i] - q[i];
+      vtype diag = A(i, i);
+      invDiag[i] = (diag != 0.0) ? 1.0 / diag : 1.0;
+    }
+    vtype bnorm = sqrt(parallelInner(b, b));
+    vtype rnorm = sqrt(parallelInner(r, r));
+    if(bnorm == 0.0)
+    {
+      x = 0.0;
+      return 0;
+    }
+    if((rnorm / bnorm) <= tolerance) { return 0; }
+
+    for (int i = 0; i < n; i++)
+    {
+      z[i] = invDiag[i] * r[i];
+      p[i] = z[i];
+    }
+    vtype rz = parallelInner(r, z);
+
+    for (int iteration = 1; iteration <= max; iteration++)
+    {
+      A.multiply(p, q);
+      vtype alpha = rz / parallelInner(p, q);
+      for (int i = 0; i < n; i++)
+      {
+        x[i] += alpha * p[i];
+        r[i] -= alpha * q[i];
+      }
+      rnorm = sqrt(parallelInner(r, r));
+      if(rnorm / bnorm < tolerance) { return iteration; }
+
+      for (int i = 0; i < n; i++)
+      { z[i] = invDiag[i] * r[i]; }
+      vtype rz1 = parallelInner(r, z);
+      vtype beta = rz1 / rz;
+      rz = rz1;
+      for (int i = 0; i < n; i++)
+      { p[i] = z[i] + beta * p[i]; }
+    }
+
+    return -1;
+  }
+
   template<typename matrix, typename vector, typename type>
   int GMRES(const matrix& A, vector& x, const vector& b, int m, int max, type tolerance)
   {
@@ -53,8 +53,10 @@
 
 #include "MovingFiniteElementSmoothing.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <limits>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -96,6 +98,59 @@ inline int delta(int i, int j)
   return (i == j);
 }
 
+// -----------------------------------------------------------------------------
+//  Builds the sparsity pattern of the 3N x 3N stiffness matrix: the three rows of a node
+//  hold the three columns of every node that shares a triangle with it (and its own).
+// -----------------------------------------------------------------------------
+MFE::CSRMatrix<double> CreateStiffnessMatrix(const FaceArray::Face_t* triangles, int ntri, int numberNodes)
+{
+  std::vector<std::vector<int>> nodeNeighbors(numberNodes);
+  for(int r = 0; r < numberNodes; r++)
+  {
+    nodeNeighbors[r].push_back(r);
+  }
+  for(int t = 0; t < ntri; t++)
+  {
+    for(int n0 = 0; n0 < 3; n0++)
+    {
+      for(int n1 = 0; n1 < 3; n1++)
+      {
+        nodeNeighbors[triangles[t].verts[n0]].push_back(static_cast<int>(triangles[t].verts[n1]));
+      }
+    }
+  }
+
+  std::vector<size_t> rowStart(3 * numberNodes + 1, 0);
+  for(int r = 0; r < numberNodes; r++)
+  {
+    std::vector<int>& neighbors = nodeNeighbors[r];
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    for(int s = 0; s < 3; s++)
+    {
+      rowStart[3 * r + s + 1] = rowStart[3 * r + s] + 3 * neighbors.size();
+    }
+  }
+
+  std::vector<int> columns(rowStart.back());
+  for(int r = 0; r < numberNodes; r++)
+  {
+    for(int s = 0; s < 3; s++)
+    {
+      size_t k = rowStart[3 * r + s];
+      for(const auto& neighbor : nodeNeighbors[r])
+      {
+        columns[k++] = 3 * neighbor;
+        columns[k++] = 3 * neighbor + 1;
+        columns[k++] = 3 * neighbor + 2;
+      }
+    }
+    std::vector<int>().swap(nodeNeighbors[r]);
+  }
+
+  return MFE::CSRMatrix<double>(3 * numberNodes, 3 * numberNodes, std::move(rowStart), std::move(columns));
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -632,7 +687,8 @@ void MovingFiniteElementSmoothing::execute()
   // Allocate vectors and matricies
   int n_size = 3 * numberNodes;
   MFE::Vector<double> x(n_size), F(n_size);
-  MFE::SMatrix<double> K(n_size, n_size);
+  // The mesh connectivity does not change between updates so the sparsity pattern is built once
+  MFE::CSRMatrix<double> K = CreateStiffnessMatrix(triangles, ntri, numberNodes);
 
   // Allocate constants for solving linear equations
   const double epsilon = 1.0; // change this if quality force too
@@ -819,7 +875,7 @@ void MovingFiniteElementSmoothing::execute()
           {
             for(int j = 0; j < 3; j++)
             {
-              K[3 * h + k][3 * i + j] += one12th * (1.0 + delta(i, h)) * n[j] * n[k] * A;
+              K(3 * h + k, 3 * i + j) += one12th * (1.0 + delta(i, h)) * n[j] * n[k] * A;
             }
           }
         }
@@ -830,7 +886,7 @@ void MovingFiniteElementSmoothing::execute()
     {
       for(int s = 0; s < 3; s++)
       {
-        K[3 * r + s][3 * r + s] += epsilon;
+        K(3 * r + s, 3 * r + s) += epsilon;
       }
     }
 
@@ -842,22 +898,23 @@ void MovingFiniteElementSmoothing::execute()
         // only do this if we want the constraint
         if(nodeConstraint[r] % 2 != 0)
         {
-          K[3 * r][3 * r] = large;
+          K(3 * r, 3 * r) = large;
         } // X
         if((nodeConstraint[r] / 2) % 2 != 0)
         {
-          K[3 * r + 1][3 * r + 1] = large;
+          K(3 * r + 1, 3 * r + 1) = large;
         } // Y
         if(nodeConstraint[r] / 4 != 0)
         {
-          K[3 * r + 2][3 * r + 2] = large;
+          K(3 * r + 2, 3 * r + 2) = large;
         } // Z
         //  changed  12 v 10, ADR
       }
     }
 
     // solve for node velocities
-    int iterations = MFE::CR(K, x, F, 4000, 1.0e-5);
+    // K is symmetric positive definite; x still holds the previous update's velocities as the starting guess
+    int iterations = MFE::PCG(K, x, F, 4000, 1.0e-5);
     if(isVerbose)
     {
       qDebug() << iterations << " iterations ... "
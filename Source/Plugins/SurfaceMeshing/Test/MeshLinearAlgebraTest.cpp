@@ -0,0 +1,204 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/MeshLinearAlgebra.h"
+
+class MeshLinearAlgebraTest
+{
+public:
+  MeshLinearAlgebraTest() = default;
+  virtual ~MeshLinearAlgebraTest() = default;
+
+  /**
+   * @brief Returns the name of the class for MeshLinearAlgebraTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("MeshLinearAlgebraTest");
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds the five point Laplacian of a dim x dim grid plus a random positive
+  // diagonal shift, which is symmetric positive definite and not constant along
+  // the diagonal, so the Jacobi preconditioner has something to do
+  // -----------------------------------------------------------------------------
+  MFE::CSRMatrix<double> CreateLaplacian(int dim, std::mt19937_64& generator)
+  {
+    int n = dim * dim;
+    std::vector<size_t> rowStart(1, 0);
+    std::vector<int> columns;
+    for(int i = 0; i < n; i++)
+    {
+      int x = i % dim;
+      int y = i / dim;
+      if(y > 0)
+      {
+        columns.push_back(i - dim);
+      }
+      if(x > 0)
+      {
+        columns.push_back(i - 1);
+      }
+      columns.push_back(i);
+      if(x < dim - 1)
+      {
+        columns.push_back(i + 1);
+      }
+      if(y < dim - 1)
+      {
+        columns.push_back(i + dim);
+      }
+      rowStart.push_back(columns.size());
+    }
+
+    std::uniform_real_distribution<double> shift(0.01, 10.0);
+    MFE::CSRMatrix<double> A(n, n, rowStart, columns);
+    for(int i = 0; i < n; i++)
+    {
+      for(size_t k = A.rowBegin(i); k < A.rowEnd(i); k++)
+      {
+        int j = A.index(k);
+        A(i, j) = (i == j) ? 4.0 + shift(generator) : -1.0;
+      }
+    }
+    return A;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestCSRMatrix()
+  {
+    std::vector<size_t> rowStart = {0, 2, 3, 5};
+    std::vector<int> columns = {0, 2, 1, 0, 2};
+    MFE::CSRMatrix<double> A(3, 3, rowStart, columns);
+    A(0, 0) = 2.0;
+    A(0, 2) = -1.0;
+    A(1, 1) = 3.0;
+    A(2, 0) = -1.0;
+    A(2, 2) = 4.0;
+
+    const MFE::CSRMatrix<double>& constA = A;
+    DREAM3D_REQUIRE_EQUAL(constA(0, 2), -1.0)
+    DREAM3D_REQUIRE_EQUAL(constA(0, 1), 0.0)
+    DREAM3D_REQUIRE_EQUAL(constA(1, 0), 0.0)
+    DREAM3D_REQUIRE_EQUAL(A.find(1, 2), columns.size())
+
+    MFE::Vector<double> x(3);
+    x[0] = 1.0;
+    x[1] = 2.0;
+    x[2] = 3.0;
+    MFE::Vector<double> b = A * x;
+    DREAM3D_REQUIRE_EQUAL(b[0], -1.0)
+    DREAM3D_REQUIRE_EQUAL(b[1], 6.0)
+    DREAM3D_REQUIRE_EQUAL(b[2], 11.0)
+
+    A.zero();
+    DREAM3D_REQUIRE_EQUAL(constA(2, 2), 0.0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestPCG()
+  {
+    std::mt19937_64 generator(12345);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    // 10000 unknowns span several inner product blocks
+    const int dim = 100;
+    MFE::CSRMatrix<double> A = CreateLaplacian(dim, generator);
+    int n = A.dimension1();
+
+    MFE::Vector<double> expected(n);
+    for(int i = 0; i < n; i++)
+    {
+      expected[i] = distribution(generator);
+    }
+    MFE::Vector<double> b = A * expected;
+
+    MFE::Vector<double> x(n);
+    int iterations = MFE::PCG(A, x, b, 1000, 1.0E-12);
+    DREAM3D_REQUIRED(iterations, >, 0)
+
+    MFE::Vector<double> residual = b - A * x;
+    DREAM3D_REQUIRED(MFE::norm(residual), <=, 1.0E-10 * MFE::norm(b))
+    for(int i = 0; i < n; i++)
+    {
+      DREAM3D_REQUIRED(std::fabs(x[i] - expected[i]), <, 1.0E-8)
+    }
+
+    // A starting guess that already solves the system needs no iterations
+    DREAM3D_REQUIRE_EQUAL(MFE::PCG(A, expected, b, 1000, 1.0E-12), 0)
+
+    // A zero right hand side has the zero solution
+    MFE::Vector<double> zero(n);
+    x = 1.0;
+    DREAM3D_REQUIRE_EQUAL(MFE::PCG(A, x, zero, 1000, 1.0E-12), 0)
+    DREAM3D_REQUIRE_EQUAL(MFE::inorm(x), 0.0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start " << getNameOfClass().toStdString() << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestCSRMatrix())
+    DREAM3D_REGISTER_TEST(TestPCG())
+  }
+
+private:
+  MeshLinearAlgebraTest(const MeshLinearAlgebraTest&); // Copy Constructor Not Implemented
+  void operator=(const MeshLinearAlgebraTest&);        // Move assignment Not Implemented
+};
@@ -38,6 +38,7 @@
 #include "InsertPrecipitatePhases.h"
 
 #include <memory>
+#include <array>
 #include <fstream>
 #include <random>
 #include <chrono>
@@ -75,6 +76,7 @@
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/FrontierGapFill.h"
 namespace
 {
 OrthoRhombicOps::Pointer m_OrthoOps;
@@ -128,7 +130,6 @@ InsertPrecipitatePhases::InsertPrecipitatePhases()
 , m_NumFeaturesArrayPath(SIMPL::Defaults::SyntheticVolumeDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::NumFeatures)
 , m_SaveGeometricDescriptions(0)
 , m_NewAttributeMatrixPath(SIMPL::Defaults::SyntheticVolumeDataContainerName, PrecipitateSyntheticShapeParametersName, "")
-, m_Neighbors(nullptr)
 {
 
   initialize();
@@ -362,7 +363,6 @@ void InsertPrecipitatePhases::initialize()
   m_SuperEllipsoidOps = ShapeOps::NullPointer();
   ::m_OrthoOps = OrthoRhombicOps::New();
 
-  m_Neighbors = nullptr;
   m_StatsDataArray = StatsDataArray::NullPointer();
 
   m_ColumnList.clear();
@@ -2674,155 +2674,19 @@ void InsertPrecipitatePhases::assign_gaps()
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
 
-  int32_t featurename = 0, feature = 0;
-  int32_t current = 0;
-  int32_t most = 0;
-  int64_t gapVoxelCount = 1;
-  int32_t iterationCounter = 0;
-  int64_t neighpoint;
-  bool good = false;
-  int32_t neighbor = 0;
-
-  int64_t xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-  int64_t yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  int64_t zPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
-  size_t totalFeatures = m->getAttributeMatrix(getFeaturePhasesArrayPath().getAttributeMatrixName())->getNumberOfTuples();
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -xPoints * yPoints;
-  neighpoints[1] = -xPoints;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xPoints;
-  neighpoints[5] = xPoints * yPoints;
-
-  Int64ArrayType::Pointer neighborsPtr = Int64ArrayType::CreateArray(m->getGeometryAs<ImageGeom>()->getNumberOfElements(), "_INTERNAL_USE_ONLY_Neighbors", true);
-  neighborsPtr->initializeWithValue(-1);
-  m_Neighbors = neighborsPtr->getPointer(0);
-
-  std::vector<int32_t> n(totalFeatures + 1, 0);
+  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+  std::array<size_t, 3> dims = {{udims[0], udims[1], udims[2]}};
 
-  while(gapVoxelCount != 0)
+  // Only the gap voxels that touch an assigned Feature are visited in each cycle
+  FrontierGapFill gapFill(m_FeatureIds, dims);
+  int32_t iterationCounter = 0;
+  int64_t gapVoxelCount = gapFill.getRemainingGapCount();
+  while(gapFill.assignNextLayer())
   {
     iterationCounter++;
-    gapVoxelCount = 0;
-    int64_t zStride, yStride;
-    for(int64_t i = 0; i < zPoints; i++)
-    {
-      zStride = i * xPoints * yPoints;
-      for(int64_t j = 0; j < yPoints; j++)
-      {
-        yStride = j * xPoints;
-        for(int64_t k = 0; k < xPoints; k++)
-        {
-          featurename = m_FeatureIds[zStride + yStride + k];
-          if(featurename < 0)
-          {
-            gapVoxelCount++;
-            current = 0;
-            most = 0;
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = true;
-              neighpoint = zStride + yStride + k + neighpoints[l];
-              if(l == 0 && i == 0)
-              {
-                good = false;
-              }
-              if(l == 5 && i == (zPoints - 1))
-              {
-                good = false;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = false;
-              }
-              if(l == 4 && j == (yPoints - 1))
-              {
-                good = false;
-              }
-              if(l == 2 && k == 0)
-              {
-                good = false;
-              }
-              if(l == 3 && k == (xPoints - 1))
-              {
-                good = false;
-              }
-              if(good)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(feature > 0)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if(current > most)
-                  {
-                    most = current;
-                    m_Neighbors[zStride + yStride + k] = neighpoint;
-                  }
-                }
-              }
-            }
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = true;
-              neighpoint = zStride + yStride + k + neighpoints[l];
-              if(l == 0 && i == 0)
-              {
-                good = false;
-              }
-              if(l == 5 && i == (zPoints - 1))
-              {
-                good = false;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = false;
-              }
-              if(l == 4 && j == (yPoints - 1))
-              {
-                good = false;
-              }
-              if(l == 2 && k == 0)
-              {
-                good = false;
-              }
-              if(l == 3 && k == (xPoints - 1))
-              {
-                good = false;
-              }
-              if(good)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(feature > 0)
-                {
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      featurename = m_FeatureIds[j];
-      neighbor = m_Neighbors[j];
-      if(featurename < 0 && neighbor != -1 && m_FeatureIds[neighbor] > 0)
-      {
-        m_FeatureIds[j] = m_FeatureIds[neighbor];
-      }
-    }
-    if(iterationCounter >= 1)
-    {
-      QString ss = QObject::tr("Assign Gaps || Cycle#: %1 || Remaining "
-                               "Unassigned Voxel Count: %2")
-                       .arg(iterationCounter)
-                       .arg(gapVoxelCount);
-      notifyStatusMessage(ss);
-    }
+    QString ss = QObject::tr("Assign Gaps || Cycle#: %1 || Remaining Unassigned Voxel Count: %2").arg(iterationCounter).arg(gapVoxelCount);
+    notifyStatusMessage(ss);
+    gapVoxelCount = gapFill.getRemainingGapCount();
     if(getCancel())
     {
       return;
@@ -790,7 +790,6 @@ private:
   ShapeOps::Pointer m_EllipsoidOps;
   ShapeOps::Pointer m_SuperEllipsoidOps;
 
-  int64_t* m_Neighbors;
   StatsDataArray::WeakPointer m_StatsDataArray;
 
   std::vector<std::vector<int64_t>> m_ColumnList;
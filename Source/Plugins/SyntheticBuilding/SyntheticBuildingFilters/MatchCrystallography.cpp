@@ -35,10 +35,20 @@
 
 #include "MatchCrystallography.h"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
+#include <random>
 
 #include <QtCore/QTextStream>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -75,6 +85,140 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID33 = 33,
 };
 
+namespace
+{
+const size_t k_TrialBatchSize = 256;
+
+/**
+ * @brief The CrystallographyTrial struct holds one swap or switch trial along with the
+ * misorientation bin each boundary of the trial Features would move to if it is accepted.
+ * A bin of -1 marks a boundary that does not change.
+ */
+struct CrystallographyTrial
+{
+  bool switchOrientations = false;
+  int32_t feature1 = 0;
+  int32_t feature2 = -1;
+  int32_t newOdfBin = 0;
+  std::array<float, 3> newEulers = {{0.0f, 0.0f, 0.0f}};
+  std::array<float, 4> newQuat = {{0.0f, 0.0f, 0.0f, 0.0f}};
+  std::vector<int32_t> newMisoBins1;
+  std::vector<int32_t> newMisoBins2;
+};
+
+using BinChange = std::pair<int32_t, float>;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void addBinChange(std::vector<BinChange>& changes, int32_t bin, float delta)
+{
+  for(BinChange& change : changes)
+  {
+    if(change.first == bin)
+    {
+      change.second += delta;
+      return;
+    }
+  }
+  changes.emplace_back(bin, delta);
+}
+
+// -----------------------------------------------------------------------------
+// Returns how much the squared error between the actual and simulated distributions
+// drops when the changes are applied; a positive value is an improvement
+// -----------------------------------------------------------------------------
+float squaredErrorChange(const float* actual, const float* sim, const std::vector<BinChange>& changes)
+{
+  float errorChange = 0.0f;
+  for(const BinChange& change : changes)
+  {
+    float before = actual[change.first] - sim[change.first];
+    float after = before - change.second;
+    errorChange += (before * before) - (after * after);
+  }
+  return errorChange;
+}
+
+/**
+ * @brief The EvaluateCrystallographyTrialsImpl class computes the new misorientation bins
+ * for a batch of trials. Trials in a batch never share a Feature neighborhood, so each one
+ * only reads orientations that no other trial in the batch can change.
+ */
+class EvaluateCrystallographyTrialsImpl
+{
+  std::vector<CrystallographyTrial>& m_Trials;
+  NeighborList<int32_t>& m_NeighborList;
+  const std::vector<std::vector<int32_t>>& m_MisorientationBins;
+  float* m_AvgQuats;
+  LaueOps::Pointer m_OrientationOps;
+
+public:
+  EvaluateCrystallographyTrialsImpl(std::vector<CrystallographyTrial>& trials, NeighborList<int32_t>& neighborList, const std::vector<std::vector<int32_t>>& misorientationBins, float* avgQuats,
+                                    LaueOps::Pointer orientationOps)
+  : m_Trials(trials)
+  , m_NeighborList(neighborList)
+  , m_MisorientationBins(misorientationBins)
+  , m_AvgQuats(avgQuats)
+  , m_OrientationOps(orientationOps)
+  {
+  }
+  virtual ~EvaluateCrystallographyTrialsImpl() = default;
+
+  void evaluateNeighbors(int32_t feature, int32_t excluded, const QuatType& q1, std::vector<int32_t>& newBins) const
+  {
+    const std::vector<int32_t>& cachedBins = m_MisorientationBins[feature];
+    newBins.assign(cachedBins.size(), -1);
+    for(size_t j = 0; j < cachedBins.size(); j++)
+    {
+      int32_t neighbor = m_NeighborList[feature][j];
+      if(cachedBins[j] < 0 || neighbor == excluded)
+      {
+        continue;
+      }
+      float* quatPtr = m_AvgQuats + neighbor * 4;
+      QuatType q2(quatPtr[0], quatPtr[1], quatPtr[2], quatPtr[3]);
+      OrientationD axisAngle = m_OrientationOps->calculateMisorientation(q1, q2);
+      OrientationD rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
+      newBins[j] = m_OrientationOps->getMisoBin(rod);
+    }
+  }
+
+  void evaluate(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      CrystallographyTrial& trial = m_Trials[i];
+      if(trial.switchOrientations)
+      {
+        // Each Feature takes on the orientation of the other
+        float* quatPtr = m_AvgQuats + trial.feature1 * 4;
+        QuatType q1(quatPtr[0], quatPtr[1], quatPtr[2], quatPtr[3]);
+        quatPtr = m_AvgQuats + trial.feature2 * 4;
+        QuatType q2(quatPtr[0], quatPtr[1], quatPtr[2], quatPtr[3]);
+        evaluateNeighbors(trial.feature1, trial.feature2, q2, trial.newMisoBins1);
+        evaluateNeighbors(trial.feature2, trial.feature1, q1, trial.newMisoBins2);
+      }
+      else
+      {
+        QuatF q = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(trial.newEulers[0], trial.newEulers[1], trial.newEulers[2]));
+        q.copyInto(trial.newQuat.data(), 4);
+        QuatType q1(q[0], q[1], q[2], q[3]);
+        evaluateNeighbors(trial.feature1, -1, q1, trial.newMisoBins1);
+        trial.newMisoBins2.clear();
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    evaluate(r.begin(), r.end());
+  }
+#endif
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -98,8 +242,6 @@ MatchCrystallography::MatchCrystallography()
   m_SharedSurfaceAreaList = NeighborList<float>::NullPointer();
   m_StatsDataArray = StatsDataArray::NullPointer();
 
-  m_MdfChange = m_OdfChange = 0.0f;
-
   m_ActualOdf = FloatArrayType::NullPointer();
   m_SimOdf = FloatArrayType::NullPointer();
   m_ActualMdf = FloatArrayType::NullPointer();
@@ -222,7 +364,6 @@ void MatchCrystallography::initialize()
   m_SharedSurfaceAreaList = NeighborList<float>::NullPointer();
   m_StatsDataArray = StatsDataArray::NullPointer();
 
-  m_MdfChange = m_OdfChange = 0.0f;
   m_UnbiasedVolume.clear();
   m_TotalSurfaceArea.clear();
 
@@ -230,7 +371,8 @@ void MatchCrystallography::initialize()
   m_SimOdf = FloatArrayType::NullPointer();
   m_ActualMdf = FloatArrayType::NullPointer();
   m_SimMdf = FloatArrayType::NullPointer();
-  m_MisorientationLists.clear();
+  m_MisorientationBins.clear();
+  m_OdfAliasTable.clear();
 
   m_OrientationOps = LaueOps::GetAllOrientationOps();
 }
@@ -575,8 +717,6 @@ void MatchCrystallography::assign_eulers(size_t ensem)
   std::array<double, 3> randx3;
 
   int32_t numbins = 0;
-  // QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-  float random = 0.0f;
   int32_t choose = 0, phase = 0;
 
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
@@ -584,22 +724,24 @@ void MatchCrystallography::assign_eulers(size_t ensem)
   CubicOps cOps;
   HexagonalOps hOps;
 
+  if(EbsdLib::CrystalStructure::Cubic_High == m_CrystalStructures[ensem])
+  {
+    numbins = cOps.getODFSize();
+  }
+  if(EbsdLib::CrystalStructure::Hexagonal_High == m_CrystalStructures[ensem])
+  {
+    numbins = hOps.getODFSize();
+  }
+  if(numbins > 0)
+  {
+    build_odf_alias_table(numbins);
+  }
+
   for(size_t i = 1; i < totalFeatures; i++)
   {
     phase = m_FeaturePhases[i];
     if(phase == ensem)
     {
-      random = static_cast<float>(distribution(generator));
-
-      if(EbsdLib::CrystalStructure::Cubic_High == m_CrystalStructures[phase])
-      {
-        numbins = cOps.getODFSize();
-      };
-      if(EbsdLib::CrystalStructure::Hexagonal_High == m_CrystalStructures[phase])
-      {
-        numbins = hOps.getODFSize();
-      }
-
       // If we get to here and numbins is still zero, then an unknown or unsupported crystal structure
       // was used, so we bail
       if(numbins == 0)
@@ -609,7 +751,7 @@ void MatchCrystallography::assign_eulers(size_t ensem)
         return;
       }
 
-      choose = pick_euler(random, numbins);
+      choose = pick_euler(distribution(generator), numbins);
 
       randx3[0] = distribution(generator);
       randx3[1] = distribution(generator);
@@ -620,9 +762,9 @@ void MatchCrystallography::assign_eulers(size_t ensem)
       m_FeatureEulerAngles[3 * i + 1] = eulers[1];
       m_FeatureEulerAngles[3 * i + 2] = eulers[2];
 
-      QuatF q(m_AvgQuats + i * 4);
       OrientationF eu(m_FeatureEulerAngles[3 * i], m_FeatureEulerAngles[3 * i + 1], m_FeatureEulerAngles[3 * i + 2]);
-      q = OrientationTransformation::eu2qu<OrientationF, QuatF>(eu);
+      QuatF q = OrientationTransformation::eu2qu<OrientationF, QuatF>(eu);
+      q.copyInto(m_AvgQuats + i * 4, 4);
       if(!m_SurfaceFeatures[i])
       {
         m_SimOdf->setValue(choose, (m_SimOdf->getValue(choose) + m_Volumes[i] / m_UnbiasedVolume[ensem]));
@@ -634,103 +776,25 @@ void MatchCrystallography::assign_eulers(size_t ensem)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int32_t MatchCrystallography::pick_euler(float random, int32_t numbins)
+void MatchCrystallography::build_odf_alias_table(int32_t numbins)
 {
-  int32_t choose = 0;
-  float totaldensity = 0.0f;
-
-  for(int32_t j = 0; j < numbins; j++)
-  {
-    float density = m_ActualOdf->getValue(j);
-    float td1 = totaldensity;
-    totaldensity = totaldensity + density;
-    if(random < totaldensity && random >= td1)
-    {
-      choose = j;
-      break;
-    }
-  }
-  return choose;
+  m_OdfAliasTable.build(m_ActualOdf->getPointer(0), m_ActualOdf->getSize(), numbins);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, const QuatF& q1, const QuatF& q2)
+int32_t MatchCrystallography::pick_euler(double random, int32_t numbins)
 {
-  double curmiso1 = 0.0f, curmiso2 = 0.0f, curmiso3 = 0.0f;
-  size_t curmisobin = 0, newmisobin = 0;
-
-  curmiso1 = m_MisorientationLists[feature][3 * j];
-  curmiso2 = m_MisorientationLists[feature][3 * j + 1];
-  curmiso3 = m_MisorientationLists[feature][3 * j + 2];
-
-  OrientationD rod(curmiso1, curmiso2, curmiso3, 0.0);
-  double mag = std::sqrt(curmiso1 * curmiso1 + curmiso2 * curmiso2 + curmiso3 * curmiso3);
-  if(mag == 0.0)
+  if(numbins <= 0)
   {
-    rod[3] = std::numeric_limits<double>::infinity();
+    return 0;
   }
-  else
+  if(m_OdfAliasTable.getNumberOfBins() != numbins)
   {
-    rod[3] = mag;
-    rod[0] = rod[0] / rod[3];
-    rod[1] = rod[1] / rod[3];
-    rod[2] = rod[2] / rod[3];
+    build_odf_alias_table(numbins);
   }
-
-  curmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  QuatType qq1(q1[0], q1[1], q1[2], q1[3]);
-  QuatType qq2(q2[0], q2[1], q2[2], q2[3]);
-  OrientationD axisAngle = m_OrientationOps[sym]->calculateMisorientation(q1, q2);
-
-  rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
-  newmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  m_MdfChange = m_MdfChange + (((m_ActualMdf->getValue(curmisobin) - m_SimMdf->getValue(curmisobin)) * (m_ActualMdf->getValue(curmisobin) - m_SimMdf->getValue(curmisobin))) -
-                               ((m_ActualMdf->getValue(curmisobin) - (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem]))) *
-                                (m_ActualMdf->getValue(curmisobin) - (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])))));
-  m_MdfChange = m_MdfChange + (((m_ActualMdf->getValue(newmisobin) - m_SimMdf->getValue(newmisobin)) * (m_ActualMdf->getValue(newmisobin) - m_SimMdf->getValue(newmisobin))) -
-                               ((m_ActualMdf->getValue(newmisobin) - (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem]))) *
-                                (m_ActualMdf->getValue(newmisobin) - (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])))));
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody2(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2)
-{
-  float curmiso1 = 0.0f, curmiso2 = 0.0f, curmiso3 = 0.0f;
-  size_t curmisobin = 0, newmisobin = 0;
-  float miso1 = 0.0f, miso2 = 0.0f, miso3 = 0.0f;
-
-  curmiso1 = m_MisorientationLists[feature][3 * j];
-  curmiso2 = m_MisorientationLists[feature][3 * j + 1];
-  curmiso3 = m_MisorientationLists[feature][3 * j + 2];
-
-  OrientationD rod(curmiso1, curmiso2, curmiso3, 0.0f);
-  float mag = sqrt(curmiso1 * curmiso1 + curmiso2 * curmiso2 + curmiso3 * curmiso3);
-  if(mag == 0.0f)
-  {
-    rod[3] = std::numeric_limits<float>::infinity();
-  }
-  else
-  {
-    rod[3] = mag;
-    rod[0] = rod[0] / rod[3];
-    rod[1] = rod[1] / rod[3];
-    rod[2] = rod[2] / rod[3];
-  }
-
-  curmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  OrientationD axisAngle = m_OrientationOps[sym]->calculateMisorientation(q1, q2);
-
-  rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
-  newmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  m_MisorientationLists[feature][3 * j] = miso1;
-  m_MisorientationLists[feature][3 * j + 1] = miso2;
-  m_MisorientationLists[feature][3 * j + 2] = miso3;
-  m_SimMdf->setValue(curmisobin, (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])));
-  m_SimMdf->setValue(newmisobin, (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])));
+  return m_OdfAliasTable.pick(random);
 }
 
 // -----------------------------------------------------------------------------
@@ -755,21 +819,6 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
 
   int32_t numbins = 0;
   int32_t iterations = 0, badtrycount = 0;
-  float random = 0.0f;
-  size_t counter = 0;
-
-  QuatF q1;
-  QuatF q2;
-  //  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
-  float ea1 = 0.0f, ea2 = 0.0f, ea3 = 0.0f;
-  float g1ea1 = 0.0f, g1ea2 = 0.0f, g1ea3 = 0.0f, g2ea1 = 0.0f, g2ea2 = 0.0f, g2ea3 = 0.0f;
-  int32_t g1odfbin = 0, g2odfbin = 0;
-  float deltaerror = 0.0f;
-  float currentodferror = 0.0f, currentmdferror = 0.0f;
-  int32_t selectedfeature1 = 0, selectedfeature2 = 0;
-  iterations = 0;
-  badtrycount = 0;
   if(EbsdLib::CrystalStructure::Cubic_High == m_CrystalStructures[ensem])
   {
     numbins = 18 * 18 * 18;
@@ -778,11 +827,143 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
   {
     numbins = 36 * 36 * 12;
   }
+  int32_t numMdfBins = static_cast<int32_t>(m_ActualMdf->getSize());
+
+  LaueOps::Pointer orientationOps = m_OrientationOps[m_CrystalStructures[ensem]];
+
+  // Only interior Features of this phase take part in the trials; cache the ODF bin each one sits in
+  std::vector<int32_t> candidates;
+  std::vector<int32_t> odfBins(totalFeatures, 0);
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    if(!m_SurfaceFeatures[i] && m_FeaturePhases[i] == static_cast<int32_t>(ensem))
+    {
+      candidates.push_back(static_cast<int32_t>(i));
+      OrientationD eu(m_FeatureEulerAngles[3 * i], m_FeatureEulerAngles[3 * i + 1], m_FeatureEulerAngles[3 * i + 2]);
+      OrientationD rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
+      odfBins[i] = orientationOps->getOdfBin(rod);
+    }
+  }
+
+  float* actualOdfPtr = m_ActualOdf->getPointer(0);
+  float* simOdfPtr = m_SimOdf->getPointer(0);
+  float* actualMdfPtr = m_ActualMdf->getPointer(0);
+  float* simMdfPtr = m_SimMdf->getPointer(0);
+  float odfScale = 1.0f / m_UnbiasedVolume[ensem];
+  float mdfScale = 1.0f / m_TotalSurfaceArea[ensem];
+
+  std::vector<CrystallographyTrial> trials(k_TrialBatchSize);
+  CrystallographyTrial pendingTrial;
+  bool hasPendingTrial = false;
+  std::vector<int32_t> touchedStamp(totalFeatures, -1);
+  std::vector<int32_t> ownedStamp(totalFeatures, -1);
+  std::vector<BinChange> odfChanges;
+  std::vector<BinChange> mdfChanges;
+  int32_t batch = 0;
+
+  // Draws the next trial exactly as the serial swap/switch loop would
+  auto generateTrial = [&](CrystallographyTrial& trial) {
+    size_t numCandidates = candidates.size();
+    trial.switchOrientations = (distribution(generator) >= 0.5 && numCandidates > 1);
+    size_t index1 = std::min(static_cast<size_t>(distribution(generator) * numCandidates), numCandidates - 1);
+    trial.feature1 = candidates[index1];
+    trial.feature2 = -1;
+    if(trial.switchOrientations)
+    {
+      size_t index2 = std::min(static_cast<size_t>(distribution(generator) * (numCandidates - 1)), numCandidates - 2);
+      if(index2 >= index1)
+      {
+        index2++;
+      }
+      trial.feature2 = candidates[index2];
+    }
+    else
+    {
+      trial.newOdfBin = pick_euler(distribution(generator), numbins);
+      randx3[0] = distribution(generator);
+      randx3[1] = distribution(generator);
+      randx3[2] = distribution(generator);
+      OrientationD g1ea = orientationOps->determineEulerAngles(randx3.data(), trial.newOdfBin);
+      g1ea = orientationOps->randomizeEulerAngles(g1ea);
+      trial.newEulers[0] = static_cast<float>(g1ea[0]);
+      trial.newEulers[1] = static_cast<float>(g1ea[1]);
+      trial.newEulers[2] = static_cast<float>(g1ea[2]);
+    }
+  };
+
+  // A trial may join the batch only if none of its Features is, or neighbors, a Feature
+  // already claimed by an earlier trial in the batch
+  auto claimTrial = [&](const CrystallographyTrial& trial) {
+    std::array<int32_t, 2> features = {{trial.feature1, trial.feature2}};
+    size_t numFeatures = trial.switchOrientations ? 2 : 1;
+    for(size_t f = 0; f < numFeatures; f++)
+    {
+      if(touchedStamp[features[f]] == batch)
+      {
+        return false;
+      }
+      for(const int32_t& neighbor : neighborlist[features[f]])
+      {
+        if(ownedStamp[neighbor] == batch)
+        {
+          return false;
+        }
+      }
+    }
+    for(size_t f = 0; f < numFeatures; f++)
+    {
+      ownedStamp[features[f]] = batch;
+      touchedStamp[features[f]] = batch;
+      for(const int32_t& neighbor : neighborlist[features[f]])
+      {
+        touchedStamp[neighbor] = batch;
+      }
+    }
+    return true;
+  };
+
+  auto addMisorientationChanges = [&](int32_t feature, const std::vector<int32_t>& newBins) {
+    const std::vector<int32_t>& cachedBins = m_MisorientationBins[feature];
+    for(size_t j = 0; j < newBins.size(); j++)
+    {
+      if(newBins[j] >= 0 && newBins[j] != cachedBins[j])
+      {
+        float area = neighborsurfacearealist[feature][j] * mdfScale;
+        addBinChange(mdfChanges, cachedBins[j], -area);
+        addBinChange(mdfChanges, newBins[j], area);
+      }
+    }
+  };
+
+  // Both sides of every changed boundary keep the same cached bin
+  auto updateMisorientationBins = [&](int32_t feature, const std::vector<int32_t>& newBins) {
+    for(size_t j = 0; j < newBins.size(); j++)
+    {
+      if(newBins[j] < 0)
+      {
+        continue;
+      }
+      m_MisorientationBins[feature][j] = newBins[j];
+      int32_t neighbor = neighborlist[feature][j];
+      std::vector<int32_t>& neighborBins = m_MisorientationBins[neighbor];
+      for(size_t k = 0; k < neighborBins.size(); k++)
+      {
+        if(neighborlist[neighbor][k] == feature && neighborBins[k] >= 0)
+        {
+          neighborBins[k] = newBins[j];
+          break;
+        }
+      }
+    }
+  };
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+#endif
 
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
   uint64_t startMillis = millis;
-  int32_t lastIteration = 0;
-  while(badtrycount < (m_MaxIterations / 10) && iterations < m_MaxIterations)
+  while(!candidates.empty() && badtrycount < (m_MaxIterations / 10) && iterations < m_MaxIterations)
   {
     uint64_t currentMillis = QDateTime::currentMSecsSinceEpoch();
     if(currentMillis - millis > 1000)
@@ -795,317 +976,136 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
       notifyStatusMessage(ss);
 
       millis = QDateTime::currentMSecsSinceEpoch();
-      lastIteration = iterations;
     }
-    currentodferror = 0;
-    currentmdferror = 0;
-    float* actualOdfPtr = m_ActualOdf->getPointer(0);
-    float* simOdfPtr = m_SimOdf->getPointer(0);
-    float delta = 0.0f;
-    for(int32_t i = 0; i < numbins; i++)
-    {
-      delta = actualOdfPtr[i] - simOdfPtr[i];
-      currentodferror = currentodferror + (delta * delta);
-    }
-    for(int32_t i = 0; i < (numbins); i++)
-    {
-      currentmdferror = currentmdferror + ((m_ActualMdf->getValue(i) - m_SimMdf->getValue(i)) * (m_ActualMdf->getValue(i) - m_SimMdf->getValue(i)));
-    }
-    iterations++;
-    badtrycount++;
-    random = static_cast<float>(distribution(generator));
-
     if(getCancel())
     {
       return;
     }
 
-    if(random < 0.5) // SwapOutOrientation
+    // Fill the batch in draw order and stop at the first trial that touches the neighborhood of
+    // an earlier one; that trial opens the next batch. Every trial in a batch therefore sees the
+    // same Feature orientations and cached bins it would have seen in a serial run.
+    size_t maxTrials = std::min(k_TrialBatchSize, static_cast<size_t>(m_MaxIterations - iterations));
+    size_t numTrials = 0;
+    while(numTrials < maxTrials)
     {
-      counter = 0;
-      selectedfeature1 = static_cast<int32_t>(distribution(generator) * totalFeatures);
-      if(selectedfeature1 >= totalFeatures)
+      CrystallographyTrial& trial = trials[numTrials];
+      if(hasPendingTrial)
       {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
+        std::swap(trial, pendingTrial);
+        hasPendingTrial = false;
       }
-      while((m_SurfaceFeatures[selectedfeature1] || m_FeaturePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
+      else
       {
-        if(selectedfeature1 >= totalFeatures)
-        {
-          selectedfeature1 = selectedfeature1 - totalFeatures;
-        }
-        selectedfeature1++;
-        counter++;
+        generateTrial(trial);
       }
-      if(selectedfeature1 >= totalFeatures)
+      if(!claimTrial(trial))
       {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
+        std::swap(trial, pendingTrial);
+        hasPendingTrial = true;
+        break;
       }
-      if(counter == totalFeatures)
+      numTrials++;
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel && numTrials > 1)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numTrials), EvaluateCrystallographyTrialsImpl(trials, neighborlist, m_MisorientationBins, m_AvgQuats, orientationOps),
+                        tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      EvaluateCrystallographyTrialsImpl serial(trials, neighborlist, m_MisorientationBins, m_AvgQuats, orientationOps);
+      serial.evaluate(0, numTrials);
+    }
+
+    // The running errors are updated incrementally below; refresh them once per batch so
+    // round off cannot accumulate
+    float currentodferror = 0.0f, currentmdferror = 0.0f;
+    for(int32_t i = 0; i < numbins; i++)
+    {
+      float delta = actualOdfPtr[i] - simOdfPtr[i];
+      currentodferror = currentodferror + (delta * delta);
+    }
+    for(int32_t i = 0; i < numMdfBins; i++)
+    {
+      float delta = actualMdfPtr[i] - simMdfPtr[i];
+      currentmdferror = currentmdferror + (delta * delta);
+    }
+
+    for(size_t t = 0; t < numTrials && badtrycount < (m_MaxIterations / 10); t++)
+    {
+      const CrystallographyTrial& trial = trials[t];
+      int32_t feature1 = trial.feature1;
+      int32_t feature2 = trial.feature2;
+      iterations++;
+      badtrycount++;
+
+      odfChanges.clear();
+      mdfChanges.clear();
+      float volume1 = m_Volumes[feature1] * odfScale;
+      if(trial.switchOrientations)
       {
-        badtrycount = 10 * m_NumFeatures[ensem];
+        float volume2 = m_Volumes[feature2] * odfScale;
+        addBinChange(odfChanges, odfBins[feature1], volume2 - volume1);
+        addBinChange(odfChanges, odfBins[feature2], volume1 - volume2);
+        addMisorientationChanges(feature1, trial.newMisoBins1);
+        addMisorientationChanges(feature2, trial.newMisoBins2);
       }
       else
       {
-        ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
-        ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
-        ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
-        OrientationD rod(4, 0.0);
-
-        OrientationD eu(m_FeatureEulerAngles[3 * selectedfeature1], m_FeatureEulerAngles[3 * selectedfeature1 + 1], m_FeatureEulerAngles[3 * selectedfeature1 + 2]);
-        rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
-
-        g1odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
-        random = static_cast<float>(distribution(generator));
-        int32_t choose = 0;
-
-        choose = pick_euler(random, numbins);
-
-        randx3[0] = distribution(generator);
-        randx3[1] = distribution(generator);
-        randx3[2] = distribution(generator);
-        OrientationD g1ea = m_OrientationOps[m_CrystalStructures[ensem]]->determineEulerAngles(randx3.data(), choose);
-        g1ea = m_OrientationOps[m_CrystalStructures[ensem]]->randomizeEulerAngles(g1ea);
-
-        q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(g1ea);
-
-        m_OdfChange = ((m_ActualOdf->getValue(choose) - m_SimOdf->getValue(choose)) * (m_ActualOdf->getValue(choose) - m_SimOdf->getValue(choose))) -
-                      ((m_ActualOdf->getValue(choose) - (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                       (m_ActualOdf->getValue(choose) - (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))));
-        m_OdfChange = m_OdfChange + (((m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin)) * (m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin))) -
-                                     ((m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                                      (m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])))));
-
-        m_MdfChange = 0;
-        size_t size = 0;
-        if(!neighborlist[selectedfeature1].empty())
-        {
-          size = neighborlist[selectedfeature1].size();
-        }
-        for(size_t j = 0; j < size; j++)
-        {
-          int32_t neighbor = neighborlist[selectedfeature1][j];
-          eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
-
-          q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
-          float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-          MC_LoopBody1(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-        }
-
-        deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
-        if(deltaerror > 0)
-        {
-          badtrycount = 0;
-          m_FeatureEulerAngles[3 * selectedfeature1] = g1ea1;
-          m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g1ea2;
-          m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g1ea3;
-          q1.copyInto(m_AvgQuats + selectedfeature1 * 4, 4);
-          m_SimOdf->setValue(choose, (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-          m_SimOdf->setValue(g1odfbin, (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-          size = 0;
-          if(!neighborlist[selectedfeature1].empty())
-          {
-            size = neighborlist[selectedfeature1].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            int neighbor = neighborlist[selectedfeature1][j];
-            eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
+        addBinChange(odfChanges, odfBins[feature1], -volume1);
+        addBinChange(odfChanges, trial.newOdfBin, volume1);
+        addMisorientationChanges(feature1, trial.newMisoBins1);
+      }
 
-            q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
-            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-            MC_LoopBody2(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-          }
-        }
+      float odfChange = squaredErrorChange(actualOdfPtr, simOdfPtr, odfChanges);
+      float mdfChange = squaredErrorChange(actualMdfPtr, simMdfPtr, mdfChanges);
+      float deltaerror = 0.0f;
+      if(currentodferror > 0.0f)
+      {
+        deltaerror += odfChange / currentodferror;
       }
-      if(getCancel())
+      if(currentmdferror > 0.0f)
       {
-        return;
+        deltaerror += mdfChange / currentmdferror;
       }
-    }
-    else // SwitchOrientation
-    {
-      counter = 0;
-      selectedfeature1 = static_cast<int32_t>(distribution(generator) * totalFeatures);
-      if(selectedfeature1 >= totalFeatures)
+      if(deltaerror <= 0.0f)
       {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
+        continue;
       }
-      while((m_SurfaceFeatures[selectedfeature1] || m_FeaturePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
+
+      badtrycount = 0;
+      for(const BinChange& change : odfChanges)
       {
-        if(selectedfeature1 >= totalFeatures)
-        {
-          selectedfeature1 = selectedfeature1 - totalFeatures;
-        }
-        selectedfeature1++;
-        counter++;
+        simOdfPtr[change.first] += change.second;
       }
-      if(selectedfeature1 >= totalFeatures)
+      for(const BinChange& change : mdfChanges)
       {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
+        simMdfPtr[change.first] += change.second;
       }
-      if(counter == totalFeatures)
+      currentodferror -= odfChange;
+      currentmdferror -= mdfChange;
+
+      if(trial.switchOrientations)
       {
-        badtrycount = 10 * m_NumFeatures[ensem];
+        std::swap_ranges(m_FeatureEulerAngles + 3 * feature1, m_FeatureEulerAngles + 3 * feature1 + 3, m_FeatureEulerAngles + 3 * feature2);
+        std::swap_ranges(m_AvgQuats + 4 * feature1, m_AvgQuats + 4 * feature1 + 4, m_AvgQuats + 4 * feature2);
+        std::swap(odfBins[feature1], odfBins[feature2]);
+        updateMisorientationBins(feature1, trial.newMisoBins1);
+        updateMisorientationBins(feature2, trial.newMisoBins2);
       }
       else
       {
-        counter = 0;
-        selectedfeature2 = static_cast<int32_t>(distribution(generator) * totalFeatures);
-        if(selectedfeature2 >= totalFeatures)
-        {
-          selectedfeature2 = selectedfeature2 - totalFeatures;
-        }
-        while((m_SurfaceFeatures[selectedfeature2] || m_FeaturePhases[selectedfeature2] != static_cast<int32_t>(ensem) || selectedfeature2 == selectedfeature1) && counter < totalFeatures)
-        {
-          if(selectedfeature2 >= totalFeatures)
-          {
-            selectedfeature2 = selectedfeature2 - totalFeatures;
-          }
-          selectedfeature2++;
-          counter++;
-        }
-        if(selectedfeature2 >= totalFeatures)
-        {
-          selectedfeature2 = selectedfeature2 - totalFeatures;
-        }
-        if(counter == totalFeatures)
-        {
-          badtrycount = 10 * m_NumFeatures[ensem];
-        }
-        else
-        {
-          g1ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
-          g1ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
-          g1ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
-          g2ea1 = m_FeatureEulerAngles[3 * selectedfeature2];
-          g2ea2 = m_FeatureEulerAngles[3 * selectedfeature2 + 1];
-          g2ea3 = m_FeatureEulerAngles[3 * selectedfeature2 + 2];
-          q1.copyInto(m_AvgQuats + selectedfeature1 * 4, 4);
-          OrientationD eu(m_FeatureEulerAngles[3 * selectedfeature1], m_FeatureEulerAngles[3 * selectedfeature1 + 1], m_FeatureEulerAngles[3 * selectedfeature1 + 2]);
-          OrientationD rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
-
-          g1odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
-          q1.copyInto(m_AvgQuats + selectedfeature2 * 4, 4);
-
-          eu = OrientationD(m_FeatureEulerAngles[3 * selectedfeature2], m_FeatureEulerAngles[3 * selectedfeature2 + 1], m_FeatureEulerAngles[3 * selectedfeature2 + 2]);
-          rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
-          g2odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
-
-          m_OdfChange =
-              ((m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin)) * (m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin))) -
-              ((m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]))) *
-               (m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]))));
-          m_OdfChange =
-              m_OdfChange +
-              (((m_ActualOdf->getValue(g2odfbin) - m_SimOdf->getValue(g2odfbin)) * (m_ActualOdf->getValue(g2odfbin) - m_SimOdf->getValue(g2odfbin))) -
-               ((m_ActualOdf->getValue(g2odfbin) - (m_SimOdf->getValue(g2odfbin) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                (m_ActualOdf->getValue(g2odfbin) -
-                 (m_SimOdf->getValue(g2odfbin) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])))));
-
-          m_MdfChange = 0;
-
-          q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g2ea1, g2ea2, g2ea3));
-
-          size_t size = 0;
-          if(!neighborlist[selectedfeature1].empty())
-          {
-            size = neighborlist[selectedfeature1].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            int32_t neighbor = neighborlist[selectedfeature1][j];
-            eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
-
-            QuatF q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
-            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-            if(neighbor != static_cast<int>(selectedfeature2))
-            {
-              MC_LoopBody1(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-            }
-          }
-
-          q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g1ea1, g1ea2, g1ea3));
-          size = 0;
-          if(!neighborlist[selectedfeature2].empty())
-          {
-            size = neighborlist[selectedfeature2].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            size_t neighbor = neighborlist[selectedfeature2][j];
-            eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
-            QuatF q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
-            float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
-            if(neighbor != selectedfeature1)
-            {
-              MC_LoopBody1(selectedfeature2, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-            }
-          }
-
-          deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
-          if(deltaerror > 0)
-          {
-
-            badtrycount = 0;
-            m_FeatureEulerAngles[3 * selectedfeature1] = g2ea1;
-            m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g2ea2;
-            m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g2ea3;
-            m_FeatureEulerAngles[3 * selectedfeature2] = g1ea1;
-            m_FeatureEulerAngles[3 * selectedfeature2 + 1] = g1ea2;
-            m_FeatureEulerAngles[3 * selectedfeature2 + 2] = g1ea3;
-            m_SimOdf->setValue(g1odfbin, (m_SimOdf->getValue(g1odfbin) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-            m_SimOdf->setValue(g2odfbin, (m_SimOdf->getValue(g2odfbin) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem])));
-
-            q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g1ea1, g1ea2, g1ea3));
-            q1.copyInto(m_AvgQuats + selectedfeature1 * 4, 4);
-            size = 0;
-            if(!neighborlist[selectedfeature1].empty())
-            {
-              size = neighborlist[selectedfeature1].size();
-            }
-            for(size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedfeature1][j];
-              ea1 = m_FeatureEulerAngles[3 * neighbor];
-              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
-              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
-              q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(ea1, ea2, ea3));
-              float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-              if(neighbor != selectedfeature2)
-              {
-                MC_LoopBody2(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-              }
-            }
-
-            q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g1ea1, g1ea2, g1ea3));
-            q1.copyInto(m_AvgQuats + selectedfeature2 * 4, 4);
-            size = 0;
-            if(!neighborlist[selectedfeature2].empty())
-            {
-              size = neighborlist[selectedfeature2].size();
-            }
-            for(size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedfeature2][j];
-              ea1 = m_FeatureEulerAngles[3 * neighbor];
-              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
-              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
-              q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(ea1, ea2, ea3));
-              float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
-              if(neighbor != selectedfeature1)
-              {
-                MC_LoopBody2(selectedfeature2, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-              }
-            }
-          }
-        }
+        std::copy(trial.newEulers.begin(), trial.newEulers.end(), m_FeatureEulerAngles + 3 * feature1);
+        std::copy(trial.newQuat.begin(), trial.newQuat.end(), m_AvgQuats + 4 * feature1);
+        odfBins[feature1] = trial.newOdfBin;
+        updateMisorientationBins(feature1, trial.newMisoBins1);
       }
     }
-    if(getCancel())
-    {
-      return;
-    }
+    batch++;
   }
 
   if(getCancel())
@@ -1136,20 +1136,14 @@ void MatchCrystallography::measure_misorientations(size_t ensem)
   uint32_t crys1 = 0;
   int32_t mbin = 0;
 
-  m_MisorientationLists.resize(totalFeatures);
+  m_MisorientationBins.resize(totalFeatures);
 
   for(size_t i = 1; i < totalFeatures; i++)
   {
     if(m_FeaturePhases[i] == ensem)
     {
-      if(!m_MisorientationLists[i].empty())
-      {
-        m_MisorientationLists[i].clear();
-      }
-      if(!neighborlist[i].empty())
-      {
-        m_MisorientationLists[i].assign(neighborlist[i].size() * 3, 0.0f);
-      }
+      // A bin of -1 marks a boundary that does not take part in the MDF
+      m_MisorientationBins[i].assign(neighborlist[i].size(), -1);
 
       QuatF q1(m_AvgQuats + i * 4);
       crys1 = m_CrystalStructures[ensem];
@@ -1169,22 +1163,14 @@ void MatchCrystallography::measure_misorientations(size_t ensem)
           OrientationD axisAngle = m_OrientationOps[crys1]->calculateMisorientation(q1, q2);
 
           OrientationD rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
-          m_MisorientationLists[i][3 * j] = rod[0];
-          m_MisorientationLists[i][3 * j + 1] = rod[1];
-          m_MisorientationLists[i][3 * j + 2] = rod[2];
           mbin = m_OrientationOps[crys1]->getMisoBin(rod);
+          m_MisorientationBins[i][j] = mbin;
           if(!m_SurfaceFeatures[i] && (nname > static_cast<int32_t>(i) || m_SurfaceFeatures[nname]))
           {
             float neighsurfarea = neighborsurfacearealist[i][j];
             m_SimMdf->setValue(mbin, (m_SimMdf->getValue(mbin) + (neighsurfarea / m_TotalSurfaceArea[m_FeaturePhases[i]])));
           }
         }
-        else
-        {
-          m_MisorientationLists[i][3 * j] = -100;
-          m_MisorientationLists[i][3 * j + 1] = -100;
-          m_MisorientationLists[i][3 * j + 2] = -100;
-        }
       }
     }
   }
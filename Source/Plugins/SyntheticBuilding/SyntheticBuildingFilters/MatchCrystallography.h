@@ -46,6 +46,7 @@
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
 #include "SyntheticBuilding/SyntheticBuildingDLLExport.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/OdfAliasTable.h"
 
 #include "EbsdLib/Core/Quaternion.hpp"
 
@@ -368,40 +369,25 @@ protected:
   void assign_eulers(size_t ensem);
 
   /**
-   * @brief pick_euler Picks a random bin from the incoming orientation statistics
-   * @param random Key random value to compare for sampling
-   * @param numbins Number of possible bins to sample
-   * @return Integer value for bin index
-   */
-  int32_t pick_euler(float random, int32_t numbins);
-
-  /**
-   * @brief MC_LoopBody1 Determines the misorientation change after performing a swap
-   * @param feature Feature Id of Feature that has been swapped
-   * @param ensem Ensemble index of the current phase
-   * @param j Neighbor index for the Feature
-   * @param neighsurfarea Surface area for the Feature neighbor
-   * @param sym Crystal structure index
-   * @param q1 Quaterions for the Feature
-   * @param q2 Quaterions for the Feature neighbor
+   * @brief build_odf_alias_table Builds the alias table used to sample the incoming ODF
+   * in constant time per draw. The table is rebuilt whenever the number of bins changes.
+   * @param numbins Number of ODF bins to sample
    */
-  void MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, const QuatF& q1, const QuatF& q2);
+  void build_odf_alias_table(int32_t numbins);
 
   /**
-   * @brief MC_LoopBody2 Reinserts the swapped orientation if the swap did not improve the fit
-   * @param feature Feature Id of the Feature that has been swapped
-   * @param phase Ensemble index of the current phase
-   * @param j Neighbor index for the Feature
-   * @param neighsurfarea Surface area for the Feature neighbor
-   * @param sym Crystal structure index
-   * @param q1 Quaternions for the Feature
-   * @param q2 Quaternions for the Feature neighbor
+   * @brief pick_euler Picks a random bin from the incoming orientation statistics
+   * using the ODF alias table
+   * @param random Key random value in [0, 1) used for sampling
+   * @param numbins Number of possible bins to sample
+   * @return Integer value for bin index
    */
-  void MC_LoopBody2(int32_t feature, size_t phase, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2);
+  int32_t pick_euler(double random, int32_t numbins);
 
   /**
    * @brief matchCrystallography Swaps orientations for Features unitl convergence to
-   * the input statistics
+   * the input statistics. Trials are generated serially and evaluated in parallel batches
+   * of non-adjacent Features against the cached misorientation bins, then accepted in order.
    * @param ensem Ensemble index of the current phase
    */
   void matchCrystallography(size_t ensem);
@@ -463,9 +449,6 @@ private:
   StatsDataArray::WeakPointer m_StatsDataArray;
 
   // All other private instance variables
-  float m_MdfChange;
-  float m_OdfChange;
-
   std::vector<float> m_UnbiasedVolume;
   std::vector<float> m_TotalSurfaceArea;
 
@@ -474,7 +457,9 @@ private:
   FloatArrayType::Pointer m_ActualMdf;
   FloatArrayType::Pointer m_SimMdf;
 
-  std::vector<std::vector<float>> m_MisorientationLists;
+  std::vector<std::vector<int32_t>> m_MisorientationBins;
+
+  OdfAliasTable m_OdfAliasTable;
 
   LaueOpsContainer m_OrientationOps;
 public:
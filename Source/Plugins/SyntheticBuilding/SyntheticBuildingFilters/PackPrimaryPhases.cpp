@@ -35,6 +35,7 @@
 
 #include "PackPrimaryPhases.h"
 
+#include <array>
 #include <fstream>
 
 #include <QtCore/QDir>
@@ -71,6 +72,7 @@
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/FrontierGapFill.h"
 
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
@@ -314,7 +316,6 @@ PackPrimaryPhases::~PackPrimaryPhases() = default;
 // -----------------------------------------------------------------------------
 void PackPrimaryPhases::initialize()
 {
-  m_Neighbors = nullptr;
   m_BoundaryCells = nullptr;
 
   m_StatsDataArray = StatsDataArray::NullPointer();
@@ -2867,155 +2868,19 @@ void PackPrimaryPhases::assignGapsOnly()
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
 
-  int32_t featurename = 0, feature = 0;
-  int32_t current = 0;
-  int32_t most = 0;
-  int64_t gapVoxelCount = 1;
-  int64_t previousGapVoxelCount = 0;
-  int32_t iterationCounter = 0;
-  int64_t neighpoint;
-  bool good = false;
-  int32_t neighbor = 0;
-
-  int64_t xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-  int64_t yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  int64_t zPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
-  size_t totalPoints = m->getAttributeMatrix(m_OutputCellAttributeMatrixPath.getAttributeMatrixName())->getNumberOfTuples();
-  size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples();
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -xPoints * yPoints;
-  neighpoints[1] = -xPoints;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xPoints;
-  neighpoints[5] = xPoints * yPoints;
-
-  Int64ArrayType::Pointer neighborsPtr = Int64ArrayType::CreateArray(m->getGeometryAs<ImageGeom>()->getNumberOfElements(), "_INTERNAL_USE_ONLY_Neighbors", true);
-  neighborsPtr->initializeWithValue(-1);
-  m_Neighbors = neighborsPtr->getPointer(0);
-
-  std::vector<int32_t> n(totalFeatures + 1, 0);
+  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+  std::array<size_t, 3> dims = {{udims[0], udims[1], udims[2]}};
 
-  while(gapVoxelCount != 0 && gapVoxelCount != previousGapVoxelCount)
+  // Only the gap voxels that touch an assigned Feature are visited in each cycle
+  FrontierGapFill gapFill(m_FeatureIds, dims, m_CellPhases, m_FeaturePhases);
+  int32_t iterationCounter = 0;
+  int64_t gapVoxelCount = gapFill.getRemainingGapCount();
+  while(gapFill.assignNextLayer())
   {
     iterationCounter++;
-    previousGapVoxelCount = gapVoxelCount;
-    gapVoxelCount = 0;
-    int64_t zStride, yStride;
-    for(int64_t i = 0; i < zPoints; i++)
-    {
-      zStride = i * xPoints * yPoints;
-      for(int64_t j = 0; j < yPoints; j++)
-      {
-        yStride = j * xPoints;
-        for(int64_t k = 0; k < xPoints; k++)
-        {
-          featurename = m_FeatureIds[zStride + yStride + k];
-          if(featurename < 0)
-          {
-            gapVoxelCount++;
-            current = 0;
-            most = 0;
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = true;
-              neighpoint = zStride + yStride + k + neighpoints[l];
-              if(l == 0 && i == 0)
-              {
-                good = false;
-              }
-              if(l == 5 && i == (zPoints - 1))
-              {
-                good = false;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = false;
-              }
-              if(l == 4 && j == (yPoints - 1))
-              {
-                good = false;
-              }
-              if(l == 2 && k == 0)
-              {
-                good = false;
-              }
-              if(l == 3 && k == (xPoints - 1))
-              {
-                good = false;
-              }
-              if(good)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(feature > 0)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if(current > most)
-                  {
-                    most = current;
-                    m_Neighbors[zStride + yStride + k] = neighpoint;
-                  }
-                }
-              }
-            }
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = true;
-              neighpoint = zStride + yStride + k + neighpoints[l];
-              if(l == 0 && i == 0)
-              {
-                good = false;
-              }
-              if(l == 5 && i == (zPoints - 1))
-              {
-                good = false;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = false;
-              }
-              if(l == 4 && j == (yPoints - 1))
-              {
-                good = false;
-              }
-              if(l == 2 && k == 0)
-              {
-                good = false;
-              }
-              if(l == 3 && k == (xPoints - 1))
-              {
-                good = false;
-              }
-              if(good)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(feature > 0)
-                {
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      featurename = m_FeatureIds[j];
-      neighbor = m_Neighbors[j];
-      if(featurename < 0 && neighbor != -1 && m_FeatureIds[neighbor] > 0)
-      {
-        m_FeatureIds[j] = m_FeatureIds[neighbor];
-        m_CellPhases[j] = m_FeaturePhases[m_FeatureIds[neighbor]];
-      }
-    }
-    if(iterationCounter >= 1)
-    {
-      QString ss = QObject::tr("Assign Gaps || Cycle#: %1 || Remaining Unassigned Voxel Count: %2").arg(iterationCounter).arg(gapVoxelCount);
-      notifyStatusMessage(ss);
-    }
+    QString ss = QObject::tr("Assign Gaps || Cycle#: %1 || Remaining Unassigned Voxel Count: %2").arg(iterationCounter).arg(gapVoxelCount);
+    notifyStatusMessage(ss);
+    gapVoxelCount = gapFill.getRemainingGapCount();
     if(getCancel())
     {
       return;
@@ -3023,6 +2888,7 @@ void PackPrimaryPhases::assignGapsOnly()
   }
   if(gapVoxelCount != 0)
   {
+    size_t totalPoints = m->getAttributeMatrix(m_OutputCellAttributeMatrixPath.getAttributeMatrixName())->getNumberOfTuples();
     for(size_t j = 0; j < totalPoints; j++)
     {
       if(m_FeatureIds[j] < 0)
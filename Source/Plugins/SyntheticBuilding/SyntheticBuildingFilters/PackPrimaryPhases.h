@@ -674,8 +674,6 @@ private:
   QString m_AxisEulerAnglesArrayName;
   QString m_Omega3sArrayName;
   QString m_EquivalentDiametersArrayName;
-  int64_t* m_Neighbors = nullptr;
-
   int8_t* m_BoundaryCells = nullptr;
 
   StringDataArray::WeakPointer m_PhaseNamesPtr;
@@ -0,0 +1,349 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FrontierGapFill.h"
+
+#include <algorithm>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/partitioner.h>
+#endif
+
+namespace
+{
+const size_t k_CellChunkSize = 65536;
+const size_t k_FrontierChunkSize = 4096;
+
+/**
+ * @brief The FaceNeighbors class enumerates the face neighbors of a cell in -Z, -Y, -X, +X, +Y, +Z order
+ */
+class FaceNeighbors
+{
+public:
+  explicit FaceNeighbors(const std::array<int64_t, 3>& dims)
+  : m_Dims(dims)
+  {
+    m_Offsets = {{-dims[0] * dims[1], -dims[0], -1, 1, dims[0], dims[0] * dims[1]}};
+  }
+
+  /**
+   * @brief find Writes the neighbors of a cell that lie inside the volume
+   * @return Number of neighbors written
+   */
+  int32_t find(int64_t index, std::array<int64_t, 6>& neighbors) const
+  {
+    int64_t column = index % m_Dims[0];
+    int64_t row = (index / m_Dims[0]) % m_Dims[1];
+    int64_t plane = index / (m_Dims[0] * m_Dims[1]);
+    bool good[6] = {plane > 0, row > 0, column > 0, column < m_Dims[0] - 1, row < m_Dims[1] - 1, plane < m_Dims[2] - 1};
+    int32_t count = 0;
+    for(int32_t l = 0; l < 6; l++)
+    {
+      if(good[l])
+      {
+        neighbors[count++] = index + m_Offsets[l];
+      }
+    }
+    return count;
+  }
+
+private:
+  std::array<int64_t, 3> m_Dims;
+  std::array<int64_t, 6> m_Offsets;
+};
+
+/**
+ * @brief The CollectFrontierImpl class collects, per chunk, the gap cells that touch an assigned Feature. The
+ * initial search scans chunks of the whole volume; later searches scan chunks of the previous frontier and look
+ * at the neighbors of the cells that were just assigned.
+ */
+class CollectFrontierImpl
+{
+public:
+  CollectFrontierImpl(const int32_t* featureIds, const FaceNeighbors& faceNeighbors, const std::vector<int64_t>* previousFrontier, size_t numCells,
+                      std::vector<std::vector<int64_t>>& chunks, std::vector<int64_t>& gapCounts)
+  : m_FeatureIds(featureIds)
+  , m_FaceNeighbors(faceNeighbors)
+  , m_PreviousFrontier(previousFrontier)
+  , m_NumCells(numCells)
+  , m_Chunks(chunks)
+  , m_GapCounts(gapCounts)
+  {
+  }
+  virtual ~CollectFrontierImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    std::array<int64_t, 6> neighbors = {{0, 0, 0, 0, 0, 0}};
+    for(size_t chunk = start; chunk < end; chunk++)
+    {
+      std::vector<int64_t>& found = m_Chunks[chunk];
+      if(nullptr == m_PreviousFrontier)
+      {
+        size_t last = std::min(m_NumCells, (chunk + 1) * k_CellChunkSize);
+        for(size_t i = chunk * k_CellChunkSize; i < last; i++)
+        {
+          int64_t index = static_cast<int64_t>(i);
+          if(m_FeatureIds[index] >= 0)
+          {
+            continue;
+          }
+          m_GapCounts[chunk]++;
+          int32_t count = m_FaceNeighbors.find(index, neighbors);
+          for(int32_t l = 0; l < count; l++)
+          {
+            if(m_FeatureIds[neighbors[l]] > 0)
+            {
+              found.push_back(index);
+              break;
+            }
+          }
+        }
+      }
+      else
+      {
+        size_t last = std::min(m_PreviousFrontier->size(), (chunk + 1) * k_FrontierChunkSize);
+        for(size_t i = chunk * k_FrontierChunkSize; i < last; i++)
+        {
+          int32_t count = m_FaceNeighbors.find((*m_PreviousFrontier)[i], neighbors);
+          for(int32_t l = 0; l < count; l++)
+          {
+            if(m_FeatureIds[neighbors[l]] < 0)
+            {
+              found.push_back(neighbors[l]);
+            }
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int32_t* m_FeatureIds;
+  const FaceNeighbors& m_FaceNeighbors;
+  const std::vector<int64_t>* m_PreviousFrontier;
+  size_t m_NumCells;
+  std::vector<std::vector<int64_t>>& m_Chunks;
+  std::vector<int64_t>& m_GapCounts;
+};
+
+/**
+ * @brief The AssignFrontierImpl class either chooses the label of every frontier cell from the current Feature Ids
+ * or writes the chosen labels. The two passes are separate so that no choice sees a label written in the same layer.
+ */
+class AssignFrontierImpl
+{
+public:
+  AssignFrontierImpl(bool write, int32_t* featureIds, const FaceNeighbors& faceNeighbors, const std::vector<int64_t>& frontier, std::vector<int32_t>& labels, int32_t* cellPhases,
+                     const int32_t* featurePhases)
+  : m_Write(write)
+  , m_FeatureIds(featureIds)
+  , m_FaceNeighbors(faceNeighbors)
+  , m_Frontier(frontier)
+  , m_Labels(labels)
+  , m_CellPhases(cellPhases)
+  , m_FeaturePhases(featurePhases)
+  {
+  }
+  virtual ~AssignFrontierImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    if(m_Write)
+    {
+      for(size_t i = start; i < end; i++)
+      {
+        m_FeatureIds[m_Frontier[i]] = m_Labels[i];
+        if(nullptr != m_CellPhases)
+        {
+          m_CellPhases[m_Frontier[i]] = m_FeaturePhases[m_Labels[i]];
+        }
+      }
+      return;
+    }
+
+    std::array<int64_t, 6> neighbors = {{0, 0, 0, 0, 0, 0}};
+    std::array<int32_t, 6> features = {{0, 0, 0, 0, 0, 0}};
+    for(size_t i = start; i < end; i++)
+    {
+      int32_t count = m_FaceNeighbors.find(m_Frontier[i], neighbors);
+      int32_t numFeatures = 0;
+      int32_t most = 0;
+      int32_t label = 0;
+      for(int32_t l = 0; l < count; l++)
+      {
+        int32_t feature = m_FeatureIds[neighbors[l]];
+        if(feature <= 0)
+        {
+          continue;
+        }
+        features[numFeatures++] = feature;
+        int32_t current = static_cast<int32_t>(std::count(features.begin(), features.begin() + numFeatures, feature));
+        if(current > most)
+        {
+          most = current;
+          label = feature;
+        }
+      }
+      m_Labels[i] = label;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  bool m_Write;
+  int32_t* m_FeatureIds;
+  const FaceNeighbors& m_FaceNeighbors;
+  const std::vector<int64_t>& m_Frontier;
+  std::vector<int32_t>& m_Labels;
+  int32_t* m_CellPhases;
+  const int32_t* m_FeaturePhases;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void collectFrontier(const CollectFrontierImpl& impl, size_t numChunks)
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks), impl, tbb::auto_partitioner());
+#else
+  impl.convert(0, numChunks);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void assignFrontier(const AssignFrontierImpl& impl, size_t frontierSize)
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, frontierSize), impl, tbb::auto_partitioner());
+#else
+  impl.convert(0, frontierSize);
+#endif
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FrontierGapFill::FrontierGapFill(int32_t* featureIds, const std::array<size_t, 3>& dims, int32_t* cellPhases, const int32_t* featurePhases)
+: m_FeatureIds(featureIds)
+, m_CellPhases(cellPhases)
+, m_FeaturePhases(featurePhases)
+{
+  m_Dims = {{static_cast<int64_t>(dims[0]), static_cast<int64_t>(dims[1]), static_cast<int64_t>(dims[2])}};
+  FaceNeighbors faceNeighbors(m_Dims);
+
+  size_t numCells = dims[0] * dims[1] * dims[2];
+  size_t numChunks = (numCells + k_CellChunkSize - 1) / k_CellChunkSize;
+  std::vector<std::vector<int64_t>> chunks(numChunks);
+  std::vector<int64_t> gapCounts(numChunks, 0);
+  collectFrontier(CollectFrontierImpl(m_FeatureIds, faceNeighbors, nullptr, numCells, chunks, gapCounts), numChunks);
+
+  for(size_t chunk = 0; chunk < numChunks; chunk++)
+  {
+    m_RemainingGapCount += gapCounts[chunk];
+    m_Frontier.insert(m_Frontier.end(), chunks[chunk].begin(), chunks[chunk].end());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FrontierGapFill::~FrontierGapFill() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FrontierGapFill::assignNextLayer()
+{
+  if(m_Frontier.empty())
+  {
+    return false;
+  }
+  FaceNeighbors faceNeighbors(m_Dims);
+
+  // Every frontier cell touches an assigned Feature, so every one of them is assigned in this layer
+  m_Labels.resize(m_Frontier.size());
+  assignFrontier(AssignFrontierImpl(false, m_FeatureIds, faceNeighbors, m_Frontier, m_Labels, m_CellPhases, m_FeaturePhases), m_Frontier.size());
+  assignFrontier(AssignFrontierImpl(true, m_FeatureIds, faceNeighbors, m_Frontier, m_Labels, m_CellPhases, m_FeaturePhases), m_Frontier.size());
+  m_RemainingGapCount -= static_cast<int64_t>(m_Frontier.size());
+
+  // The next frontier is made of the gap cells next to the cells that were just assigned
+  size_t numChunks = (m_Frontier.size() + k_FrontierChunkSize - 1) / k_FrontierChunkSize;
+  std::vector<std::vector<int64_t>> chunks(numChunks);
+  std::vector<int64_t> gapCounts(numChunks, 0);
+  collectFrontier(CollectFrontierImpl(m_FeatureIds, faceNeighbors, &m_Frontier, 0, chunks, gapCounts), numChunks);
+
+  std::vector<int64_t> frontier;
+  for(const std::vector<int64_t>& chunk : chunks)
+  {
+    frontier.insert(frontier.end(), chunk.begin(), chunk.end());
+  }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_sort(frontier.begin(), frontier.end());
+#else
+  std::sort(frontier.begin(), frontier.end());
+#endif
+  frontier.erase(std::unique(frontier.begin(), frontier.end()), frontier.end());
+  m_Frontier.swap(frontier);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t FrontierGapFill::getRemainingGapCount() const
+{
+  return m_RemainingGapCount;
+}
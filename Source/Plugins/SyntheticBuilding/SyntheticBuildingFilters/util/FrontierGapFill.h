@@ -0,0 +1,90 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The FrontierGapFill class grows Feature labels into the unassigned (negative) cells of an image volume.
+ * Each call to assignNextLayer() gives every gap cell that touches an assigned Feature (Id > 0) the Feature that
+ * is most common among its face neighbors; ties go to the first neighbor in -Z, -Y, -X, +X, +Y, +Z order. This is
+ * the same result as repeatedly sweeping the whole volume, but only the active frontier of gap cells is visited.
+ * The labels of a layer are chosen from the previous layer before any of them are written, and the next frontier is
+ * kept sorted, so the result does not depend on the thread schedule.
+ */
+class FrontierGapFill
+{
+public:
+  /**
+   * @brief FrontierGapFill
+   * @param featureIds Cell Feature Ids, updated in place
+   * @param dims X, Y and Z dimensions of the volume
+   * @param cellPhases Optional cell phases that are updated from featurePhases whenever a cell is assigned
+   * @param featurePhases Feature phases; required when cellPhases is set
+   */
+  FrontierGapFill(int32_t* featureIds, const std::array<size_t, 3>& dims, int32_t* cellPhases = nullptr, const int32_t* featurePhases = nullptr);
+  virtual ~FrontierGapFill();
+
+  /**
+   * @brief assignNextLayer Assigns the current frontier and finds the next one
+   * @return False if there was nothing left to assign
+   */
+  bool assignNextLayer();
+
+  /**
+   * @brief getRemainingGapCount Number of cells that are still unassigned
+   * @return
+   */
+  int64_t getRemainingGapCount() const;
+
+private:
+  int32_t* m_FeatureIds = nullptr;
+  std::array<int64_t, 3> m_Dims = {{0, 0, 0}};
+  int32_t* m_CellPhases = nullptr;
+  const int32_t* m_FeaturePhases = nullptr;
+  int64_t m_RemainingGapCount = 0;
+  std::vector<int64_t> m_Frontier;
+  std::vector<int32_t> m_Labels;
+
+public:
+  FrontierGapFill(const FrontierGapFill&) = delete;            // Copy Constructor Not Implemented
+  FrontierGapFill(FrontierGapFill&&) = delete;                 // Move Constructor Not Implemented
+  FrontierGapFill& operator=(const FrontierGapFill&) = delete; // Copy Assignment Not Implemented
+  FrontierGapFill& operator=(FrontierGapFill&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,160 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "OdfAliasTable.h"
+
+#include <algorithm>
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+OdfAliasTable::OdfAliasTable() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+OdfAliasTable::~OdfAliasTable() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void OdfAliasTable::build(const float* density, size_t densitySize, int32_t numBins)
+{
+  m_Probability.assign(std::max(numBins, 0), 1.0f);
+  m_Alias.resize(m_Probability.size());
+  for(int32_t j = 0; j < numBins; j++)
+  {
+    m_Alias[j] = j;
+  }
+
+  int32_t odfSize = static_cast<int32_t>(std::min(densitySize, m_Probability.size()));
+  double totaldensity = 0.0;
+  for(int32_t j = 0; j < odfSize; j++)
+  {
+    totaldensity += std::max(density[j], 0.0f);
+  }
+  if(totaldensity <= 0.0)
+  {
+    return;
+  }
+
+  std::vector<double> scaled(numBins, 0.0);
+  std::vector<int32_t> small;
+  std::vector<int32_t> large;
+  small.reserve(numBins);
+  large.reserve(numBins);
+  for(int32_t j = 0; j < numBins; j++)
+  {
+    if(j < odfSize)
+    {
+      scaled[j] = std::max(density[j], 0.0f) * numBins / totaldensity;
+    }
+    if(scaled[j] < 1.0)
+    {
+      small.push_back(j);
+    }
+    else
+    {
+      large.push_back(j);
+    }
+  }
+
+  while(!small.empty() && !large.empty())
+  {
+    int32_t lessBin = small.back();
+    small.pop_back();
+    int32_t moreBin = large.back();
+    large.pop_back();
+
+    m_Probability[lessBin] = static_cast<float>(scaled[lessBin]);
+    m_Alias[lessBin] = moreBin;
+    scaled[moreBin] = (scaled[moreBin] + scaled[lessBin]) - 1.0;
+    if(scaled[moreBin] < 1.0)
+    {
+      small.push_back(moreBin);
+    }
+    else
+    {
+      large.push_back(moreBin);
+    }
+  }
+  // Whatever is left over (including round off) returns its own bin with probability 1
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void OdfAliasTable::clear()
+{
+  m_Probability.clear();
+  m_Alias.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t OdfAliasTable::getNumberOfBins() const
+{
+  return static_cast<int32_t>(m_Alias.size());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t OdfAliasTable::pick(double random) const
+{
+  int32_t numBins = getNumberOfBins();
+  if(numBins <= 0)
+  {
+    return 0;
+  }
+
+  double scaled = random * static_cast<double>(numBins);
+  int32_t choose = static_cast<int32_t>(scaled);
+  if(choose < 0)
+  {
+    choose = 0;
+  }
+  if(choose >= numBins)
+  {
+    choose = numBins - 1;
+  }
+  double fraction = scaled - static_cast<double>(choose);
+  if(fraction >= m_Probability[choose])
+  {
+    choose = m_Alias[choose];
+  }
+  return choose;
+}
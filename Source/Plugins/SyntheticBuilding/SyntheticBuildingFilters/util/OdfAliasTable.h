@@ -0,0 +1,89 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The OdfAliasTable class samples ODF bins in proportion to their density in constant time per draw
+ * using Vose's alias method. Every bin keeps the probability of returning itself and the bin that receives the
+ * remainder of its slot. Negative densities count as zero and bins past the end of the density array are never
+ * picked.
+ */
+class OdfAliasTable
+{
+public:
+  OdfAliasTable();
+  virtual ~OdfAliasTable();
+
+  /**
+   * @brief build Builds the table for numBins bins from the first numBins densities
+   * @param density ODF density of each bin; it does not have to be normalized
+   * @param densitySize Number of values in density
+   * @param numBins Number of bins to sample
+   */
+  void build(const float* density, size_t densitySize, int32_t numBins);
+
+  /**
+   * @brief clear Releases the table
+   */
+  void clear();
+
+  /**
+   * @brief getNumberOfBins Number of bins the table was built for
+   * @return
+   */
+  int32_t getNumberOfBins() const;
+
+  /**
+   * @brief pick Picks a bin
+   * @param random Uniform random value in [0, 1)
+   * @return Bin index
+   */
+  int32_t pick(double random) const;
+
+private:
+  std::vector<float> m_Probability;
+  std::vector<int32_t> m_Alias;
+
+public:
+  OdfAliasTable(const OdfAliasTable&) = delete;            // Copy Constructor Not Implemented
+  OdfAliasTable(OdfAliasTable&&) = delete;                 // Move Constructor Not Implemented
+  OdfAliasTable& operator=(const OdfAliasTable&) = delete; // Copy Assignment Not Implemented
+  OdfAliasTable& operator=(OdfAliasTable&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,237 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SyntheticBuildingTestFileLocations.h"
+
+// Directly include the .cpp file instead of the header because of the way the unit
+// tests are compiled.
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/FrontierGapFill.cpp"
+
+class FrontierGapFillTest
+{
+public:
+  FrontierGapFillTest() = default;
+  virtual ~FrontierGapFillTest() = default;
+
+  /**
+   * @brief Returns the name of the class for FrontierGapFillTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("FrontierGapFillTest");
+  }
+
+  // -----------------------------------------------------------------------------
+  // One full volume sweep of PackPrimaryPhases::assignGapsOnly as it was before the
+  // frontier: every gap cell picks the neighbor Feature that first reaches the highest
+  // count and the picks are written after the sweep.
+  // Returns the number of gap cells found by the sweep.
+  // -----------------------------------------------------------------------------
+  int64_t ReferenceSweep(std::vector<int32_t>& featureIds, std::vector<int32_t>& cellPhases, const std::vector<int32_t>& featurePhases, std::vector<int64_t>& neighbors,
+                         const std::array<size_t, 3>& dims)
+  {
+    int64_t xPoints = static_cast<int64_t>(dims[0]);
+    int64_t yPoints = static_cast<int64_t>(dims[1]);
+    int64_t zPoints = static_cast<int64_t>(dims[2]);
+    int64_t neighpoints[6] = {-xPoints * yPoints, -xPoints, -1, 1, xPoints, xPoints * yPoints};
+    std::vector<int32_t> n(featurePhases.size() + 1, 0);
+
+    int64_t gapVoxelCount = 0;
+    for(int64_t i = 0; i < zPoints; i++)
+    {
+      for(int64_t j = 0; j < yPoints; j++)
+      {
+        for(int64_t k = 0; k < xPoints; k++)
+        {
+          int64_t index = (i * xPoints * yPoints) + (j * xPoints) + k;
+          if(featureIds[index] >= 0)
+          {
+            continue;
+          }
+          gapVoxelCount++;
+          bool good[6] = {i > 0, j > 0, k > 0, k < xPoints - 1, j < yPoints - 1, i < zPoints - 1};
+          int32_t most = 0;
+          for(int32_t l = 0; l < 6; l++)
+          {
+            int32_t feature = good[l] ? featureIds[index + neighpoints[l]] : 0;
+            if(feature > 0)
+            {
+              n[feature]++;
+              if(n[feature] > most)
+              {
+                most = n[feature];
+                neighbors[index] = index + neighpoints[l];
+              }
+            }
+          }
+          for(int32_t l = 0; l < 6; l++)
+          {
+            int32_t feature = good[l] ? featureIds[index + neighpoints[l]] : 0;
+            if(feature > 0)
+            {
+              n[feature] = 0;
+            }
+          }
+        }
+      }
+    }
+    for(size_t j = 0; j < featureIds.size(); j++)
+    {
+      int64_t neighbor = neighbors[j];
+      if(featureIds[j] < 0 && neighbor != -1 && featureIds[neighbor] > 0)
+      {
+        featureIds[j] = featureIds[neighbor];
+        cellPhases[j] = featurePhases[featureIds[neighbor]];
+      }
+    }
+    return gapVoxelCount;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareWithSweeps(const std::array<size_t, 3>& dims, int32_t numFeatures, double seedFraction, std::mt19937_64& generator)
+  {
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+    std::uniform_int_distribution<int32_t> featureDistribution(1, numFeatures);
+    std::uniform_int_distribution<int32_t> phaseDistribution(1, 3);
+    std::bernoulli_distribution seedDistribution(seedFraction);
+
+    std::vector<int32_t> featurePhases(numFeatures + 1, 0);
+    for(int32_t f = 1; f <= numFeatures; f++)
+    {
+      featurePhases[f] = phaseDistribution(generator);
+    }
+
+    std::vector<int32_t> featureIds(totalPoints, -1);
+    std::vector<int32_t> cellPhases(totalPoints, 0);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      if(seedDistribution(generator))
+      {
+        featureIds[i] = featureDistribution(generator);
+        cellPhases[i] = featurePhases[featureIds[i]];
+      }
+    }
+    // A shell of Feature 0 cells around the first cell keeps it from ever being reached
+    if(totalPoints > 1)
+    {
+      featureIds[0] = -1;
+      featureIds[1] = 0;
+      if(dims[1] > 1)
+      {
+        featureIds[dims[0]] = 0;
+      }
+      if(dims[2] > 1)
+      {
+        featureIds[dims[0] * dims[1]] = 0;
+      }
+    }
+
+    std::vector<int32_t> referenceIds = featureIds;
+    std::vector<int32_t> referencePhases = cellPhases;
+    std::vector<int64_t> neighbors(totalPoints, -1);
+
+    FrontierGapFill gapFill(featureIds.data(), dims, cellPhases.data(), featurePhases.data());
+    int64_t gapVoxelCount = ReferenceSweep(referenceIds, referencePhases, featurePhases, neighbors, dims);
+    DREAM3D_REQUIRE_EQUAL(gapFill.getRemainingGapCount(), gapVoxelCount)
+
+    // Every layer must match one sweep of the whole volume
+    while(gapFill.assignNextLayer())
+    {
+      DREAM3D_REQUIRE(featureIds == referenceIds)
+      DREAM3D_REQUIRE(cellPhases == referencePhases)
+      gapVoxelCount = ReferenceSweep(referenceIds, referencePhases, featurePhases, neighbors, dims);
+      DREAM3D_REQUIRE_EQUAL(gapFill.getRemainingGapCount(), gapVoxelCount)
+    }
+
+    // Nothing that a sweep could still reach is left
+    DREAM3D_REQUIRE(featureIds == referenceIds)
+    DREAM3D_REQUIRE(cellPhases == referencePhases)
+    int64_t remaining = 0;
+    for(int32_t featureId : featureIds)
+    {
+      remaining += (featureId < 0) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE_EQUAL(gapFill.getRemainingGapCount(), remaining)
+    DREAM3D_REQUIRE(featureIds[0] < 0 || totalPoints == 1)
+    ReferenceSweep(referenceIds, referencePhases, featurePhases, neighbors, dims);
+    DREAM3D_REQUIRE(featureIds == referenceIds)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestAssignGaps()
+  {
+    std::mt19937_64 generator(24680);
+    const std::array<size_t, 3> shapes[] = {{{1, 1, 1}}, {{120, 1, 1}}, {{30, 25, 1}}, {{1, 20, 30}}, {{24, 18, 12}}, {{70, 60, 40}}};
+    const double seedFractions[] = {0.002, 0.05, 0.5};
+    for(const std::array<size_t, 3>& dims : shapes)
+    {
+      for(double seedFraction : seedFractions)
+      {
+        CompareWithSweeps(dims, 25, seedFraction, generator);
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start " << getNameOfClass().toStdString() << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestAssignGaps())
+  }
+
+private:
+  FrontierGapFillTest(const FrontierGapFillTest&); // Copy Constructor Not Implemented
+  void operator=(const FrontierGapFillTest&);      // Move assignment Not Implemented
+};
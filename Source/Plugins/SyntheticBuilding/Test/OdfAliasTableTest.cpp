@@ -0,0 +1,187 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SyntheticBuildingTestFileLocations.h"
+
+// Directly include the .cpp file instead of the header because of the way the unit
+// tests are compiled.
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/OdfAliasTable.cpp"
+
+class OdfAliasTableTest
+{
+public:
+  OdfAliasTableTest() = default;
+  virtual ~OdfAliasTableTest() = default;
+
+  /**
+   * @brief Returns the name of the class for OdfAliasTableTest
+   */
+  QString getNameOfClass() const
+  {
+    return QString("OdfAliasTableTest");
+  }
+
+  // -----------------------------------------------------------------------------
+  // The cumulative density scan MatchCrystallography used before the alias table
+  // -----------------------------------------------------------------------------
+  int32_t ReferencePick(const std::vector<float>& density, float random)
+  {
+    int32_t choose = 0;
+    float totaldensity = 0.0f;
+    for(int32_t j = 0; j < static_cast<int32_t>(density.size()); j++)
+    {
+      float td1 = totaldensity;
+      totaldensity = totaldensity + density[j];
+      if(random < totaldensity && random >= td1)
+      {
+        choose = j;
+        break;
+      }
+    }
+    return choose;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Picks on an even grid of random values, so the fraction of picks per bin is the probability of the bin
+  // up to the grid spacing
+  // -----------------------------------------------------------------------------
+  template <typename Picker>
+  std::vector<double> PickFractions(int32_t numBins, size_t numSamples, Picker picker)
+  {
+    std::vector<double> fractions(numBins, 0.0);
+    for(size_t k = 0; k < numSamples; k++)
+    {
+      double random = (static_cast<double>(k) + 0.5) / static_cast<double>(numSamples);
+      int32_t bin = picker(random);
+      DREAM3D_REQUIRE(bin >= 0 && bin < numBins)
+      fractions[bin] += 1.0 / static_cast<double>(numSamples);
+    }
+    return fractions;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMatchesCumulativeScan()
+  {
+    // A normalized, uneven ODF with some empty bins
+    const int32_t k_NumBins = 200;
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> density(k_NumBins, 0.0f);
+    double total = 0.0;
+    for(int32_t j = 0; j < k_NumBins; j++)
+    {
+      float value = distribution(generator);
+      density[j] = (j % 7 == 0) ? 0.0f : value * value * value;
+      total += density[j];
+    }
+    for(float& value : density)
+    {
+      value = static_cast<float>(value / total);
+    }
+
+    OdfAliasTable table;
+    table.build(density.data(), density.size(), k_NumBins);
+    DREAM3D_REQUIRE_EQUAL(table.getNumberOfBins(), k_NumBins)
+
+    const size_t k_NumSamples = 2000000;
+    std::vector<double> aliasFractions = PickFractions(k_NumBins, k_NumSamples, [&table](double random) { return table.pick(random); });
+    std::vector<double> scanFractions = PickFractions(k_NumBins, k_NumSamples, [this, &density](double random) { return ReferencePick(density, static_cast<float>(random)); });
+    for(int32_t j = 0; j < k_NumBins; j++)
+    {
+      DREAM3D_REQUIRE(std::fabs(aliasFractions[j] - density[j]) < 1.0E-4)
+      DREAM3D_REQUIRE(std::fabs(aliasFractions[j] - scanFractions[j]) < 1.0E-4)
+      if(density[j] == 0.0f)
+      {
+        DREAM3D_REQUIRE_EQUAL(aliasFractions[j], 0.0)
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestUnnormalizedDensity()
+  {
+    // Negative densities count as zero and the bins past the end of the density are never picked
+    std::vector<float> density = {2.0f, -1.0f, 6.0f, 0.0f};
+    OdfAliasTable table;
+    table.build(density.data(), density.size(), 6);
+    std::vector<double> fractions = PickFractions(6, 800000, [&table](double random) { return table.pick(random); });
+    DREAM3D_REQUIRE(std::fabs(fractions[0] - 0.25) < 1.0E-4)
+    DREAM3D_REQUIRE_EQUAL(fractions[1], 0.0)
+    DREAM3D_REQUIRE(std::fabs(fractions[2] - 0.75) < 1.0E-4)
+    DREAM3D_REQUIRE_EQUAL(fractions[3], 0.0)
+    DREAM3D_REQUIRE_EQUAL(fractions[4], 0.0)
+    DREAM3D_REQUIRE_EQUAL(fractions[5], 0.0)
+
+    // The end points of the random range stay inside the table
+    DREAM3D_REQUIRE(table.pick(0.0) >= 0)
+    DREAM3D_REQUIRE(table.pick(1.0) < 6)
+
+    table.clear();
+    DREAM3D_REQUIRE_EQUAL(table.getNumberOfBins(), 0)
+    DREAM3D_REQUIRE_EQUAL(table.pick(0.5), 0)
+    return EXIT_SUCCESS;
+  }
+
+  /**
+   * @brief This is the main function
+   */
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start " << getNameOfClass().toStdString() << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestMatchesCumulativeScan())
+    DREAM3D_REGISTER_TEST(TestUnnormalizedDensity())
+  }
+
+private:
+  OdfAliasTableTest(const OdfAliasTableTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const OdfAliasTableTest&) = delete;    // Move assignment Not Implemented
+};
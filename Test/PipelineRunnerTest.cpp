@@ -39,18 +39,32 @@
 
 #ifdef _MSC_VER
 #include <direct.h>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
 #else
+#include <sys/resource.h>
+#include <sys/time.h>
 #include <unistd.h>
 #endif
 
 // C++ Includes
+#include <algorithm>
 #include <iostream>
+#include <thread>
 
 // Qt Includes
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMap>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QStringListIterator>
@@ -59,6 +73,8 @@
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
 
 #include "SIMPLib/FilterParameters/H5FilterParametersReader.h"
 #include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
@@ -75,10 +91,115 @@
 
 #include "PipelineRunnerTest.h"
 
+namespace
+{
+/**
+ * @brief Wall times below this many milliseconds are dominated by timer and scheduler noise
+ * and are not checked against the baseline.
+ */
+const double k_BenchmarkNoiseFloorMillis = 50.0;
+
+struct ProcessUsage
+{
+  double cpuMillis = 0.0;
+  qint64 peakRss = 0;
+};
+
+/**
+ * @brief Returns the user + system CPU time consumed so far by this process and its peak
+ * resident set size in bytes. Peak RSS is a process wide high water mark so the value
+ * recorded for a filter is the largest footprint seen up to and including that filter.
+ */
+ProcessUsage QueryProcessUsage()
+{
+  ProcessUsage usage;
+#ifdef _MSC_VER
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  if(GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime) != 0)
+  {
+    ULARGE_INTEGER kernel;
+    kernel.LowPart = kernelTime.dwLowDateTime;
+    kernel.HighPart = kernelTime.dwHighDateTime;
+    ULARGE_INTEGER user;
+    user.LowPart = userTime.dwLowDateTime;
+    user.HighPart = userTime.dwHighDateTime;
+    // FILETIME values are in 100 nanosecond ticks
+    usage.cpuMillis = static_cast<double>(kernel.QuadPart + user.QuadPart) / 10000.0;
+  }
+  PROCESS_MEMORY_COUNTERS counters;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) != 0)
+  {
+    usage.peakRss = static_cast<qint64>(counters.PeakWorkingSetSize);
+  }
+#else
+  struct rusage ru;
+  if(getrusage(RUSAGE_SELF, &ru) == 0)
+  {
+    usage.cpuMillis = static_cast<double>(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000.0 + static_cast<double>(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1000.0;
+#ifdef __APPLE__
+    usage.peakRss = static_cast<qint64>(ru.ru_maxrss); // Bytes on macOS
+#else
+    usage.peakRss = static_cast<qint64>(ru.ru_maxrss) * 1024; // Kilobytes on Linux
+#endif
+  }
+#endif
+  return usage;
+}
+
+/**
+ * @brief Multiplies every "Dimensions" property of the pipeline's filters (InitializeSyntheticVolume,
+ * CreateImageGeometry, ...) by the scale factor so the same pipeline can be run at several
+ * input sizes.
+ * @return True if at least one filter was rescaled.
+ */
+bool ScalePipelineDimensions(const FilterPipeline::Pointer& pipeline, int scale)
+{
+  bool didScale = false;
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  for(const auto& filter : filters)
+  {
+    QVariant var = filter->property("Dimensions");
+    if(!var.isValid() || !var.canConvert<IntVec3Type>())
+    {
+      continue;
+    }
+    IntVec3Type dims = var.value<IntVec3Type>();
+    for(size_t i = 0; i < 3; i++)
+    {
+      // Leave the flat axis of 2D geometries alone
+      if(dims[i] > 1)
+      {
+        dims[i] = dims[i] * scale;
+      }
+    }
+    var.setValue(dims);
+    didScale = filter->setProperty("Dimensions", var) || didScale;
+  }
+  return didScale;
+}
+
+/**
+ * @brief The pipeline list file prefixes each entry with its ctest index, "[N]    /path/to/pipeline.json".
+ */
+QString StripPipelineIndex(const QString& line)
+{
+  QString pipelineFile = line.trimmed();
+  if(pipelineFile.startsWith("["))
+  {
+    int close = pipelineFile.indexOf("]");
+    if(close > 0)
+    {
+      pipelineFile = pipelineFile.mid(close + 1).trimmed();
+    }
+  }
+  return pipelineFile;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ExecutePipeline(const QString& pipelineFile)
+FilterPipeline::Pointer ReadPipelineFile(const QString& pipelineFile)
 {
   int err = EXIT_SUCCESS;
 
@@ -114,6 +235,17 @@ void ExecutePipeline(const QString& pipelineFile)
   }
   DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
 
+  return pipeline;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutePipeline(const QString& pipelineFile)
+{
+  FilterPipeline::Pointer pipeline = ReadPipelineFile(pipelineFile);
+  int err = EXIT_SUCCESS;
+
   TestObserver obs; // Create an Observer to report errors/progress from the executing pipeline
   pipeline->addMessageReceiver(&obs);
   // Preflight the pipeline
@@ -140,6 +272,167 @@ void ExecutePipeline(const QString& pipelineFile)
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject BenchmarkPipeline(const QString& pipelineFile, int scale)
+{
+  FilterPipeline::Pointer pipeline = ReadPipelineFile(pipelineFile);
+  int err = EXIT_SUCCESS;
+
+  QJsonObject result;
+  result["Pipeline"] = QFileInfo(pipelineFile).fileName();
+  result["Scale"] = scale;
+
+  bool scalable = ScalePipelineDimensions(pipeline, scale);
+  result["Scalable"] = scalable;
+  if(!scalable && scale != 1)
+  {
+    // Nothing in this pipeline depends on the synthetic size so it only runs at scale 1
+    return QJsonObject();
+  }
+
+  TestObserver obs; // Create an Observer to report errors/progress from the executing pipeline
+  pipeline->addMessageReceiver(&obs);
+  err = pipeline->preflightPipeline();
+  if(err < 0)
+  {
+    std::cout << "Errors preflighting the pipeline. Exiting Now." << std::endl;
+  }
+  DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+
+  // Run the filters one at a time, the same way FilterPipeline::execute() does, so each one
+  // can be timed on its own.
+  double hardwareThreads = static_cast<double>(std::max(1u, std::thread::hardware_concurrency()));
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  QJsonArray filterResults;
+  double totalMillis = 0.0;
+  ProcessUsage usage = QueryProcessUsage();
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  for(int i = 0; i < filters.size(); i++)
+  {
+    AbstractFilter::Pointer filter = filters[i];
+    if(!filter->getEnabled())
+    {
+      continue;
+    }
+    filter->setDataContainerArray(dca);
+
+    ProcessUsage before = usage;
+    QElapsedTimer timer;
+    timer.start();
+    filter->execute();
+    double wallMillis = static_cast<double>(timer.nsecsElapsed()) / 1.0E6;
+    usage = QueryProcessUsage();
+
+    err = filter->getErrorCode();
+    if(err < 0)
+    {
+      std::cout << "Error Condition of Filter " << filter->getHumanLabel().toStdString() << ": " << err << std::endl;
+      err = EXIT_FAILURE;
+    }
+    DREAM3D_REQUIRE_EQUAL(err, EXIT_SUCCESS)
+    dca = filter->getDataContainerArray();
+
+    double cpuMillis = usage.cpuMillis - before.cpuMillis;
+    QJsonObject filterResult;
+    filterResult["Index"] = i;
+    filterResult["Filter"] = filter->getNameOfClass();
+    filterResult["Human Label"] = filter->getHumanLabel();
+    filterResult["Wall Time (ms)"] = wallMillis;
+    filterResult["CPU Time (ms)"] = cpuMillis;
+    // Average number of busy hardware threads as a fraction of the machine, 1.0 is fully parallel
+    filterResult["Thread Utilization"] = wallMillis > 0.0 ? cpuMillis / wallMillis / hardwareThreads : 0.0;
+    filterResult["Peak RSS (bytes)"] = static_cast<double>(usage.peakRss);
+    filterResults.append(filterResult);
+
+    totalMillis += wallMillis;
+  }
+
+  result["Wall Time (ms)"] = totalMillis;
+  result["Peak RSS (bytes)"] = static_cast<double>(usage.peakRss);
+  result["Filters"] = filterResults;
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString BenchmarkKey(const QJsonObject& pipelineResult, const QJsonObject& filterResult)
+{
+  QString key = QString("%1 [x%2]").arg(pipelineResult["Pipeline"].toString()).arg(pipelineResult["Scale"].toInt());
+  if(filterResult.isEmpty())
+  {
+    return key;
+  }
+  return QString("%1 (%2) %3").arg(key).arg(filterResult["Index"].toInt()).arg(filterResult["Filter"].toString());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QMap<QString, double> CollectBenchmarkTimes(const QJsonArray& pipelineResults)
+{
+  QMap<QString, double> times;
+  for(const auto& pipelineValue : pipelineResults)
+  {
+    QJsonObject pipelineResult = pipelineValue.toObject();
+    times[BenchmarkKey(pipelineResult, QJsonObject())] = pipelineResult["Wall Time (ms)"].toDouble();
+    QJsonArray filterResults = pipelineResult["Filters"].toArray();
+    for(const auto& filterValue : filterResults)
+    {
+      QJsonObject filterResult = filterValue.toObject();
+      times[BenchmarkKey(pipelineResult, filterResult)] = filterResult["Wall Time (ms)"].toDouble();
+    }
+  }
+  return times;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int CompareToBaseline(const QJsonArray& pipelineResults, const QString& baselineFile, double thresholdPercent)
+{
+  QFile source(baselineFile);
+  if(!source.open(QFile::ReadOnly))
+  {
+    std::cout << "Benchmark baseline '" << baselineFile.toStdString() << "' could not be opened. Skipping the regression check." << std::endl;
+    return EXIT_SUCCESS;
+  }
+  QJsonParseError parseError;
+  QJsonDocument doc = QJsonDocument::fromJson(source.readAll(), &parseError);
+  source.close();
+  if(parseError.error != QJsonParseError::NoError)
+  {
+    std::cout << "Benchmark baseline '" << baselineFile.toStdString() << "' is not valid JSON: " << parseError.errorString().toStdString() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  QMap<QString, double> baseline = CollectBenchmarkTimes(doc.object()["Pipelines"].toArray());
+  QMap<QString, double> current = CollectBenchmarkTimes(pipelineResults);
+
+  int err = EXIT_SUCCESS;
+  for(auto iter = current.constBegin(); iter != current.constEnd(); ++iter)
+  {
+    if(!baseline.contains(iter.key()))
+    {
+      continue;
+    }
+    double reference = baseline.value(iter.key());
+    if(reference < k_BenchmarkNoiseFloorMillis)
+    {
+      continue;
+    }
+    double change = (iter.value() - reference) / reference * 100.0;
+    if(change > thresholdPercent)
+    {
+      std::cout << "REGRESSION: " << iter.key().toStdString() << " took " << iter.value() << " ms, baseline " << reference << " ms (+" << change << "%)" << std::endl;
+      err = EXIT_FAILURE;
+    }
+  }
+  return err;
+}
+
 #define OVERWRITE_SOURCE_FILE 1
 // -----------------------------------------------------------------------------
 //
@@ -239,6 +532,50 @@ int main(int argc, char* argv[])
   // Send progress messages from PipelineBuilder to this object for display
   QMetaObjectUtilities::RegisterMetaTypes();
 
+  // Benchmark mode:
+  //   PipelineRunnerTest --benchmark <results.json> [--baseline <baseline.json>] [--threshold <percent>] [--sizes 1,2,4]
+  // runs every pipeline at each size (a multiplier applied to the synthetic volume dimensions),
+  // writes per filter timings to <results.json> and fails if any of them regress past the
+  // threshold compared to the baseline.
+  QString benchmarkFile;
+  QString baselineFile;
+  double thresholdPercent = 10.0;
+  QList<int> scales = {1};
+  QStringList args = app.arguments();
+  for(int i = 1; i < args.size() - 1; i++)
+  {
+    if(args[i] == "--benchmark")
+    {
+      benchmarkFile = args[++i];
+    }
+    else if(args[i] == "--baseline")
+    {
+      baselineFile = args[++i];
+    }
+    else if(args[i] == "--threshold")
+    {
+      thresholdPercent = args[++i].toDouble();
+    }
+    else if(args[i] == "--sizes")
+    {
+      scales.clear();
+      QStringList tokens = args[++i].split(",", QString::SkipEmptyParts);
+      for(const auto& token : tokens)
+      {
+        int scale = token.trimmed().toInt();
+        if(scale > 0)
+        {
+          scales.push_back(scale);
+        }
+      }
+    }
+  }
+  bool benchmark = !benchmarkFile.isEmpty();
+  if(!benchmark || scales.isEmpty())
+  {
+    scales = {1};
+  }
+
   int err = 0;
   // Read in the contents of the PipelineList file which contains all the Pipelines that we want
   // to execute
@@ -253,39 +590,77 @@ int main(int argc, char* argv[])
   }
   // Split the file into tokens using the newline character
   QStringList list = contents.split(QRegExp("\\n"));
-  QStringListIterator sourceLines(list);
 
   // Iterate over all the entries in the file and process each pipeline. Note that the order of the
-  // pipelines will probably matter
+  // pipelines will probably matter, so every pipeline is run at one size before moving to the next.
+  QJsonArray benchmarkResults;
   int testNum = 0;
-  while(sourceLines.hasNext())
+  for(const auto& scale : scales)
   {
-    QString pipelineFile = sourceLines.next();
-    pipelineFile = pipelineFile.trimmed();
-    if(pipelineFile.isEmpty())
+    QStringListIterator sourceLines(list);
+    while(sourceLines.hasNext())
     {
-      continue;
+      QString pipelineFile = StripPipelineIndex(sourceLines.next());
+      if(pipelineFile.isEmpty())
+      {
+        continue;
+      }
+      try
+      {
+        QFileInfo fi(pipelineFile);
+
+        // pipelineFile = AdjustOutputDirectory(pipelineFile);
+
+        SIMPL::unittest::CurrentMethod = fi.fileName().toStdString();
+        SIMPL::unittest::numTests++;
+
+        std::cout << "\"" << testNum++ << "\": {" << std::endl;
+
+        if(benchmark)
+        {
+          QJsonObject result = BenchmarkPipeline(pipelineFile, scale);
+          if(!result.isEmpty())
+          {
+            benchmarkResults.append(result);
+          }
+        }
+        else
+        {
+          ExecutePipeline(pipelineFile);
+        }
+
+        TestPassed(fi.fileName().toStdString());
+        std::cout << "}," << std::endl;
+        SIMPL::unittest::CurrentMethod = "";
+      } catch(TestException& e)
+      {
+        TestFailed(SIMPL::unittest::CurrentMethod);
+        std::cout << e.what() << std::endl;
+        err = EXIT_FAILURE;
+      }
     }
-    try
-    {
-      QFileInfo fi(pipelineFile);
-
-      // pipelineFile = AdjustOutputDirectory(pipelineFile);
-
-      SIMPL::unittest::CurrentMethod = fi.fileName().toStdString();
-      SIMPL::unittest::numTests++;
-
-      std::cout << "\"" << testNum++ << "\": {" << std::endl;
+  }
 
-      ExecutePipeline(pipelineFile);
+  if(benchmark)
+  {
+    QJsonObject root;
+    root["SIMPLib Version"] = SIMPLib::Version::Complete();
+    root["Hardware Threads"] = static_cast<int>(std::thread::hardware_concurrency());
+    root["Pipelines"] = benchmarkResults;
+    QFile out(benchmarkFile);
+    if(out.open(QFile::WriteOnly))
+    {
+      out.write(QJsonDocument(root).toJson());
+      out.close();
+    }
+    else
+    {
+      std::cout << "Benchmark results could not be written to '" << benchmarkFile.toStdString() << "'" << std::endl;
+      err = EXIT_FAILURE;
+    }
 
-      TestPassed(fi.fileName().toStdString());
-      std::cout << "}," << std::endl;
-      SIMPL::unittest::CurrentMethod = "";
-    } catch(TestException& e)
+    if(!baselineFile.isEmpty() && CompareToBaseline(benchmarkResults, baselineFile, thresholdPercent) != EXIT_SUCCESS)
     {
-      TestFailed(SIMPL::unittest::CurrentMethod);
-      std::cout << e.what() << std::endl;
       err = EXIT_FAILURE;
     }
   }